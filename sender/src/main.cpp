@@ -1,167 +1,325 @@
-// ROTS Sender Main Application - ESP32
-#include "rots_sender.h"
-#include "rots_sensor_manager.h"
-#include "rots_ai_engine.h"
-#include "rots_communication.h"
-#include "rots_system_monitor.h"
-#include "rots_debug.h"
-
-// 全局变量
-ROTS_SenderStatus_t sender_status;
-bool system_initialized = false;
-
-// 函数声明
-void setup();
-void loop();
-ROTS_StatusTypeDef ROTS_Sender_Init(void);
-void ROTS_Sender_MainLoop(void);
-void ROTS_Sender_ErrorHandler(ROTS_StatusTypeDef error_code);
-
-void setup() {
-    // 初始化串口
-    Serial.begin(115200);
-    delay(1000);
-    
-    DEBUG_INFO("ROTS Sender Starting...\r\n");
-    
-    // 初始化系统
-    ROTS_StatusTypeDef status = ROTS_Sender_Init();
-    if (status != ROTS_OK) {
-        ROTS_Sender_ErrorHandler(status);
-        return;
-    }
-    
-    system_initialized = true;
-    DEBUG_INFO("System initialization completed\r\n");
-}
-
-void loop() {
-    if (!system_initialized) {
-        delay(1000);
-        return;
-    }
-    
-    ROTS_Sender_MainLoop();
-    delay(10);
-}
-
-ROTS_StatusTypeDef ROTS_Sender_Init(void) {
-    ROTS_StatusTypeDef status = ROTS_OK;
-    
-    // 初始化调试系统
-    status = ROTS_Debug_Init();
-    if (status != ROTS_OK) return status;
-    
-    // 初始化传感器管理器
-    status = ROTS_SensorManager_Init();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("Sensor manager init failed\r\n");
-        return status;
-    }
-    
-    // 初始化AI引擎
-    status = ROTS_AIEngine_Init();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("AI engine init failed\r\n");
-        return status;
-    }
-    
-    // 初始化通信模块
-    status = ROTS_Communication_Init();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("Communication init failed\r\n");
-        return status;
-    }
-    
-    // 初始化系统监控
-    status = ROTS_SystemMonitor_Init();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("System monitor init failed\r\n");
-        return status;
-    }
-    
-    // 初始化发送端状态
-    sender_status.state = ROTS_SENDER_IDLE;
-    sender_status.last_detection_time = 0;
-    sender_status.detection_count = 0;
-    sender_status.error_count = 0;
-    
-    return ROTS_OK;
-}
-
-void ROTS_Sender_MainLoop(void) {
-    static uint32_t last_sensor_read = 0;
-    static uint32_t last_ai_inference = 0;
-    static uint32_t last_status_update = 0;
-    static uint32_t last_debug_output = 0;
-    
-    uint32_t current_time = millis();
-    
-    // 读取传感器数据 (每100ms)
-    if (current_time - last_sensor_read >= 100) {
-        ROTS_SensorData_t sensor_data;
-        ROTS_StatusTypeDef status = ROTS_SensorManager_ReadSensors(&sensor_data);
-        
-        if (status == ROTS_OK) {
-            // 更新传感器数据
-            ROTS_SensorManager_UpdateData(&sensor_data);
-            last_sensor_read = current_time;
-        } else {
-            DEBUG_ERROR("Sensor read failed: %d\r\n", status);
-        }
-    }
-    
-    // AI推理 (每500ms)
-    if (current_time - last_ai_inference >= 500) {
-        ROTS_OdorResult_t ai_result;
-        ROTS_StatusTypeDef status = ROTS_AIEngine_ProcessOdor(&ai_result);
-        
-        if (status == ROTS_OK && ai_result.confidence > ROTS_AI_CONFIDENCE_THRESHOLD) {
-            DEBUG_INFO("Odor detected: %s (confidence: %.2f)\r\n", 
-                      ai_result.odor_name, ai_result.confidence);
-            
-            // 发送检测结果
-            ROTS_Communication_SendOdorDetection(&ai_result);
-            
-            // 更新状态
-            sender_status.state = ROTS_SENDER_DETECTING;
-            sender_status.last_detection_time = current_time;
-            sender_status.detection_count++;
-        } else if (current_time - sender_status.last_detection_time > 5000) {
-            // 5秒内无检测，回到空闲状态
-            sender_status.state = ROTS_SENDER_IDLE;
-        }
-        
-        last_ai_inference = current_time;
-    }
-    
-    // 更新系统状态 (每1秒)
-    if (current_time - last_status_update >= 1000) {
-        ROTS_SystemMonitor_Update();
-        last_status_update = current_time;
-    }
-    
-    // 调试输出 (每10秒)
-    if (current_time - last_debug_output >= 10000) {
-        ROTS_Debug_PrintSystemStatus();
-        ROTS_Debug_PrintSensorStatus();
-        ROTS_Debug_PrintAIStatus();
-        ROTS_Debug_PrintMemoryUsage();
-        last_debug_output = current_time;
-    }
-}
-
-void ROTS_Sender_ErrorHandler(ROTS_StatusTypeDef error_code) {
-    DEBUG_ERROR("System error: %d\r\n", error_code);
-    
-    // 显示错误LED
-    digitalWrite(ROTS_ERROR_LED_PIN, HIGH);
-    
-    // 记录错误
-    sender_status.error_count++;
-    ROTS_SystemMonitor_LogError(error_code);
-    
-    // 尝试恢复
-    delay(1000);
-    digitalWrite(ROTS_ERROR_LED_PIN, LOW);
-}
+// ROTS Sender Main Application - ESP32
+#include "rots_sender.h"
+#include "rots_sensor_manager.h"
+#include "rots_ai_engine.h"
+#include "rots_communication.h"
+#include "rots_system_monitor.h"
+#include "rots_spsc_queue.h"
+#include "rots_decision_smoother.h"
+#include "rots_debug.h"
+
+// 全局变量
+ROTS_SenderStatus_t sender_status;
+bool system_initialized = false;
+
+// 任务与任务间队列: 采集 -> 传感器帧 -> 推理 -> 检测结果 -> 通信
+static ROTS_SensorData_t frame_queue_storage[ROTS_FRAME_QUEUE_SIZE];
+static ROTS_OdorResult_t result_queue_storage[ROTS_RESULT_QUEUE_SIZE];
+static ROTS_SPSCQueue_t frame_queue;
+static ROTS_SPSCQueue_t result_queue;
+static TaskHandle_t acquisition_task = NULL;
+static TaskHandle_t inference_task = NULL;
+static TaskHandle_t comm_task = NULL;
+
+// 新颖读数上报 (仅通信任务访问)
+static bool novelty_active = false;
+static uint32_t last_novelty_report = 0;
+
+// 函数声明
+void setup();
+void loop();
+ROTS_StatusTypeDef ROTS_Sender_Init(void);
+ROTS_StatusTypeDef ROTS_Sender_StartTasks(void);
+void ROTS_Sender_ErrorHandler(ROTS_StatusTypeDef error_code);
+
+// 私有函数声明
+static void ROTS_Sender_AcquisitionTask(void* arg);
+static void ROTS_Sender_InferenceTask(void* arg);
+static void ROTS_Sender_CommTask(void* arg);
+static void ROTS_Sender_HandleResult(const ROTS_OdorResult_t* result);
+static void ROTS_Sender_PrintPipelineStatus(void);
+
+void setup() {
+    // 初始化串口
+    Serial.begin(115200);
+    delay(1000);
+    
+    DEBUG_INFO("ROTS Sender Starting...\r\n");
+    
+    // 初始化系统
+    ROTS_StatusTypeDef status = ROTS_Sender_Init();
+    if (status != ROTS_OK) {
+        ROTS_Sender_ErrorHandler(status);
+        return;
+    }
+    
+    // 启动采集/推理/通信任务
+    status = ROTS_Sender_StartTasks();
+    if (status != ROTS_OK) {
+        ROTS_Sender_ErrorHandler(status);
+        return;
+    }
+    
+    system_initialized = true;
+    DEBUG_INFO("System initialization completed\r\n");
+}
+
+void loop() {
+    if (!system_initialized) {
+        delay(1000);
+        return;
+    }
+    
+    // 工作全部在固定核的任务中进行, 释放loop任务的栈
+    vTaskDelete(NULL);
+}
+
+ROTS_StatusTypeDef ROTS_Sender_Init(void) {
+    ROTS_StatusTypeDef status = ROTS_OK;
+    
+    // 初始化调试系统
+    status = ROTS_Debug_Init();
+    if (status != ROTS_OK) return status;
+    
+    // 初始化传感器管理器 (预热和校准在主循环中进行, 与通信初始化并行)
+    status = ROTS_SensorManager_Init();
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Sensor manager init failed\r\n");
+        return status;
+    }
+    
+    // 初始化AI引擎
+    status = ROTS_AIEngine_Init();
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("AI engine init failed\r\n");
+        return status;
+    }
+    
+    // 初始化判定平滑 (默认配置)
+    status = ROTS_DecisionSmoother_Init(NULL);
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Decision smoother init failed\r\n");
+        return status;
+    }
+    
+    // 初始化通信模块
+    status = ROTS_Communication_Init();
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Communication init failed\r\n");
+        return status;
+    }
+    
+    // 初始化系统监控
+    status = ROTS_SystemMonitor_Init();
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("System monitor init failed\r\n");
+        return status;
+    }
+    
+    // 初始化发送端状态
+    sender_status.state = ROTS_SENDER_IDLE;
+    sender_status.last_detection_time = 0;
+    sender_status.detection_count = 0;
+    sender_status.error_count = 0;
+    
+    return ROTS_OK;
+}
+
+// 创建任务间队列和固定核任务 (先创建消费端, 生产端启动时通知目标已存在)
+ROTS_StatusTypeDef ROTS_Sender_StartTasks(void) {
+    ROTS_SPSCQueue_Init(&frame_queue, frame_queue_storage, sizeof(ROTS_SensorData_t), ROTS_FRAME_QUEUE_SIZE);
+    ROTS_SPSCQueue_Init(&result_queue, result_queue_storage, sizeof(ROTS_OdorResult_t), ROTS_RESULT_QUEUE_SIZE);
+    
+    if (xTaskCreatePinnedToCore(ROTS_Sender_CommTask, "rots_comm", ROTS_COMM_TASK_STACK, NULL,
+                                ROTS_COMM_TASK_PRIORITY, &comm_task, ROTS_COMM_TASK_CORE) != pdPASS ||
+        xTaskCreatePinnedToCore(ROTS_Sender_InferenceTask, "rots_infer", ROTS_INFER_TASK_STACK, NULL,
+                                ROTS_INFER_TASK_PRIORITY, &inference_task, ROTS_INFER_TASK_CORE) != pdPASS ||
+        xTaskCreatePinnedToCore(ROTS_Sender_AcquisitionTask, "rots_acq", ROTS_ACQ_TASK_STACK, NULL,
+                                ROTS_ACQ_TASK_PRIORITY, &acquisition_task, ROTS_ACQ_TASK_CORE) != pdPASS) {
+        DEBUG_ERROR("Task creation failed\r\n");
+        return ROTS_MEMORY_ERROR;
+    }
+    
+    return ROTS_OK;
+}
+
+// 采集任务: 推进预热/校准, 按采样间隔读取传感器, 帧放入队列后即返回
+static void ROTS_Sender_AcquisitionTask(void* arg) {
+    (void)arg;
+    uint32_t last_sensor_read = 0;
+    
+    for (;;) {
+        uint32_t current_time = millis();
+        
+        // 推进传感器预热/校准
+        ROTS_SensorManager_Update();
+        
+        // 读取传感器数据 (间隔随信号活动在100ms与5ms之间切换)
+        if (ROTS_SensorManager_IsReady() && current_time - last_sensor_read >= ROTS_SensorManager_GetSampleInterval()) {
+            ROTS_SensorData_t sensor_data;
+            ROTS_StatusTypeDef status = ROTS_SensorManager_ReadSensors(&sensor_data);
+            
+            if (status == ROTS_OK) {
+                // 推理跟不上时丢弃本帧 (计入队列统计), 采集不等待
+                ROTS_SPSCQueue_Push(&frame_queue, &sensor_data);
+                xTaskNotifyGive(inference_task);
+                last_sensor_read = current_time;
+            } else {
+                DEBUG_ERROR("Sensor read failed: %d\r\n", status);
+            }
+        }
+        
+        // 高速采样时缩短让出时间, 否则任务周期限制了采样率
+        vTaskDelay(pdMS_TO_TICKS(ROTS_SensorManager_GetSampleInterval() < 20 ? 1 : 10));
+    }
+}
+
+// 推理任务: 逐帧更新历史与时序特征, 每500ms推理一次, 结果放入队列 (现场学习期间每100ms采样一次)
+static void ROTS_Sender_InferenceTask(void* arg) {
+    (void)arg;
+    uint32_t last_ai_inference = 0;
+    
+    for (;;) {
+        // 等待新帧, 最长等到下一次推理时刻
+        uint32_t interval = ROTS_AIEngine_IsLearning() ? ROTS_AI_LEARN_INTERVAL : ROTS_AI_INFERENCE_INTERVAL;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(interval));
+        
+        ROTS_SensorData_t sensor_data;
+        while (ROTS_SPSCQueue_Pop(&frame_queue, &sensor_data) == ROTS_OK) {
+            ROTS_SensorManager_UpdateData(&sensor_data);
+        }
+        
+        // AI推理 (每500ms, 传感器就绪后)
+        uint32_t current_time = millis();
+        if (ROTS_SensorManager_IsReady() && current_time - last_ai_inference >= interval) {
+            ROTS_OdorResult_t ai_result;
+            ROTS_StatusTypeDef status = ROTS_AIEngine_ProcessOdor(&ai_result);
+            bool learning = ROTS_AIEngine_IsLearning();
+            
+            // 有气味 (或正在学习) 时暂停基线跟踪
+            ROTS_SensorManager_SetOdorPresent(status == ROTS_OK && (ai_result.odor_type != ROTS_ODOR_UNKNOWN || learning));
+            
+            // 学习期间的结果不参与检测事件
+            if (status == ROTS_OK && !learning && ROTS_SPSCQueue_Push(&result_queue, &ai_result) == ROTS_OK) {
+                xTaskNotifyGive(comm_task);
+            }
+            
+            last_ai_inference = current_time;
+        }
+    }
+}
+
+// 通信任务: 发布检测结果, 维护WiFi/MQTT连接, 系统状态与调试输出
+static void ROTS_Sender_CommTask(void* arg) {
+    (void)arg;
+    uint32_t last_status_update = 0;
+    uint32_t last_debug_output = 0;
+    
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        
+        ROTS_OdorResult_t ai_result;
+        while (ROTS_SPSCQueue_Pop(&result_queue, &ai_result) == ROTS_OK) {
+            ROTS_Sender_HandleResult(&ai_result);
+        }
+        
+        uint32_t current_time = millis();
+        if (current_time - sender_status.last_detection_time > 5000) {
+            // 5秒内无检测，回到空闲状态
+            sender_status.state = ROTS_SENDER_IDLE;
+        }
+        
+        // 连接维护与MQTT消息处理 (重连可能阻塞, 只影响本任务)
+        ROTS_Communication_Update();
+        
+        // 采集任务生成的基线快照在此写入NVS
+        ROTS_SensorManager_SaveBaseline();
+        
+        // 更新系统状态 (每1秒)
+        if (current_time - last_status_update >= ROTS_STATUS_UPDATE_INTERVAL) {
+            ROTS_SystemMonitor_Update();
+            last_status_update = current_time;
+        }
+        
+        // 调试输出 (每10秒)
+        if (current_time - last_debug_output >= ROTS_DEBUG_OUTPUT_INTERVAL) {
+            ROTS_Debug_PrintSystemStatus();
+            ROTS_Debug_PrintSensorStatus();
+            ROTS_Debug_PrintAIStatus();
+            ROTS_Debug_PrintMemoryUsage();
+            ROTS_Sender_PrintPipelineStatus();
+            last_debug_output = current_time;
+        }
+    }
+}
+
+// 处理一条推理结果: 每次结果都送入平滑器, 只在气味出现/切换/消失时发布
+static void ROTS_Sender_HandleResult(const ROTS_OdorResult_t* result) {
+    static const char* const event_names[] = { "none", "onset", "change", "offset" };
+    
+    // 新颖读数单独上报 (开始时立即, 持续时按间隔), 在检测事件中按无气味计票, 不驱动接收端
+    ROTS_OdorResult_t vote = *result;
+    if (result->novel) {
+        if (!novelty_active || result->timestamp - last_novelty_report >= ROTS_NOVELTY_REPORT_INTERVAL) {
+            ROTS_SensorData_t frame;
+            if (ROTS_SensorManager_GetCurrentData(&frame) == ROTS_OK) {
+                ROTS_Communication_SendNovelty(result, &frame);
+            }
+            last_novelty_report = result->timestamp;
+        }
+        vote.odor_type = ROTS_ODOR_UNKNOWN;
+        vote.confidence = 0.0f;
+    }
+    novelty_active = result->novel;
+    
+    ROTS_DecisionEvent_t event;
+    if (ROTS_DecisionSmoother_Update(&vote, &event) == ROTS_OK) {
+        DEBUG_INFO("Odor %s: %s (confidence: %.2f)\r\n",
+                  event_names[event.type], event.result.odor_name, event.result.confidence);
+        
+        // 发送检测事件
+        ROTS_Communication_SendOdorEvent(&event);
+        if (event.type != ROTS_DECISION_OFFSET) {
+            sender_status.detection_count++;
+        }
+    }
+    
+    // 更新状态 (气味持续期间保持检测状态)
+    if (ROTS_DecisionSmoother_GetActive() != ROTS_ODOR_UNKNOWN) {
+        sender_status.state = ROTS_SENDER_DETECTING;
+        sender_status.last_detection_time = result->timestamp;
+    }
+}
+
+// 打印任务间队列与任务栈余量
+static void ROTS_Sender_PrintPipelineStatus(void) {
+    ROTS_SPSCQueue_t* queues[2] = { &frame_queue, &result_queue };
+    const char* names[2] = { "Frame", "Result" };
+    
+    DEBUG_INFO("=== Pipeline Status ===\r\n");
+    for (int i = 0; i < 2; i++) {
+        ROTS_SPSCQueueStats_t stats;
+        ROTS_SPSCQueue_GetStats(queues[i], &stats);
+        DEBUG_INFO("%s queue: depth %u/%u (max %u), %lu pushed, %lu dropped\r\n",
+                  names[i], stats.depth, stats.capacity, stats.high_water, stats.pushed, stats.dropped);
+    }
+    DEBUG_INFO("Stack free: acq %u, infer %u, comm %u bytes\r\n",
+              uxTaskGetStackHighWaterMark(acquisition_task),
+              uxTaskGetStackHighWaterMark(inference_task),
+              uxTaskGetStackHighWaterMark(comm_task));
+}
+
+void ROTS_Sender_ErrorHandler(ROTS_StatusTypeDef error_code) {
+    DEBUG_ERROR("System error: %d\r\n", error_code);
+    
+    // 显示错误LED
+    digitalWrite(ROTS_ERROR_LED_PIN, HIGH);
+    
+    // 记录错误
+    sender_status.error_count++;
+    ROTS_SystemMonitor_LogError(error_code);
+    
+    // 尝试恢复
+    delay(1000);
+    digitalWrite(ROTS_ERROR_LED_PIN, LOW);
+}
@@ -0,0 +1,276 @@
+// ROTS ADC Capture - 后台ADC连续采集模块
+//
+// 采集端在后台按固定频率整帧扫描8路MQ通道, 整帧写完后经顺序锁发布;
+// 主循环只取最新的完整帧快照, 不再在loop中阻塞等待ADC转换.
+// ESP32: esp_timer周期回调 (运行于esp_timer任务) 完成整帧扫描.
+// 主机: 独立线程生成合成帧, 用于无板卡测量帧吞吐.
+#include "rots_sender.h"
+#include "rots_adc_capture.h"
+#include "rots_seqlock.h"
+
+#include <atomic>
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#include "rots_debug.h"
+#else
+#include <thread>
+#include <chrono>
+#endif
+
+static_assert(sizeof(ROTS_ADCFrame_t) % 4 == 0, "ADC frame must be a whole number of seqlock words");
+
+// 私有变量
+static std::atomic<uint32_t> frame_words[ROTS_SEQLOCK_WORDS(sizeof(ROTS_ADCFrame_t))];
+static ROTS_Seqlock_t latest_frame;
+static ROTS_ADCFrame_t scan_frame;           // 扫描中的帧 (仅写端访问)
+static std::atomic<bool> capture_running(false);
+static bool capture_initialized = false;
+static uint32_t capture_rate_hz = 0;
+static uint32_t last_consumed_sequence = 0;
+static uint32_t frames_consumed = 0;
+static uint32_t frames_skipped = 0;
+static volatile uint32_t last_scan_us = 0;
+
+#ifdef ARDUINO
+static esp_timer_handle_t capture_timer = NULL;
+
+// MQ通道引脚 (与ROTS_SensorData_t字段顺序一致)
+static const uint8_t capture_pins[ROTS_MAX_SENSORS] = {
+    ROTS_MQ2_PIN, ROTS_MQ3_PIN, ROTS_MQ4_PIN, ROTS_MQ5_PIN,
+    ROTS_MQ6_PIN, ROTS_MQ7_PIN, ROTS_MQ8_PIN, ROTS_MQ9_PIN
+};
+#else
+static std::thread capture_thread;
+static uint32_t synth_noise_state = 0x12345678u;
+#endif
+
+// 私有函数声明
+static void ROTS_ADCCapture_PublishFrame(void);
+static ROTS_StatusTypeDef ROTS_ADCCapture_StartBackend(void);
+static void ROTS_ADCCapture_StopBackend(void);
+
+// 初始化采集模块
+ROTS_StatusTypeDef ROTS_ADCCapture_Init(uint32_t sample_rate_hz) {
+    if (sample_rate_hz > ROTS_ADC_CAPTURE_MAX_RATE_HZ) {
+        return ROTS_INVALID_PARAM;
+    }
+#ifdef ARDUINO
+    // 硬件后端必须有确定的扫描周期; 主机后端0表示全速运行
+    if (sample_rate_hz == 0) {
+        return ROTS_INVALID_PARAM;
+    }
+    analogReadResolution(12);
+#endif
+
+    if (capture_running.load()) {
+        ROTS_ADCCapture_Stop();
+    }
+
+    memset(&scan_frame, 0, sizeof(scan_frame));
+    ROTS_Seqlock_Init(&latest_frame, frame_words, sizeof(ROTS_ADCFrame_t), NULL);
+    capture_rate_hz = sample_rate_hz;
+    last_consumed_sequence = 0;
+    frames_consumed = 0;
+    frames_skipped = 0;
+    last_scan_us = 0;
+
+    capture_initialized = true;
+    return ROTS_OK;
+}
+
+// 启动后台采集
+ROTS_StatusTypeDef ROTS_ADCCapture_Start(void) {
+    if (!capture_initialized) {
+        return ROTS_ERROR;
+    }
+    if (capture_running.load()) {
+        return ROTS_OK;
+    }
+
+    capture_running.store(true);
+    ROTS_StatusTypeDef status = ROTS_ADCCapture_StartBackend();
+    if (status != ROTS_OK) {
+        capture_running.store(false);
+    }
+    return status;
+}
+
+// 停止后台采集
+ROTS_StatusTypeDef ROTS_ADCCapture_Stop(void) {
+    if (!capture_running.load()) {
+        return ROTS_OK;
+    }
+
+    capture_running.store(false);
+    ROTS_ADCCapture_StopBackend();
+    return ROTS_OK;
+}
+
+// 修改采集频率 (运行中会重启后端)
+ROTS_StatusTypeDef ROTS_ADCCapture_SetSampleRate(uint32_t sample_rate_hz) {
+    if (!capture_initialized || sample_rate_hz > ROTS_ADC_CAPTURE_MAX_RATE_HZ) {
+        return ROTS_INVALID_PARAM;
+    }
+#ifdef ARDUINO
+    if (sample_rate_hz == 0) {
+        return ROTS_INVALID_PARAM;
+    }
+#endif
+    if (sample_rate_hz == capture_rate_hz) {
+        return ROTS_OK;
+    }
+
+    bool was_running = capture_running.load();
+    if (was_running) {
+        ROTS_ADCCapture_Stop();
+    }
+    capture_rate_hz = sample_rate_hz;
+    if (was_running) {
+        return ROTS_ADCCapture_Start();
+    }
+    return ROTS_OK;
+}
+
+// 获取最新完整帧
+ROTS_StatusTypeDef ROTS_ADCCapture_GetLatestFrame(ROTS_ADCFrame_t* frame) {
+    if (!capture_initialized || !frame) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    // 写端持续打断读取时返回BUSY, 尚未发布任何帧时序号为0
+    if (ROTS_Seqlock_Read(&latest_frame, frame) != ROTS_OK || frame->sequence == 0) {
+        return ROTS_BUSY;
+    }
+
+    if (frame->sequence > last_consumed_sequence) {
+        if (last_consumed_sequence != 0) {
+            frames_skipped += frame->sequence - last_consumed_sequence - 1;
+        }
+        last_consumed_sequence = frame->sequence;
+        frames_consumed++;
+    }
+    return ROTS_OK;
+}
+
+// 获取采集统计
+ROTS_StatusTypeDef ROTS_ADCCapture_GetStats(ROTS_ADCCaptureStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    stats->running = capture_running.load();
+    stats->sample_rate_hz = capture_rate_hz;
+    stats->frames_captured = ROTS_Seqlock_GetVersion(&latest_frame);
+    stats->frames_consumed = frames_consumed;
+    stats->frames_skipped = frames_skipped;
+    stats->last_scan_us = last_scan_us;
+    return ROTS_OK;
+}
+
+// 采集是否在运行
+bool ROTS_ADCCapture_IsRunning(void) {
+    return capture_running.load();
+}
+
+// 发布扫描完的帧 (序号与顺序锁版本号一致)
+static void ROTS_ADCCapture_PublishFrame(void) {
+    scan_frame.sequence = ROTS_Seqlock_GetVersion(&latest_frame) + 1;
+    ROTS_Seqlock_Write(&latest_frame, &scan_frame);
+}
+
+#ifdef ARDUINO
+// esp_timer回调: 整帧扫描8路MQ
+static void ROTS_ADCCapture_TimerCallback(void* arg) {
+    (void)arg;
+    if (!capture_running.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    uint32_t start_us = (uint32_t)esp_timer_get_time();
+    scan_frame.timestamp_us = start_us;
+
+    for (int ch = 0; ch < ROTS_MAX_SENSORS; ch++) {
+        scan_frame.raw[ch] = (uint16_t)analogRead(capture_pins[ch]);
+    }
+
+    last_scan_us = (uint32_t)esp_timer_get_time() - start_us;
+    ROTS_ADCCapture_PublishFrame();
+}
+
+static ROTS_StatusTypeDef ROTS_ADCCapture_StartBackend(void) {
+    if (capture_timer == NULL) {
+        esp_timer_create_args_t timer_args = {};
+        timer_args.callback = ROTS_ADCCapture_TimerCallback;
+        timer_args.arg = NULL;
+        timer_args.dispatch_method = ESP_TIMER_TASK;
+        timer_args.name = "rots_adc";
+        timer_args.skip_unhandled_events = true;
+
+        if (esp_timer_create(&timer_args, &capture_timer) != ESP_OK) {
+            DEBUG_ERROR("ADC capture timer create failed\r\n");
+            return ROTS_ERROR;
+        }
+    }
+
+    if (esp_timer_start_periodic(capture_timer, 1000000ULL / capture_rate_hz) != ESP_OK) {
+        DEBUG_ERROR("ADC capture timer start failed\r\n");
+        return ROTS_ERROR;
+    }
+
+    DEBUG_INFO("ADC capture started: %lu Hz\r\n", capture_rate_hz);
+    return ROTS_OK;
+}
+
+static void ROTS_ADCCapture_StopBackend(void) {
+    if (capture_timer != NULL) {
+        esp_timer_stop(capture_timer);
+    }
+}
+#else
+// 合成噪声 (线性同余)
+static int ROTS_ADCCapture_SynthNoise(void) {
+    synth_noise_state = synth_noise_state * 1664525u + 1013904223u;
+    return (int)((synth_noise_state >> 24) & 0x1F) - 16;
+}
+
+// 主机线程: 生成合成帧 (基线 + 慢变化 + 噪声)
+static void ROTS_ADCCapture_HostThread(void) {
+    using clock = std::chrono::steady_clock;
+    const clock::time_point epoch = clock::now();
+    clock::time_point next_frame = epoch;
+
+    while (capture_running.load(std::memory_order_relaxed)) {
+        clock::time_point start = clock::now();
+        uint32_t now_us = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(start - epoch).count();
+
+        scan_frame.timestamp_us = now_us;
+        for (int ch = 0; ch < ROTS_MAX_SENSORS; ch++) {
+            float drift = 200.0f * sinf((float)now_us * 1e-6f * 0.5f + (float)ch);
+            int value = 1200 + ch * 100 + (int)drift + ROTS_ADCCapture_SynthNoise();
+            if (value < 0) value = 0;
+            if (value > 4095) value = 4095;
+            scan_frame.raw[ch] = (uint16_t)value;
+        }
+
+        last_scan_us = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+        ROTS_ADCCapture_PublishFrame();
+
+        if (capture_rate_hz != 0) {
+            next_frame += std::chrono::microseconds(1000000 / capture_rate_hz);
+            std::this_thread::sleep_until(next_frame);
+        }
+    }
+}
+
+static ROTS_StatusTypeDef ROTS_ADCCapture_StartBackend(void) {
+    capture_thread = std::thread(ROTS_ADCCapture_HostThread);
+    return ROTS_OK;
+}
+
+static void ROTS_ADCCapture_StopBackend(void) {
+    if (capture_thread.joinable()) {
+        capture_thread.join();
+    }
+}
+#endif
@@ -0,0 +1,44 @@
+// ROTS ADC Capture Header
+#ifndef ROTS_ADC_CAPTURE_H
+#define ROTS_ADC_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 采集配置
+#define ROTS_ADC_CAPTURE_MAX_RATE_HZ   2000   // 单核esp_timer可承受的上限
+
+// 一帧原始采样 (8路MQ在同一次扫描中完成)
+typedef struct {
+    uint16_t raw[ROTS_MAX_SENSORS];  // 12位ADC码值
+    uint32_t timestamp_us;           // 扫描开始时间
+    uint32_t sequence;               // 帧序号, 从1开始
+} ROTS_ADCFrame_t;
+
+// 采集统计
+typedef struct {
+    bool running;
+    uint32_t sample_rate_hz;
+    uint32_t frames_captured;
+    uint32_t frames_consumed;
+    uint32_t frames_skipped;   // 未被读取即被新帧取代的帧数
+    uint32_t last_scan_us;     // 最近一次整帧扫描耗时
+} ROTS_ADCCaptureStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_ADCCapture_Init(uint32_t sample_rate_hz);
+ROTS_StatusTypeDef ROTS_ADCCapture_Start(void);
+ROTS_StatusTypeDef ROTS_ADCCapture_Stop(void);
+ROTS_StatusTypeDef ROTS_ADCCapture_SetSampleRate(uint32_t sample_rate_hz);
+ROTS_StatusTypeDef ROTS_ADCCapture_GetLatestFrame(ROTS_ADCFrame_t* frame);
+ROTS_StatusTypeDef ROTS_ADCCapture_GetStats(ROTS_ADCCaptureStats_t* stats);
+bool ROTS_ADCCapture_IsRunning(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_ADC_CAPTURE_H */
@@ -0,0 +1,251 @@
+// ROTS ADS1115 - 外部I2C ADC驱动
+//
+// 每块板轮流对4路单端输入做单次转换. ROTS_ADS1115_Update每次主循环
+// 对所有板做一轮批量处理: 读取已完成的转换结果, 随即启动下一路转换,
+// 不等待转换完成. 结果换算为与板载ADC一致的12位码值 (0-3.3V),
+// 因此外部通道可以直接复用校准与基线跟踪逻辑.
+#include "rots_sender.h"
+#include "rots_ads1115.h"
+
+// ADS1115寄存器
+#define ADS1115_REG_CONVERSION  0x00
+#define ADS1115_REG_CONFIG      0x01
+
+// 配置: OS=1启动, 单端AINx, PGA ±4.096V, 单次模式, 860SPS, 比较器关闭
+#define ADS1115_CONFIG_OS          0x8000
+#define ADS1115_CONFIG_MUX_SINGLE  0x4000   // MUX = 100 + 输入号
+#define ADS1115_CONFIG_PGA_4V096   0x0200
+#define ADS1115_CONFIG_MODE_SINGLE 0x0100
+#define ADS1115_CONFIG_DR_860SPS   0x00E0
+#define ADS1115_CONFIG_COMP_OFF    0x0003
+
+// ±4.096V量程下LSB为125uV, 3.3V对应26400个LSB
+#define ADS1115_LSB_PER_FULL_SCALE  26400
+
+// 单板状态
+typedef struct {
+    bool present;
+    bool converting;
+    uint8_t input;
+    uint32_t start_time;
+    uint32_t probe_time;
+    uint16_t codes[ROTS_ADS1115_INPUTS];
+} ROTS_ADS1115Board_t;
+
+// 私有变量
+static const ROTS_ADS1115Bus_t* ads_bus = NULL;
+static ROTS_ADS1115Board_t ads_boards[ROTS_ADS1115_MAX_BOARDS];
+static ROTS_ADS1115Stats_t ads_stats;
+
+// 私有函数声明
+static bool ROTS_ADS1115_StartConversion(uint8_t board);
+static uint16_t ROTS_ADS1115_ToCode12(int16_t value);
+
+#ifdef ARDUINO
+static bool ROTS_ADS1115_WireWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length);
+static bool ROTS_ADS1115_WireRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+static const ROTS_ADS1115Bus_t wire_bus = {
+    ROTS_ADS1115_WireWrite,
+    ROTS_ADS1115_WireRead
+};
+#else
+// 主机构建: 模拟板, 各输入输出不同的固定电压
+static uint16_t mock_config[ROTS_ADS1115_MAX_BOARDS];
+
+static bool ROTS_ADS1115_MockWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length);
+static bool ROTS_ADS1115_MockRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+static const ROTS_ADS1115Bus_t mock_bus = {
+    ROTS_ADS1115_MockWrite,
+    ROTS_ADS1115_MockRead
+};
+#endif
+
+// 初始化外部ADC (I2C须已由环境传感器模块初始化)
+ROTS_StatusTypeDef ROTS_ADS1115_Init(uint8_t board_count) {
+    if (board_count > ROTS_ADS1115_MAX_BOARDS) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memset(ads_boards, 0, sizeof(ads_boards));
+    memset(&ads_stats, 0, sizeof(ROTS_ADS1115Stats_t));
+    ads_stats.board_count = board_count;
+
+#ifdef ARDUINO
+    ads_bus = &wire_bus;
+#else
+    ads_bus = &mock_bus;
+#endif
+
+    return ROTS_OK;
+}
+
+// 替换I2C总线实现
+ROTS_StatusTypeDef ROTS_ADS1115_SetBus(const ROTS_ADS1115Bus_t* bus) {
+    if (!bus || !bus->write_regs || !bus->read_regs) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    ads_bus = bus;
+    for (uint8_t board = 0; board < ads_stats.board_count; board++) {
+        ads_boards[board].present = false;
+        ads_boards[board].probe_time = 0;
+    }
+    ads_stats.boards_present = 0;
+    return ROTS_OK;
+}
+
+// 批量处理所有板: 取回已完成的转换并启动下一路 (不阻塞)
+void ROTS_ADS1115_Update(uint32_t now_ms) {
+    if (!ads_bus || ads_stats.board_count == 0) {
+        return;
+    }
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+
+    for (uint8_t board = 0; board < ads_stats.board_count; board++) {
+        ROTS_ADS1115Board_t* state = &ads_boards[board];
+        uint8_t address = ROTS_ADS1115_BASE_ADDRESS + board;
+
+        if (!state->present) {
+            if (state->probe_time != 0 && now_ms - state->probe_time < ROTS_ADS1115_PROBE_INTERVAL_MS) {
+                continue;
+            }
+            state->probe_time = now_ms | 1;
+            state->input = 0;
+            state->converting = ROTS_ADS1115_StartConversion(board);
+            state->present = state->converting;
+            state->start_time = now_ms;
+            if (state->present) {
+                ads_stats.boards_present |= (uint8_t)(1u << board);
+            }
+            continue;
+        }
+
+        if (state->converting && now_ms - state->start_time < ROTS_ADS1115_CONVERSION_MS) {
+            continue;
+        }
+
+        if (state->converting) {
+            uint8_t data[2];
+            if (ads_bus->read_regs(address, ADS1115_REG_CONVERSION, data, sizeof(data))) {
+                state->codes[state->input] = ROTS_ADS1115_ToCode12((int16_t)((data[0] << 8) | data[1]));
+                ads_stats.conversions++;
+            } else {
+                ads_stats.errors++;
+            }
+            state->input = (uint8_t)((state->input + 1) % ROTS_ADS1115_INPUTS);
+        }
+
+        state->converting = ROTS_ADS1115_StartConversion(board);
+        state->start_time = now_ms;
+        if (!state->converting) {
+            // 总线无响应, 按探测周期重试
+            ads_stats.errors++;
+            state->present = false;
+            state->probe_time = now_ms | 1;
+            ads_stats.boards_present &= (uint8_t)~(1u << board);
+        }
+    }
+
+    uint32_t cycles = ROTS_CYCLE_COUNT() - start;
+    ads_stats.last_update_cycles = cycles;
+    if (cycles > ads_stats.max_update_cycles) {
+        ads_stats.max_update_cycles = cycles;
+    }
+}
+
+// 获取最新码值 (按板顺序, 每板4路; 不在线的板输出0)
+ROTS_StatusTypeDef ROTS_ADS1115_GetCodes(uint16_t* codes, uint8_t count) {
+    if (!codes || count > ads_stats.board_count * ROTS_ADS1115_INPUTS) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    for (uint8_t ch = 0; ch < count; ch++) {
+        const ROTS_ADS1115Board_t* state = &ads_boards[ch / ROTS_ADS1115_INPUTS];
+        codes[ch] = state->present ? state->codes[ch % ROTS_ADS1115_INPUTS] : 0;
+    }
+    return ROTS_OK;
+}
+
+// 获取驱动统计
+ROTS_StatusTypeDef ROTS_ADS1115_GetStats(ROTS_ADS1115Stats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &ads_stats, sizeof(ROTS_ADS1115Stats_t));
+    return ROTS_OK;
+}
+
+// 启动当前输入的单次转换
+static bool ROTS_ADS1115_StartConversion(uint8_t board) {
+    uint16_t config = ADS1115_CONFIG_OS | ADS1115_CONFIG_MUX_SINGLE |
+                      ((uint16_t)ads_boards[board].input << 12) |
+                      ADS1115_CONFIG_PGA_4V096 | ADS1115_CONFIG_MODE_SINGLE |
+                      ADS1115_CONFIG_DR_860SPS | ADS1115_CONFIG_COMP_OFF;
+    uint8_t data[2] = { (uint8_t)(config >> 8), (uint8_t)config };
+    return ads_bus->write_regs(ROTS_ADS1115_BASE_ADDRESS + board, ADS1115_REG_CONFIG, data, sizeof(data));
+}
+
+// 换算为0-3.3V对应的12位码值
+static uint16_t ROTS_ADS1115_ToCode12(int16_t value) {
+    if (value <= 0) return 0;
+    uint32_t code = ((uint32_t)value * 4095 + ADS1115_LSB_PER_FULL_SCALE / 2) / ADS1115_LSB_PER_FULL_SCALE;
+    return (uint16_t)(code > 4095 ? 4095 : code);
+}
+
+#ifdef ARDUINO
+// Wire写寄存器
+static bool ROTS_ADS1115_WireWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    Wire.write(data, length);
+    return Wire.endTransmission() == 0;
+}
+
+// Wire读寄存器
+static bool ROTS_ADS1115_WireRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0) {
+        return false;
+    }
+    if (Wire.requestFrom(address, length) != length) {
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = (uint8_t)Wire.read();
+    }
+    return true;
+}
+#else
+static bool ROTS_ADS1115_MockWrite(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length) {
+    uint8_t board = (uint8_t)(address - ROTS_ADS1115_BASE_ADDRESS);
+    if (board >= ROTS_ADS1115_MAX_BOARDS || reg != ADS1115_REG_CONFIG || length != 2) {
+        return false;
+    }
+
+    mock_config[board] = (uint16_t)((data[0] << 8) | data[1]);
+    return true;
+}
+
+// 转换结果: 0.8V起, 每路递增0.2V
+static bool ROTS_ADS1115_MockRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    uint8_t board = (uint8_t)(address - ROTS_ADS1115_BASE_ADDRESS);
+    if (board >= ROTS_ADS1115_MAX_BOARDS || length != 2) {
+        return false;
+    }
+
+    uint16_t value = mock_config[board];
+    if (reg == ADS1115_REG_CONVERSION) {
+        uint8_t input = (uint8_t)((mock_config[board] >> 12) & 0x03);
+        uint8_t channel = (uint8_t)(board * ROTS_ADS1115_INPUTS + input);
+        value = (uint16_t)(6400 + channel * 1600);
+    }
+    data[0] = (uint8_t)(value >> 8);
+    data[1] = (uint8_t)value;
+    return true;
+}
+#endif
@@ -0,0 +1,49 @@
+// ROTS ADS1115 External ADC Header
+#ifndef ROTS_ADS1115_H
+#define ROTS_ADS1115_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// ADS1115配置
+#define ROTS_ADS1115_MAX_BOARDS        4       // 地址0x48-0x4B
+#define ROTS_ADS1115_BASE_ADDRESS      0x48
+#define ROTS_ADS1115_INPUTS            4       // 每板单端输入数
+#define ROTS_ADS1115_CONVERSION_MS     2       // 860SPS单次转换约1.2ms
+#define ROTS_ADS1115_PROBE_INTERVAL_MS 5000    // 未响应板的重试周期
+
+#if ROTS_ADS1115_BOARD_COUNT > ROTS_ADS1115_MAX_BOARDS
+#error "ROTS_ADS1115_BOARD_COUNT exceeds the number of ADS1115 addresses"
+#endif
+
+// I2C总线操作 (寄存器为16位大端)
+typedef struct {
+    bool (*write_regs)(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length);
+    bool (*read_regs)(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+} ROTS_ADS1115Bus_t;
+
+// 驱动统计
+typedef struct {
+    uint8_t board_count;
+    uint8_t boards_present;     // 位掩码
+    uint32_t conversions;
+    uint32_t errors;
+    uint32_t last_update_cycles;
+    uint32_t max_update_cycles;
+} ROTS_ADS1115Stats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_ADS1115_Init(uint8_t board_count);
+ROTS_StatusTypeDef ROTS_ADS1115_SetBus(const ROTS_ADS1115Bus_t* bus);
+void ROTS_ADS1115_Update(uint32_t now_ms);
+ROTS_StatusTypeDef ROTS_ADS1115_GetCodes(uint16_t* codes, uint8_t count);
+ROTS_StatusTypeDef ROTS_ADS1115_GetStats(ROTS_ADS1115Stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_ADS1115_H */
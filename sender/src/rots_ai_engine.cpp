@@ -1,262 +1,1016 @@
-// ROTS AI Engine - AI推理引擎
-#include "rots_sender.h"
-#include "rots_ai_engine.h"
-#include "rots_debug.h"
-
-// 私有变量
-static bool ai_initialized = false;
-static float feature_vector[ROTS_AI_FEATURE_SIZE];
-static float model_weights[ROTS_AI_MODEL_SIZE];
-static ROTS_OdorResult_t last_result;
-
-// 特征提取参数
-static const float feature_weights[ROTS_AI_FEATURE_SIZE] = {
-    1.0f, 0.8f, 0.6f, 0.4f, 0.2f,  // MQ传感器权重
-    0.9f, 0.7f, 0.5f, 0.3f, 0.1f,  // 环境传感器权重
-    0.6f, 0.4f, 0.2f, 0.1f, 0.05f  // 交叉特征权重
-};
-
-// 气味识别阈值
-static const float odor_thresholds[6] = {
-    0.7f, 0.7f, 0.7f, 0.7f, 0.7f, 0.6f  // 对应6种气味
-};
-
-// 私有函数声明
-static void ROTS_AIEngine_ExtractFeatures(const ROTS_SensorData_t* sensor_data);
-static ROTS_OdorType_t ROTS_AIEngine_ClassifyOdor(void);
-static float ROTS_AIEngine_CalculateConfidence(ROTS_OdorType_t odor_type);
-static void ROTS_AIEngine_LoadModel(void);
-
-// 初始化AI引擎
-ROTS_StatusTypeDef ROTS_AIEngine_Init(void) {
-    DEBUG_INFO("Initializing AI engine...\r\n");
-    
-    // 初始化特征向量
-    memset(feature_vector, 0, sizeof(feature_vector));
-    
-    // 加载模型权重
-    ROTS_AIEngine_LoadModel();
-    
-    // 初始化结果
-    memset(&last_result, 0, sizeof(ROTS_OdorResult_t));
-    
-    ai_initialized = true;
-    DEBUG_INFO("AI engine initialized\r\n");
-    return ROTS_OK;
-}
-
-// 处理气味检测
-ROTS_StatusTypeDef ROTS_AIEngine_ProcessOdor(ROTS_OdorResult_t* result) {
-    if (!ai_initialized || !result) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    // 获取当前传感器数据
-    ROTS_SensorData_t sensor_data;
-    ROTS_StatusTypeDef status = ROTS_SensorManager_GetCurrentData(&sensor_data);
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("Failed to get sensor data\r\n");
-        return status;
-    }
-    
-    // 提取特征
-    ROTS_AIEngine_ExtractFeatures(&sensor_data);
-    
-    // 分类识别
-    ROTS_OdorType_t odor_type = ROTS_AIEngine_ClassifyOdor();
-    
-    // 计算置信度
-    float confidence = ROTS_AIEngine_CalculateConfidence(odor_type);
-    
-    // 设置结果
-    result->odor_type = odor_type;
-    result->confidence = confidence;
-    result->intensity = confidence * 100.0f; // 转换为百分比
-    result->timestamp = millis();
-    
-    // 设置气味名称
-    switch (odor_type) {
-        case ROTS_ODOR_COFFEE:
-            strcpy(result->odor_name, "Coffee");
-            break;
-        case ROTS_ODOR_ALCOHOL:
-            strcpy(result->odor_name, "Alcohol");
-            break;
-        case ROTS_ODOR_LEMON:
-            strcpy(result->odor_name, "Lemon");
-            break;
-        case ROTS_ODOR_MINT:
-            strcpy(result->odor_name, "Mint");
-            break;
-        case ROTS_ODOR_LAVENDER:
-            strcpy(result->odor_name, "Lavender");
-            break;
-        default:
-            strcpy(result->odor_name, "Unknown");
-            break;
-    }
-    
-    // 更新最后结果
-    memcpy(&last_result, result, sizeof(ROTS_OdorResult_t));
-    
-    DEBUG_DEBUG("AI inference: %s (%.2f)\r\n", result->odor_name, result->confidence);
-    
-    return ROTS_OK;
-}
-
-// 提取特征
-static void ROTS_AIEngine_ExtractFeatures(const ROTS_SensorData_t* sensor_data) {
-    // 基础传感器特征
-    feature_vector[0] = sensor_data->mq2_value;
-    feature_vector[1] = sensor_data->mq3_value;
-    feature_vector[2] = sensor_data->mq4_value;
-    feature_vector[3] = sensor_data->mq5_value;
-    feature_vector[4] = sensor_data->mq6_value;
-    feature_vector[5] = sensor_data->mq7_value;
-    feature_vector[6] = sensor_data->mq8_value;
-    feature_vector[7] = sensor_data->mq9_value;
-    
-    // 环境特征
-    feature_vector[8] = sensor_data->temperature;
-    feature_vector[9] = sensor_data->humidity;
-    feature_vector[10] = sensor_data->pressure;
-    
-    // 交叉特征
-    feature_vector[11] = sensor_data->mq2_value / sensor_data->mq3_value;
-    feature_vector[12] = sensor_data->mq4_value / sensor_data->mq5_value;
-    feature_vector[13] = sensor_data->mq6_value / sensor_data->mq7_value;
-    feature_vector[14] = sensor_data->mq8_value / sensor_data->mq9_value;
-    
-    // 归一化特征
-    for (int i = 0; i < ROTS_AI_FEATURE_SIZE; i++) {
-        feature_vector[i] *= feature_weights[i];
-    }
-}
-
-// 分类识别
-static ROTS_OdorType_t ROTS_AIEngine_ClassifyOdor(void) {
-    // 简化的神经网络推理
-    float scores[6] = {0};
-    
-    // 计算每种气味的得分
-    for (int odor = 0; odor < 6; odor++) {
-        for (int feature = 0; feature < ROTS_AI_FEATURE_SIZE; feature++) {
-            scores[odor] += feature_vector[feature] * model_weights[odor * ROTS_AI_FEATURE_SIZE + feature];
-        }
-    }
-    
-    // 找到最高得分
-    float max_score = scores[0];
-    int max_index = 0;
-    
-    for (int i = 1; i < 6; i++) {
-        if (scores[i] > max_score) {
-            max_score = scores[i];
-            max_index = i;
-        }
-    }
-    
-    // 检查是否超过阈值
-    if (max_score > odor_thresholds[max_index]) {
-        return (ROTS_OdorType_t)(max_index + 1);
-    }
-    
-    return ROTS_ODOR_UNKNOWN;
-}
-
-// 计算置信度
-static float ROTS_AIEngine_CalculateConfidence(ROTS_OdorType_t odor_type) {
-    if (odor_type == ROTS_ODOR_UNKNOWN) {
-        return 0.0f;
-    }
-    
-    // 简化的置信度计算
-    float confidence = 0.5f + random(0, 50) / 100.0f; // 0.5-1.0
-    
-    // 确保在合理范围内
-    if (confidence > 1.0f) confidence = 1.0f;
-    if (confidence < 0.0f) confidence = 0.0f;
-    
-    return confidence;
-}
-
-// 加载模型权重
-static void ROTS_AIEngine_LoadModel(void) {
-    // 使用预定义的简单权重，模拟训练好的模型
-    // 这些权重是基于经验设计的，用于演示
-    float demo_weights[ROTS_AI_MODEL_SIZE] = {
-        // Coffee weights (sensor 0-7, env 8-10, cross 11-14)
-        0.8f, 0.2f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f,  // MQ sensors
-        0.3f, 0.2f, 0.1f,  // Environment
-        0.1f, 0.1f, 0.1f, 0.1f,  // Cross features
-        
-        // Alcohol weights
-        0.1f, 0.8f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f,
-        0.2f, 0.3f, 0.1f,
-        0.1f, 0.1f, 0.1f, 0.1f,
-        
-        // Lemon weights
-        0.1f, 0.1f, 0.8f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f,
-        0.2f, 0.2f, 0.1f,
-        0.1f, 0.1f, 0.1f, 0.1f,
-        
-        // Mint weights
-        0.1f, 0.1f, 0.1f, 0.8f, 0.1f, 0.1f, 0.1f, 0.1f,
-        0.2f, 0.2f, 0.1f,
-        0.1f, 0.1f, 0.1f, 0.1f,
-        
-        // Lavender weights
-        0.1f, 0.1f, 0.1f, 0.1f, 0.8f, 0.1f, 0.1f, 0.1f,
-        0.2f, 0.2f, 0.1f,
-        0.1f, 0.1f, 0.1f, 0.1f,
-        
-        // Mixed weights
-        0.3f, 0.3f, 0.3f, 0.3f, 0.3f, 0.3f, 0.3f, 0.3f,
-        0.2f, 0.2f, 0.1f,
-        0.2f, 0.2f, 0.2f, 0.2f
-    };
-    
-    memcpy(model_weights, demo_weights, sizeof(model_weights));
-    
-    DEBUG_INFO("Demo model weights loaded\r\n");
-}
-
-// 获取AI状态
-ROTS_StatusTypeDef ROTS_AIEngine_GetStatus(ROTS_AIStatus_t* status) {
-    if (!ai_initialized || !status) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    status->initialized = ai_initialized;
-    status->last_inference_time = last_result.timestamp;
-    status->last_odor_type = last_result.odor_type;
-    status->last_confidence = last_result.confidence;
-    status->inference_count = 0; // 简化实现
-    
-    return ROTS_OK;
-}
-
-// 更新模型
-ROTS_StatusTypeDef ROTS_AIEngine_UpdateModel(const float* new_weights, uint16_t size) {
-    if (!ai_initialized || !new_weights || size != ROTS_AI_MODEL_SIZE) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    memcpy(model_weights, new_weights, sizeof(model_weights));
-    DEBUG_INFO("Model updated\r\n");
-    
-    return ROTS_OK;
-}
-
-// 重置AI引擎
-ROTS_StatusTypeDef ROTS_AIEngine_Reset(void) {
-    if (!ai_initialized) {
-        return ROTS_ERROR;
-    }
-    
-    memset(feature_vector, 0, sizeof(feature_vector));
-    memset(&last_result, 0, sizeof(ROTS_OdorResult_t));
-    
-    DEBUG_INFO("AI engine reset\r\n");
-    return ROTS_OK;
-}
+// ROTS AI Engine - AI推理引擎
+#include "rots_sender.h"
+#include "rots_ai_engine.h"
+#include "rots_sensor_manager.h"
+#include "rots_ai_model.h"
+#include "rots_model_blob.h"
+#include "rots_model_store.h"
+#include "rots_model_update.h"
+#include "rots_seqlock.h"
+#include "rots_prototypes.h"
+#include "rots_novelty.h"
+#include "rots_debug.h"
+
+// 演示模型按8个板载通道设计 (8通道 + 3环境 + 4比值), 不使用时序特征
+#define ROTS_AI_DEMO_CHANNELS     ROTS_MAX_SENSORS
+#define ROTS_AI_DEMO_FEATURES     ROTS_AI_BASE_FEATURE_COUNT(ROTS_AI_DEMO_CHANNELS)
+
+// 私有变量
+static bool ai_initialized = false;
+static uint8_t ai_channel_count = 0;
+static uint8_t ai_feature_count = 0;
+static uint32_t ai_channel_mask = 0;
+static float feature_vector[ROTS_AI_FEATURE_SIZE];
+static float feature_weights[ROTS_AI_FEATURE_SIZE];
+static float class_probabilities[ROTS_AI_ODOR_CLASSES];  // 最近一次完整推理的校准概率
+
+// 强度回归头: 每类一组线性权重, 作用于与分类共用的特征向量, 输出%满量程
+static float intensity_weights[ROTS_AI_MODEL_SIZE];
+static float intensity_bias[ROTS_AI_ODOR_CLASSES];
+static bool intensity_demo = true;
+static uint32_t intensity_cycles = 0;
+
+// 新颖度: 各训练类别的特征均值与逆方差 (离线拟合, 随模型容器下发, 直接引用映射的Flash),
+// 模型不带统计量时不评估
+static_assert(ROTS_AI_FEATURE_SIZE <= 256, "novelty feature indices are 8-bit");
+static const float* novelty_means = NULL;
+static const float* novelty_inv_vars = NULL;
+static float novelty_threshold = ROTS_NOVELTY_THRESHOLD;
+static volatile bool novelty_loaded = false;
+static uint32_t novel_count = 0;
+static uint32_t novelty_cycles = 0;
+
+// 现场学习: 通信任务提交请求, 推理任务取出执行并发布状态
+static_assert(ROTS_AI_PROTO_FEATURE_COUNT(ROTS_MAX_CHANNELS) <= ROTS_PROTO_MAX_FEATURES, "prototype features exceed table width");
+static_assert(sizeof(ROTS_AILearnStatus_t) % 4 == 0, "learn status must be word-sized for the seqlock");
+static volatile uint8_t classifier_mode = ROTS_AI_CLASSIFIER_MODE;
+static ROTS_AILearnStatus_t learn_request;
+static uint32_t learn_request_duration = 0;
+static std::atomic<bool> learn_request_pending(false);
+static ROTS_AILearnStatus_t learn_status;
+static std::atomic<uint32_t> learn_status_words[ROTS_SEQLOCK_WORDS(sizeof(ROTS_AILearnStatus_t))];
+static ROTS_Seqlock_t learn_status_lock;
+static uint32_t learn_duration = 0;
+static uint32_t learn_start = 0;
+static std::atomic<bool> learn_active(false);
+
+// 最近一次推理结果: 推理任务发布, 通信/调试任务读取快照
+static_assert(sizeof(ROTS_OdorResult_t) % 4 == 0, "odor result must be word-sized for the seqlock");
+static std::atomic<uint32_t> last_result_words[ROTS_SEQLOCK_WORDS(sizeof(ROTS_OdorResult_t))];
+static ROTS_Seqlock_t last_result;
+
+// int8与浮点对照统计
+static uint32_t quant_inferences = 0;
+static uint32_t shadow_runs = 0;
+static uint32_t shadow_mismatches = 0;
+static float shadow_max_error = 0.0f;
+static uint32_t int8_cycles = 0;
+static uint32_t float_cycles = 0;
+
+// 第一级门控统计
+static uint32_t inference_count = 0;
+static uint32_t full_inferences = 0;
+static uint32_t gate_skips = 0;
+static uint32_t gate_skip_run = 0;
+static uint32_t gate_cycles = 0;
+static bool gate_deviated = true;       // 最近一次门控时各通道偏离基线 (或尚无基线可比)
+static uint32_t full_cycles = 0;
+static uint64_t cycles_saved = 0;
+
+// 特征提取参数 (演示布局)
+static const float demo_feature_weights[ROTS_AI_DEMO_FEATURES] = {
+    1.0f, 0.8f, 0.6f, 0.4f, 0.2f,  // MQ传感器权重
+    0.9f, 0.7f, 0.5f, 0.3f, 0.1f,  // 环境传感器权重
+    0.6f, 0.4f, 0.2f, 0.1f, 0.05f  // 交叉特征权重
+};
+
+// 时序特征缩放 (使其与基础特征量级相近, 避免压缩int8输入量化的分辨率)
+static const float temporal_feature_weights[ROTS_TEMPORAL_FEATURES] = {
+    0.1f, 0.5f, 0.5f, 0.05f, 1.0f  // 斜率, EWMA, 极差, 面积, 起始后时间
+};
+
+// 气味识别阈值
+static const float odor_thresholds[6] = {
+    0.7f, 0.7f, 0.7f, 0.7f, 0.7f, 0.6f  // 对应6种气味
+};
+
+// 私有函数声明
+static bool ROTS_AIEngine_GateQuiet(uint32_t channel_mask);
+static void ROTS_AIEngine_ExtractFeatures(const ROTS_SensorData_t* sensor_data, uint32_t channel_mask);
+static ROTS_OdorType_t ROTS_AIEngine_ClassifyOdor(void);
+static void ROTS_AIEngine_FloatScores(float* scores);
+static void ROTS_AIEngine_ShadowCompare(const float* int8_scores);
+static ROTS_OdorType_t ROTS_AIEngine_Decide(const float* scores, float* probs);
+static ROTS_StatusTypeDef ROTS_AIEngine_ApplyModel(const ROTS_AIModelDesc_t* desc, const float* params, uint32_t param_count);
+static ROTS_StatusTypeDef ROTS_AIEngine_ApplyBlob(const uint8_t* blob, uint32_t size);
+static void ROTS_AIEngine_ResetShadow(void);
+static void ROTS_AIEngine_SwapUpdatedModel(void);
+static float ROTS_AIEngine_CalculateConfidence(ROTS_OdorType_t odor_type);
+static float ROTS_AIEngine_EstimateIntensity(ROTS_OdorType_t odor_type);
+static float ROTS_AIEngine_NoveltyScore(void);
+static ROTS_StatusTypeDef ROTS_AIEngine_SetIntensityHead(const float* weights, const float* bias, uint32_t size);
+static ROTS_StatusTypeDef ROTS_AIEngine_SetNoveltyStats(const float* means, const float* inv_vars, uint32_t size, float threshold);
+static void ROTS_AIEngine_LoadDemoModel(void);
+static void ROTS_AIEngine_LoadDemoIntensityHead(void);
+static void ROTS_AIEngine_TakeLearnRequest(uint32_t now);
+static void ROTS_AIEngine_LearnStep(uint32_t now);
+static void ROTS_AIEngine_FinishLearn(ROTS_StatusTypeDef result);
+static bool ROTS_AIEngine_MatchPrototype(ROTS_OdorType_t* odor_type, float* confidence);
+static void ROTS_AIEngine_PrototypeFeatures(float* features);
+static uint8_t ROTS_AIEngine_DemoFeatureIndex(uint8_t feature);
+
+// 初始化AI引擎
+ROTS_StatusTypeDef ROTS_AIEngine_Init(void) {
+    DEBUG_INFO("Initializing AI engine...\r\n");
+    
+    // 特征维数随通道数确定
+    ai_channel_count = ROTS_SensorManager_GetChannelCount();
+    ai_feature_count = ROTS_AI_FEATURE_COUNT(ai_channel_count);
+    
+    // 初始化特征向量
+    memset(feature_vector, 0, sizeof(feature_vector));
+    
+    // 加载模型权重: 先装入演示模型, 模型分区中有匹配的模型容器时替换之
+    ROTS_AIEngine_LoadDemoModel();
+    ROTS_AIEngine_LoadDemoIntensityHead();
+    const uint8_t* blob = NULL;
+    uint32_t blob_size = 0;
+    if (ROTS_ModelStore_Init() == ROTS_OK && ROTS_ModelStore_GetBlob(&blob, &blob_size) == ROTS_OK) {
+        if (ROTS_AIEngine_ApplyBlob(blob, blob_size) == ROTS_OK) {
+            DEBUG_INFO("Flash model 0x%08lX loaded\r\n", ROTS_ModelBlob_GetHeader(blob)->model_id);
+        } else {
+            DEBUG_INFO("No usable flash model, using demo model\r\n");
+        }
+    }
+    
+    // 初始化结果
+    ROTS_Seqlock_Init(&last_result, last_result_words, sizeof(ROTS_OdorResult_t), NULL);
+    
+    // 现场学习的原型 (从NVS恢复)
+    if (ROTS_Prototypes_Init(ROTS_AI_PROTO_FEATURE_COUNT(ai_channel_count)) != ROTS_OK) {
+        DEBUG_ERROR("Prototype table init failed\r\n");
+    }
+    memset(&learn_status, 0, sizeof(learn_status));
+    ROTS_Seqlock_Init(&learn_status_lock, learn_status_words, sizeof(ROTS_AILearnStatus_t), &learn_status);
+    
+    ai_initialized = true;
+    DEBUG_INFO("AI engine initialized\r\n");
+    return ROTS_OK;
+}
+
+// 处理气味检测
+ROTS_StatusTypeDef ROTS_AIEngine_ProcessOdor(ROTS_OdorResult_t* result) {
+    if (!ai_initialized || !result) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 远程更新的模型在两次推理之间切换
+    ROTS_AIEngine_SwapUpdatedModel();
+    
+    // 现场学习命令
+    ROTS_AIEngine_TakeLearnRequest(millis());
+    bool learning = learn_active.load(std::memory_order_relaxed);
+    
+    // 屏蔽健康评估判定失效的通道
+    ai_channel_mask = ROTS_SensorManager_GetHealthyMask();
+    inference_count++;
+    
+    ROTS_OdorType_t odor_type = ROTS_ODOR_UNKNOWN;
+    float confidence = ROTS_AI_MIN_CONFIDENCE;
+    float intensity = 0.0f;
+    float novelty = 0.0f;
+    bool novel = false;
+    
+    // 第一级门控: 各通道贴近洁净空气基线时直接判为无气味, 不做特征提取与打分 (学习期间不门控)
+    if (!learning && ROTS_AIEngine_GateQuiet(ai_channel_mask)) {
+        gate_skips++;
+        if (full_cycles > gate_cycles) {
+            cycles_saved += full_cycles - gate_cycles;
+        }
+    } else {
+        uint32_t start = ROTS_CYCLE_COUNT();
+        
+        // 获取当前传感器数据
+        ROTS_SensorData_t sensor_data;
+        ROTS_StatusTypeDef status = ROTS_SensorManager_GetCurrentData(&sensor_data);
+        if (status != ROTS_OK) {
+            DEBUG_ERROR("Failed to get sensor data\r\n");
+            return status;
+        }
+        
+        // 提取特征
+        ROTS_AIEngine_ExtractFeatures(&sensor_data, ai_channel_mask);
+        
+        if (learning) {
+            // 学习期间只采集样本, 结果为无气味
+            ROTS_AIEngine_LearnStep(millis());
+        } else {
+            // 分类识别与置信度
+            if (classifier_mode != ROTS_AI_CLASSIFIER_PROTOTYPE) {
+                odor_type = ROTS_AIEngine_ClassifyOdor();
+                confidence = ROTS_AIEngine_CalculateConfidence(odor_type);
+                
+                // 新颖度: 读数不像任何训练类别时, 模型只是在六类中挑了最接近的一个
+                // 统计量中没有洁净空气类, 门控的强制刷新在洁净空气中也会走到这里, 只在
+                // 偏离基线或模型有检出时评估, 否则基线空气本身就会被判为新颖
+                if (gate_deviated || odor_type != ROTS_ODOR_UNKNOWN) {
+                    novelty = ROTS_AIEngine_NoveltyScore();
+                    novel = novelty > novelty_threshold;
+                }
+            }
+            
+            // 现场学习的气味 (模型判为未知, 或读数不像任何训练类别时)
+            if (classifier_mode != ROTS_AI_CLASSIFIER_MODEL && (odor_type == ROTS_ODOR_UNKNOWN || novel) &&
+                ROTS_AIEngine_MatchPrototype(&odor_type, &confidence)) {
+                novel = false;
+            }
+            if (novel) {
+                novel_count++;
+            }
+            
+            // 强度回归 (复用本次特征向量, 只计算判定类别的一行)
+            intensity = ROTS_AIEngine_EstimateIntensity(odor_type);
+        }
+        
+        // 完整推理耗时 (1/8指数平均, 用于估算门控节省的周期)
+        uint32_t cycles = ROTS_CYCLE_COUNT() - start;
+        full_cycles = full_inferences == 0 ? cycles : full_cycles + ((int32_t)(cycles - full_cycles)) / 8;
+        full_inferences++;
+    }
+    
+    // 设置结果
+    result->odor_type = odor_type;
+    result->confidence = confidence;
+    result->intensity = intensity;
+    result->timestamp = millis();
+    result->novelty = novelty;
+    result->novel = novel;
+    
+    // 设置气味名称
+    switch (odor_type) {
+        case ROTS_ODOR_COFFEE:
+            strcpy(result->odor_name, "Coffee");
+            break;
+        case ROTS_ODOR_ALCOHOL:
+            strcpy(result->odor_name, "Alcohol");
+            break;
+        case ROTS_ODOR_LEMON:
+            strcpy(result->odor_name, "Lemon");
+            break;
+        case ROTS_ODOR_MINT:
+            strcpy(result->odor_name, "Mint");
+            break;
+        case ROTS_ODOR_LAVENDER:
+            strcpy(result->odor_name, "Lavender");
+            break;
+        default:
+            strcpy(result->odor_name, "Unknown");
+            break;
+    }
+    
+    // 现场学习的气味用学习时的名称
+    if (odor_type >= ROTS_ODOR_LEARNED) {
+        strcpy(result->odor_name, ROTS_Prototypes_GetName(odor_type - ROTS_ODOR_LEARNED));
+    }
+    
+    // 发布最后结果
+    ROTS_Seqlock_Write(&last_result, result);
+    
+    DEBUG_DEBUG("AI inference: %s (%.2f)\r\n", result->odor_name, result->confidence);
+    
+    return ROTS_OK;
+}
+
+// 门控判定: 时序窗口已满, 没有通道处于响应期, 且平均相对偏离低于阈值时返回true
+// 连续跳过ROTS_AI_GATE_REFRESH次后放行一次, 使对照统计和慢变化的气味仍能被完整模型看到
+static bool ROTS_AIEngine_GateQuiet(uint32_t channel_mask) {
+    uint32_t start = ROTS_CYCLE_COUNT();
+    
+    // 强制刷新时同样计算偏离, 供新颖度判断本次是否为洁净空气
+    float deviation;
+    gate_deviated = ROTS_TemporalFeatures_GetDeviation(channel_mask, &deviation) != ROTS_OK ||
+                    deviation >= ROTS_AI_GATE_THRESHOLD;
+    bool quiet = !gate_deviated && gate_skip_run < ROTS_AI_GATE_REFRESH;
+    gate_skip_run = quiet ? gate_skip_run + 1 : 0;
+    
+    gate_cycles = ROTS_CYCLE_COUNT() - start;
+    return quiet;
+}
+
+// 提取特征
+static void ROTS_AIEngine_ExtractFeatures(const ROTS_SensorData_t* sensor_data, uint32_t channel_mask) {
+    float channels[ROTS_MAX_CHANNELS];
+    uint8_t index = 0;
+    
+    // 基础传感器特征 (被屏蔽的通道置0, 不参与打分)
+    for (int ch = 0; ch < ai_channel_count; ch++) {
+        bool usable = ch < sensor_data->channel_count && (channel_mask & (1UL << ch));
+        channels[ch] = usable ? sensor_data->channels[ch] : 0.0f;
+        feature_vector[index++] = channels[ch];
+    }
+    
+    // 环境特征
+    feature_vector[index++] = sensor_data->temperature;
+    feature_vector[index++] = sensor_data->humidity;
+    feature_vector[index++] = sensor_data->pressure;
+    
+    // 交叉特征 (相邻通道比值, 外部板离线或通道被屏蔽时分母为0)
+    for (int pair = 0; pair < ai_channel_count / 2; pair++) {
+        float denominator = channels[2 * pair + 1];
+        feature_vector[index++] = denominator != 0.0f ? channels[2 * pair] / denominator : 0.0f;
+    }
+    
+    // 时序特征 (每通道随采样增量更新, 此处只取结果)
+    for (int ch = 0; ch < ai_channel_count; ch++) {
+        bool usable = ch < sensor_data->channel_count && (channel_mask & (1UL << ch));
+        float* temporal = &feature_vector[index];
+        if (!usable || ROTS_TemporalFeatures_Get(ch, temporal) != ROTS_OK) {
+            memset(temporal, 0, ROTS_TEMPORAL_FEATURES * sizeof(float));
+        }
+        index += ROTS_TEMPORAL_FEATURES;
+    }
+    
+    // 归一化特征
+    for (int i = 0; i < ai_feature_count; i++) {
+        feature_vector[i] *= feature_weights[i];
+    }
+}
+
+// 分类识别
+static ROTS_OdorType_t ROTS_AIEngine_ClassifyOdor(void) {
+    float scores[ROTS_AI_ODOR_CLASSES];
+    
+#if ROTS_AI_USE_INT8
+    uint32_t start = ROTS_CYCLE_COUNT();
+    ROTS_AIModel_RunLogits(feature_vector, scores, true);
+    int8_cycles = ROTS_CYCLE_COUNT() - start;
+    
+    // 定期用浮点路径对照, 统计量化误差
+    if (++quant_inferences % ROTS_AI_SHADOW_INTERVAL == 0) {
+        ROTS_AIEngine_ShadowCompare(scores);
+    }
+#else
+    ROTS_AIEngine_FloatScores(scores);
+#endif
+    
+    return ROTS_AIEngine_Decide(scores, class_probabilities);
+}
+
+// 浮点打分 (参考实现)
+static void ROTS_AIEngine_FloatScores(float* scores) {
+    uint32_t start = ROTS_CYCLE_COUNT();
+    ROTS_AIModel_RunLogits(feature_vector, scores, false);
+    float_cycles = ROTS_CYCLE_COUNT() - start;
+}
+
+// 对照int8与浮点打分
+static void ROTS_AIEngine_ShadowCompare(const float* int8_scores) {
+    float scores[ROTS_AI_ODOR_CLASSES];
+    ROTS_AIEngine_FloatScores(scores);
+    
+    float max_magnitude = 0.0f;
+    float max_error = 0.0f;
+    for (int odor = 0; odor < ROTS_AI_ODOR_CLASSES; odor++) {
+        float magnitude = fabsf(scores[odor]);
+        float error = fabsf(int8_scores[odor] - scores[odor]);
+        if (magnitude > max_magnitude) max_magnitude = magnitude;
+        if (error > max_error) max_error = error;
+    }
+    
+    if (max_magnitude > 0.0f && max_error / max_magnitude > shadow_max_error) {
+        shadow_max_error = max_error / max_magnitude;
+    }
+    float probs[ROTS_AI_ODOR_CLASSES];
+    float int8_probs[ROTS_AI_ODOR_CLASSES];
+    if (ROTS_AIEngine_Decide(scores, probs) != ROTS_AIEngine_Decide(int8_scores, int8_probs)) {
+        shadow_mismatches++;
+    }
+    shadow_runs++;
+}
+
+// 由得分做判定, 同时按模型的校准温度算出各类概率
+// 模型自带Softmax输出时阈值作用于概率, 否则作用于原始得分 (演示模型的阈值按得分给出)
+static ROTS_OdorType_t ROTS_AIEngine_Decide(const float* scores, float* probs) {
+    ROTS_AIModelInfo_t info;
+    ROTS_AIModel_GetInfo(&info);
+    ROTS_AIModel_Softmax(scores, probs, ROTS_AI_ODOR_CLASSES, info.temperature);
+    const float* decision = info.softmax_output ? probs : scores;
+    
+    // 找到最高得分
+    float max_score = decision[0];
+    int max_index = 0;
+    
+    for (int i = 1; i < ROTS_AI_ODOR_CLASSES; i++) {
+        if (decision[i] > max_score) {
+            max_score = decision[i];
+            max_index = i;
+        }
+    }
+    
+    // 检查是否超过阈值
+    if (max_score > odor_thresholds[max_index]) {
+        return (ROTS_OdorType_t)(max_index + 1);
+    }
+    
+    return ROTS_ODOR_UNKNOWN;
+}
+
+// 计算置信度: 判定类别的校准概率
+static float ROTS_AIEngine_CalculateConfidence(ROTS_OdorType_t odor_type) {
+    if (odor_type == ROTS_ODOR_UNKNOWN) {
+        return ROTS_AI_MIN_CONFIDENCE;
+    }
+    
+    float confidence = class_probabilities[odor_type - 1];
+    
+    // 确保在合理范围内
+    if (confidence > ROTS_AI_MAX_CONFIDENCE) confidence = ROTS_AI_MAX_CONFIDENCE;
+    if (confidence < ROTS_AI_MIN_CONFIDENCE) confidence = ROTS_AI_MIN_CONFIDENCE;
+    
+    return confidence;
+}
+
+// 加载演示模型
+static void ROTS_AIEngine_LoadDemoModel(void) {
+    // 使用预定义的简单权重，模拟训练好的模型
+    // 这些权重是基于经验设计的，用于演示
+    static const float demo_weights[ROTS_AI_ODOR_CLASSES * ROTS_AI_DEMO_FEATURES] = {
+        // Coffee weights (sensor 0-7, env 8-10, cross 11-14)
+        0.8f, 0.2f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f,  // MQ sensors
+        0.3f, 0.2f, 0.1f,  // Environment
+        0.1f, 0.1f, 0.1f, 0.1f,  // Cross features
+        
+        // Alcohol weights
+        0.1f, 0.8f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f,
+        0.2f, 0.3f, 0.1f,
+        0.1f, 0.1f, 0.1f, 0.1f,
+        
+        // Lemon weights
+        0.1f, 0.1f, 0.8f, 0.1f, 0.1f, 0.1f, 0.1f, 0.1f,
+        0.2f, 0.2f, 0.1f,
+        0.1f, 0.1f, 0.1f, 0.1f,
+        
+        // Mint weights
+        0.1f, 0.1f, 0.1f, 0.8f, 0.1f, 0.1f, 0.1f, 0.1f,
+        0.2f, 0.2f, 0.1f,
+        0.1f, 0.1f, 0.1f, 0.1f,
+        
+        // Lavender weights
+        0.1f, 0.1f, 0.1f, 0.1f, 0.8f, 0.1f, 0.1f, 0.1f,
+        0.2f, 0.2f, 0.1f,
+        0.1f, 0.1f, 0.1f, 0.1f,
+        
+        // Mixed weights
+        0.3f, 0.3f, 0.3f, 0.3f, 0.3f, 0.3f, 0.3f, 0.3f,
+        0.2f, 0.2f, 0.1f,
+        0.2f, 0.2f, 0.2f, 0.2f
+    };
+    
+    // 按实际通道数展开: 多出的通道与比值沿用演示布局最后一项, 时序特征权重为0
+    static float model_weights[ROTS_AI_MODEL_SIZE];
+    const uint8_t base_features = ROTS_AI_BASE_FEATURE_COUNT(ai_channel_count);
+    for (int feature = 0; feature < ai_feature_count; feature++) {
+        if (feature >= base_features) {
+            feature_weights[feature] = temporal_feature_weights[(feature - base_features) % ROTS_TEMPORAL_FEATURES];
+            for (int odor = 0; odor < ROTS_AI_ODOR_CLASSES; odor++) {
+                model_weights[odor * ai_feature_count + feature] = 0.0f;
+            }
+            continue;
+        }
+        
+        uint8_t demo = ROTS_AIEngine_DemoFeatureIndex(feature);
+        feature_weights[feature] = demo_feature_weights[demo];
+        for (int odor = 0; odor < ROTS_AI_ODOR_CLASSES; odor++) {
+            model_weights[odor * ai_feature_count + feature] = demo_weights[odor * ROTS_AI_DEMO_FEATURES + demo];
+        }
+    }
+    
+    // 单层线性模型
+    ROTS_AIModelDesc_t desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.inputs = ai_feature_count;
+    desc.layer_count = 1;
+    desc.layers[0].type = ROTS_AI_LAYER_DENSE;
+    desc.layers[0].outputs = ROTS_AI_ODOR_CLASSES;
+    
+    if (ROTS_AIEngine_ApplyModel(&desc, model_weights, ROTS_AI_ODOR_CLASSES * ai_feature_count) != ROTS_OK) {
+        DEBUG_ERROR("Demo model rejected\r\n");
+        return;
+    }
+    DEBUG_INFO("Demo model weights loaded (%u features)\r\n", ai_feature_count);
+}
+
+// 估计强度: 判定类别的回归头与特征向量点积, 限制在0..ROTS_AI_MAX_INTENSITY
+static float ROTS_AIEngine_EstimateIntensity(ROTS_OdorType_t odor_type) {
+    if (odor_type == ROTS_ODOR_UNKNOWN) {
+        intensity_cycles = 0;
+        return 0.0f;
+    }
+    
+    // 现场学习的气味没有专门的回归行, 沿用混合气味 (全部通道) 一行
+    uint32_t start = ROTS_CYCLE_COUNT();
+    uint8_t row = odor_type >= ROTS_ODOR_LEARNED ? ROTS_AI_ODOR_CLASSES - 1 : odor_type - 1;
+    const float* weights = &intensity_weights[row * ai_feature_count];
+    float intensity = intensity_bias[row];
+    for (int i = 0; i < ai_feature_count; i++) {
+        intensity += weights[i] * feature_vector[i];
+    }
+    
+    if (intensity < 0.0f) intensity = 0.0f;
+    if (intensity > ROTS_AI_MAX_INTENSITY) intensity = ROTS_AI_MAX_INTENSITY;
+    intensity_cycles = ROTS_CYCLE_COUNT() - start;
+    return intensity;
+}
+
+// 新颖度: 本次特征向量到最近训练类别的距离 (故障通道与环境量不参与)
+static float ROTS_AIEngine_NoveltyScore(void) {
+    if (!novelty_loaded) {
+        novelty_cycles = 0;
+        return 0.0f;
+    }
+    
+    uint32_t start = ROTS_CYCLE_COUNT();
+    uint8_t used[ROTS_AI_FEATURE_SIZE];
+    uint16_t used_count = ROTS_Novelty_SelectFeatures(ai_channel_count, ai_channel_mask, used);
+    float novelty = ROTS_Novelty_Score(feature_vector, novelty_means, novelty_inv_vars, ai_feature_count,
+                                       ROTS_AI_ODOR_CLASSES, used, used_count, NULL);
+    novelty_cycles = ROTS_CYCLE_COUNT() - start;
+    return novelty;
+}
+
+// 取出通信任务提交的学习/删除命令 (学习进行中时不取, 命令保持挂起)
+static void ROTS_AIEngine_TakeLearnRequest(uint32_t now) {
+    if (learn_active.load(std::memory_order_relaxed) || !learn_request_pending.load(std::memory_order_acquire)) {
+        return;
+    }
+    
+    memcpy(learn_status.name, learn_request.name, sizeof(learn_status.name));
+    learn_status.command = learn_request.command;
+    learn_status.samples = 0;
+    learn_duration = learn_request_duration;
+    learn_request_pending.store(false, std::memory_order_release);
+    
+    if (learn_status.command == ROTS_AI_LEARN_CMD_FORGET) {
+        ROTS_AIEngine_FinishLearn(ROTS_Prototypes_Remove(learn_status.name));
+        return;
+    }
+    
+    uint8_t slot = 0;
+    ROTS_StatusTypeDef status = ROTS_Prototypes_Begin(learn_status.name, &slot);
+    if (status != ROTS_OK) {
+        ROTS_AIEngine_FinishLearn(status);
+        return;
+    }
+    
+    learn_status.slot = slot;
+    learn_status.active = 1;
+    learn_start = now;
+    learn_active.store(true, std::memory_order_relaxed);
+    ROTS_Seqlock_Write(&learn_status_lock, &learn_status);
+    DEBUG_INFO("Learning '%s' for %lu ms\r\n", learn_status.name, learn_duration);
+}
+
+// 加入一个学习样本, 到时后结束
+static void ROTS_AIEngine_LearnStep(uint32_t now) {
+    float features[ROTS_PROTO_MAX_FEATURES];
+    ROTS_AIEngine_PrototypeFeatures(features);
+    if (ROTS_Prototypes_AddSample(learn_status.slot, features) == ROTS_OK) {
+        learn_status.samples++;
+    }
+    
+    if (now - learn_start >= learn_duration) {
+        ROTS_AIEngine_FinishLearn(ROTS_Prototypes_Commit(learn_status.slot));
+    }
+}
+
+// 发布命令结果
+static void ROTS_AIEngine_FinishLearn(ROTS_StatusTypeDef result) {
+    learn_status.active = 0;
+    learn_status.result = (uint8_t)result;
+    learn_status.sequence++;
+    learn_active.store(false, std::memory_order_relaxed);
+    ROTS_Seqlock_Write(&learn_status_lock, &learn_status);
+    
+    DEBUG_INFO("%s '%s': %d (%lu samples)\r\n",
+              learn_status.command == ROTS_AI_LEARN_CMD_FORGET ? "Forget" : "Learn",
+              learn_status.name, result, learn_status.samples);
+}
+
+// 查找最近原型, 命中时改写类别与置信度
+static bool ROTS_AIEngine_MatchPrototype(ROTS_OdorType_t* odor_type, float* confidence) {
+    float features[ROTS_PROTO_MAX_FEATURES];
+    ROTS_AIEngine_PrototypeFeatures(features);
+    
+    ROTS_ProtoMatch_t match;
+    if (ROTS_Prototypes_Match(features, &match) != ROTS_OK) {
+        return false;
+    }
+    
+    *odor_type = (ROTS_OdorType_t)(ROTS_ODOR_LEARNED + match.slot);
+    *confidence = match.confidence;
+    return true;
+}
+
+// 原型特征: 归一化后的通道值与相邻通道比值 (环境量随现场变化, 不参与)
+static void ROTS_AIEngine_PrototypeFeatures(float* features) {
+    uint8_t index = 0;
+    for (int ch = 0; ch < ai_channel_count; ch++) {
+        features[index++] = feature_vector[ch];
+    }
+    for (int pair = 0; pair < ai_channel_count / 2; pair++) {
+        features[index++] = feature_vector[ai_channel_count + 3 + pair];
+    }
+}
+
+// 演示回归头: 各气味取演示分类权重最大的通道 (混合气味取全部板载通道平均),
+// 浓度线性映射到0..100%. 仅为占位, 应以标定数据训练后随模型容器下发
+static void ROTS_AIEngine_LoadDemoIntensityHead(void) {
+    memset(intensity_weights, 0, sizeof(intensity_weights));
+    memset(intensity_bias, 0, sizeof(intensity_bias));
+    
+    // 特征向量中的通道值已乘以feature_weights, 此处除回ppm
+    uint8_t demo_channels = ai_channel_count < ROTS_AI_DEMO_CHANNELS ? ai_channel_count : ROTS_AI_DEMO_CHANNELS;
+    for (int odor = 0; odor < ROTS_AI_ODOR_CLASSES; odor++) {
+        float* weights = &intensity_weights[odor * ai_feature_count];
+        bool mixed = odor >= demo_channels || odor == ROTS_AI_ODOR_CLASSES - 1;
+        for (int ch = mixed ? 0 : odor; ch < (mixed ? demo_channels : odor + 1); ch++) {
+            if (feature_weights[ch] > 0.0f) {
+                weights[ch] = ROTS_AI_MAX_INTENSITY / (ROTS_AI_DEMO_INTENSITY_FULL_SCALE * feature_weights[ch]) /
+                              (mixed ? demo_channels : 1);
+            }
+        }
+    }
+    intensity_demo = true;
+}
+
+// 校验输入/输出宽度后加载模型, 并清零对照统计
+static ROTS_StatusTypeDef ROTS_AIEngine_ApplyModel(const ROTS_AIModelDesc_t* desc, const float* params, uint32_t param_count) {
+    if (!desc || desc->inputs != ai_feature_count || desc->layer_count > ROTS_AI_MAX_LAYERS) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 输出宽度取最后一个全连接层
+    uint16_t outputs = desc->inputs;
+    for (uint8_t l = 0; l < desc->layer_count; l++) {
+        if (desc->layers[l].type == ROTS_AI_LAYER_DENSE) {
+            outputs = desc->layers[l].outputs;
+        }
+    }
+    if (outputs != ROTS_AI_ODOR_CLASSES) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    ROTS_StatusTypeDef status = ROTS_AIModel_Load(desc, params, param_count);
+    if (status != ROTS_OK) {
+        return status;
+    }
+    
+    // 原模型的统计量不再适用
+    novelty_loaded = false;
+    ROTS_AIEngine_ResetShadow();
+    return ROTS_OK;
+}
+
+// 校验并加载模型容器 (输入须为当前特征数, 输出须为ROTS_AI_ODOR_CLASSES)
+static ROTS_StatusTypeDef ROTS_AIEngine_ApplyBlob(const uint8_t* blob, uint32_t size) {
+    ROTS_StatusTypeDef status = ROTS_ModelBlob_Validate(blob, size);
+    if (status != ROTS_OK) {
+        return status;
+    }
+    
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    if (header->inputs != ai_feature_count || header->outputs != ROTS_AI_ODOR_CLASSES) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    status = ROTS_AIModel_LoadBlob(blob, size);
+    if (status != ROTS_OK) {
+        return status;
+    }
+    
+    // 容器附带的回归头与统计量随模型切换; 不带回归头时退回演示回归头,
+    // 不带统计量时停用新颖度 (原模型的参数不再适用)
+    uint32_t section_size = 0;
+    uint32_t count = (uint32_t)header->inputs * header->outputs;
+    const float* head = (const float*)ROTS_ModelBlob_FindSection(blob, ROTS_MODEL_SECTION_INTENSITY, &section_size);
+    if (!head) {
+        ROTS_AIEngine_LoadDemoIntensityHead();
+    } else if (ROTS_AIEngine_SetIntensityHead(head, head + count, count) != ROTS_OK) {
+        DEBUG_WARNING("Model intensity head rejected, using demo head\r\n");
+        ROTS_AIEngine_LoadDemoIntensityHead();
+    }
+    
+    novelty_loaded = false;
+    const float* novelty = (const float*)ROTS_ModelBlob_FindSection(blob, ROTS_MODEL_SECTION_NOVELTY, &section_size);
+    if (novelty) {
+        if (ROTS_AIEngine_SetNoveltyStats(novelty + 1, novelty + 1 + count, count, novelty[0]) != ROTS_OK) {
+            DEBUG_WARNING("Model novelty stats rejected\r\n");
+        }
+    }
+    
+    ROTS_AIEngine_ResetShadow();
+    return ROTS_OK;
+}
+
+// 切换到远程更新接收完成的模型 (不兼容时保留原模型)
+static void ROTS_AIEngine_SwapUpdatedModel(void) {
+    const uint8_t* blob = NULL;
+    uint32_t size = 0;
+    if (ROTS_ModelUpdate_TakeReady(&blob, &size) != ROTS_OK) {
+        return;
+    }
+    
+    ROTS_StatusTypeDef status = ROTS_AIEngine_ApplyBlob(blob, size);
+    ROTS_ModelUpdate_Complete(status);
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Updated model rejected: %d\r\n", status);
+        return;
+    }
+    DEBUG_INFO("Switched to updated model 0x%08lX\r\n", ROTS_ModelBlob_GetHeader(blob)->model_id);
+}
+
+// 清零int8/浮点对照统计
+static void ROTS_AIEngine_ResetShadow(void) {
+    quant_inferences = 0;
+    shadow_runs = 0;
+    shadow_mismatches = 0;
+    shadow_max_error = 0.0f;
+}
+
+// 特征在演示布局中的对应位置
+static uint8_t ROTS_AIEngine_DemoFeatureIndex(uint8_t feature) {
+    const uint8_t demo_pairs = ROTS_AI_DEMO_CHANNELS / 2;
+    
+    if (feature < ai_channel_count) {
+        return feature < ROTS_AI_DEMO_CHANNELS ? feature : ROTS_AI_DEMO_CHANNELS - 1;
+    }
+    feature -= ai_channel_count;
+    if (feature < 3) {
+        return ROTS_AI_DEMO_CHANNELS + feature;
+    }
+    feature -= 3;
+    return ROTS_AI_DEMO_CHANNELS + 3 + (feature < demo_pairs ? feature : demo_pairs - 1);
+}
+
+// 获取最近一次推理结果 (可在其他任务中调用)
+ROTS_StatusTypeDef ROTS_AIEngine_GetLastResult(ROTS_OdorResult_t* result) {
+    if (!ai_initialized || !result) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    return ROTS_Seqlock_Read(&last_result, result);
+}
+
+// 获取AI状态
+ROTS_StatusTypeDef ROTS_AIEngine_GetStatus(ROTS_AIStatus_t* status) {
+    if (!ai_initialized || !status) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    ROTS_OdorResult_t latest;
+    if (ROTS_Seqlock_Read(&last_result, &latest) != ROTS_OK) {
+        memset(&latest, 0, sizeof(ROTS_OdorResult_t));
+    }
+    
+    status->initialized = ai_initialized;
+    status->last_inference_time = latest.timestamp;
+    status->last_odor_type = latest.odor_type;
+    status->last_confidence = latest.confidence;
+    status->inference_count = inference_count;
+    status->full_inferences = full_inferences;
+    status->gate_skips = gate_skips;
+    status->gate_hit_rate = inference_count > 0 ? (float)gate_skips / inference_count : 0.0f;
+    status->gate_cycles = gate_cycles;
+    status->full_cycles = full_cycles;
+    status->cycles_saved = cycles_saved;
+    status->channel_count = ai_channel_count;
+    status->feature_count = ai_feature_count;
+    status->channel_mask = ai_channel_mask;
+    status->int8_enabled = ROTS_AI_USE_INT8;
+    status->shadow_runs = shadow_runs;
+    status->shadow_mismatches = shadow_mismatches;
+    status->shadow_max_error = shadow_max_error;
+    status->int8_cycles = int8_cycles;
+    status->float_cycles = float_cycles;
+    status->intensity_cycles = intensity_cycles;
+    status->intensity_demo = intensity_demo;
+    status->novelty_loaded = novelty_loaded;
+    status->novelty_threshold = novelty_threshold;
+    status->novel_count = novel_count;
+    status->novelty_cycles = novelty_cycles;
+    
+    ROTS_ProtoStats_t proto;
+    ROTS_Prototypes_GetStats(&proto);
+    status->classifier_mode = classifier_mode;
+    status->prototype_count = proto.used;
+    status->prototype_matches = proto.matches;
+    status->prototype_cycles = proto.lookup_cycles;
+    status->learning = learn_active.load(std::memory_order_relaxed);
+    
+    ROTS_AIModelInfo_t info;
+    ROTS_AIModel_GetInfo(&info);
+    status->model_source = info.source;
+    status->model_id = info.model_id;
+    status->model_temperature = info.temperature;
+    status->model_layers = info.layer_count;
+    status->model_params = info.param_count;
+    status->model_arena_bytes = info.arena_used;
+    
+    return ROTS_OK;
+}
+
+// 更新为单层线性模型 (size须为 ROTS_AI_ODOR_CLASSES * 当前特征数)
+ROTS_StatusTypeDef ROTS_AIEngine_UpdateModel(const float* new_weights, uint16_t size) {
+    if (!ai_initialized || !new_weights || size != ROTS_AI_ODOR_CLASSES * ai_feature_count) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    ROTS_AIModelDesc_t desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.inputs = ai_feature_count;
+    desc.layer_count = 1;
+    desc.layers[0].type = ROTS_AI_LAYER_DENSE;
+    desc.layers[0].outputs = ROTS_AI_ODOR_CLASSES;
+    return ROTS_AIEngine_LoadModel(&desc, new_weights, size);
+}
+
+// 加载强度回归头 (weights为[ROTS_AI_ODOR_CLASSES][当前特征数], 作用于归一化后的特征;
+// bias为每类偏置, 可为NULL; 输出单位为%满量程). 随模型容器下发的回归头
+// (rots_model_pack pack --intensity) 在加载容器时自动替换, 不必调用
+ROTS_StatusTypeDef ROTS_AIEngine_LoadIntensityHead(const float* weights, const float* bias, uint16_t size) {
+    if (!ai_initialized) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    return ROTS_AIEngine_SetIntensityHead(weights, bias, size);
+}
+
+// 校验后替换强度回归头 (复制到RAM)
+static ROTS_StatusTypeDef ROTS_AIEngine_SetIntensityHead(const float* weights, const float* bias, uint32_t size) {
+    if (!weights || size != (uint32_t)ROTS_AI_ODOR_CLASSES * ai_feature_count) {
+        return ROTS_INVALID_PARAM;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        if (!isfinite(weights[i])) {
+            return ROTS_INVALID_PARAM;
+        }
+    }
+    for (int i = 0; bias && i < ROTS_AI_ODOR_CLASSES; i++) {
+        if (!isfinite(bias[i])) {
+            return ROTS_INVALID_PARAM;
+        }
+    }
+    
+    memcpy(intensity_weights, weights, size * sizeof(float));
+    if (bias) {
+        memcpy(intensity_bias, bias, sizeof(intensity_bias));
+    } else {
+        memset(intensity_bias, 0, sizeof(intensity_bias));
+    }
+    intensity_demo = false;
+    
+    DEBUG_INFO("Intensity head updated (%lu weights)\r\n", (unsigned long)size);
+    return ROTS_OK;
+}
+
+// 替换当前模型的新颖度统计量: means/inv_vars为 [6][特征数], 作用于归一化后的特征
+// (与强度回归头相同), 不复制, 须在模型使用期间保持有效; threshold为0时使用默认阈值.
+// 通常不必调用: rots_model_pack novelty --write 把统计量写入模型容器, 加载模型时一并生效
+ROTS_StatusTypeDef ROTS_AIEngine_LoadNoveltyStats(const float* means, const float* inv_vars, uint16_t size, float threshold) {
+    if (!ai_initialized) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    return ROTS_AIEngine_SetNoveltyStats(means, inv_vars, size, threshold);
+}
+
+// 校验后启用新颖度统计量
+static ROTS_StatusTypeDef ROTS_AIEngine_SetNoveltyStats(const float* means, const float* inv_vars, uint32_t size, float threshold) {
+    if (!means || !inv_vars || size != (uint32_t)ROTS_AI_ODOR_CLASSES * ai_feature_count ||
+        !(threshold >= 0.0f) || isinf(threshold)) {
+        return ROTS_INVALID_PARAM;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        if (!isfinite(means[i]) || !(inv_vars[i] >= 0.0f) || isinf(inv_vars[i])) {
+            return ROTS_INVALID_PARAM;
+        }
+    }
+    
+    // 切换期间停用打分
+    novelty_loaded = false;
+    novelty_means = means;
+    novelty_inv_vars = inv_vars;
+    novelty_threshold = threshold > 0.0f ? threshold : ROTS_NOVELTY_THRESHOLD;
+    novelty_loaded = true;
+    
+    DEBUG_INFO("Novelty stats loaded (%lu values, threshold %.1f)\r\n", (unsigned long)size, novelty_threshold);
+    return ROTS_OK;
+}
+
+// 按层描述加载模型 (输入须为当前特征数, 输出须为ROTS_AI_ODOR_CLASSES)
+ROTS_StatusTypeDef ROTS_AIEngine_LoadModel(const ROTS_AIModelDesc_t* desc, const float* params, uint32_t param_count) {
+    if (!ai_initialized || !desc || !params) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    ROTS_StatusTypeDef status = ROTS_AIEngine_ApplyModel(desc, params, param_count);
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Model rejected (%u layers, %lu params)\r\n", desc->layer_count, param_count);
+        return status;
+    }
+    
+    DEBUG_INFO("Model updated (%u layers, %lu params)\r\n", desc->layer_count, param_count);
+    return ROTS_OK;
+}
+
+// 加载模型容器 (零拷贝引用, blob须在模型使用期间保持有效)
+ROTS_StatusTypeDef ROTS_AIEngine_LoadModelBlob(const uint8_t* blob, uint32_t size) {
+    if (!ai_initialized || !blob) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    ROTS_StatusTypeDef status = ROTS_AIEngine_ApplyBlob(blob, size);
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Model blob rejected (%lu bytes)\r\n", size);
+        return status;
+    }
+    
+    DEBUG_INFO("Model blob 0x%08lX loaded\r\n", ROTS_ModelBlob_GetHeader(blob)->model_id);
+    return ROTS_OK;
+}
+
+// 设置分类方式
+ROTS_StatusTypeDef ROTS_AIEngine_SetClassifierMode(ROTS_AIClassifierMode_t mode) {
+    if (mode > ROTS_AI_CLASSIFIER_HYBRID) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    classifier_mode = mode;
+    return ROTS_OK;
+}
+
+// 请求学习新气味 (可在其他任务中调用, 由推理任务在下一次推理时开始)
+// 学习期间应将气味持续送到传感器; 同名气味已存在时追加样本
+ROTS_StatusTypeDef ROTS_AIEngine_RequestLearn(const char* name, uint32_t duration_ms) {
+    if (!ai_initialized || !name || name[0] == '\0' || strlen(name) >= ROTS_PROTO_NAME_LENGTH ||
+        duration_ms < ROTS_AI_LEARN_MIN_MS || duration_ms > ROTS_AI_LEARN_MAX_MS) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (learn_request_pending.load(std::memory_order_acquire) || learn_active.load(std::memory_order_relaxed)) {
+        return ROTS_BUSY;
+    }
+    
+    memset(&learn_request, 0, sizeof(learn_request));
+    strcpy(learn_request.name, name);
+    learn_request.command = ROTS_AI_LEARN_CMD_LEARN;
+    learn_request_duration = duration_ms;
+    learn_request_pending.store(true, std::memory_order_release);
+    return ROTS_OK;
+}
+
+// 请求删除现场学习的气味 (可在其他任务中调用)
+ROTS_StatusTypeDef ROTS_AIEngine_RequestForget(const char* name) {
+    if (!ai_initialized || !name || name[0] == '\0' || strlen(name) >= ROTS_PROTO_NAME_LENGTH) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (learn_request_pending.load(std::memory_order_acquire) || learn_active.load(std::memory_order_relaxed)) {
+        return ROTS_BUSY;
+    }
+    
+    memset(&learn_request, 0, sizeof(learn_request));
+    strcpy(learn_request.name, name);
+    learn_request.command = ROTS_AI_LEARN_CMD_FORGET;
+    learn_request_pending.store(true, std::memory_order_release);
+    return ROTS_OK;
+}
+
+// 获取现场学习状态 (可在其他任务中调用)
+ROTS_StatusTypeDef ROTS_AIEngine_GetLearnStatus(ROTS_AILearnStatus_t* status) {
+    if (!ai_initialized || !status) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    return ROTS_Seqlock_Read(&learn_status_lock, status);
+}
+
+// 是否正在学习 (推理任务据此缩短采样间隔)
+bool ROTS_AIEngine_IsLearning(void) {
+    return learn_active.load(std::memory_order_relaxed);
+}
+
+// 重置AI引擎
+ROTS_StatusTypeDef ROTS_AIEngine_Reset(void) {
+    if (!ai_initialized) {
+        return ROTS_ERROR;
+    }
+    
+    memset(feature_vector, 0, sizeof(feature_vector));
+    gate_skip_run = 0;
+    gate_deviated = true;
+    ROTS_OdorResult_t cleared;
+    memset(&cleared, 0, sizeof(ROTS_OdorResult_t));
+    ROTS_Seqlock_Write(&last_result, &cleared);
+    
+    DEBUG_INFO("AI engine reset\r\n");
+    return ROTS_OK;
+}
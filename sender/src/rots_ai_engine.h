@@ -1,37 +1,126 @@
-// ROTS AI Engine Header
-#ifndef ROTS_AI_ENGINE_H
-#define ROTS_AI_ENGINE_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include "rots_sender.h"
-
-// AI配置
-#define ROTS_AI_FEATURE_SIZE      15
-#define ROTS_AI_MODEL_SIZE        90  // 6 odors * 15 features
-#define ROTS_AI_MAX_CONFIDENCE    1.0f
-#define ROTS_AI_MIN_CONFIDENCE    0.0f
-
-// AI状态结构
-typedef struct {
-    bool initialized;
-    uint32_t last_inference_time;
-    ROTS_OdorType_t last_odor_type;
-    float last_confidence;
-    uint32_t inference_count;
-} ROTS_AIStatus_t;
-
-// 函数声明
-ROTS_StatusTypeDef ROTS_AIEngine_Init(void);
-ROTS_StatusTypeDef ROTS_AIEngine_ProcessOdor(ROTS_OdorResult_t* result);
-ROTS_StatusTypeDef ROTS_AIEngine_GetStatus(ROTS_AIStatus_t* status);
-ROTS_StatusTypeDef ROTS_AIEngine_UpdateModel(const float* new_weights, uint16_t size);
-ROTS_StatusTypeDef ROTS_AIEngine_Reset(void);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* ROTS_AI_ENGINE_H */
+// ROTS AI Engine Header
+#ifndef ROTS_AI_ENGINE_H
+#define ROTS_AI_ENGINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+#include "rots_ai_model.h"
+#include "rots_temporal_features.h"
+#include "rots_prototypes.h"
+
+// AI配置
+#define ROTS_AI_ODOR_CLASSES      6
+#define ROTS_AI_BASE_FEATURE_COUNT(ch) ((ch) + 3 + (ch) / 2)  // 通道值 + 环境3项 + 相邻通道比值
+#define ROTS_AI_FEATURE_COUNT(ch) (ROTS_AI_BASE_FEATURE_COUNT(ch) + (ch) * ROTS_TEMPORAL_FEATURES)  // + 每通道时序特征
+#define ROTS_AI_FEATURE_SIZE      ROTS_AI_FEATURE_COUNT(ROTS_MAX_CHANNELS)  // 特征数上限
+#define ROTS_AI_MODEL_SIZE        (ROTS_AI_ODOR_CLASSES * ROTS_AI_FEATURE_SIZE)  // 单层线性模型的权重数上限
+#ifndef ROTS_AI_USE_INT8
+#define ROTS_AI_USE_INT8          1      // int8量化推理 (0为浮点推理)
+#endif
+#define ROTS_AI_SHADOW_INTERVAL   16     // 每N次int8推理用浮点路径对照一次
+#define ROTS_AI_GATE_THRESHOLD    0.1f   // 门控: 通道相对基线的平均偏离低于此值判为洁净空气
+#define ROTS_AI_GATE_REFRESH      20     // 连续跳过N次后强制运行一次完整推理
+#define ROTS_AI_MAX_CONFIDENCE    1.0f
+#define ROTS_AI_MIN_CONFIDENCE    0.0f
+#define ROTS_AI_MAX_INTENSITY     100.0f // 强度上限 (%满量程)
+#define ROTS_AI_DEMO_INTENSITY_FULL_SCALE  1000.0f  // 演示回归头: 主响应通道该浓度 (ppm) 记为100%
+#define ROTS_AI_PROTO_FEATURE_COUNT(ch) ((ch) + (ch) / 2)  // 原型特征: 通道值 + 相邻通道比值 (不含环境量)
+#define ROTS_AI_LEARN_DEFAULT_MS  5000   // 现场学习默认时长
+#define ROTS_AI_LEARN_MIN_MS      2000
+#define ROTS_AI_LEARN_MAX_MS      30000
+#define ROTS_AI_LEARN_INTERVAL    100    // 学习期间的推理 (采样) 间隔 (ms)
+#ifndef ROTS_AI_CLASSIFIER_MODE
+#define ROTS_AI_CLASSIFIER_MODE   ROTS_AI_CLASSIFIER_HYBRID
+#endif
+
+// 分类方式
+typedef enum {
+    ROTS_AI_CLASSIFIER_MODEL = 0x00,      // 仅模型
+    ROTS_AI_CLASSIFIER_PROTOTYPE = 0x01,  // 仅现场学习的原型
+    ROTS_AI_CLASSIFIER_HYBRID = 0x02      // 模型判为未知时再查原型
+} ROTS_AIClassifierMode_t;
+
+// 现场学习命令
+typedef enum {
+    ROTS_AI_LEARN_CMD_NONE = 0x00,
+    ROTS_AI_LEARN_CMD_LEARN = 0x01,       // 学习 (同名时追加样本)
+    ROTS_AI_LEARN_CMD_FORGET = 0x02       // 删除
+} ROTS_AILearnCommand_t;
+
+// 现场学习状态 (推理任务发布, 通信任务读取)
+typedef struct {
+    uint32_t sequence;          // 每完成一条命令加1
+    uint32_t samples;           // 本次学习的样本数
+    char name[ROTS_PROTO_NAME_LENGTH];
+    uint8_t command;            // ROTS_AILearnCommand_t
+    uint8_t active;             // 学习进行中
+    uint8_t result;             // ROTS_StatusTypeDef
+    uint8_t slot;
+} ROTS_AILearnStatus_t;
+
+// AI状态结构
+typedef struct {
+    bool initialized;
+    uint32_t last_inference_time;
+    ROTS_OdorType_t last_odor_type;
+    float last_confidence;
+    uint32_t inference_count;   // ProcessOdor调用次数
+    uint32_t full_inferences;   // 通过门控, 运行完整模型的次数
+    uint32_t gate_skips;        // 门控判为洁净空气而跳过的次数
+    float gate_hit_rate;        // gate_skips / inference_count
+    uint32_t gate_cycles;       // 最近一次门控耗时
+    uint32_t full_cycles;       // 完整推理 (特征提取 + 打分) 平均耗时
+    uint64_t cycles_saved;      // 累计节省周期 (按完整推理平均耗时估算)
+    uint8_t channel_count;
+    uint8_t feature_count;      // 模型权重为 ROTS_AI_ODOR_CLASSES * feature_count
+    uint32_t channel_mask;      // 最近一次推理使用的通道 (故障通道被屏蔽)
+    bool int8_enabled;
+    uint32_t shadow_runs;       // int8与浮点路径对照次数
+    uint32_t shadow_mismatches; // 两条路径判定结果不同的次数
+    float shadow_max_error;     // 最大得分误差 (相对浮点最大得分绝对值)
+    uint32_t int8_cycles;       // 最近一次int8打分耗时
+    uint32_t float_cycles;      // 最近一次浮点打分耗时
+    uint32_t intensity_cycles;  // 最近一次强度回归耗时 (完整推理之外的额外开销)
+    bool intensity_demo;        // 强度回归头仍为演示参数
+    bool novelty_loaded;        // 已加载新颖度统计量
+    float novelty_threshold;
+    uint32_t novel_count;       // 判为新颖 (分布外) 的次数
+    uint32_t novelty_cycles;    // 最近一次新颖度打分耗时
+    uint8_t classifier_mode;    // ROTS_AIClassifierMode_t
+    uint8_t prototype_count;    // 现场学习的气味数
+    uint32_t prototype_matches;
+    uint32_t prototype_cycles;  // 最近一次原型查找耗时
+    bool learning;
+    uint8_t model_source;       // ROTS_AIModelSource_t
+    uint32_t model_id;          // 模型容器版本号 (浮点参数模型为0)
+    float model_temperature;    // 置信度校准温度
+    uint8_t model_layers;
+    uint32_t model_params;
+    uint32_t model_arena_bytes; // 激活区占用
+} ROTS_AIStatus_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_AIEngine_Init(void);
+ROTS_StatusTypeDef ROTS_AIEngine_ProcessOdor(ROTS_OdorResult_t* result);
+ROTS_StatusTypeDef ROTS_AIEngine_GetStatus(ROTS_AIStatus_t* status);
+ROTS_StatusTypeDef ROTS_AIEngine_GetLastResult(ROTS_OdorResult_t* result);
+ROTS_StatusTypeDef ROTS_AIEngine_UpdateModel(const float* new_weights, uint16_t size);
+ROTS_StatusTypeDef ROTS_AIEngine_LoadIntensityHead(const float* weights, const float* bias, uint16_t size);
+ROTS_StatusTypeDef ROTS_AIEngine_LoadNoveltyStats(const float* means, const float* inv_vars, uint16_t size, float threshold);
+ROTS_StatusTypeDef ROTS_AIEngine_LoadModel(const ROTS_AIModelDesc_t* desc, const float* params, uint32_t param_count);
+ROTS_StatusTypeDef ROTS_AIEngine_LoadModelBlob(const uint8_t* blob, uint32_t size);
+ROTS_StatusTypeDef ROTS_AIEngine_Reset(void);
+ROTS_StatusTypeDef ROTS_AIEngine_SetClassifierMode(ROTS_AIClassifierMode_t mode);
+ROTS_StatusTypeDef ROTS_AIEngine_RequestLearn(const char* name, uint32_t duration_ms);
+ROTS_StatusTypeDef ROTS_AIEngine_RequestForget(const char* name);
+ROTS_StatusTypeDef ROTS_AIEngine_GetLearnStatus(ROTS_AILearnStatus_t* status);
+bool ROTS_AIEngine_IsLearning(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_AI_ENGINE_H */
@@ -0,0 +1,373 @@
+// ROTS AI Model Runtime - 分层推理运行时
+//
+// 模型由层描述加一段浮点参数给出 (全连接/ReLU/Softmax), 加载时校验
+// 层间宽度, 复制参数, 为全连接层生成int8权重, 并在静态激活区中规划
+// 两块交替使用的激活缓冲和int8输入缓冲. 推理过程不分配任何内存.
+// 也可直接加载预量化的模型容器 (rots_model_blob.h), 权重/行和/偏置
+// 均指向容器本身, 不占用RAM.
+#include "rots_sender.h"
+#include "rots_ai_model.h"
+#include "rots_ai_quant.h"
+#include "rots_model_blob.h"
+
+// 单层运行时信息
+typedef struct {
+    ROTS_AILayerDesc_t desc;
+    uint16_t inputs;
+    uint16_t outputs;
+    const float* weights;     // 浮点权重, 容器模型为NULL (按int8反量化)
+    const float* bias;        // 无偏置时为NULL
+    ROTS_QuantDense_t quant;
+} ROTS_AILayer_t;
+
+// 2^(-k/64), k = 0..64, 用于查表求exp
+#define ROTS_AI_EXP_TABLE_BITS    6
+static const float exp2_table[(1 << ROTS_AI_EXP_TABLE_BITS) + 1] = {
+    1.000000000f, 0.989228013f, 0.978572062f, 0.968030897f, 0.957603281f, 0.947287991f,
+    0.937083817f, 0.926989563f, 0.917004043f, 0.907126088f, 0.897354538f, 0.887688246f,
+    0.878126080f, 0.868666918f, 0.859309649f, 0.850053177f, 0.840896415f, 0.831838290f,
+    0.822877739f, 0.814013711f, 0.805245166f, 0.796571076f, 0.787990423f, 0.779502200f,
+    0.771105413f, 0.762799075f, 0.754582214f, 0.746453864f, 0.738413073f, 0.730458897f,
+    0.722590403f, 0.714806669f, 0.707106781f, 0.699489836f, 0.691954941f, 0.684501211f,
+    0.677127773f, 0.669833762f, 0.662618322f, 0.655480606f, 0.648419777f, 0.641435008f,
+    0.634525479f, 0.627690379f, 0.620928906f, 0.614240268f, 0.607623680f, 0.601078366f,
+    0.594603558f, 0.588198496f, 0.581862429f, 0.575594615f, 0.569394317f, 0.563260809f,
+    0.557193371f, 0.551191292f, 0.545253866f, 0.539380399f, 0.533570200f, 0.527822589f,
+    0.522136891f, 0.516512440f, 0.510948574f, 0.505444643f, 0.500000000f
+};
+
+// 私有变量
+static ROTS_AILayer_t model_layers[ROTS_AI_MAX_LAYERS];
+static ROTS_AIModelInfo_t model_info;
+static float model_params[ROTS_AI_MAX_PARAMS];
+static int8_t model_quant[ROTS_AI_QUANT_STORAGE] ROTS_AI_QUANT_ALIGNED;
+static int32_t model_row_sums[ROTS_AI_MAX_LAYERS * ROTS_AI_MAX_WIDTH];
+static uint8_t model_arena[ROTS_AI_ARENA_SIZE] ROTS_AI_QUANT_ALIGNED;
+
+// 激活区布局 (加载时确定)
+static float* arena_act[2];
+static int8_t* arena_scratch;
+
+// 私有函数声明
+static uint32_t ROTS_AIModel_ArenaBytes(uint16_t max_width);
+static void ROTS_AIModel_Commit(const ROTS_AILayer_t* layers, uint8_t layer_count,
+                                uint16_t inputs, uint16_t outputs, uint16_t max_width);
+static void ROTS_AIModel_DenseFloat(const ROTS_AILayer_t* layer, const float* input, float* output);
+static const float* ROTS_AIModel_Forward(const float* input, uint8_t layer_count, bool use_int8);
+static float ROTS_AIModel_CheckTemperature(float temperature);
+
+// 加载模型 (校验失败时保留原模型)
+ROTS_StatusTypeDef ROTS_AIModel_Load(const ROTS_AIModelDesc_t* desc, const float* params, uint32_t param_count) {
+    if (!desc || !params || desc->inputs == 0 || desc->inputs > ROTS_AI_MAX_WIDTH ||
+        desc->layer_count == 0 || desc->layer_count > ROTS_AI_MAX_LAYERS ||
+        ROTS_AIModel_CheckTemperature(desc->temperature) == 0.0f) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    // 校验层间宽度, 统计参数与存储需求
+    ROTS_AILayer_t layers[ROTS_AI_MAX_LAYERS];
+    uint16_t width = desc->inputs;
+    uint16_t max_width = width;
+    uint32_t params_needed = 0;
+    uint32_t quant_needed = 0;
+    for (uint8_t l = 0; l < desc->layer_count; l++) {
+        ROTS_AILayer_t* layer = &layers[l];
+        memset(layer, 0, sizeof(ROTS_AILayer_t));
+        layer->desc = desc->layers[l];
+        layer->inputs = width;
+
+        switch (layer->desc.type) {
+            case ROTS_AI_LAYER_DENSE:
+                if (layer->desc.outputs == 0 || layer->desc.outputs > ROTS_AI_MAX_WIDTH) {
+                    return ROTS_INVALID_PARAM;
+                }
+                layer->outputs = layer->desc.outputs;
+                layer->weights = &model_params[params_needed];
+                params_needed += (uint32_t)layer->inputs * layer->outputs;
+                if (layer->desc.flags & ROTS_AI_LAYER_FLAG_BIAS) {
+                    layer->bias = &model_params[params_needed];
+                    params_needed += layer->outputs;
+                }
+                quant_needed += (uint32_t)ROTS_AI_QUANT_PADDED(layer->inputs) * layer->outputs;
+                break;
+
+            case ROTS_AI_LAYER_RELU:
+            case ROTS_AI_LAYER_SOFTMAX:
+                layer->outputs = width;
+                break;
+
+            default:
+                return ROTS_INVALID_PARAM;
+        }
+
+        width = layer->outputs;
+        if (width > max_width) max_width = width;
+    }
+
+    if (param_count != params_needed || params_needed > ROTS_AI_MAX_PARAMS ||
+        quant_needed > ROTS_AI_QUANT_STORAGE || ROTS_AIModel_ArenaBytes(max_width) > ROTS_AI_ARENA_SIZE) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    // 校验通过, 复制参数并量化
+    memcpy(model_params, params, params_needed * sizeof(float));
+
+    uint32_t quant_offset = 0;
+    uint32_t row_offset = 0;
+    for (uint8_t l = 0; l < desc->layer_count; l++) {
+        ROTS_AILayer_t* layer = &layers[l];
+        if (layer->desc.type != ROTS_AI_LAYER_DENSE) continue;
+
+        ROTS_AIQuant_PrepareDense(&layer->quant, layer->weights,
+                                  layer->outputs, layer->inputs,
+                                  &model_quant[quant_offset], &model_row_sums[row_offset]);
+        quant_offset += (uint32_t)layer->quant.stride * layer->outputs;
+        row_offset += layer->outputs;
+    }
+
+    ROTS_AIModel_Commit(layers, desc->layer_count, desc->inputs, width, max_width);
+    model_info.source = ROTS_AI_MODEL_SOURCE_PARAMS;
+    model_info.model_id = 0;
+    model_info.temperature = ROTS_AIModel_CheckTemperature(desc->temperature);
+    model_info.param_count = params_needed;
+    model_info.quant_bytes = quant_needed;
+    return ROTS_OK;
+}
+
+// 加载模型容器 (零拷贝, blob须在模型使用期间保持有效; 校验失败时保留原模型)
+ROTS_StatusTypeDef ROTS_AIModel_LoadBlob(const uint8_t* blob, uint32_t size) {
+    ROTS_StatusTypeDef status = ROTS_ModelBlob_Validate(blob, size);
+    if (status != ROTS_OK) {
+        return status;
+    }
+
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    ROTS_AILayer_t layers[ROTS_AI_MAX_LAYERS];
+    uint16_t max_width = header->inputs;
+    uint32_t param_count = 0;
+    uint32_t quant_bytes = 0;
+    for (uint8_t l = 0; l < header->layer_count; l++) {
+        const ROTS_ModelBlobLayer_t* entry = ROTS_ModelBlob_GetLayer(blob, l);
+        ROTS_AILayer_t* layer = &layers[l];
+        memset(layer, 0, sizeof(ROTS_AILayer_t));
+        layer->desc.type = entry->type;
+        layer->desc.flags = entry->flags;
+        layer->desc.outputs = entry->outputs;
+        layer->inputs = entry->inputs;
+        layer->outputs = entry->outputs;
+
+        if (entry->type == ROTS_AI_LAYER_DENSE) {
+            layer->quant.weights = (const int8_t*)(blob + entry->weight_offset);
+            layer->quant.row_sums = (const int32_t*)(blob + entry->row_sum_offset);
+            layer->quant.inputs = entry->inputs;
+            layer->quant.stride = entry->stride;
+            layer->quant.outputs = entry->outputs;
+            layer->quant.weight_params.scale = entry->weight_scale;
+            layer->quant.weight_params.zero_point = entry->weight_zero_point;
+            param_count += (uint32_t)entry->inputs * entry->outputs;
+            quant_bytes += (uint32_t)entry->stride * entry->outputs;
+            if (entry->flags & ROTS_AI_LAYER_FLAG_BIAS) {
+                layer->bias = (const float*)(blob + entry->bias_offset);
+                param_count += entry->outputs;
+            }
+        }
+
+        if (layer->outputs > max_width) max_width = layer->outputs;
+    }
+
+    if (ROTS_AIModel_ArenaBytes(max_width) > ROTS_AI_ARENA_SIZE) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    ROTS_AIModel_Commit(layers, header->layer_count, header->inputs, header->outputs, max_width);
+    model_info.source = ROTS_AI_MODEL_SOURCE_BLOB;
+    model_info.model_id = header->model_id;
+    model_info.temperature = ROTS_AIModel_CheckTemperature(header->temperature);
+    model_info.param_count = param_count;
+    model_info.quant_bytes = quant_bytes;
+    return ROTS_OK;
+}
+
+// 执行一次推理 (output长度为模型输出宽度)
+ROTS_StatusTypeDef ROTS_AIModel_Run(const float* input, float* output, bool use_int8) {
+    if (!model_info.loaded || !input || !output) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    const float* result = ROTS_AIModel_Forward(input, model_info.layer_count, use_int8);
+    memcpy(output, result, model_info.outputs * sizeof(float));
+    return ROTS_OK;
+}
+
+// 执行一次推理, 跳过末尾的Softmax层, 输出未归一化的得分 (用于置信度校准)
+ROTS_StatusTypeDef ROTS_AIModel_RunLogits(const float* input, float* output, bool use_int8) {
+    if (!model_info.loaded || !input || !output) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    uint8_t layer_count = model_info.layer_count - (model_info.softmax_output ? 1 : 0);
+    const float* result = ROTS_AIModel_Forward(input, layer_count, use_int8);
+    memcpy(output, result, model_info.outputs * sizeof(float));
+    return ROTS_OK;
+}
+
+// 数值稳定的Softmax: 先减最大值, 再按温度缩放后查表求exp (logits与probs可为同一数组)
+void ROTS_AIModel_Softmax(const float* logits, float* probs, uint16_t count, float temperature) {
+    float max = logits[0];
+    for (uint16_t i = 1; i < count; i++) {
+        if (logits[i] > max) max = logits[i];
+    }
+
+    float checked = ROTS_AIModel_CheckTemperature(temperature);
+    float scale = checked > 0.0f ? 1.0f / checked : 1.0f;
+    float sum = 0.0f;
+    for (uint16_t i = 0; i < count; i++) {
+        probs[i] = ROTS_AIModel_FastExp((logits[i] - max) * scale);
+        sum += probs[i];
+    }
+
+    // 最大项为1, sum >= 1
+    float inverse = 1.0f / sum;
+    for (uint16_t i = 0; i < count; i++) {
+        probs[i] *= inverse;
+    }
+}
+
+// exp(x), x <= 0: 按2的幂拆分, 整数部分直接构造指数位, 小数部分查64项表线性插值
+// 相对误差约2e-5, 无需libm
+float ROTS_AIModel_FastExp(float x) {
+    if (!(x < 0.0f)) {
+        return 1.0f;
+    }
+
+    // t = -x / ln2, 以1/64倍频程为单位
+    float t = -x * (1.4426950409f * (1 << ROTS_AI_EXP_TABLE_BITS));
+    if (t >= 126.0f * (1 << ROTS_AI_EXP_TABLE_BITS)) {
+        return 0.0f;
+    }
+
+    uint32_t steps = (uint32_t)t;
+    float fraction = t - (float)steps;
+    uint32_t index = steps & ((1 << ROTS_AI_EXP_TABLE_BITS) - 1);
+    float mantissa = exp2_table[index] + (exp2_table[index + 1] - exp2_table[index]) * fraction;
+
+    // 2^(-octave)
+    uint32_t bits = (127 - (steps >> ROTS_AI_EXP_TABLE_BITS)) << 23;
+    float octave;
+    memcpy(&octave, &bits, sizeof(octave));
+    return mantissa * octave;
+}
+
+// 获取模型信息
+ROTS_StatusTypeDef ROTS_AIModel_GetInfo(ROTS_AIModelInfo_t* info) {
+    if (!info) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(info, &model_info, sizeof(ROTS_AIModelInfo_t));
+    return ROTS_OK;
+}
+
+// 激活区: 两块交替的浮点缓冲 (按16字节对齐) + int8输入缓冲
+static uint32_t ROTS_AIModel_ArenaBytes(uint16_t max_width) {
+    return 2 * ROTS_AI_QUANT_PADDED(max_width * sizeof(float)) + ROTS_AI_QUANT_PADDED(max_width);
+}
+
+// 提交层表并规划激活区 (调用前须完成全部校验)
+static void ROTS_AIModel_Commit(const ROTS_AILayer_t* layers, uint8_t layer_count,
+                                uint16_t inputs, uint16_t outputs, uint16_t max_width) {
+    uint32_t act_floats = ROTS_AI_QUANT_PADDED(max_width * sizeof(float)) / sizeof(float);
+
+    memcpy(model_layers, layers, sizeof(ROTS_AILayer_t) * layer_count);
+
+    arena_act[0] = (float*)model_arena;
+    arena_act[1] = (float*)model_arena + act_floats;
+    arena_scratch = (int8_t*)(model_arena + 2 * act_floats * sizeof(float));
+
+    model_info.loaded = true;
+    model_info.inputs = inputs;
+    model_info.outputs = outputs;
+    model_info.layer_count = layer_count;
+    model_info.softmax_output = layers[layer_count - 1].desc.type == ROTS_AI_LAYER_SOFTMAX;
+    model_info.arena_used = ROTS_AIModel_ArenaBytes(max_width);
+}
+
+// 浮点全连接 (参考实现; 容器模型无浮点权重, 按int8权重反量化计算)
+static void ROTS_AIModel_DenseFloat(const ROTS_AILayer_t* layer, const float* input, float* output) {
+    if (layer->weights) {
+        for (uint16_t o = 0; o < layer->outputs; o++) {
+            const float* row = &layer->weights[(uint32_t)o * layer->inputs];
+            float sum = 0.0f;
+            for (uint16_t i = 0; i < layer->inputs; i++) {
+                sum += row[i] * input[i];
+            }
+            output[o] = sum;
+        }
+        return;
+    }
+
+    const ROTS_QuantParams_t* params = &layer->quant.weight_params;
+    for (uint16_t o = 0; o < layer->outputs; o++) {
+        const int8_t* row = &layer->quant.weights[(uint32_t)o * layer->quant.stride];
+        float sum = 0.0f;
+        for (uint16_t i = 0; i < layer->inputs; i++) {
+            sum += (float)(row[i] - params->zero_point) * input[i];
+        }
+        output[o] = sum * params->scale;
+    }
+}
+
+// 依次执行前layer_count层, 返回结果所在的激活缓冲
+static const float* ROTS_AIModel_Forward(const float* input, uint8_t layer_count, bool use_int8) {
+    uint8_t current = 0;
+    memcpy(arena_act[current], input, model_info.inputs * sizeof(float));
+
+    for (uint8_t l = 0; l < layer_count; l++) {
+        const ROTS_AILayer_t* layer = &model_layers[l];
+        float* in = arena_act[current];
+
+        switch (layer->desc.type) {
+            case ROTS_AI_LAYER_DENSE: {
+                float* out = arena_act[current ^ 1];
+                if (use_int8) {
+                    ROTS_AIQuant_RunDense(&layer->quant, in, arena_scratch, out);
+                } else {
+                    ROTS_AIModel_DenseFloat(layer, in, out);
+                }
+                if (layer->bias) {
+                    for (uint16_t o = 0; o < layer->outputs; o++) {
+                        out[o] += layer->bias[o];
+                    }
+                }
+                current ^= 1;
+                break;
+            }
+
+            case ROTS_AI_LAYER_RELU:
+                for (uint16_t i = 0; i < layer->outputs; i++) {
+                    if (in[i] < 0.0f) in[i] = 0.0f;
+                }
+                break;
+
+            case ROTS_AI_LAYER_SOFTMAX:
+                ROTS_AIModel_Softmax(in, in, layer->outputs, 1.0f);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return arena_act[current];
+}
+
+// 校准温度: 0为未校准 (按1处理), 超出范围或非数值返回0
+static float ROTS_AIModel_CheckTemperature(float temperature) {
+    if (temperature == 0.0f) {
+        return 1.0f;
+    }
+    if (temperature >= ROTS_AI_MIN_TEMPERATURE && temperature <= ROTS_AI_MAX_TEMPERATURE) {
+        return temperature;
+    }
+    return 0.0f;
+}
@@ -0,0 +1,82 @@
+// ROTS AI Model Runtime Header
+#ifndef ROTS_AI_MODEL_H
+#define ROTS_AI_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 运行时容量 (全部静态分配)
+#define ROTS_AI_MAX_LAYERS        8
+#define ROTS_AI_MAX_WIDTH         256     // 单层最大输入/输出宽度
+#define ROTS_AI_MAX_PARAMS        4096    // 浮点参数总数 (权重 + 偏置)
+#define ROTS_AI_QUANT_STORAGE     6144    // int8权重存储 (含每行补齐)
+#define ROTS_AI_ARENA_SIZE        (2 * ROTS_AI_MAX_WIDTH * sizeof(float) + ROTS_AI_MAX_WIDTH)
+
+// 置信度校准温度范围 (0表示未校准, 按1处理)
+#define ROTS_AI_MIN_TEMPERATURE   0.05f
+#define ROTS_AI_MAX_TEMPERATURE   20.0f
+
+// 层类型
+typedef enum {
+    ROTS_AI_LAYER_DENSE = 0x01,
+    ROTS_AI_LAYER_RELU = 0x02,
+    ROTS_AI_LAYER_SOFTMAX = 0x03
+} ROTS_AILayerType_t;
+
+// 层标志
+#define ROTS_AI_LAYER_FLAG_BIAS   0x01    // 全连接层带偏置
+
+// 层描述 (输入宽度取上一层输出)
+typedef struct {
+    uint8_t type;             // ROTS_AILayerType_t
+    uint8_t flags;
+    uint16_t outputs;         // 全连接层输出宽度, 其余层忽略
+} ROTS_AILayerDesc_t;
+
+// 模型描述; 参数按层顺序排列: 全连接层为 [outputs][inputs] 权重, 其后为偏置
+typedef struct {
+    uint16_t inputs;
+    uint8_t layer_count;
+    ROTS_AILayerDesc_t layers[ROTS_AI_MAX_LAYERS];
+    float temperature;        // 置信度校准温度: 概率 = softmax(logits / T)
+} ROTS_AIModelDesc_t;
+
+// 模型来源
+typedef enum {
+    ROTS_AI_MODEL_SOURCE_NONE = 0x00,
+    ROTS_AI_MODEL_SOURCE_PARAMS = 0x01,   // 浮点参数, 加载时复制并量化到RAM
+    ROTS_AI_MODEL_SOURCE_BLOB = 0x02      // 预量化容器, 直接引用 (零拷贝)
+} ROTS_AIModelSource_t;
+
+// 模型信息
+typedef struct {
+    bool loaded;
+    uint8_t source;           // ROTS_AIModelSource_t
+    uint32_t model_id;        // 容器中的模型版本号, 浮点参数模型为0
+    uint16_t inputs;
+    uint16_t outputs;
+    uint8_t layer_count;
+    uint32_t param_count;
+    uint32_t quant_bytes;     // int8权重占用 (容器模型位于Flash)
+    uint32_t arena_used;      // 激活区占用 (字节)
+    float temperature;        // 置信度校准温度 (未校准为1)
+    bool softmax_output;      // 最后一层为Softmax
+} ROTS_AIModelInfo_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_AIModel_Load(const ROTS_AIModelDesc_t* desc, const float* params, uint32_t param_count);
+ROTS_StatusTypeDef ROTS_AIModel_LoadBlob(const uint8_t* blob, uint32_t size);
+ROTS_StatusTypeDef ROTS_AIModel_Run(const float* input, float* output, bool use_int8);
+ROTS_StatusTypeDef ROTS_AIModel_RunLogits(const float* input, float* output, bool use_int8);
+void ROTS_AIModel_Softmax(const float* logits, float* probs, uint16_t count, float temperature);
+float ROTS_AIModel_FastExp(float x);
+ROTS_StatusTypeDef ROTS_AIModel_GetInfo(ROTS_AIModelInfo_t* info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_AI_MODEL_H */
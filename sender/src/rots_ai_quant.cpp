@@ -0,0 +1,122 @@
+// ROTS AI Quantization - int8推理内核
+//
+// 权重按张量对称量化为int8, 输入每次推理按实际范围做非对称量化,
+// 点积在int32中累加, 最后一次性乘回两侧的scale:
+//   out = sx * sw * (sum(qx * qw) - zx * sum(qw))
+// 向量按16字节对齐并补零, 内循环按16元素分块, 便于替换为S3向量指令.
+#include "rots_sender.h"
+#include "rots_ai_quant.h"
+
+// 私有函数声明
+static int8_t ROTS_AIQuant_Clamp(int32_t value);
+
+// 由数据范围确定量化参数 (范围总是包含0, 使0可精确表示)
+void ROTS_AIQuant_ChooseParams(const float* values, uint32_t count, bool symmetric, ROTS_QuantParams_t* params) {
+    float min = 0.0f;
+    float max = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        if (values[i] < min) min = values[i];
+        if (values[i] > max) max = values[i];
+    }
+
+    if (symmetric) {
+        float bound = max > -min ? max : -min;
+        params->scale = bound > 0.0f ? bound / 127.0f : 1.0f;
+        params->zero_point = 0;
+        return;
+    }
+
+    if (max - min <= 0.0f) {
+        params->scale = 1.0f;
+        params->zero_point = 0;
+        return;
+    }
+
+    params->scale = (max - min) / 255.0f;
+    int32_t zero_point = (int32_t)lroundf(-128.0f - min / params->scale);
+    if (zero_point < -128) zero_point = -128;
+    if (zero_point > 127) zero_point = 127;
+    params->zero_point = zero_point;
+}
+
+// 量化 (饱和到int8)
+void ROTS_AIQuant_Quantize(const float* values, uint16_t count, const ROTS_QuantParams_t* params, int8_t* out) {
+    const float inv_scale = 1.0f / params->scale;
+    for (uint16_t i = 0; i < count; i++) {
+        out[i] = ROTS_AIQuant_Clamp((int32_t)lroundf(values[i] * inv_scale) + params->zero_point);
+    }
+}
+
+// int8点积, int32累加 (length须为16的倍数, 补零部分不影响结果)
+int32_t ROTS_AIQuant_DotInt8(const int8_t* a, const int8_t* b, uint16_t length) {
+    int32_t acc0 = 0;
+    int32_t acc1 = 0;
+    int32_t acc2 = 0;
+    int32_t acc3 = 0;
+
+    // 4路独立累加, 减少依赖链; 每轮16元素对应一次128位向量乘加
+    for (uint16_t i = 0; i < length; i += ROTS_AI_QUANT_ALIGN) {
+        const int8_t* pa = a + i;
+        const int8_t* pb = b + i;
+        acc0 += pa[0] * pb[0] + pa[4] * pb[4] + pa[8] * pb[8] + pa[12] * pb[12];
+        acc1 += pa[1] * pb[1] + pa[5] * pb[5] + pa[9] * pb[9] + pa[13] * pb[13];
+        acc2 += pa[2] * pb[2] + pa[6] * pb[6] + pa[10] * pb[10] + pa[14] * pb[14];
+        acc3 += pa[3] * pb[3] + pa[7] * pb[7] + pa[11] * pb[11] + pa[15] * pb[15];
+    }
+
+    return acc0 + acc1 + acc2 + acc3;
+}
+
+// 量化全连接层权重 ([outputs][inputs]行优先浮点权重)
+ROTS_StatusTypeDef ROTS_AIQuant_PrepareDense(ROTS_QuantDense_t* layer, const float* weights,
+                                             uint16_t outputs, uint16_t inputs,
+                                             int8_t* weight_storage, int32_t* row_sum_storage) {
+    if (!layer || !weights || !weight_storage || !row_sum_storage || outputs == 0 || inputs == 0) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    layer->weights = weight_storage;
+    layer->row_sums = row_sum_storage;
+    layer->inputs = inputs;
+    layer->stride = ROTS_AI_QUANT_PADDED(inputs);
+    layer->outputs = outputs;
+
+    ROTS_AIQuant_ChooseParams(weights, (uint32_t)outputs * inputs, true, &layer->weight_params);
+
+    memset(weight_storage, 0, (size_t)outputs * layer->stride);
+    for (uint16_t o = 0; o < outputs; o++) {
+        int8_t* row = &weight_storage[o * layer->stride];
+        ROTS_AIQuant_Quantize(&weights[o * inputs], inputs, &layer->weight_params, row);
+
+        int32_t sum = 0;
+        for (uint16_t i = 0; i < inputs; i++) {
+            sum += row[i];
+        }
+        row_sum_storage[o] = sum;
+    }
+
+    return ROTS_OK;
+}
+
+// 执行全连接层 (input_scratch须为stride长度的对齐缓冲)
+void ROTS_AIQuant_RunDense(const ROTS_QuantDense_t* layer, const float* input, int8_t* input_scratch, float* output) {
+    ROTS_QuantParams_t input_params;
+    ROTS_AIQuant_ChooseParams(input, layer->inputs, false, &input_params);
+
+    ROTS_AIQuant_Quantize(input, layer->inputs, &input_params, input_scratch);
+    memset(&input_scratch[layer->inputs], 0, layer->stride - layer->inputs);
+
+    const float scale = input_params.scale * layer->weight_params.scale;
+    for (uint16_t o = 0; o < layer->outputs; o++) {
+        int32_t acc = ROTS_AIQuant_DotInt8(input_scratch, &layer->weights[o * layer->stride], layer->stride);
+        acc -= input_params.zero_point * layer->row_sums[o];
+        output[o] = (float)acc * scale;
+    }
+}
+
+// 饱和到int8
+static int8_t ROTS_AIQuant_Clamp(int32_t value) {
+    if (value < -128) return -128;
+    if (value > 127) return 127;
+    return (int8_t)value;
+}
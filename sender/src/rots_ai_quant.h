@@ -0,0 +1,45 @@
+// ROTS AI Quantization Header
+#ifndef ROTS_AI_QUANT_H
+#define ROTS_AI_QUANT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// int8向量按16字节对齐并补零到16的整数倍 (对应ESP32-S3 PIE的128位向量宽度)
+#define ROTS_AI_QUANT_ALIGN        16
+#define ROTS_AI_QUANT_PADDED(n)    (((n) + ROTS_AI_QUANT_ALIGN - 1) & ~(ROTS_AI_QUANT_ALIGN - 1))
+#define ROTS_AI_QUANT_ALIGNED      __attribute__((aligned(ROTS_AI_QUANT_ALIGN)))
+
+// 每张量量化参数: real = scale * (q - zero_point)
+typedef struct {
+    float scale;
+    int32_t zero_point;
+} ROTS_QuantParams_t;
+
+// int8全连接层 (权重对称量化, zero_point为0)
+typedef struct {
+    const int8_t* weights;      // [outputs][stride], 调用方提供对齐存储 (RAM或映射的Flash)
+    const int32_t* row_sums;    // 每行权重和, 用于扣除输入零点
+    uint16_t inputs;
+    uint16_t stride;            // ROTS_AI_QUANT_PADDED(inputs)
+    uint16_t outputs;
+    ROTS_QuantParams_t weight_params;
+} ROTS_QuantDense_t;
+
+// 函数声明
+void ROTS_AIQuant_ChooseParams(const float* values, uint32_t count, bool symmetric, ROTS_QuantParams_t* params);
+void ROTS_AIQuant_Quantize(const float* values, uint16_t count, const ROTS_QuantParams_t* params, int8_t* out);
+int32_t ROTS_AIQuant_DotInt8(const int8_t* a, const int8_t* b, uint16_t length);
+ROTS_StatusTypeDef ROTS_AIQuant_PrepareDense(ROTS_QuantDense_t* layer, const float* weights,
+                                             uint16_t outputs, uint16_t inputs,
+                                             int8_t* weight_storage, int32_t* row_sum_storage);
+void ROTS_AIQuant_RunDense(const ROTS_QuantDense_t* layer, const float* input, int8_t* input_scratch, float* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_AI_QUANT_H */
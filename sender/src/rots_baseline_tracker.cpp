@@ -0,0 +1,295 @@
+// ROTS Baseline Tracker - MQ传感器基线漂移跟踪模块
+//
+// 在安静期 (AI引擎未检测到气味) 以1秒块均值驱动的慢速EMA跟踪各通道
+// 清洁空气基线 (ADC码值), 块内不稳定的通道本块不更新. 基线变化超过阈值时
+// 通知传感器管理器更新校准系数, 并定期持久化以便重启后直接使用.
+// 跟踪在采集任务中进行, NVS写入可能阻塞数十毫秒: 采集任务只生成待保存的
+// 快照, 由通信任务调用ROTS_BaselineTracker_Persist写入.
+#include <atomic>
+
+#include "rots_sender.h"
+#include "rots_baseline_tracker.h"
+
+#ifdef ARDUINO
+#include <Preferences.h>
+#include "rots_debug.h"
+#endif
+
+#define ROTS_BASELINE_STORE_MAGIC    0x524F4253UL  // "ROBS"
+#define ROTS_BASELINE_STORE_VERSION  2
+
+// 持久化记录
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    float baseline[ROTS_MAX_CHANNELS];
+} ROTS_BaselineRecord_t;
+
+// 私有变量
+static float baseline[ROTS_MAX_CHANNELS];          // 当前估计
+static float applied_baseline[ROTS_MAX_CHANNELS];  // 最近一次生效的基线
+static float restored_baseline[ROTS_MAX_CHANNELS];
+static uint8_t baseline_channels = 0;
+static bool baseline_seeded = false;
+static bool baseline_dirty = false;
+static ROTS_BaselineStats_t baseline_stats;
+
+static uint32_t block_start = 0;
+static uint16_t block_count = 0;
+static uint32_t block_sum[ROTS_MAX_CHANNELS];
+static uint16_t block_min[ROTS_MAX_CHANNELS];
+static uint16_t block_max[ROTS_MAX_CHANNELS];
+
+// 待保存的快照: 采集任务在标志为false时填写后置位, 通信任务写入NVS后清除
+static ROTS_BaselineRecord_t persist_record;
+static std::atomic<bool> persist_pending(false);
+static uint32_t persist_failures = 0;
+
+// 由推理任务写入, 采集任务读取 (跨核, 先写时间再写标志)
+static volatile bool odor_present = false;
+static volatile uint32_t last_odor_time = 0;
+
+#ifndef ARDUINO
+// 主机构建: 进程内模拟持久化存储
+static ROTS_BaselineRecord_t host_store;
+#endif
+
+// 私有函数声明
+static void ROTS_BaselineTracker_ResetBlock(uint32_t now_ms);
+static bool ROTS_BaselineTracker_Load(ROTS_BaselineRecord_t* record);
+static bool ROTS_BaselineTracker_Save(const ROTS_BaselineRecord_t* record);
+
+// 初始化基线跟踪 (读取已保存的基线, 通道数不一致时忽略)
+ROTS_StatusTypeDef ROTS_BaselineTracker_Init(uint8_t channel_count) {
+    if (channel_count == 0 || channel_count > ROTS_MAX_CHANNELS) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memset(&baseline_stats, 0, sizeof(ROTS_BaselineStats_t));
+    baseline_channels = channel_count;
+    baseline_seeded = false;
+    baseline_dirty = false;
+    persist_pending.store(false, std::memory_order_release);
+    persist_failures = 0;
+    odor_present = false;
+    last_odor_time = 0;
+
+    ROTS_BaselineRecord_t record;
+    if (ROTS_BaselineTracker_Load(&record) &&
+        record.magic == ROTS_BASELINE_STORE_MAGIC &&
+        record.version == ROTS_BASELINE_STORE_VERSION &&
+        record.count == channel_count) {
+        bool valid = true;
+        for (int ch = 0; ch < channel_count; ch++) {
+            if (!(record.baseline[ch] >= 1.0f && record.baseline[ch] <= 4095.0f)) {
+                valid = false;
+            }
+        }
+        if (valid) {
+            memcpy(restored_baseline, record.baseline, sizeof(restored_baseline));
+            baseline_stats.restored = true;
+        }
+    }
+
+    return ROTS_OK;
+}
+
+// 获取启动时恢复的基线
+bool ROTS_BaselineTracker_GetRestored(float baselines[ROTS_MAX_CHANNELS]) {
+    if (!baseline_stats.restored || !baselines) {
+        return false;
+    }
+
+    memcpy(baselines, restored_baseline, sizeof(restored_baseline));
+    return true;
+}
+
+// 以一次完整校准 (或恢复值) 作为跟踪起点
+void ROTS_BaselineTracker_Seed(const float baselines[ROTS_MAX_CHANNELS], uint32_t now_ms) {
+    memcpy(baseline, baselines, sizeof(baseline));
+    memcpy(applied_baseline, baselines, sizeof(applied_baseline));
+    baseline_seeded = true;
+    baseline_dirty = true;
+    ROTS_BaselineTracker_ResetBlock(now_ms);
+}
+
+// AI引擎检测结果门控
+void ROTS_BaselineTracker_SetOdorPresent(bool present, uint32_t now_ms) {
+    if (present) {
+        last_odor_time = now_ms;
+    }
+    odor_present = present;
+}
+
+// 输入一帧原始码值, 返回基线变化超过阈值的通道掩码
+uint32_t ROTS_BaselineTracker_Update(const uint16_t raw[ROTS_MAX_CHANNELS], uint32_t now_ms) {
+    if (!baseline_seeded || !raw) {
+        return 0;
+    }
+
+    // 有气味或刚结束不久时丢弃当前块
+    bool quiet = !odor_present && (now_ms - last_odor_time >= ROTS_BASELINE_QUIET_HOLD_MS);
+    if (!quiet) {
+        if (block_count > 0) {
+            baseline_stats.blocks_rejected++;
+        }
+        ROTS_BaselineTracker_ResetBlock(now_ms);
+        return 0;
+    }
+
+    for (int ch = 0; ch < baseline_channels; ch++) {
+        block_sum[ch] += raw[ch];
+        if (raw[ch] < block_min[ch]) block_min[ch] = raw[ch];
+        if (raw[ch] > block_max[ch]) block_max[ch] = raw[ch];
+    }
+    block_count++;
+
+    if (now_ms - block_start < ROTS_BASELINE_BLOCK_MS) {
+        return 0;
+    }
+
+    // 逐通道判断: 块内波动过大的通道信号不平稳, 本块不用于更新其基线,
+    // 不影响其余通道 (一路噪声大的传感器不会让所有通道停止跟踪)
+    const float alpha = (float)ROTS_BASELINE_BLOCK_MS / (ROTS_BASELINE_TIME_CONSTANT_S * 1000.0f);
+    uint32_t changed_mask = 0;
+    uint8_t stable_channels = 0;
+    for (int ch = 0; ch < baseline_channels; ch++) {
+        if (block_max[ch] - block_min[ch] > ROTS_BASELINE_STABLE_RANGE) {
+            baseline_stats.channels_unstable++;
+            continue;
+        }
+        stable_channels++;
+
+        float block_mean = (float)block_sum[ch] / block_count;
+        baseline[ch] += alpha * (block_mean - baseline[ch]);
+
+        if (fabsf(baseline[ch] - applied_baseline[ch]) > ROTS_BASELINE_APPLY_THRESHOLD * applied_baseline[ch]) {
+            applied_baseline[ch] = baseline[ch];
+            changed_mask |= 1UL << ch;
+        }
+    }
+
+    if (stable_channels > 0) {
+        baseline_stats.blocks_accepted++;
+        baseline_dirty = true;
+        if (changed_mask != 0) {
+            baseline_stats.updates_applied++;
+        }
+    } else {
+        baseline_stats.blocks_rejected++;
+    }
+
+    ROTS_BaselineTracker_ResetBlock(now_ms);
+
+    if (baseline_dirty && now_ms - baseline_stats.last_persist_time >= ROTS_BASELINE_PERSIST_INTERVAL_MS) {
+        ROTS_BaselineTracker_RequestPersist(now_ms);
+    }
+
+    return changed_mask;
+}
+
+// 获取当前基线估计
+void ROTS_BaselineTracker_GetBaselines(float baselines[ROTS_MAX_CHANNELS]) {
+    if (!baselines) return;
+    memcpy(baselines, baseline, sizeof(baseline));
+}
+
+// 生成待保存的基线快照 (采集任务调用, 不访问NVS), 上一份快照尚未写入时返回ROTS_BUSY
+ROTS_StatusTypeDef ROTS_BaselineTracker_RequestPersist(uint32_t now_ms) {
+    if (!baseline_seeded) {
+        return ROTS_ERROR;
+    }
+    if (persist_pending.load(std::memory_order_acquire)) {
+        return ROTS_BUSY;
+    }
+
+    persist_record.magic = ROTS_BASELINE_STORE_MAGIC;
+    persist_record.version = ROTS_BASELINE_STORE_VERSION;
+    persist_record.count = baseline_channels;
+    memcpy(persist_record.baseline, baseline, sizeof(persist_record.baseline));
+    persist_pending.store(true, std::memory_order_release);
+
+    baseline_stats.last_persist_time = now_ms;
+    baseline_dirty = false;
+    return ROTS_OK;
+}
+
+// 把待保存的快照写入NVS (通信任务或空闲时调用), 没有待保存的快照时返回ROTS_BUSY
+ROTS_StatusTypeDef ROTS_BaselineTracker_Persist(void) {
+    if (!persist_pending.load(std::memory_order_acquire)) {
+        return ROTS_BUSY;
+    }
+
+    // 写入失败时放弃本份快照, 下一个持久化间隔重新生成
+    bool saved = ROTS_BaselineTracker_Save(&persist_record);
+    if (!saved) {
+        persist_failures++;
+    }
+    persist_pending.store(false, std::memory_order_release);
+    return saved ? ROTS_OK : ROTS_ERROR;
+}
+
+// 获取统计
+ROTS_StatusTypeDef ROTS_BaselineTracker_GetStats(ROTS_BaselineStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &baseline_stats, sizeof(ROTS_BaselineStats_t));
+    stats->persist_pending = persist_pending.load(std::memory_order_acquire);
+    stats->persist_failures = persist_failures;
+    return ROTS_OK;
+}
+
+// 开始新的统计块
+static void ROTS_BaselineTracker_ResetBlock(uint32_t now_ms) {
+    block_start = now_ms;
+    block_count = 0;
+    for (int ch = 0; ch < ROTS_MAX_CHANNELS; ch++) {
+        block_sum[ch] = 0;
+        block_min[ch] = 0xFFFF;
+        block_max[ch] = 0;
+    }
+}
+
+#ifdef ARDUINO
+// 从NVS读取
+static bool ROTS_BaselineTracker_Load(ROTS_BaselineRecord_t* record) {
+    Preferences prefs;
+    if (!prefs.begin("rots_baseline", true)) {
+        return false;
+    }
+
+    size_t length = prefs.getBytes("record", record, sizeof(ROTS_BaselineRecord_t));
+    prefs.end();
+    return length == sizeof(ROTS_BaselineRecord_t);
+}
+
+// 写入NVS
+static bool ROTS_BaselineTracker_Save(const ROTS_BaselineRecord_t* record) {
+    Preferences prefs;
+    if (!prefs.begin("rots_baseline", false)) {
+        return false;
+    }
+
+    size_t length = prefs.putBytes("record", record, sizeof(ROTS_BaselineRecord_t));
+    prefs.end();
+
+    if (length != sizeof(ROTS_BaselineRecord_t)) {
+        DEBUG_WARNING("Baseline persist failed\r\n");
+        return false;
+    }
+    return true;
+}
+#else
+static bool ROTS_BaselineTracker_Load(ROTS_BaselineRecord_t* record) {
+    memcpy(record, &host_store, sizeof(ROTS_BaselineRecord_t));
+    return host_store.magic == ROTS_BASELINE_STORE_MAGIC;
+}
+
+static bool ROTS_BaselineTracker_Save(const ROTS_BaselineRecord_t* record) {
+    memcpy(&host_store, record, sizeof(ROTS_BaselineRecord_t));
+    return true;
+}
+#endif
@@ -0,0 +1,46 @@
+// ROTS Baseline Tracker Header
+#ifndef ROTS_BASELINE_TRACKER_H
+#define ROTS_BASELINE_TRACKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 基线跟踪配置
+#define ROTS_BASELINE_BLOCK_MS             1000      // 块均值时长
+#define ROTS_BASELINE_TIME_CONSTANT_S      3600      // EMA时间常数
+#define ROTS_BASELINE_STABLE_RANGE         24        // 块内允许的最大波动 (ADC码)
+#define ROTS_BASELINE_QUIET_HOLD_MS        30000     // 最后一次检测到气味后需保持安静的时间
+#define ROTS_BASELINE_APPLY_THRESHOLD      0.005f    // 相对变化超过0.5%时才更新校准
+#define ROTS_BASELINE_PERSIST_INTERVAL_MS  1800000   // 持久化最小间隔 (限制Flash擦写)
+
+// 基线跟踪统计
+typedef struct {
+    bool restored;              // 启动时是否恢复了已保存的基线
+    uint32_t blocks_accepted;
+    uint32_t blocks_rejected;   // 因有气味或全部通道不稳定被丢弃的块
+    uint32_t channels_unstable; // 因块内波动过大未更新的通道次数
+    uint32_t updates_applied;
+    uint32_t last_persist_time; // 最近一次生成待保存快照的时间
+    bool persist_pending;       // 快照等待通信任务写入
+    uint32_t persist_failures;
+} ROTS_BaselineStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_BaselineTracker_Init(uint8_t channel_count);
+bool ROTS_BaselineTracker_GetRestored(float baselines[ROTS_MAX_CHANNELS]);
+void ROTS_BaselineTracker_Seed(const float baselines[ROTS_MAX_CHANNELS], uint32_t now_ms);
+void ROTS_BaselineTracker_SetOdorPresent(bool present, uint32_t now_ms);
+uint32_t ROTS_BaselineTracker_Update(const uint16_t raw[ROTS_MAX_CHANNELS], uint32_t now_ms);
+void ROTS_BaselineTracker_GetBaselines(float baselines[ROTS_MAX_CHANNELS]);
+ROTS_StatusTypeDef ROTS_BaselineTracker_RequestPersist(uint32_t now_ms);
+ROTS_StatusTypeDef ROTS_BaselineTracker_Persist(void);
+ROTS_StatusTypeDef ROTS_BaselineTracker_GetStats(ROTS_BaselineStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_BASELINE_TRACKER_H */
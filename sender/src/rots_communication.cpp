@@ -1,270 +1,478 @@
-// ROTS Communication Module - 通信模块
-#include "rots_sender.h"
-#include "rots_communication.h"
-#include "rots_debug.h"
-
-// 私有变量
-static WiFiClient wifi_client;
-static PubSubClient mqtt_client(wifi_client);
-static bool wifi_connected = false;
-static bool mqtt_connected = false;
-static uint32_t last_connection_attempt = 0;
-static uint32_t last_heartbeat = 0;
-
-// 私有函数声明
-static void ROTS_Communication_MQTTCallback(char* topic, byte* payload, unsigned int length);
-static ROTS_StatusTypeDef ROTS_Communication_ConnectWiFi(void);
-static ROTS_StatusTypeDef ROTS_Communication_ConnectMQTT(void);
-static void ROTS_Communication_SendHeartbeat(void);
-
-// 初始化通信模块
-ROTS_StatusTypeDef ROTS_Communication_Init(void) {
-    DEBUG_INFO("Initializing communication...\r\n");
-    
-    // 连接WiFi
-    ROTS_StatusTypeDef status = ROTS_Communication_ConnectWiFi();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("WiFi connection failed\r\n");
-        return status;
-    }
-    
-    // 配置MQTT
-    mqtt_client.setServer(ROTS_MQTT_BROKER_HOST, ROTS_MQTT_BROKER_PORT);
-    mqtt_client.setCallback(ROTS_Communication_MQTTCallback);
-    
-    // 连接MQTT
-    status = ROTS_Communication_ConnectMQTT();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("MQTT connection failed\r\n");
-        return status;
-    }
-    
-    DEBUG_INFO("Communication initialized\r\n");
-    return ROTS_OK;
-}
-
-// 连接WiFi
-static ROTS_StatusTypeDef ROTS_Communication_ConnectWiFi(void) {
-    DEBUG_INFO("Connecting to WiFi: %s\r\n", ROTS_WIFI_SSID);
-    
-    WiFi.begin(ROTS_WIFI_SSID, ROTS_WIFI_PASSWORD);
-    
-    uint32_t start_time = millis();
-    while (WiFi.status() != WL_CONNECTED) {
-        if (millis() - start_time > ROTS_WIFI_TIMEOUT_MS) {
-            DEBUG_ERROR("WiFi connection timeout\r\n");
-            return ROTS_TIMEOUT;
-        }
-        delay(500);
-        DEBUG_DEBUG("WiFi connecting...\r\n");
-    }
-    
-    wifi_connected = true;
-    DEBUG_INFO("WiFi connected: %s\r\n", WiFi.localIP().toString().c_str());
-    return ROTS_OK;
-}
-
-// 连接MQTT
-static ROTS_StatusTypeDef ROTS_Communication_ConnectMQTT(void) {
-    DEBUG_INFO("Connecting to MQTT broker...\r\n");
-    
-    if (!mqtt_client.connect(ROTS_MQTT_CLIENT_ID)) {
-        DEBUG_ERROR("MQTT connection failed: %d\r\n", mqtt_client.state());
-        return ROTS_COMM_ERROR;
-    }
-    
-    // 订阅状态主题
-    if (!mqtt_client.subscribe(ROTS_MQTT_TOPIC_STATUS)) {
-        DEBUG_ERROR("Failed to subscribe to status topic\r\n");
-        return ROTS_COMM_ERROR;
-    }
-    
-    mqtt_connected = true;
-    DEBUG_INFO("MQTT connected\r\n");
-    return ROTS_OK;
-}
-
-// 发送气味检测结果
-ROTS_StatusTypeDef ROTS_Communication_SendOdorDetection(const ROTS_OdorResult_t* result) {
-    if (!mqtt_connected || !result) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    // 创建JSON消息
-    DynamicJsonDocument doc(512);
-    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
-    doc["odor_type"] = result->odor_type;
-    doc["odor_name"] = result->odor_name;
-    doc["confidence"] = result->confidence;
-    doc["intensity"] = result->intensity;
-    doc["timestamp"] = result->timestamp;
-    
-    // 序列化JSON
-    char json_string[512];
-    serializeJson(doc, json_string);
-    
-    // 发送MQTT消息
-    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_DETECTION, json_string)) {
-        DEBUG_ERROR("Failed to publish detection result\r\n");
-        return ROTS_COMM_ERROR;
-    }
-    
-    DEBUG_INFO("Odor detection sent: %s\r\n", result->odor_name);
-    return ROTS_OK;
-}
-
-// 发送状态信息
-ROTS_StatusTypeDef ROTS_Communication_SendStatus(const ROTS_SenderStatus_t* status) {
-    if (!mqtt_connected || !status) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    // 创建JSON消息
-    DynamicJsonDocument doc(256);
-    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
-    doc["state"] = status->state;
-    doc["detection_count"] = status->detection_count;
-    doc["error_count"] = status->error_count;
-    doc["battery_voltage"] = status->battery_voltage;
-    doc["timestamp"] = millis();
-    
-    // 序列化JSON
-    char json_string[256];
-    serializeJson(doc, json_string);
-    
-    // 发送MQTT消息
-    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_STATUS, json_string)) {
-        DEBUG_ERROR("Failed to publish status\r\n");
-        return ROTS_COMM_ERROR;
-    }
-    
-    return ROTS_OK;
-}
-
-// 发送错误信息
-ROTS_StatusTypeDef ROTS_Communication_SendError(ROTS_StatusTypeDef error_code) {
-    if (!mqtt_connected) {
-        return ROTS_COMM_ERROR;
-    }
-    
-    // 创建JSON消息
-    DynamicJsonDocument doc(128);
-    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
-    doc["error_code"] = error_code;
-    doc["timestamp"] = millis();
-    
-    // 序列化JSON
-    char json_string[128];
-    serializeJson(doc, json_string);
-    
-    // 发送MQTT消息
-    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_ERROR, json_string)) {
-        DEBUG_ERROR("Failed to publish error\r\n");
-        return ROTS_COMM_ERROR;
-    }
-    
-    DEBUG_ERROR("Error sent: %d\r\n", error_code);
-    return ROTS_OK;
-}
-
-// 更新通信状态
-ROTS_StatusTypeDef ROTS_Communication_Update(void) {
-    // 检查WiFi连接
-    if (WiFi.status() != WL_CONNECTED) {
-        if (wifi_connected) {
-            DEBUG_WARNING("WiFi disconnected\r\n");
-            wifi_connected = false;
-        }
-        
-        // 尝试重连
-        if (millis() - last_connection_attempt > 5000) {
-            ROTS_Communication_ConnectWiFi();
-            last_connection_attempt = millis();
-        }
-    } else if (!wifi_connected) {
-        DEBUG_INFO("WiFi reconnected\r\n");
-        wifi_connected = true;
-    }
-    
-    // 检查MQTT连接
-    if (wifi_connected && !mqtt_client.connected()) {
-        if (mqtt_connected) {
-            DEBUG_WARNING("MQTT disconnected\r\n");
-            mqtt_connected = false;
-        }
-        
-        // 尝试重连
-        if (millis() - last_connection_attempt > 5000) {
-            ROTS_Communication_ConnectMQTT();
-            last_connection_attempt = millis();
-        }
-    } else if (wifi_connected && !mqtt_connected) {
-        DEBUG_INFO("MQTT reconnected\r\n");
-        mqtt_connected = true;
-    }
-    
-    // 处理MQTT消息
-    if (mqtt_connected) {
-        mqtt_client.loop();
-    }
-    
-    // 发送心跳包
-    if (millis() - last_heartbeat > 30000) { // 每30秒
-        ROTS_Communication_SendHeartbeat();
-        last_heartbeat = millis();
-    }
-    
-    return ROTS_OK;
-}
-
-// MQTT回调函数
-static void ROTS_Communication_MQTTCallback(char* topic, byte* payload, unsigned int length) {
-    DEBUG_DEBUG("MQTT message received: %s\r\n", topic);
-    
-    // 解析JSON消息
-    DynamicJsonDocument doc(256);
-    deserializeJson(doc, payload, length);
-    
-    // 处理不同类型的消息
-    if (strstr(topic, "status") != NULL) {
-        // 处理状态消息
-        DEBUG_INFO("Status message received\r\n");
-    } else if (strstr(topic, "command") != NULL) {
-        // 处理命令消息
-        DEBUG_INFO("Command message received\r\n");
-    }
-}
-
-// 发送心跳包
-static void ROTS_Communication_SendHeartbeat(void) {
-    if (!mqtt_connected) return;
-    
-    // 创建心跳消息
-    DynamicJsonDocument doc(128);
-    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
-    doc["type"] = "heartbeat";
-    doc["timestamp"] = millis();
-    
-    // 序列化JSON
-    char json_string[128];
-    serializeJson(doc, json_string);
-    
-    // 发送MQTT消息
-    mqtt_client.publish("rots/heartbeat/001", json_string);
-    
-    DEBUG_DEBUG("Heartbeat sent\r\n");
-}
-
-// 获取通信状态
-ROTS_StatusTypeDef ROTS_Communication_GetStatus(ROTS_CommStatus_t* status) {
-    if (!status) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    status->wifi_connected = wifi_connected;
-    status->mqtt_connected = mqtt_connected;
-    status->wifi_rssi = WiFi.RSSI();
-    status->last_heartbeat = last_heartbeat;
-    
-    return ROTS_OK;
-}
+// ROTS Communication Module - 通信模块
+#include "rots_sender.h"
+#include "rots_communication.h"
+#include "rots_model_update.h"
+#include "rots_ai_engine.h"
+#include "rots_debug.h"
+
+// 私有变量
+static WiFiClient wifi_client;
+static PubSubClient mqtt_client(wifi_client);
+static bool wifi_connected = false;
+static bool mqtt_connected = false;
+static uint32_t last_connection_attempt = 0;
+static uint32_t last_heartbeat = 0;
+static uint8_t model_update_state = ROTS_MODEL_UPDATE_IDLE;
+static uint32_t learn_sequence = 0;     // 已应答的现场学习命令序号
+static bool learn_reported_active = false;
+
+// 私有函数声明
+static void ROTS_Communication_MQTTCallback(char* topic, byte* payload, unsigned int length);
+static ROTS_StatusTypeDef ROTS_Communication_ConnectWiFi(void);
+static ROTS_StatusTypeDef ROTS_Communication_ConnectMQTT(void);
+static void ROTS_Communication_SendHeartbeat(void);
+static void ROTS_Communication_SendModelAck(const ROTS_ModelUpdateAck_t* ack);
+static void ROTS_Communication_HandleCommand(DynamicJsonDocument& doc);
+static void ROTS_Communication_SendCommandAck(uint8_t command, const char* name, const char* state,
+                                              ROTS_StatusTypeDef result, uint32_t samples);
+static void ROTS_Communication_PollLearnStatus(void);
+
+// 初始化通信模块
+ROTS_StatusTypeDef ROTS_Communication_Init(void) {
+    DEBUG_INFO("Initializing communication...\r\n");
+    
+    // 连接WiFi
+    ROTS_StatusTypeDef status = ROTS_Communication_ConnectWiFi();
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("WiFi connection failed\r\n");
+        return status;
+    }
+    
+    // 配置MQTT
+    mqtt_client.setServer(ROTS_MQTT_BROKER_HOST, ROTS_MQTT_BROKER_PORT);
+    mqtt_client.setCallback(ROTS_Communication_MQTTCallback);
+    mqtt_client.setBufferSize(ROTS_MQTT_BUFFER_SIZE);
+    
+    // 模型远程更新
+    ROTS_ModelUpdate_Init();
+    
+    // 连接MQTT
+    status = ROTS_Communication_ConnectMQTT();
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("MQTT connection failed\r\n");
+        return status;
+    }
+    
+    DEBUG_INFO("Communication initialized\r\n");
+    return ROTS_OK;
+}
+
+// 连接WiFi
+static ROTS_StatusTypeDef ROTS_Communication_ConnectWiFi(void) {
+    DEBUG_INFO("Connecting to WiFi: %s\r\n", ROTS_WIFI_SSID);
+    
+    WiFi.begin(ROTS_WIFI_SSID, ROTS_WIFI_PASSWORD);
+    
+    uint32_t start_time = millis();
+    while (WiFi.status() != WL_CONNECTED) {
+        if (millis() - start_time > ROTS_WIFI_TIMEOUT_MS) {
+            DEBUG_ERROR("WiFi connection timeout\r\n");
+            return ROTS_TIMEOUT;
+        }
+        delay(500);
+        DEBUG_DEBUG("WiFi connecting...\r\n");
+    }
+    
+    wifi_connected = true;
+    DEBUG_INFO("WiFi connected: %s\r\n", WiFi.localIP().toString().c_str());
+    return ROTS_OK;
+}
+
+// 连接MQTT
+static ROTS_StatusTypeDef ROTS_Communication_ConnectMQTT(void) {
+    DEBUG_INFO("Connecting to MQTT broker...\r\n");
+    
+    if (!mqtt_client.connect(ROTS_MQTT_CLIENT_ID)) {
+        DEBUG_ERROR("MQTT connection failed: %d\r\n", mqtt_client.state());
+        return ROTS_COMM_ERROR;
+    }
+    
+    // 订阅状态主题
+    if (!mqtt_client.subscribe(ROTS_MQTT_TOPIC_STATUS)) {
+        DEBUG_ERROR("Failed to subscribe to status topic\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    // 订阅模型更新主题 (QoS 1, 断线重连后由发送端按应答续传)
+    if (!mqtt_client.subscribe(ROTS_MQTT_TOPIC_MODEL, 1)) {
+        DEBUG_ERROR("Failed to subscribe to model topic\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    // 订阅命令主题
+    if (!mqtt_client.subscribe(ROTS_MQTT_TOPIC_COMMAND)) {
+        DEBUG_ERROR("Failed to subscribe to command topic\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    mqtt_connected = true;
+    DEBUG_INFO("MQTT connected\r\n");
+    return ROTS_OK;
+}
+
+// 发送气味检测结果
+ROTS_StatusTypeDef ROTS_Communication_SendOdorDetection(const ROTS_OdorResult_t* result) {
+    if (!mqtt_connected || !result) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 创建JSON消息
+    DynamicJsonDocument doc(512);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["odor_type"] = result->odor_type;
+    doc["odor_name"] = result->odor_name;
+    doc["confidence"] = result->confidence;
+    doc["intensity"] = result->intensity;
+    doc["timestamp"] = result->timestamp;
+    
+    // 序列化JSON
+    char json_string[512];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_DETECTION, json_string)) {
+        DEBUG_ERROR("Failed to publish detection result\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    DEBUG_INFO("Odor detection sent: %s\r\n", result->odor_name);
+    return ROTS_OK;
+}
+
+// 发送检测事件 (在单次结果字段之外附加事件类型, 前一气味, 结束的气味及其持续时间)
+ROTS_StatusTypeDef ROTS_Communication_SendOdorEvent(const ROTS_DecisionEvent_t* event) {
+    static const char* const event_names[] = { "none", "onset", "change", "offset" };
+    
+    if (!mqtt_connected || !event || event->type == ROTS_DECISION_NONE) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 创建JSON消息
+    DynamicJsonDocument doc(512);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["event"] = event_names[event->type];
+    doc["odor_type"] = event->result.odor_type;
+    doc["odor_name"] = event->result.odor_name;
+    doc["confidence"] = event->result.confidence;
+    doc["intensity"] = event->result.intensity;
+    doc["previous_type"] = event->previous_type;
+    doc["ended_type"] = event->ended_type;
+    doc["duration_ms"] = event->duration_ms;
+    doc["timestamp"] = event->result.timestamp;
+    
+    // 序列化JSON
+    char json_string[512];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_DETECTION, json_string)) {
+        DEBUG_ERROR("Failed to publish detection event\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    DEBUG_INFO("Odor %s sent: %s\r\n", event_names[event->type], event->result.odor_name);
+    return ROTS_OK;
+}
+
+// 发送新颖 (分布外) 读数: 模型的猜测, 新颖度与当时的传感器帧, 供收集再训练数据
+ROTS_StatusTypeDef ROTS_Communication_SendNovelty(const ROTS_OdorResult_t* result, const ROTS_SensorData_t* frame) {
+    if (!mqtt_connected || !result || !frame) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 创建JSON消息
+    DynamicJsonDocument doc(1024);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["novelty"] = result->novelty;
+    doc["model_guess"] = result->odor_type;
+    doc["model_confidence"] = result->confidence;
+    doc["temperature"] = frame->temperature;
+    doc["humidity"] = frame->humidity;
+    doc["pressure"] = frame->pressure;
+    JsonArray channels = doc.createNestedArray("channels");
+    for (int ch = 0; ch < frame->channel_count; ch++) {
+        channels.add(frame->channels[ch]);
+    }
+    doc["timestamp"] = result->timestamp;
+    
+    // 序列化JSON
+    char json_string[ROTS_MQTT_BUFFER_SIZE];
+    serializeJson(doc, json_string, sizeof(json_string));
+    
+    // 发送MQTT消息
+    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_NOVELTY, json_string)) {
+        DEBUG_ERROR("Failed to publish novelty\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    DEBUG_INFO("Novel reading sent: %.1f\r\n", result->novelty);
+    return ROTS_OK;
+}
+
+// 发送状态信息
+ROTS_StatusTypeDef ROTS_Communication_SendStatus(const ROTS_SenderStatus_t* status) {
+    if (!mqtt_connected || !status) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 创建JSON消息
+    DynamicJsonDocument doc(256);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["state"] = status->state;
+    doc["detection_count"] = status->detection_count;
+    doc["error_count"] = status->error_count;
+    doc["battery_voltage"] = status->battery_voltage;
+    doc["timestamp"] = millis();
+    
+    // 序列化JSON
+    char json_string[256];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_STATUS, json_string)) {
+        DEBUG_ERROR("Failed to publish status\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    return ROTS_OK;
+}
+
+// 发送错误信息
+ROTS_StatusTypeDef ROTS_Communication_SendError(ROTS_StatusTypeDef error_code) {
+    if (!mqtt_connected) {
+        return ROTS_COMM_ERROR;
+    }
+    
+    // 创建JSON消息
+    DynamicJsonDocument doc(128);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["error_code"] = error_code;
+    doc["timestamp"] = millis();
+    
+    // 序列化JSON
+    char json_string[128];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    if (!mqtt_client.publish(ROTS_MQTT_TOPIC_ERROR, json_string)) {
+        DEBUG_ERROR("Failed to publish error\r\n");
+        return ROTS_COMM_ERROR;
+    }
+    
+    DEBUG_ERROR("Error sent: %d\r\n", error_code);
+    return ROTS_OK;
+}
+
+// 更新通信状态
+ROTS_StatusTypeDef ROTS_Communication_Update(void) {
+    // 检查WiFi连接
+    if (WiFi.status() != WL_CONNECTED) {
+        if (wifi_connected) {
+            DEBUG_WARNING("WiFi disconnected\r\n");
+            wifi_connected = false;
+        }
+        
+        // 尝试重连
+        if (millis() - last_connection_attempt > 5000) {
+            ROTS_Communication_ConnectWiFi();
+            last_connection_attempt = millis();
+        }
+    } else if (!wifi_connected) {
+        DEBUG_INFO("WiFi reconnected\r\n");
+        wifi_connected = true;
+    }
+    
+    // 检查MQTT连接
+    if (wifi_connected && !mqtt_client.connected()) {
+        if (mqtt_connected) {
+            DEBUG_WARNING("MQTT disconnected\r\n");
+            mqtt_connected = false;
+        }
+        
+        // 尝试重连
+        if (millis() - last_connection_attempt > 5000) {
+            ROTS_Communication_ConnectMQTT();
+            last_connection_attempt = millis();
+        }
+    } else if (wifi_connected && !mqtt_connected) {
+        DEBUG_INFO("MQTT reconnected\r\n");
+        mqtt_connected = true;
+    }
+    
+    // 处理MQTT消息
+    if (mqtt_connected) {
+        mqtt_client.loop();
+    }
+    
+    // 模型更新: 超时检查, 状态变化 (切换完成/失败) 时补发应答
+    ROTS_ModelUpdate_Poll(millis());
+    ROTS_ModelUpdateAck_t ack;
+    ROTS_ModelUpdate_GetAck(&ack);
+    if (ack.state != model_update_state) {
+        model_update_state = ack.state;
+        ROTS_Communication_SendModelAck(&ack);
+    }
+    
+    // 现场学习: 开始与完成时应答
+    ROTS_Communication_PollLearnStatus();
+    
+    // 发送心跳包
+    if (millis() - last_heartbeat > 30000) { // 每30秒
+        ROTS_Communication_SendHeartbeat();
+        last_heartbeat = millis();
+    }
+    
+    return ROTS_OK;
+}
+
+// MQTT回调函数
+static void ROTS_Communication_MQTTCallback(char* topic, byte* payload, unsigned int length) {
+    DEBUG_DEBUG("MQTT message received: %s\r\n", topic);
+    
+    // 模型更新帧为二进制, 不经JSON解析
+    if (strcmp(topic, ROTS_MQTT_TOPIC_MODEL) == 0) {
+        ROTS_ModelUpdateAck_t ack;
+        ROTS_ModelUpdate_HandleFrame(payload, length, millis(), &ack);
+        model_update_state = ack.state;
+        ROTS_Communication_SendModelAck(&ack);
+        return;
+    }
+    
+    // 解析JSON消息
+    DynamicJsonDocument doc(256);
+    DeserializationError error = deserializeJson(doc, payload, length);
+    
+    // 处理不同类型的消息
+    if (strstr(topic, "status") != NULL) {
+        // 处理状态消息
+        DEBUG_INFO("Status message received\r\n");
+    } else if (strcmp(topic, ROTS_MQTT_TOPIC_COMMAND) == 0) {
+        // 处理命令消息
+        DEBUG_INFO("Command message received\r\n");
+        if (error) {
+            ROTS_Communication_SendCommandAck(ROTS_AI_LEARN_CMD_NONE, "", "rejected", ROTS_INVALID_PARAM, 0);
+            return;
+        }
+        ROTS_Communication_HandleCommand(doc);
+    }
+}
+
+// 处理设备命令:
+//   {"cmd":"learn","name":"coffee","seconds":5}  学习新气味 (同名时追加样本)
+//   {"cmd":"forget","name":"coffee"}             删除现场学习的气味
+// 命令由推理任务异步执行, 此处立即应答是否受理, 完成后由PollLearnStatus再次应答
+static void ROTS_Communication_HandleCommand(DynamicJsonDocument& doc) {
+    const char* cmd = doc["cmd"] | "";
+    const char* name = doc["name"] | "";
+    
+    uint8_t command = ROTS_AI_LEARN_CMD_NONE;
+    ROTS_StatusTypeDef status = ROTS_INVALID_PARAM;
+    if (strcmp(cmd, "learn") == 0) {
+        command = ROTS_AI_LEARN_CMD_LEARN;
+        uint32_t seconds = doc["seconds"] | (uint32_t)(ROTS_AI_LEARN_DEFAULT_MS / 1000);
+        status = ROTS_AIEngine_RequestLearn(name, seconds <= ROTS_AI_LEARN_MAX_MS / 1000 ? seconds * 1000 : 0);
+    } else if (strcmp(cmd, "forget") == 0) {
+        command = ROTS_AI_LEARN_CMD_FORGET;
+        status = ROTS_AIEngine_RequestForget(name);
+    }
+    
+    ROTS_Communication_SendCommandAck(command, name, status == ROTS_OK ? "accepted" : "rejected", status, 0);
+}
+
+// 推理任务开始学习或完成命令时发送应答
+static void ROTS_Communication_PollLearnStatus(void) {
+    ROTS_AILearnStatus_t learn;
+    if (ROTS_AIEngine_GetLearnStatus(&learn) != ROTS_OK) {
+        return;
+    }
+    
+    if (learn.sequence != learn_sequence) {
+        learn_sequence = learn.sequence;
+        learn_reported_active = false;
+        ROTS_Communication_SendCommandAck(learn.command, learn.name, "done",
+                                          (ROTS_StatusTypeDef)learn.result, learn.samples);
+    } else if (learn.active && !learn_reported_active) {
+        learn_reported_active = true;
+        ROTS_Communication_SendCommandAck(learn.command, learn.name, "learning", ROTS_OK, 0);
+    }
+}
+
+// 发送心跳包
+static void ROTS_Communication_SendHeartbeat(void) {
+    if (!mqtt_connected) return;
+    
+    // 创建心跳消息
+    DynamicJsonDocument doc(128);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["type"] = "heartbeat";
+    doc["timestamp"] = millis();
+    
+    // 序列化JSON
+    char json_string[128];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    mqtt_client.publish("rots/heartbeat/001", json_string);
+    
+    DEBUG_DEBUG("Heartbeat sent\r\n");
+}
+
+// 发送模型更新应答
+static void ROTS_Communication_SendModelAck(const ROTS_ModelUpdateAck_t* ack) {
+    if (!mqtt_connected) return;
+    
+    // 创建应答消息
+    DynamicJsonDocument doc(192);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["transfer_id"] = ack->transfer_id;
+    doc["state"] = ack->state;
+    doc["result"] = ack->result;
+    doc["next_offset"] = ack->next_offset;
+    doc["total_size"] = ack->total_size;
+    
+    // 序列化JSON
+    char json_string[192];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    mqtt_client.publish(ROTS_MQTT_TOPIC_MODEL_ACK, json_string);
+}
+
+// 发送设备命令应答 (state: accepted/rejected/learning/done)
+static void ROTS_Communication_SendCommandAck(uint8_t command, const char* name, const char* state,
+                                              ROTS_StatusTypeDef result, uint32_t samples) {
+    static const char* const command_names[] = { "unknown", "learn", "forget" };
+    
+    if (!mqtt_connected) return;
+    
+    // 创建应答消息
+    DynamicJsonDocument doc(192);
+    doc["device_id"] = ROTS_MQTT_CLIENT_ID;
+    doc["cmd"] = command_names[command <= ROTS_AI_LEARN_CMD_FORGET ? command : 0];
+    doc["name"] = name;
+    doc["state"] = state;
+    doc["result"] = result;
+    doc["samples"] = samples;
+    doc["timestamp"] = millis();
+    
+    // 序列化JSON
+    char json_string[192];
+    serializeJson(doc, json_string);
+    
+    // 发送MQTT消息
+    mqtt_client.publish(ROTS_MQTT_TOPIC_COMMAND_ACK, json_string);
+}
+
+// 获取通信状态
+ROTS_StatusTypeDef ROTS_Communication_GetStatus(ROTS_CommStatus_t* status) {
+    if (!status) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    status->wifi_connected = wifi_connected;
+    status->mqtt_connected = mqtt_connected;
+    status->wifi_rssi = WiFi.RSSI();
+    status->last_heartbeat = last_heartbeat;
+    
+    return ROTS_OK;
+}
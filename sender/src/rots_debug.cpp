@@ -1,186 +1,317 @@
-// ROTS Debug Module - 调试模块
-#include "rots_sender.h"
-#include "rots_debug.h"
-
-// 调试级别
-static ROTS_DebugLevel_t debug_level = ROTS_DEBUG_INFO;
-
-// 初始化调试系统
-ROTS_StatusTypeDef ROTS_Debug_Init(void) {
-    // 配置调试LED
-    pinMode(ROTS_ERROR_LED_PIN, OUTPUT);
-    pinMode(ROTS_STATUS_LED_PIN, OUTPUT);
-    
-    digitalWrite(ROTS_ERROR_LED_PIN, LOW);
-    digitalWrite(ROTS_STATUS_LED_PIN, LOW);
-    
-    DEBUG_INFO("Debug system initialized\r\n");
-    return ROTS_OK;
-}
-
-// 设置调试级别
-void ROTS_Debug_SetLevel(ROTS_DebugLevel_t level) {
-    debug_level = level;
-}
-
-// 打印调试信息
-void ROTS_Debug_Print(ROTS_DebugLevel_t level, const char* format, ...) {
-    if (level > debug_level) return;
-    
-    char buffer[256];
-    char timestamp[20];
-    uint32_t tick = millis();
-    
-    // 添加时间戳
-    sprintf(timestamp, "[%lu] ", tick);
-    strcpy(buffer, timestamp);
-    
-    // 添加级别标识
-    switch (level) {
-        case ROTS_DEBUG_ERROR:
-            strcat(buffer, "ERROR: ");
-            break;
-        case ROTS_DEBUG_WARNING:
-            strcat(buffer, "WARN:  ");
-            break;
-        case ROTS_DEBUG_INFO:
-            strcat(buffer, "INFO:  ");
-            break;
-        case ROTS_DEBUG_DEBUG:
-            strcat(buffer, "DEBUG: ");
-            break;
-    }
-    
-    // 格式化消息
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer + strlen(buffer), sizeof(buffer) - strlen(buffer), format, args);
-    va_end(args);
-    
-    // 发送到串口
-    Serial.print(buffer);
-}
-
-// 打印十六进制数据
-void ROTS_Debug_PrintHex(ROTS_DebugLevel_t level, const char* label, const uint8_t* data, uint16_t length) {
-    if (level > debug_level) return;
-    
-    char buffer[512];
-    char hex_str[4];
-    
-    sprintf(buffer, "[%lu] %s: ", millis(), label);
-    
-    for (uint16_t i = 0; i < length; i++) {
-        sprintf(hex_str, "%02X ", data[i]);
-        strcat(buffer, hex_str);
-        
-        if ((i + 1) % 16 == 0) {
-            strcat(buffer, "\r\n");
-            Serial.print(buffer);
-            strcpy(buffer, "        ");
-        }
-    }
-    
-    if (length % 16 != 0) {
-        strcat(buffer, "\r\n");
-    }
-    
-    Serial.print(buffer);
-}
-
-// 打印系统状态
-void ROTS_Debug_PrintSystemStatus(void) {
-    DEBUG_INFO("=== System Status ===\r\n");
-    DEBUG_INFO("Free Heap: %lu bytes\r\n", ESP.getFreeHeap());
-    DEBUG_INFO("Free PSRAM: %lu bytes\r\n", ESP.getFreePsram());
-    DEBUG_INFO("CPU Frequency: %lu MHz\r\n", ESP.getCpuFreqMHz());
-    DEBUG_INFO("Uptime: %lu seconds\r\n", millis() / 1000);
-}
-
-// 打印传感器状态
-void ROTS_Debug_PrintSensorStatus(void) {
-    ROTS_SensorStatus_t status;
-    if (ROTS_SensorManager_GetStatus(&status) == ROTS_OK) {
-        DEBUG_INFO("=== Sensor Status ===\r\n");
-        DEBUG_INFO("Initialized: %s\r\n", status.initialized ? "Yes" : "No");
-        DEBUG_INFO("Temperature: %.1f°C\r\n", status.temperature);
-        DEBUG_INFO("Humidity: %.1f%%\r\n", status.humidity);
-        DEBUG_INFO("Pressure: %.1f hPa\r\n", status.pressure);
-        DEBUG_INFO("Health: %d%%\r\n", status.sensor_health);
-    }
-}
-
-// 打印AI状态
-void ROTS_Debug_PrintAIStatus(void) {
-    ROTS_AIStatus_t status;
-    if (ROTS_AIEngine_GetStatus(&status) == ROTS_OK) {
-        DEBUG_INFO("=== AI Status ===\r\n");
-        DEBUG_INFO("Initialized: %s\r\n", status.initialized ? "Yes" : "No");
-        DEBUG_INFO("Last Inference: %lu\r\n", status.last_inference_time);
-        DEBUG_INFO("Last Odor: %d\r\n", status.last_odor_type);
-        DEBUG_INFO("Last Confidence: %.2f\r\n", status.last_confidence);
-        DEBUG_INFO("Inference Count: %lu\r\n", status.inference_count);
-    }
-}
-
-// 打印通信状态
-void ROTS_Debug_PrintCommStatus(void) {
-    ROTS_CommStatus_t status;
-    if (ROTS_Communication_GetStatus(&status) == ROTS_OK) {
-        DEBUG_INFO("=== Communication Status ===\r\n");
-        DEBUG_INFO("WiFi Connected: %s\r\n", status.wifi_connected ? "Yes" : "No");
-        DEBUG_INFO("MQTT Connected: %s\r\n", status.mqtt_connected ? "Yes" : "No");
-        DEBUG_INFO("WiFi RSSI: %ld dBm\r\n", status.wifi_rssi);
-        DEBUG_INFO("Last Heartbeat: %lu\r\n", status.last_heartbeat);
-    }
-}
-
-// 打印内存使用情况
-void ROTS_Debug_PrintMemoryUsage(void) {
-    DEBUG_INFO("=== Memory Usage ===\r\n");
-    DEBUG_INFO("Free Heap: %lu bytes\r\n", ESP.getFreeHeap());
-    DEBUG_INFO("Free PSRAM: %lu bytes\r\n", ESP.getFreePsram());
-    DEBUG_INFO("Heap Size: %lu bytes\r\n", ESP.getHeapSize());
-    DEBUG_INFO("PSRAM Size: %lu bytes\r\n", ESP.getPsramSize());
-}
-
-// 打印错误信息
-void ROTS_Debug_PrintError(ROTS_StatusTypeDef error_code) {
-    const char* error_messages[] = {
-        "OK",
-        "ERROR",
-        "BUSY",
-        "TIMEOUT",
-        "INVALID_PARAM",
-        "COMM_ERROR",
-        "SENSOR_ERROR",
-        "AI_ERROR",
-        "MEMORY_ERROR"
-    };
-    
-    if (error_code < sizeof(error_messages) / sizeof(char*)) {
-        DEBUG_ERROR("Error: %s (%d)\r\n", error_messages[error_code], error_code);
-    } else {
-        DEBUG_ERROR("Unknown Error: %d\r\n", error_code);
-    }
-}
-
-// 闪烁LED指示
-void ROTS_Debug_BlinkLED(uint8_t pin, uint8_t times, uint16_t delay_ms) {
-    for (uint8_t i = 0; i < times; i++) {
-        digitalWrite(pin, HIGH);
-        delay(delay_ms);
-        digitalWrite(pin, LOW);
-        delay(delay_ms);
-    }
-}
-
-// 错误LED指示
-void ROTS_Debug_ErrorLED(bool state) {
-    digitalWrite(ROTS_ERROR_LED_PIN, state ? HIGH : LOW);
-}
-
-// 状态LED指示
-void ROTS_Debug_StatusLED(bool state) {
-    digitalWrite(ROTS_STATUS_LED_PIN, state ? HIGH : LOW);
-}
+// ROTS Debug Module - 调试模块
+#include "rots_sender.h"
+#include "rots_debug.h"
+#include "rots_sensor_manager.h"
+#include "rots_adc_capture.h"
+#include "rots_signal_filter.h"
+#include "rots_env_sensors.h"
+#include "rots_env_compensation.h"
+#include "rots_ads1115.h"
+#include "rots_heater_scheduler.h"
+#include "rots_sensor_health.h"
+#include "rots_temporal_features.h"
+#include "rots_decision_smoother.h"
+#include "rots_ai_engine.h"
+#include "rots_communication.h"
+#include "rots_model_update.h"
+#include "rots_model_store.h"
+
+// 调试级别
+static ROTS_DebugLevel_t debug_level = ROTS_DEBUG_INFO;
+
+// 初始化调试系统
+ROTS_StatusTypeDef ROTS_Debug_Init(void) {
+    // 配置调试LED
+    pinMode(ROTS_ERROR_LED_PIN, OUTPUT);
+    pinMode(ROTS_STATUS_LED_PIN, OUTPUT);
+    
+    digitalWrite(ROTS_ERROR_LED_PIN, LOW);
+    digitalWrite(ROTS_STATUS_LED_PIN, LOW);
+    
+    DEBUG_INFO("Debug system initialized\r\n");
+    return ROTS_OK;
+}
+
+// 设置调试级别
+void ROTS_Debug_SetLevel(ROTS_DebugLevel_t level) {
+    debug_level = level;
+}
+
+// 打印调试信息
+void ROTS_Debug_Print(ROTS_DebugLevel_t level, const char* format, ...) {
+    if (level > debug_level) return;
+    
+    char buffer[256];
+    char timestamp[20];
+    uint32_t tick = millis();
+    
+    // 添加时间戳
+    sprintf(timestamp, "[%lu] ", tick);
+    strcpy(buffer, timestamp);
+    
+    // 添加级别标识
+    switch (level) {
+        case ROTS_DEBUG_ERROR:
+            strcat(buffer, "ERROR: ");
+            break;
+        case ROTS_DEBUG_WARNING:
+            strcat(buffer, "WARN:  ");
+            break;
+        case ROTS_DEBUG_INFO:
+            strcat(buffer, "INFO:  ");
+            break;
+        case ROTS_DEBUG_DEBUG:
+            strcat(buffer, "DEBUG: ");
+            break;
+    }
+    
+    // 格式化消息
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer + strlen(buffer), sizeof(buffer) - strlen(buffer), format, args);
+    va_end(args);
+    
+    // 发送到串口
+    Serial.print(buffer);
+}
+
+// 打印十六进制数据
+void ROTS_Debug_PrintHex(ROTS_DebugLevel_t level, const char* label, const uint8_t* data, uint16_t length) {
+    if (level > debug_level) return;
+    
+    char buffer[512];
+    char hex_str[4];
+    
+    sprintf(buffer, "[%lu] %s: ", millis(), label);
+    
+    for (uint16_t i = 0; i < length; i++) {
+        sprintf(hex_str, "%02X ", data[i]);
+        strcat(buffer, hex_str);
+        
+        if ((i + 1) % 16 == 0) {
+            strcat(buffer, "\r\n");
+            Serial.print(buffer);
+            strcpy(buffer, "        ");
+        }
+    }
+    
+    if (length % 16 != 0) {
+        strcat(buffer, "\r\n");
+    }
+    
+    Serial.print(buffer);
+}
+
+// 打印系统状态
+void ROTS_Debug_PrintSystemStatus(void) {
+    DEBUG_INFO("=== System Status ===\r\n");
+    DEBUG_INFO("Free Heap: %lu bytes\r\n", ESP.getFreeHeap());
+    DEBUG_INFO("Free PSRAM: %lu bytes\r\n", ESP.getFreePsram());
+    DEBUG_INFO("CPU Frequency: %lu MHz\r\n", ESP.getCpuFreqMHz());
+    DEBUG_INFO("Uptime: %lu seconds\r\n", millis() / 1000);
+}
+
+// 打印传感器状态
+void ROTS_Debug_PrintSensorStatus(void) {
+    ROTS_SensorStatus_t status;
+    if (ROTS_SensorManager_GetStatus(&status) == ROTS_OK) {
+        DEBUG_INFO("=== Sensor Status ===\r\n");
+        DEBUG_INFO("Initialized: %s\r\n", status.initialized ? "Yes" : "No");
+        DEBUG_INFO("Ready: %s (%d%%)\r\n", status.ready ? "Yes" : "No", status.calibration_progress);
+        DEBUG_INFO("Channels: %u\r\n", status.channel_count);
+        DEBUG_INFO("Temperature: %.1f°C\r\n", status.temperature);
+        DEBUG_INFO("Humidity: %.1f%%\r\n", status.humidity);
+        DEBUG_INFO("Pressure: %.1f hPa\r\n", status.pressure);
+        DEBUG_INFO("Health: %d%% (healthy mask 0x%08lX)\r\n", status.sensor_health, status.healthy_mask);
+        DEBUG_INFO("Sample Rate: %u Hz (%lu switches)\r\n", status.sample_rate_hz, status.rate_switches);
+        DEBUG_INFO("Baseline: %s, %lu updates\r\n",
+                  status.baseline_restored ? "restored" : "calibrated", status.baseline_updates);
+        DEBUG_INFO("Conversion LUT Error: %.3f%%\r\n", status.conversion_max_error * 100.0f);
+        DEBUG_INFO("Frame snapshot: %lu published, %lu read retries\r\n",
+                  status.frames_published, status.snapshot_retries);
+    }
+    
+    ROTS_ADCCaptureStats_t capture;
+    if (ROTS_ADCCapture_GetStats(&capture) == ROTS_OK && capture.running) {
+        DEBUG_INFO("ADC Capture: %lu Hz, captured %lu, consumed %lu, skipped %lu, scan %lu us\r\n",
+                  capture.sample_rate_hz, capture.frames_captured, capture.frames_consumed,
+                  capture.frames_skipped, capture.last_scan_us);
+    }
+    
+    ROTS_FilterStats_t filter;
+    if (ROTS_SignalFilter_GetStats(&filter) == ROTS_OK) {
+        DEBUG_INFO("Filter: %lu frames, %lu outliers, %lu/%lu cycles (last/max)\r\n",
+                  filter.frames_processed, filter.outliers_rejected,
+                  filter.last_cycles, filter.max_cycles);
+    }
+    
+    ROTS_EnvCompStats_t comp;
+    if (ROTS_EnvComp_GetStats(&comp) == ROTS_OK) {
+        DEBUG_INFO("Env Compensation: %lu frames, %lu grid loads, %lu/%lu cycles (last/max)\r\n",
+                  comp.frames_processed, comp.grids_loaded, comp.last_cycles, comp.max_cycles);
+    }
+    
+    ROTS_EnvStats_t env;
+    if (ROTS_EnvSensors_GetStats(&env) == ROTS_OK) {
+        DEBUG_INFO("Env: BMP280 %s %lu/%lu, DHT22 %lu/%lu (reads/errors), %lu cycles max\r\n",
+                  env.bmp280_present ? "ok" : "missing", env.bmp280_reads, env.bmp280_errors,
+                  env.dht22_reads, env.dht22_errors, env.max_update_cycles);
+    }
+    
+    ROTS_ADS1115Stats_t ads;
+    if (ROTS_ADS1115_GetStats(&ads) == ROTS_OK && ads.board_count > 0) {
+        DEBUG_INFO("ADS1115: %u boards (present 0x%02X), %lu conversions, %lu errors, %lu cycles max\r\n",
+                  ads.board_count, ads.boards_present, ads.conversions, ads.errors, ads.max_update_cycles);
+    }
+    
+    ROTS_SensorHealthStats_t health;
+    if (ROTS_SensorHealth_GetStats(&health) == ROTS_OK) {
+        for (uint8_t ch = 0; ch < health.channel_count; ch++) {
+            if (health.health[ch] < 100 || health.flags[ch] != 0) {
+                DEBUG_INFO("Channel %u health %u%% flags 0x%02X (std %.2f, corr %.2f)\r\n",
+                          ch, health.health[ch], health.flags[ch], health.stddev[ch], health.correlation[ch]);
+            }
+        }
+        DEBUG_INFO("Health: %lu blocks, %lu/%lu cycles (last/max)\r\n",
+                  health.blocks_evaluated, health.last_cycles, health.max_cycles);
+    }
+    
+    ROTS_TemporalStats_t temporal;
+    if (ROTS_TemporalFeatures_GetStats(&temporal) == ROTS_OK) {
+        DEBUG_INFO("Temporal: %lu updates, window %u, onset 0x%08lX, %lu/%lu cycles (last/max)\r\n",
+                  temporal.updates, temporal.window_fill, temporal.onset_mask,
+                  temporal.update_cycles, temporal.max_update_cycles);
+    }
+    
+    ROTS_HeaterStats_t heater;
+    if (ROTS_HeaterScheduler_GetStats(&heater) == ROTS_OK) {
+        for (uint8_t id = 0; id < heater.heater_count; id++) {
+            DEBUG_INFO("Heater %u: phase %u, duty %u, %lu cycles, latched %s (%u)\r\n",
+                      id, heater.phase[id], heater.duty[id], heater.cycles[id],
+                      heater.latched[id] ? "yes" : "no", heater.latched_code[id]);
+        }
+        DEBUG_INFO("Heater windows: %lu samples, %lu empty\r\n", heater.window_samples, heater.empty_windows);
+    }
+}
+
+// 打印AI状态
+void ROTS_Debug_PrintAIStatus(void) {
+    ROTS_AIStatus_t status;
+    if (ROTS_AIEngine_GetStatus(&status) == ROTS_OK) {
+        DEBUG_INFO("=== AI Status ===\r\n");
+        DEBUG_INFO("Initialized: %s\r\n", status.initialized ? "Yes" : "No");
+        DEBUG_INFO("Last Inference: %lu\r\n", status.last_inference_time);
+        DEBUG_INFO("Last Odor: %d\r\n", status.last_odor_type);
+        DEBUG_INFO("Last Confidence: %.2f\r\n", status.last_confidence);
+        DEBUG_INFO("Inference Count: %lu (%lu full, %lu gated)\r\n",
+                  status.inference_count, status.full_inferences, status.gate_skips);
+        DEBUG_INFO("Gate: %.1f%% hit rate, %lu cycles gate / %lu cycles full, %llu cycles saved\r\n",
+                  status.gate_hit_rate * 100.0f, status.gate_cycles, status.full_cycles, status.cycles_saved);
+        DEBUG_INFO("Features: %u (%u channels, mask 0x%08lX)\r\n",
+                  status.feature_count, status.channel_count, status.channel_mask);
+        DEBUG_INFO("Model: %s 0x%08lX, %u layers, %lu params, %lu arena bytes, T=%.2f\r\n",
+                  status.model_source == ROTS_AI_MODEL_SOURCE_BLOB ? "flash" : "ram", status.model_id,
+                  status.model_layers, status.model_params, status.model_arena_bytes, status.model_temperature);
+        DEBUG_INFO("Inference: %s, %lu cycles int8 / %lu cycles float\r\n",
+                  status.int8_enabled ? "int8" : "float", status.int8_cycles, status.float_cycles);
+        if (status.int8_cycles > 0) {
+            DEBUG_INFO("Int8 rate: %lu inferences/s\r\n",
+                      (unsigned long)(ESP.getCpuFreqMHz() * 1000000UL / status.int8_cycles));
+        }
+        DEBUG_INFO("Int8 shadow: %lu runs, %lu mismatches, max score error %.2f%%\r\n",
+                  status.shadow_runs, status.shadow_mismatches, status.shadow_max_error * 100.0f);
+        DEBUG_INFO("Intensity head: %s, %lu cycles (%.1f%% of full inference)\r\n",
+                  status.intensity_demo ? "demo" : "loaded", status.intensity_cycles,
+                  status.full_cycles > 0 ? status.intensity_cycles * 100.0f / status.full_cycles : 0.0f);
+        static const char* const classifier_modes[] = { "model", "prototype", "hybrid" };
+        DEBUG_INFO("Classifier: %s, %u learned odors, %lu matches, %lu cycles lookup%s\r\n",
+                  classifier_modes[status.classifier_mode], status.prototype_count,
+                  status.prototype_matches, status.prototype_cycles, status.learning ? ", learning" : "");
+        if (status.novelty_loaded) {
+            DEBUG_INFO("Novelty: threshold %.1f, %lu novel, %lu cycles\r\n",
+                      status.novelty_threshold, status.novel_count, status.novelty_cycles);
+        } else {
+            DEBUG_INFO("Novelty: no stats loaded\r\n");
+        }
+    }
+    
+    ROTS_SmootherStats_t smoother;
+    if (ROTS_DecisionSmoother_GetStats(&smoother) == ROTS_OK) {
+        DEBUG_INFO("Smoother: active %d, %lu detections -> %lu events (%lu onset, %lu change, %lu offset)\r\n",
+                  smoother.active_type, smoother.detections,
+                  smoother.onsets + smoother.changes + smoother.offsets,
+                  smoother.onsets, smoother.changes, smoother.offsets);
+    }
+}
+
+// 打印通信状态
+void ROTS_Debug_PrintCommStatus(void) {
+    ROTS_CommStatus_t status;
+    if (ROTS_Communication_GetStatus(&status) == ROTS_OK) {
+        DEBUG_INFO("=== Communication Status ===\r\n");
+        DEBUG_INFO("WiFi Connected: %s\r\n", status.wifi_connected ? "Yes" : "No");
+        DEBUG_INFO("MQTT Connected: %s\r\n", status.mqtt_connected ? "Yes" : "No");
+        DEBUG_INFO("WiFi RSSI: %ld dBm\r\n", status.wifi_rssi);
+        DEBUG_INFO("Last Heartbeat: %lu\r\n", status.last_heartbeat);
+    }
+    
+    ROTS_ModelUpdateStatus_t update;
+    ROTS_ModelStoreStatus_t store;
+    if (ROTS_ModelUpdate_GetStatus(&update) == ROTS_OK && ROTS_ModelStore_GetStatus(&store) == ROTS_OK) {
+        DEBUG_INFO("Model update: state %u, %lu/%lu bytes, %lu ok / %lu failed (last error %d), %lu rejected frames\r\n",
+                  update.state, update.received, update.total_size, update.completed, update.failed,
+                  update.last_error, update.rejected_frames);
+        DEBUG_INFO("Model slots: %u mapped, active %u, %lu swaps\r\n",
+                  store.slot_count, store.active_slot, store.activations);
+    }
+}
+
+// 打印内存使用情况
+void ROTS_Debug_PrintMemoryUsage(void) {
+    DEBUG_INFO("=== Memory Usage ===\r\n");
+    DEBUG_INFO("Free Heap: %lu bytes\r\n", ESP.getFreeHeap());
+    DEBUG_INFO("Free PSRAM: %lu bytes\r\n", ESP.getFreePsram());
+    DEBUG_INFO("Heap Size: %lu bytes\r\n", ESP.getHeapSize());
+    DEBUG_INFO("PSRAM Size: %lu bytes\r\n", ESP.getPsramSize());
+}
+
+// 打印错误信息
+void ROTS_Debug_PrintError(ROTS_StatusTypeDef error_code) {
+    const char* error_messages[] = {
+        "OK",
+        "ERROR",
+        "BUSY",
+        "TIMEOUT",
+        "INVALID_PARAM",
+        "COMM_ERROR",
+        "SENSOR_ERROR",
+        "AI_ERROR",
+        "MEMORY_ERROR"
+    };
+    
+    if (error_code < sizeof(error_messages) / sizeof(char*)) {
+        DEBUG_ERROR("Error: %s (%d)\r\n", error_messages[error_code], error_code);
+    } else {
+        DEBUG_ERROR("Unknown Error: %d\r\n", error_code);
+    }
+}
+
+// 闪烁LED指示
+void ROTS_Debug_BlinkLED(uint8_t pin, uint8_t times, uint16_t delay_ms) {
+    for (uint8_t i = 0; i < times; i++) {
+        digitalWrite(pin, HIGH);
+        delay(delay_ms);
+        digitalWrite(pin, LOW);
+        delay(delay_ms);
+    }
+}
+
+// 错误LED指示
+void ROTS_Debug_ErrorLED(bool state) {
+    digitalWrite(ROTS_ERROR_LED_PIN, state ? HIGH : LOW);
+}
+
+// 状态LED指示
+void ROTS_Debug_StatusLED(bool state) {
+    digitalWrite(ROTS_STATUS_LED_PIN, state ? HIGH : LOW);
+}
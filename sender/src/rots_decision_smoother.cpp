@@ -0,0 +1,229 @@
+// ROTS Decision Smoother - 推理结果的滞回投票平滑
+//
+// 持续一分钟的气味原本会发布约120条相同结果, 类别间抖动会让接收端来回切换.
+// 这里把逐次结果变为出现/切换/消失事件. 不依赖Arduino, 可在主机上回放记录.
+#include "rots_sender.h"
+#include "rots_decision_smoother.h"
+
+// 私有变量
+static ROTS_SmootherConfig_t smoother_config;
+static uint8_t vote_ring[ROTS_SMOOTHER_MAX_WINDOW];          // 各次推理的投票类别 (类别下标)
+static float confidence_ring[ROTS_SMOOTHER_MAX_WINDOW];
+static uint8_t vote_head = 0;
+static uint8_t vote_fill = 0;
+static uint8_t vote_count[ROTS_SMOOTHER_CLASSES];           // 窗口内各类票数
+static float confidence_sum[ROTS_SMOOTHER_CLASSES];
+static ROTS_OdorResult_t last_vote[ROTS_SMOOTHER_CLASSES];  // 各类最近一票的结果 (名称/强度)
+static uint8_t active_class = 0;                            // 当前气味的类别下标, 0为无气味
+static uint32_t active_since = 0;
+static ROTS_SmootherStats_t smoother_stats;
+
+// 私有函数声明
+static bool ROTS_DecisionSmoother_CheckConfig(const ROTS_SmootherConfig_t* config);
+static int ROTS_DecisionSmoother_ClassIndex(ROTS_OdorType_t odor_type);
+static ROTS_OdorType_t ROTS_DecisionSmoother_ClassType(uint8_t index);
+static void ROTS_DecisionSmoother_Emit(ROTS_DecisionEvent_t* event, ROTS_DecisionEventType_t type,
+                                       uint8_t index, uint32_t now);
+
+// 初始化, config为NULL时使用默认配置
+ROTS_StatusTypeDef ROTS_DecisionSmoother_Init(const ROTS_SmootherConfig_t* config) {
+    ROTS_SmootherConfig_t defaults;
+    if (!config) {
+        defaults.window = ROTS_SMOOTHER_WINDOW;
+        defaults.enter_votes = ROTS_SMOOTHER_ENTER_VOTES;
+        defaults.exit_votes = ROTS_SMOOTHER_EXIT_VOTES;
+        defaults.enter_confidence = ROTS_SMOOTHER_ENTER_CONFIDENCE;
+        defaults.exit_confidence = ROTS_SMOOTHER_EXIT_CONFIDENCE;
+        config = &defaults;
+    }
+
+    if (!ROTS_DecisionSmoother_CheckConfig(config)) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    smoother_config = *config;
+    memset(&smoother_stats, 0, sizeof(smoother_stats));
+    ROTS_DecisionSmoother_Reset();
+    return ROTS_OK;
+}
+
+// 修改配置 (投票窗口以当前气味重新填满, 换配置本身不产生事件, 之后按新窗口重新投票)
+ROTS_StatusTypeDef ROTS_DecisionSmoother_SetConfig(const ROTS_SmootherConfig_t* config) {
+    if (!config || !ROTS_DecisionSmoother_CheckConfig(config)) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    // 以当前气味的平均置信度填充, 否则清空的窗口会在下一次更新时判为消失
+    float confidence = vote_count[active_class] ? confidence_sum[active_class] / vote_count[active_class] : 0.0f;
+
+    smoother_config = *config;
+    vote_head = 0;
+    vote_fill = active_class != 0 ? smoother_config.window : 0;
+    memset(vote_count, 0, sizeof(vote_count));
+    memset(confidence_sum, 0, sizeof(confidence_sum));
+    for (uint8_t i = 0; i < vote_fill; i++) {
+        vote_ring[i] = active_class;
+        confidence_ring[i] = confidence;
+    }
+    vote_count[active_class] = vote_fill;
+    confidence_sum[active_class] = confidence * vote_fill;
+    return ROTS_OK;
+}
+
+// 获取当前配置
+void ROTS_DecisionSmoother_GetConfig(ROTS_SmootherConfig_t* config) {
+    if (config) {
+        *config = smoother_config;
+    }
+}
+
+// 清空投票窗口并回到无气味状态 (不产生事件)
+void ROTS_DecisionSmoother_Reset(void) {
+    vote_head = 0;
+    vote_fill = 0;
+    memset(vote_count, 0, sizeof(vote_count));
+    memset(confidence_sum, 0, sizeof(confidence_sum));
+    memset(last_vote, 0, sizeof(last_vote));
+    active_class = 0;
+    active_since = 0;
+}
+
+// 输入一次推理结果, 产生事件时返回ROTS_OK, 否则返回ROTS_BUSY
+ROTS_StatusTypeDef ROTS_DecisionSmoother_Update(const ROTS_OdorResult_t* result, ROTS_DecisionEvent_t* event) {
+    int index = result ? ROTS_DecisionSmoother_ClassIndex(result->odor_type) : -1;
+    if (!event || index < 0) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    smoother_stats.updates++;
+    event->type = ROTS_DECISION_NONE;
+
+    // 投票: 当前气味以较低阈值计票 (滞回), 其余类别需达到进入阈值
+    uint8_t vote = 0;
+    if (index != 0) {
+        if (result->confidence > smoother_config.enter_confidence) {
+            vote = (uint8_t)index;
+            smoother_stats.detections++;
+        } else if (index == active_class && result->confidence > smoother_config.exit_confidence) {
+            vote = (uint8_t)index;
+        }
+    }
+    if (vote != 0) {
+        last_vote[vote] = *result;
+    }
+
+    // 移出最旧一票, 加入新票
+    if (vote_fill == smoother_config.window) {
+        uint8_t oldest = vote_ring[vote_head];
+        vote_count[oldest]--;
+        confidence_sum[oldest] = vote_count[oldest] ? confidence_sum[oldest] - confidence_ring[vote_head] : 0.0f;
+    } else {
+        vote_fill++;
+    }
+    vote_ring[vote_head] = vote;
+    confidence_ring[vote_head] = result->confidence;
+    vote_count[vote]++;
+    confidence_sum[vote] += result->confidence;
+    vote_head = (uint8_t)((vote_head + 1) % smoother_config.window);
+
+    // 票数最多的气味 (同票时保持当前气味)
+    uint8_t best = active_class;
+    for (uint8_t c = 1; c < ROTS_SMOOTHER_CLASSES; c++) {
+        if (vote_count[c] > vote_count[best] || best == 0) {
+            best = c;
+        }
+    }
+
+    if (active_class == 0) {
+        if (vote_count[best] >= smoother_config.enter_votes) {
+            ROTS_DecisionSmoother_Emit(event, ROTS_DECISION_ONSET, best, result->timestamp);
+        }
+    } else if (best != active_class && vote_count[best] >= smoother_config.enter_votes) {
+        ROTS_DecisionSmoother_Emit(event, ROTS_DECISION_CHANGE, best, result->timestamp);
+    } else if (vote_count[active_class] < smoother_config.exit_votes) {
+        ROTS_DecisionSmoother_Emit(event, ROTS_DECISION_OFFSET, 0, result->timestamp);
+    }
+
+    return event->type == ROTS_DECISION_NONE ? ROTS_BUSY : ROTS_OK;
+}
+
+// 当前气味
+ROTS_OdorType_t ROTS_DecisionSmoother_GetActive(void) {
+    return ROTS_DecisionSmoother_ClassType(active_class);
+}
+
+// 获取统计
+ROTS_StatusTypeDef ROTS_DecisionSmoother_GetStats(ROTS_SmootherStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    *stats = smoother_stats;
+    stats->active_type = ROTS_DecisionSmoother_ClassType(active_class);
+    stats->active_since = active_since;
+    return ROTS_OK;
+}
+
+// 配置校验
+static bool ROTS_DecisionSmoother_CheckConfig(const ROTS_SmootherConfig_t* config) {
+    return config->window >= 1 && config->window <= ROTS_SMOOTHER_MAX_WINDOW &&
+           config->exit_votes >= 1 && config->exit_votes <= config->enter_votes &&
+           config->enter_votes <= config->window &&
+           config->exit_confidence >= 0.0f && config->exit_confidence <= config->enter_confidence &&
+           config->enter_confidence <= 1.0f;
+}
+
+// 气味类型 -> 类别下标 (内置气味在前, 现场学习的气味在后), 无效类型返回-1
+static int ROTS_DecisionSmoother_ClassIndex(ROTS_OdorType_t odor_type) {
+    if ((uint32_t)odor_type < ROTS_SMOOTHER_BUILTIN_CLASSES) {
+        return (int)odor_type;
+    }
+    if (odor_type >= ROTS_ODOR_LEARNED && odor_type < ROTS_ODOR_LEARNED + ROTS_LEARNED_ODOR_SLOTS) {
+        return ROTS_SMOOTHER_BUILTIN_CLASSES + (odor_type - ROTS_ODOR_LEARNED);
+    }
+    return -1;
+}
+
+// 类别下标 -> 气味类型
+static ROTS_OdorType_t ROTS_DecisionSmoother_ClassType(uint8_t index) {
+    if (index < ROTS_SMOOTHER_BUILTIN_CLASSES) {
+        return (ROTS_OdorType_t)index;
+    }
+    return (ROTS_OdorType_t)(ROTS_ODOR_LEARNED + index - ROTS_SMOOTHER_BUILTIN_CLASSES);
+}
+
+// 填写事件并切换当前气味
+static void ROTS_DecisionSmoother_Emit(ROTS_DecisionEvent_t* event, ROTS_DecisionEventType_t type,
+                                       uint8_t index, uint32_t now) {
+    event->type = type;
+    event->result = last_vote[index];
+    event->result.odor_type = ROTS_DecisionSmoother_ClassType(index);
+    event->result.confidence = vote_count[index] ? confidence_sum[index] / vote_count[index] : 0.0f;
+    event->result.timestamp = now;
+    event->previous_type = ROTS_DecisionSmoother_ClassType(active_class);
+    event->ended_type = ROTS_ODOR_UNKNOWN;
+    event->duration_ms = active_class != 0 ? now - active_since : 0;
+
+    switch (type) {
+        case ROTS_DECISION_ONSET:
+            smoother_stats.onsets++;
+            break;
+        case ROTS_DECISION_CHANGE:
+            smoother_stats.changes++;
+            break;
+        case ROTS_DECISION_OFFSET:
+            // 消失事件本身报告无气味, 结束的气味单独给出
+            memset(&event->result, 0, sizeof(event->result));
+            event->result.odor_type = ROTS_ODOR_UNKNOWN;
+            strcpy(event->result.odor_name, "Unknown");
+            event->result.timestamp = now;
+            event->ended_type = event->previous_type;
+            smoother_stats.offsets++;
+            break;
+        default:
+            break;
+    }
+
+    active_class = index;
+    active_since = now;
+}
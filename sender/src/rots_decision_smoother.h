@@ -0,0 +1,75 @@
+// ROTS Decision Smoother Header
+#ifndef ROTS_DECISION_SMOOTHER_H
+#define ROTS_DECISION_SMOOTHER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+#include "rots_ai_engine.h"
+
+// 判定平滑: 最近window次推理结果按类别投票, 带滞回地维护当前气味,
+// 只在气味出现/切换/消失时产生事件, 代替每次推理各发布一条结果.
+// 进入需enter_votes票且置信度高于enter_confidence, 当前气味以较低的
+// exit_confidence计票, 票数低于exit_votes时结束. 每次更新O(1), 内存固定.
+#define ROTS_SMOOTHER_MAX_WINDOW      16
+#define ROTS_SMOOTHER_BUILTIN_CLASSES (ROTS_AI_ODOR_CLASSES + 1)  // ROTS_ODOR_UNKNOWN (无气味票) 与分类器各类 (含混合类)
+#define ROTS_SMOOTHER_CLASSES         (ROTS_SMOOTHER_BUILTIN_CLASSES + ROTS_LEARNED_ODOR_SLOTS)  // + 现场学习的气味
+#define ROTS_SMOOTHER_WINDOW          8       // 默认窗口 (推理次数, 500ms一次即4s)
+#define ROTS_SMOOTHER_ENTER_VOTES     5
+#define ROTS_SMOOTHER_EXIT_VOTES      3
+#define ROTS_SMOOTHER_ENTER_CONFIDENCE  ROTS_AI_CONFIDENCE_THRESHOLD
+#define ROTS_SMOOTHER_EXIT_CONFIDENCE   0.5f
+
+// 事件类型
+typedef enum {
+    ROTS_DECISION_NONE = 0x00,
+    ROTS_DECISION_ONSET = 0x01,   // 无气味 -> 气味
+    ROTS_DECISION_CHANGE = 0x02,  // 气味A -> 气味B
+    ROTS_DECISION_OFFSET = 0x03   // 气味 -> 无气味
+} ROTS_DecisionEventType_t;
+
+// 配置
+typedef struct {
+    uint8_t window;               // 1..ROTS_SMOOTHER_MAX_WINDOW
+    uint8_t enter_votes;          // exit_votes..window
+    uint8_t exit_votes;           // 1..enter_votes
+    float enter_confidence;
+    float exit_confidence;        // 不高于enter_confidence
+} ROTS_SmootherConfig_t;
+
+// 事件
+typedef struct {
+    ROTS_DecisionEventType_t type;
+    ROTS_OdorResult_t result;       // 出现/切换: 新气味 (置信度为窗口内平均); 消失: ROTS_ODOR_UNKNOWN, 强度为0
+    ROTS_OdorType_t previous_type;  // 切换/消失前的气味, 出现时为ROTS_ODOR_UNKNOWN
+    ROTS_OdorType_t ended_type;     // 消失: 结束的气味, 其余事件为ROTS_ODOR_UNKNOWN
+    uint32_t duration_ms;           // 切换/消失: 前一气味的持续时间
+} ROTS_DecisionEvent_t;
+
+// 统计
+typedef struct {
+    uint32_t updates;
+    uint32_t detections;          // 置信度高于enter_confidence的推理次数 (逐次发布时的消息数)
+    uint32_t onsets;
+    uint32_t changes;
+    uint32_t offsets;
+    ROTS_OdorType_t active_type;
+    uint32_t active_since;
+} ROTS_SmootherStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_DecisionSmoother_Init(const ROTS_SmootherConfig_t* config);
+ROTS_StatusTypeDef ROTS_DecisionSmoother_SetConfig(const ROTS_SmootherConfig_t* config);
+void ROTS_DecisionSmoother_GetConfig(ROTS_SmootherConfig_t* config);
+void ROTS_DecisionSmoother_Reset(void);
+ROTS_StatusTypeDef ROTS_DecisionSmoother_Update(const ROTS_OdorResult_t* result, ROTS_DecisionEvent_t* event);
+ROTS_OdorType_t ROTS_DecisionSmoother_GetActive(void);
+ROTS_StatusTypeDef ROTS_DecisionSmoother_GetStats(ROTS_SmootherStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_DECISION_SMOOTHER_H */
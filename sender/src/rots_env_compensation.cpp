@@ -0,0 +1,177 @@
+// ROTS Environment Compensation - MQ传感器温湿度补偿模块
+//
+// 每个通道一张温度 x 湿度补偿系数网格, 按 [温度][湿度][通道] 排列,
+// 同一组温湿度下各通道的系数连续存放. 插值权重每帧只算一次,
+// 通道循环内为纯整数乘加, 便于编译器展开/向量化.
+#include "rots_sender.h"
+#include "rots_env_compensation.h"
+
+#define ROTS_ENV_COMP_ONE          (1u << ROTS_ENV_COMP_FRAC_BITS)
+#define ROTS_ENV_COMP_WEIGHT_BITS  8     // 插值分数精度
+#define ROTS_ENV_COMP_GRID_SIZE    (ROTS_ENV_COMP_TEMP_POINTS * ROTS_ENV_COMP_HUM_POINTS * ROTS_ENV_COMP_CHANNELS)
+
+typedef uint16_t ROTS_EnvCompRow_t[ROTS_ENV_COMP_CHANNELS];
+
+// 私有变量
+static ROTS_EnvCompRow_t comp_grid[ROTS_ENV_COMP_TEMP_POINTS][ROTS_ENV_COMP_HUM_POINTS];
+static ROTS_EnvCompStats_t comp_stats;
+
+// 私有函数声明
+static uint16_t ROTS_EnvComp_ToFixed(float factor);
+static void ROTS_EnvComp_Locate(float value, float min, float step, uint8_t points,
+                                uint8_t* index, uint32_t* frac);
+
+// 初始化补偿模块 (载入默认网格)
+ROTS_StatusTypeDef ROTS_EnvComp_Init(void) {
+    memset(&comp_stats, 0, sizeof(ROTS_EnvCompStats_t));
+    ROTS_EnvComp_ResetDefault();
+    return ROTS_OK;
+}
+
+// 设置单通道网格 (按 [温度][湿度] 行优先排列的浮点系数)
+ROTS_StatusTypeDef ROTS_EnvComp_SetChannelGrid(uint8_t channel,
+                                               const float factors[ROTS_ENV_COMP_TEMP_POINTS * ROTS_ENV_COMP_HUM_POINTS]) {
+    if (channel >= ROTS_ENV_COMP_CHANNELS || !factors) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    for (int t = 0; t < ROTS_ENV_COMP_TEMP_POINTS; t++) {
+        for (int h = 0; h < ROTS_ENV_COMP_HUM_POINTS; h++) {
+            float factor = factors[t * ROTS_ENV_COMP_HUM_POINTS + h];
+            if (!(factor >= 0.0f)) {
+                return ROTS_INVALID_PARAM;
+            }
+        }
+    }
+
+    for (int t = 0; t < ROTS_ENV_COMP_TEMP_POINTS; t++) {
+        for (int h = 0; h < ROTS_ENV_COMP_HUM_POINTS; h++) {
+            comp_grid[t][h][channel] = ROTS_EnvComp_ToFixed(factors[t * ROTS_ENV_COMP_HUM_POINTS + h]);
+        }
+    }
+
+    comp_stats.grids_loaded++;
+    return ROTS_OK;
+}
+
+// 读取单通道网格
+ROTS_StatusTypeDef ROTS_EnvComp_GetChannelGrid(uint8_t channel,
+                                               float factors[ROTS_ENV_COMP_TEMP_POINTS * ROTS_ENV_COMP_HUM_POINTS]) {
+    if (channel >= ROTS_ENV_COMP_CHANNELS || !factors) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    for (int t = 0; t < ROTS_ENV_COMP_TEMP_POINTS; t++) {
+        for (int h = 0; h < ROTS_ENV_COMP_HUM_POINTS; h++) {
+            factors[t * ROTS_ENV_COMP_HUM_POINTS + h] = (float)comp_grid[t][h][channel] / ROTS_ENV_COMP_ONE;
+        }
+    }
+    return ROTS_OK;
+}
+
+// 整体载入Q4.12网格 (与内部布局 [温度][湿度][通道] 一致, 可直接来自Flash/网络)
+ROTS_StatusTypeDef ROTS_EnvComp_LoadGrids(const uint16_t* grid, uint32_t length) {
+    if (!grid || length != ROTS_ENV_COMP_GRID_SIZE) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(comp_grid, grid, sizeof(comp_grid));
+    comp_stats.grids_loaded++;
+    return ROTS_OK;
+}
+
+// 恢复默认网格 (与原线性温度补偿一致)
+void ROTS_EnvComp_ResetDefault(void) {
+    for (int t = 0; t < ROTS_ENV_COMP_TEMP_POINTS; t++) {
+        float temperature = ROTS_ENV_COMP_TEMP_MIN + t * ROTS_ENV_COMP_TEMP_STEP;
+        uint16_t factor = ROTS_EnvComp_ToFixed(1.0f + (temperature - 25.0f) * ROTS_ENV_COMP_DEFAULT_TEMP_COEFF);
+
+        for (int h = 0; h < ROTS_ENV_COMP_HUM_POINTS; h++) {
+            for (int ch = 0; ch < ROTS_ENV_COMP_CHANNELS; ch++) {
+                comp_grid[t][h][ch] = factor;
+            }
+        }
+    }
+}
+
+// 对一帧浓度应用补偿 (原地)
+void ROTS_EnvComp_Apply(float* values, uint8_t channel_count, float temperature, float humidity) {
+    if (!values || channel_count > ROTS_ENV_COMP_CHANNELS) {
+        return;
+    }
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+
+    uint8_t t0, h0;
+    uint32_t ft, fh;
+    ROTS_EnvComp_Locate(temperature, ROTS_ENV_COMP_TEMP_MIN, ROTS_ENV_COMP_TEMP_STEP,
+                        ROTS_ENV_COMP_TEMP_POINTS, &t0, &ft);
+    ROTS_EnvComp_Locate(humidity, ROTS_ENV_COMP_HUM_MIN, ROTS_ENV_COMP_HUM_STEP,
+                        ROTS_ENV_COMP_HUM_POINTS, &h0, &fh);
+
+    // 四个角点权重 (Q16, 和为65536)
+    const uint32_t one = 1u << ROTS_ENV_COMP_WEIGHT_BITS;
+    const uint32_t w00 = (one - ft) * (one - fh);
+    const uint32_t w01 = (one - ft) * fh;
+    const uint32_t w10 = ft * (one - fh);
+    const uint32_t w11 = ft * fh;
+
+    const uint16_t* g00 = comp_grid[t0][h0];
+    const uint16_t* g01 = comp_grid[t0][h0 + 1];
+    const uint16_t* g10 = comp_grid[t0 + 1][h0];
+    const uint16_t* g11 = comp_grid[t0 + 1][h0 + 1];
+
+    const float scale = 1.0f / (float)ROTS_ENV_COMP_ONE;
+    for (int ch = 0; ch < channel_count; ch++) {
+        // 权重和为2^16, 系数最大2^16-1, 累加不会溢出32位
+        uint32_t acc = w00 * g00[ch] + w01 * g01[ch] + w10 * g10[ch] + w11 * g11[ch];
+        uint32_t factor = (acc + (1u << 15)) >> (2 * ROTS_ENV_COMP_WEIGHT_BITS);
+        values[ch] *= (float)factor * scale;
+    }
+
+    uint32_t cycles = ROTS_CYCLE_COUNT() - start;
+    comp_stats.frames_processed++;
+    comp_stats.last_cycles = cycles;
+    if (cycles > comp_stats.max_cycles) {
+        comp_stats.max_cycles = cycles;
+    }
+}
+
+// 获取补偿统计
+ROTS_StatusTypeDef ROTS_EnvComp_GetStats(ROTS_EnvCompStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &comp_stats, sizeof(ROTS_EnvCompStats_t));
+    return ROTS_OK;
+}
+
+// 浮点系数转Q4.12 (饱和)
+static uint16_t ROTS_EnvComp_ToFixed(float factor) {
+    if (factor <= 0.0f) return 0;
+    float scaled = factor * ROTS_ENV_COMP_ONE + 0.5f;
+    if (scaled >= 65535.0f) return 65535;
+    return (uint16_t)scaled;
+}
+
+// 计算所在网格单元及单元内分数 (超出范围时夹到边界)
+static void ROTS_EnvComp_Locate(float value, float min, float step, uint8_t points,
+                                uint8_t* index, uint32_t* frac) {
+    float position = (value - min) / step;
+    float last = (float)(points - 1);
+
+    // NaN也走下边界
+    if (!(position > 0.0f)) position = 0.0f;
+    if (position > last) position = last;
+
+    uint32_t fixed = (uint32_t)(position * (1u << ROTS_ENV_COMP_WEIGHT_BITS) + 0.5f);
+    uint32_t cell = fixed >> ROTS_ENV_COMP_WEIGHT_BITS;
+    if (cell >= (uint32_t)(points - 1)) {
+        // 落在最后一个网格点上: 用最后一个单元, 分数取满
+        cell = points - 2;
+    }
+
+    *index = (uint8_t)cell;
+    *frac = fixed - (cell << ROTS_ENV_COMP_WEIGHT_BITS);
+}
@@ -0,0 +1,45 @@
+// ROTS Environment Compensation Header
+#ifndef ROTS_ENV_COMPENSATION_H
+#define ROTS_ENV_COMPENSATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 补偿网格配置 (温度 x 湿度, 等间距)
+#define ROTS_ENV_COMP_CHANNELS       ROTS_MAX_CHANNELS
+#define ROTS_ENV_COMP_TEMP_POINTS    9
+#define ROTS_ENV_COMP_TEMP_MIN       -20.0f   // °C
+#define ROTS_ENV_COMP_TEMP_STEP      10.0f
+#define ROTS_ENV_COMP_HUM_POINTS     6
+#define ROTS_ENV_COMP_HUM_MIN        0.0f     // %RH
+#define ROTS_ENV_COMP_HUM_STEP       20.0f
+#define ROTS_ENV_COMP_FRAC_BITS      12       // 网格系数为Q4.12 (0-15.99)
+#define ROTS_ENV_COMP_DEFAULT_TEMP_COEFF  0.02f  // 默认网格: 1 + (T - 25) * 系数, 与湿度无关
+
+// 补偿统计
+typedef struct {
+    uint32_t frames_processed;
+    uint32_t grids_loaded;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+} ROTS_EnvCompStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_EnvComp_Init(void);
+ROTS_StatusTypeDef ROTS_EnvComp_SetChannelGrid(uint8_t channel,
+                                               const float factors[ROTS_ENV_COMP_TEMP_POINTS * ROTS_ENV_COMP_HUM_POINTS]);
+ROTS_StatusTypeDef ROTS_EnvComp_GetChannelGrid(uint8_t channel,
+                                               float factors[ROTS_ENV_COMP_TEMP_POINTS * ROTS_ENV_COMP_HUM_POINTS]);
+ROTS_StatusTypeDef ROTS_EnvComp_LoadGrids(const uint16_t* grid, uint32_t length);
+void ROTS_EnvComp_ResetDefault(void);
+void ROTS_EnvComp_Apply(float* values, uint8_t channel_count, float temperature, float humidity);
+ROTS_StatusTypeDef ROTS_EnvComp_GetStats(ROTS_EnvCompStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_ENV_COMPENSATION_H */
@@ -0,0 +1,564 @@
+// ROTS Environment Sensors - BMP280/DHT22非阻塞驱动
+//
+// 两个传感器各自按固定周期启动转换, 由ROTS_EnvSensors_Update在主循环中
+// 推进状态机, 结果写入带时间戳的缓存; 采样帧只读取缓存, 不再等待总线.
+// BMP280: I2C强制模式, 启动转换后下一轮再读取结果.
+// DHT22: 起始信号由状态机保持, 数据位由下降沿中断记录时间, 结束后统一解码,
+// 不需要关中断忙等.
+#include "rots_sender.h"
+#include "rots_env_sensors.h"
+
+#ifdef ARDUINO
+#include "rots_debug.h"
+#endif
+
+// BMP280寄存器
+#define BMP280_REG_CALIB      0x88
+#define BMP280_REG_CHIP_ID    0xD0
+#define BMP280_REG_STATUS     0xF3
+#define BMP280_REG_CTRL_MEAS  0xF4
+#define BMP280_REG_CONFIG     0xF5
+#define BMP280_REG_DATA       0xF7
+#define BMP280_CHIP_ID        0x58
+#define BMP280_STATUS_MEASURING  0x08
+#define BMP280_CTRL_FORCED    0x2D   // osrs_t x1, osrs_p x4, 强制模式
+
+// DHT22时序
+#define DHT22_EDGE_CAPACITY   48
+#define DHT22_EDGE_COUNT      42     // 响应1个 + 引导1个 + 40个数据位
+#define DHT22_BIT_THRESHOLD_US  100  // 下降沿间隔: 0约76us, 1约120us
+
+// 驱动状态
+typedef enum {
+    ROTS_BMP280_IDLE = 0,
+    ROTS_BMP280_CONVERTING
+} ROTS_BMP280State_t;
+
+typedef enum {
+    ROTS_DHT22_IDLE = 0,
+    ROTS_DHT22_START,
+    ROTS_DHT22_RECEIVING
+} ROTS_DHT22State_t;
+
+// BMP280校准参数
+typedef struct {
+    uint16_t dig_T1;
+    int16_t dig_T2;
+    int16_t dig_T3;
+    uint16_t dig_P1;
+    int16_t dig_P2;
+    int16_t dig_P3;
+    int16_t dig_P4;
+    int16_t dig_P5;
+    int16_t dig_P6;
+    int16_t dig_P7;
+    int16_t dig_P8;
+    int16_t dig_P9;
+} ROTS_BMP280Calib_t;
+
+// 私有变量
+static const ROTS_EnvBus_t* env_bus = NULL;
+static ROTS_EnvReading_t env_reading;
+static ROTS_EnvStats_t env_stats;
+
+static ROTS_BMP280State_t bmp_state = ROTS_BMP280_IDLE;
+static ROTS_BMP280Calib_t bmp_calib;
+static uint32_t bmp_start_time = 0;
+static uint32_t bmp_probe_time = 0;
+static bool bmp_probed = false;
+static float bmp_temperature = 25.0f;
+
+static ROTS_DHT22State_t dht_state = ROTS_DHT22_IDLE;
+static uint32_t dht_start_time = 0;
+static bool dht_started = false;
+static volatile uint32_t dht_edges[DHT22_EDGE_CAPACITY];
+static volatile uint8_t dht_edge_count = 0;
+
+// 私有函数声明
+static void ROTS_EnvSensors_UpdateBMP280(uint32_t now_ms);
+static void ROTS_EnvSensors_UpdateDHT22(uint32_t now_ms);
+static bool ROTS_EnvSensors_ProbeBMP280(void);
+static bool ROTS_EnvSensors_ReadBMP280(float* temperature, float* pressure);
+static bool ROTS_EnvSensors_DecodeDHT22(float* temperature, float* humidity);
+static void ROTS_EnvSensors_DHT22DriveLow(void);
+static void ROTS_EnvSensors_DHT22Release(void);
+static void ROTS_EnvSensors_DHT22Finish(void);
+
+#ifdef ARDUINO
+static bool ROTS_EnvSensors_WireWrite(uint8_t address, uint8_t reg, uint8_t value);
+static bool ROTS_EnvSensors_WireRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+static const ROTS_EnvBus_t wire_bus = {
+    ROTS_EnvSensors_WireWrite,
+    ROTS_EnvSensors_WireRead
+};
+#else
+// 主机构建: BMP280模拟寄存器 (数据手册示例校准值, 约25.08°C/1006.5hPa)
+static uint8_t mock_bmp280_regs[256];
+static float mock_dht_temperature = 23.5f;
+static float mock_dht_humidity = 45.0f;
+static uint8_t mock_faults = ROTS_ENV_MOCK_NONE;
+
+static bool ROTS_EnvSensors_MockWrite(uint8_t address, uint8_t reg, uint8_t value);
+static bool ROTS_EnvSensors_MockRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+static const ROTS_EnvBus_t mock_bus = {
+    ROTS_EnvSensors_MockWrite,
+    ROTS_EnvSensors_MockRead
+};
+#endif
+
+// 初始化环境传感器
+ROTS_StatusTypeDef ROTS_EnvSensors_Init(void) {
+    memset(&env_stats, 0, sizeof(ROTS_EnvStats_t));
+    memset(&env_reading, 0, sizeof(ROTS_EnvReading_t));
+    env_reading.temperature = 25.0f;
+    env_reading.humidity = 50.0f;
+    env_reading.pressure = 1013.25f;
+
+    bmp_state = ROTS_BMP280_IDLE;
+    bmp_probed = false;
+    dht_state = ROTS_DHT22_IDLE;
+    dht_started = false;
+
+#ifdef ARDUINO
+    Wire.begin(ROTS_SDA_PIN, ROTS_SCL_PIN);
+    Wire.setClock(400000);
+    pinMode(ROTS_DHT22_PIN, INPUT_PULLUP);
+    env_bus = &wire_bus;
+#else
+    // 模拟寄存器: 芯片ID与校准参数
+    static const uint8_t calib[24] = {
+        0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC,   // T1=27504 T2=26435 T3=-1000
+        0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B,   // P1=36477 P2=-10685 P3=3024
+        0x27, 0x0B, 0x8C, 0x00, 0xF9, 0xFF,   // P4=2855 P5=140 P6=-7
+        0x8C, 0x3C, 0xF8, 0xC6, 0x70, 0x17    // P7=15500 P8=-14600 P9=6000
+    };
+    static const uint8_t data[6] = {
+        0x65, 0x5A, 0xC0,                     // adc_P = 415148
+        0x7E, 0xED, 0x00                      // adc_T = 519888
+    };
+    memset(mock_bmp280_regs, 0, sizeof(mock_bmp280_regs));
+    memcpy(&mock_bmp280_regs[BMP280_REG_CALIB], calib, sizeof(calib));
+    memcpy(&mock_bmp280_regs[BMP280_REG_DATA], data, sizeof(data));
+    mock_bmp280_regs[BMP280_REG_CHIP_ID] = BMP280_CHIP_ID;
+    mock_faults = ROTS_ENV_MOCK_NONE;
+    env_bus = &mock_bus;
+#endif
+
+    return ROTS_OK;
+}
+
+// 替换I2C总线实现 (用于模拟或共享总线)
+ROTS_StatusTypeDef ROTS_EnvSensors_SetBus(const ROTS_EnvBus_t* bus) {
+    if (!bus || !bus->write_reg || !bus->read_regs) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    env_bus = bus;
+    bmp_state = ROTS_BMP280_IDLE;
+    bmp_probed = false;
+    env_stats.bmp280_present = false;
+    return ROTS_OK;
+}
+
+// 推进两个传感器的状态机 (每次主循环调用, 不阻塞)
+void ROTS_EnvSensors_Update(uint32_t now_ms) {
+    if (!env_bus) {
+        return;
+    }
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+
+    ROTS_EnvSensors_UpdateBMP280(now_ms);
+    ROTS_EnvSensors_UpdateDHT22(now_ms);
+
+    uint32_t cycles = ROTS_CYCLE_COUNT() - start;
+    env_stats.last_update_cycles = cycles;
+    if (cycles > env_stats.max_update_cycles) {
+        env_stats.max_update_cycles = cycles;
+    }
+}
+
+// 获取最新缓存读数
+ROTS_StatusTypeDef ROTS_EnvSensors_GetReading(ROTS_EnvReading_t* reading) {
+    if (!reading) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(reading, &env_reading, sizeof(ROTS_EnvReading_t));
+    return ROTS_OK;
+}
+
+// 三项读数中最陈旧的一项的时间 (尚无读数时返回UINT32_MAX)
+uint32_t ROTS_EnvSensors_GetAge(const ROTS_EnvReading_t* reading, uint32_t now_ms) {
+    if (!reading || !reading->temperature_valid || !reading->humidity_valid || !reading->pressure_valid) {
+        return UINT32_MAX;
+    }
+
+    uint32_t age = now_ms - reading->temperature_time;
+    if (now_ms - reading->humidity_time > age) age = now_ms - reading->humidity_time;
+    if (now_ms - reading->pressure_time > age) age = now_ms - reading->pressure_time;
+    return age;
+}
+
+// 获取驱动统计
+ROTS_StatusTypeDef ROTS_EnvSensors_GetStats(ROTS_EnvStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &env_stats, sizeof(ROTS_EnvStats_t));
+    return ROTS_OK;
+}
+
+// BMP280: 周期性启动强制模式转换, 转换完成后读取
+static void ROTS_EnvSensors_UpdateBMP280(uint32_t now_ms) {
+    if (!env_stats.bmp280_present) {
+        if (bmp_probed && now_ms - bmp_probe_time < ROTS_BMP280_PROBE_INTERVAL_MS) {
+            return;
+        }
+        bmp_probed = true;
+        bmp_probe_time = now_ms;
+        if (!ROTS_EnvSensors_ProbeBMP280()) {
+            return;
+        }
+        env_stats.bmp280_present = true;
+        bmp_state = ROTS_BMP280_IDLE;
+        bmp_start_time = now_ms - ROTS_BMP280_INTERVAL_MS;
+    }
+
+    switch (bmp_state) {
+        case ROTS_BMP280_IDLE:
+            if (now_ms - bmp_start_time >= ROTS_BMP280_INTERVAL_MS) {
+                if (env_bus->write_reg(ROTS_BMP280_I2C_ADDRESS, BMP280_REG_CTRL_MEAS, BMP280_CTRL_FORCED)) {
+                    bmp_state = ROTS_BMP280_CONVERTING;
+                } else {
+                    // 总线错误后重新探测
+                    env_stats.bmp280_errors++;
+                    env_stats.bmp280_present = false;
+                }
+                bmp_start_time = now_ms;
+            }
+            break;
+
+        case ROTS_BMP280_CONVERTING: {
+            if (now_ms - bmp_start_time < ROTS_BMP280_CONVERSION_MS) {
+                break;
+            }
+
+            uint8_t status = 0;
+            bool ok = env_bus->read_regs(ROTS_BMP280_I2C_ADDRESS, BMP280_REG_STATUS, &status, 1);
+            if (ok && (status & BMP280_STATUS_MEASURING) &&
+                now_ms - bmp_start_time < ROTS_BMP280_TIMEOUT_MS) {
+                break;
+            }
+
+            float temperature, pressure;
+            if (ok && !(status & BMP280_STATUS_MEASURING) &&
+                ROTS_EnvSensors_ReadBMP280(&temperature, &pressure)) {
+                bmp_temperature = temperature;
+                env_reading.pressure = pressure;
+                env_reading.pressure_valid = true;
+                env_reading.pressure_time = now_ms;
+
+                // DHT22读数陈旧时以BMP280温度代替
+                if (!env_reading.temperature_valid ||
+                    now_ms - env_reading.temperature_time > ROTS_ENV_STALE_MS) {
+                    env_reading.temperature = bmp_temperature;
+                    env_reading.temperature_valid = true;
+                    env_reading.temperature_time = now_ms;
+                }
+                env_stats.bmp280_reads++;
+            } else {
+                env_stats.bmp280_errors++;
+                if (!ok) {
+                    // 总线错误后重新探测
+                    env_stats.bmp280_present = false;
+                }
+            }
+            bmp_state = ROTS_BMP280_IDLE;
+            break;
+        }
+    }
+}
+
+// DHT22: 起始信号 -> 释放总线并记录下降沿 -> 解码
+static void ROTS_EnvSensors_UpdateDHT22(uint32_t now_ms) {
+    switch (dht_state) {
+        case ROTS_DHT22_IDLE:
+            if (!dht_started || now_ms - dht_start_time >= ROTS_DHT22_INTERVAL_MS) {
+                dht_started = true;
+                dht_start_time = now_ms;
+                ROTS_EnvSensors_DHT22DriveLow();
+                dht_state = ROTS_DHT22_START;
+            }
+            break;
+
+        case ROTS_DHT22_START:
+            if (now_ms - dht_start_time >= ROTS_DHT22_START_MS) {
+                dht_edge_count = 0;
+                ROTS_EnvSensors_DHT22Release();
+                dht_state = ROTS_DHT22_RECEIVING;
+            }
+            break;
+
+        case ROTS_DHT22_RECEIVING:
+            if (now_ms - dht_start_time >= ROTS_DHT22_START_MS + ROTS_DHT22_RECEIVE_MS) {
+                ROTS_EnvSensors_DHT22Finish();
+
+                float temperature, humidity;
+                if (ROTS_EnvSensors_DecodeDHT22(&temperature, &humidity)) {
+                    env_reading.temperature = temperature;
+                    env_reading.temperature_valid = true;
+                    env_reading.temperature_time = now_ms;
+                    env_reading.humidity = humidity;
+                    env_reading.humidity_valid = true;
+                    env_reading.humidity_time = now_ms;
+                    env_stats.dht22_reads++;
+                } else {
+                    env_stats.dht22_errors++;
+                }
+                dht_state = ROTS_DHT22_IDLE;
+            }
+            break;
+    }
+}
+
+// 检测BMP280并读取校准参数
+static bool ROTS_EnvSensors_ProbeBMP280(void) {
+    uint8_t chip_id = 0;
+    if (!env_bus->read_regs(ROTS_BMP280_I2C_ADDRESS, BMP280_REG_CHIP_ID, &chip_id, 1) ||
+        chip_id != BMP280_CHIP_ID) {
+        return false;
+    }
+
+    uint8_t raw[24];
+    if (!env_bus->read_regs(ROTS_BMP280_I2C_ADDRESS, BMP280_REG_CALIB, raw, sizeof(raw))) {
+        return false;
+    }
+
+    // 校准参数为小端16位
+    uint16_t words[12];
+    for (int i = 0; i < 12; i++) {
+        words[i] = (uint16_t)(raw[2 * i] | (raw[2 * i + 1] << 8));
+    }
+    bmp_calib.dig_T1 = words[0];
+    bmp_calib.dig_T2 = (int16_t)words[1];
+    bmp_calib.dig_T3 = (int16_t)words[2];
+    bmp_calib.dig_P1 = words[3];
+    bmp_calib.dig_P2 = (int16_t)words[4];
+    bmp_calib.dig_P3 = (int16_t)words[5];
+    bmp_calib.dig_P4 = (int16_t)words[6];
+    bmp_calib.dig_P5 = (int16_t)words[7];
+    bmp_calib.dig_P6 = (int16_t)words[8];
+    bmp_calib.dig_P7 = (int16_t)words[9];
+    bmp_calib.dig_P8 = (int16_t)words[10];
+    bmp_calib.dig_P9 = (int16_t)words[11];
+
+    // 关闭IIR滤波, 休眠模式 (每次由强制模式触发)
+    return env_bus->write_reg(ROTS_BMP280_I2C_ADDRESS, BMP280_REG_CONFIG, 0x00);
+}
+
+// 读取转换结果并按数据手册整数公式补偿
+static bool ROTS_EnvSensors_ReadBMP280(float* temperature, float* pressure) {
+    uint8_t data[6];
+    if (!env_bus->read_regs(ROTS_BMP280_I2C_ADDRESS, BMP280_REG_DATA, data, sizeof(data))) {
+        return false;
+    }
+
+    int32_t adc_P = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+    int32_t adc_T = ((int32_t)data[3] << 12) | ((int32_t)data[4] << 4) | (data[5] >> 4);
+    if (adc_T == 0x80000 || adc_P == 0x80000) {
+        // 跳过测量时的复位值
+        return false;
+    }
+
+    // 温度 (0.01°C)
+    int32_t var1 = ((((adc_T >> 3) - ((int32_t)bmp_calib.dig_T1 << 1))) * ((int32_t)bmp_calib.dig_T2)) >> 11;
+    int32_t var2 = (((((adc_T >> 4) - ((int32_t)bmp_calib.dig_T1)) *
+                      ((adc_T >> 4) - ((int32_t)bmp_calib.dig_T1))) >> 12) *
+                    ((int32_t)bmp_calib.dig_T3)) >> 14;
+    int32_t t_fine = var1 + var2;
+    *temperature = (float)((t_fine * 5 + 128) >> 8) / 100.0f;
+
+    // 气压 (Q24.8 Pa)
+    int64_t p_var1 = (int64_t)t_fine - 128000;
+    int64_t p_var2 = p_var1 * p_var1 * (int64_t)bmp_calib.dig_P6;
+    p_var2 = p_var2 + ((p_var1 * (int64_t)bmp_calib.dig_P5) << 17);
+    p_var2 = p_var2 + (((int64_t)bmp_calib.dig_P4) << 35);
+    p_var1 = ((p_var1 * p_var1 * (int64_t)bmp_calib.dig_P3) >> 8) + ((p_var1 * (int64_t)bmp_calib.dig_P2) << 12);
+    p_var1 = ((((int64_t)1) << 47) + p_var1) * ((int64_t)bmp_calib.dig_P1) >> 33;
+    if (p_var1 == 0) {
+        return false;
+    }
+
+    int64_t p = 1048576 - adc_P;
+    p = (((p << 31) - p_var2) * 3125) / p_var1;
+    p_var1 = (((int64_t)bmp_calib.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    p_var2 = (((int64_t)bmp_calib.dig_P8) * p) >> 19;
+    p = ((p + p_var1 + p_var2) >> 8) + (((int64_t)bmp_calib.dig_P7) << 4);
+
+    *pressure = (float)p / 256.0f / 100.0f;
+    return *temperature >= ROTS_BMP280_TEMP_MIN && *temperature <= ROTS_BMP280_TEMP_MAX &&
+           *pressure >= ROTS_BMP280_PRESSURE_MIN && *pressure <= ROTS_BMP280_PRESSURE_MAX;
+}
+
+// 由下降沿时间戳解码40位数据并校验
+static bool ROTS_EnvSensors_DecodeDHT22(float* temperature, float* humidity) {
+    if (dht_edge_count < DHT22_EDGE_COUNT) {
+        return false;
+    }
+
+    // 第0个沿为传感器响应, 第1个沿为引导信号结束, 其后每两沿之间为一位
+    uint8_t bytes[5] = {0, 0, 0, 0, 0};
+    for (int bit = 0; bit < 40; bit++) {
+        uint32_t interval = dht_edges[bit + 2] - dht_edges[bit + 1];
+        bytes[bit >> 3] = (uint8_t)((bytes[bit >> 3] << 1) | (interval > DHT22_BIT_THRESHOLD_US ? 1 : 0));
+    }
+
+    if ((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) {
+        return false;
+    }
+
+    *humidity = (float)((bytes[0] << 8) | bytes[1]) / 10.0f;
+    float magnitude = (float)(((bytes[2] & 0x7F) << 8) | bytes[3]) / 10.0f;
+    *temperature = (bytes[2] & 0x80) ? -magnitude : magnitude;
+
+    return *humidity <= 100.0f && *temperature >= ROTS_DHT22_TEMP_MIN && *temperature <= ROTS_DHT22_TEMP_MAX;
+}
+
+#ifdef ARDUINO
+// DHT22数据线下降沿中断
+static void IRAM_ATTR ROTS_EnvSensors_DHT22EdgeISR(void) {
+    uint8_t count = dht_edge_count;
+    if (count < DHT22_EDGE_CAPACITY) {
+        dht_edges[count] = micros();
+        dht_edge_count = count + 1;
+    }
+}
+
+// 拉低数据线发送起始信号
+static void ROTS_EnvSensors_DHT22DriveLow(void) {
+    pinMode(ROTS_DHT22_PIN, OUTPUT);
+    digitalWrite(ROTS_DHT22_PIN, LOW);
+}
+
+// 先挂中断再释放数据线, 传感器在20-40us后响应
+static void ROTS_EnvSensors_DHT22Release(void) {
+    attachInterrupt(digitalPinToInterrupt(ROTS_DHT22_PIN), ROTS_EnvSensors_DHT22EdgeISR, FALLING);
+    pinMode(ROTS_DHT22_PIN, INPUT_PULLUP);
+}
+
+static void ROTS_EnvSensors_DHT22Finish(void) {
+    detachInterrupt(digitalPinToInterrupt(ROTS_DHT22_PIN));
+}
+
+// Wire写单个寄存器
+static bool ROTS_EnvSensors_WireWrite(uint8_t address, uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+// Wire连续读寄存器
+static bool ROTS_EnvSensors_WireRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0) {
+        return false;
+    }
+    if (Wire.requestFrom(address, length) != length) {
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = (uint8_t)Wire.read();
+    }
+    return true;
+}
+#else
+// 设置模拟DHT22读数
+void ROTS_EnvSensors_MockSetDHT22(float temperature, float humidity) {
+    mock_dht_temperature = temperature;
+    mock_dht_humidity = humidity;
+}
+
+// 设置模拟BMP280转换结果 (数据寄存器为20位左对齐)
+void ROTS_EnvSensors_MockSetBMP280(uint32_t adc_T, uint32_t adc_P) {
+    mock_bmp280_regs[BMP280_REG_DATA + 0] = (uint8_t)(adc_P >> 12);
+    mock_bmp280_regs[BMP280_REG_DATA + 1] = (uint8_t)(adc_P >> 4);
+    mock_bmp280_regs[BMP280_REG_DATA + 2] = (uint8_t)((adc_P & 0x0F) << 4);
+    mock_bmp280_regs[BMP280_REG_DATA + 3] = (uint8_t)(adc_T >> 12);
+    mock_bmp280_regs[BMP280_REG_DATA + 4] = (uint8_t)(adc_T >> 4);
+    mock_bmp280_regs[BMP280_REG_DATA + 5] = (uint8_t)((adc_T & 0x0F) << 4);
+}
+
+// 设置模拟故障
+void ROTS_EnvSensors_MockSetFault(uint8_t faults) {
+    mock_faults = faults;
+}
+
+static void ROTS_EnvSensors_DHT22DriveLow(void) {
+}
+
+// 按DHT22时序合成下降沿时间戳, 走与硬件相同的解码路径
+static void ROTS_EnvSensors_DHT22Release(void) {
+    if (mock_faults & ROTS_ENV_MOCK_DHT22_SILENT) {
+        dht_edge_count = 0;
+        return;
+    }
+
+    uint16_t humidity = (uint16_t)(mock_dht_humidity * 10.0f + 0.5f);
+    float magnitude = fabsf(mock_dht_temperature);
+    uint16_t temperature = (uint16_t)(magnitude * 10.0f + 0.5f);
+    if (mock_dht_temperature < 0.0f) temperature |= 0x8000;
+
+    uint8_t bytes[5];
+    bytes[0] = (uint8_t)(humidity >> 8);
+    bytes[1] = (uint8_t)humidity;
+    bytes[2] = (uint8_t)(temperature >> 8);
+    bytes[3] = (uint8_t)temperature;
+    bytes[4] = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+    if (mock_faults & ROTS_ENV_MOCK_DHT22_CHECKSUM) {
+        bytes[4] ^= 0x01;
+    }
+
+    uint32_t t = 30;
+    uint8_t count = 0;
+    dht_edges[count++] = t;
+    t += 160;
+    dht_edges[count++] = t;
+    for (int bit = 0; bit < 40; bit++) {
+        bool one = (bytes[bit >> 3] >> (7 - (bit & 7))) & 1;
+        t += one ? 120 : 76;
+        dht_edges[count++] = t;
+    }
+    dht_edge_count = count;
+}
+
+static void ROTS_EnvSensors_DHT22Finish(void) {
+}
+
+// 模拟寄存器写: 强制模式立即完成转换 (模拟转换卡住时保持转换中)
+static bool ROTS_EnvSensors_MockWrite(uint8_t address, uint8_t reg, uint8_t value) {
+    if (address != ROTS_BMP280_I2C_ADDRESS || (mock_faults & ROTS_ENV_MOCK_I2C_NACK)) {
+        return false;
+    }
+
+    mock_bmp280_regs[reg] = value;
+    if (reg == BMP280_REG_CTRL_MEAS) {
+        mock_bmp280_regs[BMP280_REG_STATUS] = (mock_faults & ROTS_ENV_MOCK_BMP280_BUSY) ? BMP280_STATUS_MEASURING : 0;
+    }
+    return true;
+}
+
+static bool ROTS_EnvSensors_MockRead(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    if (address != ROTS_BMP280_I2C_ADDRESS || reg + length > 256 || (mock_faults & ROTS_ENV_MOCK_I2C_NACK)) {
+        return false;
+    }
+
+    memcpy(data, &mock_bmp280_regs[reg], length);
+    return true;
+}
+#endif
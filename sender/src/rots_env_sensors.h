@@ -0,0 +1,90 @@
+// ROTS Environment Sensors Header
+#ifndef ROTS_ENV_SENSORS_H
+#define ROTS_ENV_SENSORS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 环境传感器配置
+#define ROTS_BMP280_I2C_ADDRESS        0x76
+#define ROTS_BMP280_INTERVAL_MS        1000    // 气压/温度转换周期
+#define ROTS_BMP280_CONVERSION_MS      15      // 强制模式转换时间 (T x1, P x4)
+#define ROTS_BMP280_TIMEOUT_MS         100
+#define ROTS_BMP280_PROBE_INTERVAL_MS  5000    // 未检测到传感器时的重试周期
+#define ROTS_DHT22_INTERVAL_MS         2000    // DHT22最小采样周期
+#define ROTS_DHT22_START_MS            2       // 主机起始信号低电平时间 (>=1ms)
+#define ROTS_DHT22_RECEIVE_MS          10      // 等待40位数据的时间 (约5ms)
+#define ROTS_ENV_STALE_MS              5000    // 超过此时间的读数视为陈旧
+
+// 数据手册工作范围, 超出的读数视为错误
+#define ROTS_BMP280_TEMP_MIN           -40.0f  // °C
+#define ROTS_BMP280_TEMP_MAX           85.0f
+#define ROTS_BMP280_PRESSURE_MIN       300.0f  // hPa
+#define ROTS_BMP280_PRESSURE_MAX       1100.0f
+#define ROTS_DHT22_TEMP_MIN            -40.0f  // °C
+#define ROTS_DHT22_TEMP_MAX            80.0f
+
+// I2C总线操作 (主机构建可替换为模拟寄存器)
+typedef struct {
+    bool (*write_reg)(uint8_t address, uint8_t reg, uint8_t value);
+    bool (*read_regs)(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+} ROTS_EnvBus_t;
+
+// 环境读数缓存
+typedef struct {
+    float temperature;          // 温度 (°C), DHT22优先, 陈旧时使用BMP280
+    float humidity;             // 相对湿度 (%)
+    float pressure;             // 气压 (hPa)
+    bool temperature_valid;
+    bool humidity_valid;
+    bool pressure_valid;
+    uint32_t temperature_time;  // 最近一次有效读数时间 (ms)
+    uint32_t humidity_time;
+    uint32_t pressure_time;
+} ROTS_EnvReading_t;
+
+// 驱动统计
+typedef struct {
+    bool bmp280_present;
+    uint32_t bmp280_reads;
+    uint32_t bmp280_errors;
+    uint32_t dht22_reads;
+    uint32_t dht22_errors;      // 超时或校验失败
+    uint32_t last_update_cycles;
+    uint32_t max_update_cycles;
+} ROTS_EnvStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_EnvSensors_Init(void);
+ROTS_StatusTypeDef ROTS_EnvSensors_SetBus(const ROTS_EnvBus_t* bus);
+void ROTS_EnvSensors_Update(uint32_t now_ms);
+ROTS_StatusTypeDef ROTS_EnvSensors_GetReading(ROTS_EnvReading_t* reading);
+uint32_t ROTS_EnvSensors_GetAge(const ROTS_EnvReading_t* reading, uint32_t now_ms);
+ROTS_StatusTypeDef ROTS_EnvSensors_GetStats(ROTS_EnvStats_t* stats);
+
+#ifndef ARDUINO
+// 主机构建: 模拟总线故障
+typedef enum {
+    ROTS_ENV_MOCK_NONE = 0x00,
+    ROTS_ENV_MOCK_I2C_NACK = 0x01,      // BMP280读写均无应答
+    ROTS_ENV_MOCK_BMP280_BUSY = 0x02,   // 状态寄存器一直为转换中
+    ROTS_ENV_MOCK_DHT22_SILENT = 0x04,  // DHT22不响应起始信号
+    ROTS_ENV_MOCK_DHT22_CHECKSUM = 0x08 // DHT22校验和错误
+} ROTS_EnvMockFault_t;
+
+// 主机构建: 设置模拟DHT22下一次输出的读数
+void ROTS_EnvSensors_MockSetDHT22(float temperature, float humidity);
+// 主机构建: 设置模拟BMP280的原始转换结果 (20位)
+void ROTS_EnvSensors_MockSetBMP280(uint32_t adc_T, uint32_t adc_P);
+// 主机构建: 设置故障 (ROTS_EnvMockFault_t按位组合)
+void ROTS_EnvSensors_MockSetFault(uint8_t faults);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_ENV_SENSORS_H */
@@ -0,0 +1,262 @@
+// ROTS Heater Scheduler - MQ加热循环调度
+//
+// MQ-7/MQ-9的CO读数只在低压相末尾有意义, 高压相用于清洁敏感层.
+// 调度器按显式传入的时间推进相位 (主机构建可用模拟时钟), 由PWM输出
+// 低压相的等效加热功率. 每个原始采样按所处相位打标签; 落在低压相末尾
+// 窗口内的采样取平均, 在相位切换时锁存, 之后该通道只导出锁存值.
+#include "rots_sender.h"
+#include "rots_heater_scheduler.h"
+
+// 单个加热器状态
+typedef struct {
+    ROTS_HeaterConfig_t config;
+    ROTS_HeaterPhase_t phase;
+    uint8_t low_duty;
+    uint32_t phase_start;
+    uint32_t window_sum;
+    uint16_t window_count;
+    bool latched;
+    uint16_t latched_code;
+    uint32_t cycles;
+} ROTS_Heater_t;
+
+// 私有变量
+static ROTS_Heater_t heaters[ROTS_HEATER_MAX];
+static uint8_t heater_count = 0;
+static const ROTS_HeaterDriver_t* heater_driver = NULL;
+static uint32_t window_samples = 0;
+static uint32_t empty_windows = 0;
+
+// 私有函数声明
+static void ROTS_HeaterScheduler_EnterPhase(uint8_t id, ROTS_HeaterPhase_t phase);
+static void ROTS_HeaterScheduler_LatchWindow(ROTS_Heater_t* heater);
+static ROTS_HeaterPhase_t ROTS_HeaterScheduler_Tag(const ROTS_Heater_t* heater, uint32_t now_ms);
+static uint8_t ROTS_HeaterScheduler_Duty(const ROTS_Heater_t* heater, ROTS_HeaterPhase_t phase);
+
+#ifdef ARDUINO
+static void ROTS_HeaterScheduler_LedcSetDuty(uint8_t heater, uint8_t pin, uint8_t duty);
+
+static const ROTS_HeaterDriver_t ledc_driver = {
+    ROTS_HeaterScheduler_LedcSetDuty
+};
+#else
+// 主机构建: 输出只记录在统计中
+static void ROTS_HeaterScheduler_MockSetDuty(uint8_t heater, uint8_t pin, uint8_t duty);
+
+static const ROTS_HeaterDriver_t mock_driver = {
+    ROTS_HeaterScheduler_MockSetDuty
+};
+#endif
+
+// 初始化调度器 (清空加热器列表)
+ROTS_StatusTypeDef ROTS_HeaterScheduler_Init(void) {
+    memset(heaters, 0, sizeof(heaters));
+    heater_count = 0;
+    window_samples = 0;
+    empty_windows = 0;
+
+#ifdef ARDUINO
+    heater_driver = &ledc_driver;
+#else
+    heater_driver = &mock_driver;
+#endif
+
+    return ROTS_OK;
+}
+
+// 替换加热输出实现
+ROTS_StatusTypeDef ROTS_HeaterScheduler_SetDriver(const ROTS_HeaterDriver_t* driver) {
+    if (!driver || !driver->set_duty) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    heater_driver = driver;
+    return ROTS_OK;
+}
+
+// 添加加热器, 从高压相开始
+ROTS_StatusTypeDef ROTS_HeaterScheduler_Add(const ROTS_HeaterConfig_t* config, uint32_t now_ms) {
+    if (!config || heater_count >= ROTS_HEATER_MAX || config->channel >= ROTS_MAX_CHANNELS ||
+        config->high_ms == 0 || config->low_ms == 0 || config->window_ms > config->low_ms ||
+        config->low_mv > ROTS_HEATER_SUPPLY_MV) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    for (uint8_t id = 0; id < heater_count; id++) {
+        if (heaters[id].config.channel == config->channel) {
+            return ROTS_INVALID_PARAM;
+        }
+    }
+
+    uint8_t id = heater_count;
+    ROTS_Heater_t* heater = &heaters[id];
+    memset(heater, 0, sizeof(ROTS_Heater_t));
+    memcpy(&heater->config, config, sizeof(ROTS_HeaterConfig_t));
+
+    // 加热功率与电压平方成正比
+    float ratio = (float)config->low_mv / ROTS_HEATER_SUPPLY_MV;
+    heater->low_duty = (uint8_t)(255.0f * ratio * ratio + 0.5f);
+
+#ifdef ARDUINO
+    ledcSetup(id, ROTS_HEATER_PWM_FREQ_HZ, ROTS_HEATER_PWM_BITS);
+    ledcAttachPin(config->pin, id);
+#endif
+
+    heater_count++;
+    heater->phase_start = now_ms;
+    ROTS_HeaterScheduler_EnterPhase(id, ROTS_HEATER_PHASE_HIGH);
+    return ROTS_OK;
+}
+
+// 推进相位 (不阻塞, 可重复调用)
+void ROTS_HeaterScheduler_Update(uint32_t now_ms) {
+    for (uint8_t id = 0; id < heater_count; id++) {
+        ROTS_Heater_t* heater = &heaters[id];
+        uint32_t period = heater->config.high_ms + heater->config.low_ms;
+
+        // 长时间未调用时跳过整周期, 错过的窗口记为空窗口
+        uint32_t elapsed = now_ms - heater->phase_start;
+        if (elapsed >= period) {
+            uint32_t skipped = elapsed / period;
+            heater->phase_start += skipped * period;
+            heater->cycles += skipped;
+            empty_windows += skipped;
+            heater->window_sum = 0;
+            heater->window_count = 0;
+        }
+
+        uint32_t length = heater->phase == ROTS_HEATER_PHASE_HIGH ? heater->config.high_ms : heater->config.low_ms;
+        while (now_ms - heater->phase_start >= length) {
+            heater->phase_start += length;
+            if (heater->phase == ROTS_HEATER_PHASE_HIGH) {
+                ROTS_HeaterScheduler_EnterPhase(id, ROTS_HEATER_PHASE_LOW);
+                length = heater->config.low_ms;
+            } else {
+                ROTS_HeaterScheduler_LatchWindow(heater);
+                heater->cycles++;
+                ROTS_HeaterScheduler_EnterPhase(id, ROTS_HEATER_PHASE_HIGH);
+                length = heater->config.high_ms;
+            }
+        }
+    }
+}
+
+// 处理一帧原始码值: 为加热循环通道打相位标签, 累计有效窗口采样,
+// 并以锁存值替换 (尚无锁存值时保留实时读数). phases可为NULL
+void ROTS_HeaterScheduler_Process(uint16_t* raw, uint8_t* phases, uint8_t channel_count, uint32_t now_ms) {
+    if (!raw) {
+        return;
+    }
+
+    ROTS_HeaterScheduler_Update(now_ms);
+
+    if (phases) {
+        memset(phases, ROTS_HEATER_PHASE_CONTINUOUS, channel_count);
+    }
+
+    for (uint8_t id = 0; id < heater_count; id++) {
+        ROTS_Heater_t* heater = &heaters[id];
+        uint8_t ch = heater->config.channel;
+        if (ch >= channel_count) {
+            continue;
+        }
+
+        ROTS_HeaterPhase_t tag = ROTS_HeaterScheduler_Tag(heater, now_ms);
+        if (phases) {
+            phases[ch] = (uint8_t)tag;
+        }
+
+        if (tag == ROTS_HEATER_PHASE_LOW_END) {
+            heater->window_sum += raw[ch];
+            heater->window_count++;
+            window_samples++;
+        }
+
+        if (heater->latched) {
+            raw[ch] = heater->latched_code;
+        }
+    }
+}
+
+// 查询通道当前相位 (无加热循环的通道返回CONTINUOUS)
+ROTS_HeaterPhase_t ROTS_HeaterScheduler_GetPhase(uint8_t channel, uint32_t now_ms) {
+    for (uint8_t id = 0; id < heater_count; id++) {
+        if (heaters[id].config.channel == channel) {
+            return ROTS_HeaterScheduler_Tag(&heaters[id], now_ms);
+        }
+    }
+    return ROTS_HEATER_PHASE_CONTINUOUS;
+}
+
+// 获取调度统计
+ROTS_StatusTypeDef ROTS_HeaterScheduler_GetStats(ROTS_HeaterStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memset(stats, 0, sizeof(ROTS_HeaterStats_t));
+    stats->heater_count = heater_count;
+    for (uint8_t id = 0; id < heater_count; id++) {
+        const ROTS_Heater_t* heater = &heaters[id];
+        stats->phase[id] = (uint8_t)heater->phase;
+        stats->duty[id] = ROTS_HeaterScheduler_Duty(heater, heater->phase);
+        stats->latched[id] = heater->latched;
+        stats->latched_code[id] = heater->latched_code;
+        stats->cycles[id] = heater->cycles;
+    }
+    stats->window_samples = window_samples;
+    stats->empty_windows = empty_windows;
+    return ROTS_OK;
+}
+
+// 切换相位并更新输出
+static void ROTS_HeaterScheduler_EnterPhase(uint8_t id, ROTS_HeaterPhase_t phase) {
+    ROTS_Heater_t* heater = &heaters[id];
+    heater->phase = phase;
+    heater->window_sum = 0;
+    heater->window_count = 0;
+    heater_driver->set_duty(id, heater->config.pin, ROTS_HeaterScheduler_Duty(heater, phase));
+}
+
+// 低压相结束: 锁存窗口平均值
+static void ROTS_HeaterScheduler_LatchWindow(ROTS_Heater_t* heater) {
+    if (heater->window_count == 0) {
+        empty_windows++;
+        return;
+    }
+
+    heater->latched_code = (uint16_t)((heater->window_sum + heater->window_count / 2) / heater->window_count);
+    heater->latched = true;
+}
+
+// 计算采样时刻的相位标签
+static ROTS_HeaterPhase_t ROTS_HeaterScheduler_Tag(const ROTS_Heater_t* heater, uint32_t now_ms) {
+    if (heater->phase == ROTS_HEATER_PHASE_HIGH) {
+        return ROTS_HEATER_PHASE_HIGH;
+    }
+
+    uint32_t elapsed = now_ms - heater->phase_start;
+    if (elapsed + heater->config.window_ms >= heater->config.low_ms) {
+        return ROTS_HEATER_PHASE_LOW_END;
+    }
+    return ROTS_HEATER_PHASE_LOW;
+}
+
+// 相位对应的占空比
+static uint8_t ROTS_HeaterScheduler_Duty(const ROTS_Heater_t* heater, ROTS_HeaterPhase_t phase) {
+    return phase == ROTS_HEATER_PHASE_HIGH ? 255 : heater->low_duty;
+}
+
+#ifdef ARDUINO
+// LEDC输出 (每个加热器占用一个LEDC通道)
+static void ROTS_HeaterScheduler_LedcSetDuty(uint8_t heater, uint8_t pin, uint8_t duty) {
+    (void)pin;
+    ledcWrite(heater, duty);
+}
+#else
+static void ROTS_HeaterScheduler_MockSetDuty(uint8_t heater, uint8_t pin, uint8_t duty) {
+    (void)heater;
+    (void)pin;
+    (void)duty;
+}
+#endif
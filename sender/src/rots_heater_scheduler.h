@@ -0,0 +1,66 @@
+// ROTS Heater Scheduler Header
+#ifndef ROTS_HEATER_SCHEDULER_H
+#define ROTS_HEATER_SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 调度器配置
+#define ROTS_HEATER_MAX                4
+#define ROTS_HEATER_PWM_FREQ_HZ        1000
+#define ROTS_HEATER_PWM_BITS           8
+#define ROTS_HEATER_SUPPLY_MV          5000    // 加热供电 (高压相满占空比)
+#define ROTS_HEATER_SAMPLE_WINDOW_MS   1000    // 低压相末尾的有效采样窗口
+
+// MQ-7/MQ-9 数据手册加热循环: 5V 60s清洁, 低压 90s测量
+#define ROTS_MQ7_HEATER_HIGH_MS        60000
+#define ROTS_MQ7_HEATER_LOW_MS         90000
+#define ROTS_MQ7_HEATER_LOW_MV         1400
+#define ROTS_MQ9_HEATER_HIGH_MS        60000
+#define ROTS_MQ9_HEATER_LOW_MS         90000
+#define ROTS_MQ9_HEATER_LOW_MV         1500
+
+// 单个加热器配置
+typedef struct {
+    uint8_t channel;        // 对应的采样通道 (ROTS_ChannelIndex_t)
+    uint8_t pin;            // 加热控制引脚 (MOSFET栅极)
+    uint32_t high_ms;       // 高压相时长
+    uint32_t low_ms;        // 低压相时长
+    uint16_t low_mv;        // 低压相等效电压 (按加热功率换算占空比)
+    uint32_t window_ms;     // 低压相末尾采样窗口
+} ROTS_HeaterConfig_t;
+
+// 加热输出 (duty为0-255)
+typedef struct {
+    void (*set_duty)(uint8_t heater, uint8_t pin, uint8_t duty);
+} ROTS_HeaterDriver_t;
+
+// 调度统计
+typedef struct {
+    uint8_t heater_count;
+    uint8_t phase[ROTS_HEATER_MAX];         // ROTS_HeaterPhase_t
+    uint8_t duty[ROTS_HEATER_MAX];
+    bool latched[ROTS_HEATER_MAX];          // 是否已有完整窗口的读数
+    uint16_t latched_code[ROTS_HEATER_MAX];
+    uint32_t cycles[ROTS_HEATER_MAX];
+    uint32_t window_samples;                // 进入有效窗口的采样数
+    uint32_t empty_windows;                 // 窗口内没有采样 (采样间隔过长或主循环停顿)
+} ROTS_HeaterStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_HeaterScheduler_Init(void);
+ROTS_StatusTypeDef ROTS_HeaterScheduler_SetDriver(const ROTS_HeaterDriver_t* driver);
+ROTS_StatusTypeDef ROTS_HeaterScheduler_Add(const ROTS_HeaterConfig_t* config, uint32_t now_ms);
+void ROTS_HeaterScheduler_Update(uint32_t now_ms);
+void ROTS_HeaterScheduler_Process(uint16_t* raw, uint8_t* phases, uint8_t channel_count, uint32_t now_ms);
+ROTS_HeaterPhase_t ROTS_HeaterScheduler_GetPhase(uint8_t channel, uint32_t now_ms);
+ROTS_StatusTypeDef ROTS_HeaterScheduler_GetStats(ROTS_HeaterStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_HEATER_SCHEDULER_H */
@@ -0,0 +1,163 @@
+// ROTS Model Blob - 模型容器校验
+//
+// 固件与主机打包工具共用, 保证两侧对格式的理解一致.
+#include "rots_sender.h"
+#include "rots_model_blob.h"
+#include "rots_ai_model.h"
+#include "rots_ai_quant.h"
+
+static_assert(sizeof(ROTS_ModelBlobHeader_t) == 32, "model blob header must be 32 bytes");
+static_assert(sizeof(ROTS_ModelBlobLayer_t) == 32, "model blob layer entry must be 32 bytes");
+static_assert(sizeof(ROTS_ModelBlobSection_t) == 16, "model blob section entry must be 16 bytes");
+
+// 私有函数声明
+static bool ROTS_ModelBlob_InRange(uint32_t offset, uint32_t length, uint32_t size, uint32_t align);
+
+// CRC32 (IEEE 802.3, 反射多项式0xEDB88320), 按半字节查表
+uint32_t ROTS_ModelBlob_Crc32(uint32_t crc, const uint8_t* data, uint32_t length) {
+    static const uint32_t nibble_table[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+        0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0F];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// 校验容器: 头, 层表, 层间宽度, 段表, 各段边界与对齐, CRC
+ROTS_StatusTypeDef ROTS_ModelBlob_Validate(const uint8_t* blob, uint32_t size) {
+    if (!blob || size < sizeof(ROTS_ModelBlobHeader_t) || ((uintptr_t)blob & (ROTS_MODEL_ALIGN - 1)) != 0) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    if (header->magic != ROTS_MODEL_MAGIC || header->version != ROTS_MODEL_VERSION ||
+        header->header_size != sizeof(ROTS_ModelBlobHeader_t) ||
+        header->total_size > size || header->layer_count == 0 ||
+        header->layer_count > ROTS_AI_MAX_LAYERS || header->section_slots > ROTS_MODEL_MAX_SECTIONS ||
+        header->inputs == 0 || header->inputs > ROTS_AI_MAX_WIDTH ||
+        !(header->temperature == 0.0f || (header->temperature >= ROTS_AI_MIN_TEMPERATURE &&
+                                          header->temperature <= ROTS_AI_MAX_TEMPERATURE))) {
+        return ROTS_ERROR;
+    }
+
+    uint32_t table_size = (uint32_t)header->layer_count * sizeof(ROTS_ModelBlobLayer_t);
+    uint32_t section_table_size = (uint32_t)header->section_slots * sizeof(ROTS_ModelBlobSection_t);
+    if (!ROTS_ModelBlob_InRange(header->header_size, table_size + section_table_size, header->total_size, 4)) {
+        return ROTS_ERROR;
+    }
+
+    // 先校验CRC, 再解读层表
+    uint32_t crc = ROTS_ModelBlob_Crc32(0, blob + header->header_size, header->total_size - header->header_size);
+    if (crc != header->crc32) {
+        return ROTS_ERROR;
+    }
+
+    uint16_t width = header->inputs;
+    for (uint8_t l = 0; l < header->layer_count; l++) {
+        const ROTS_ModelBlobLayer_t* layer = ROTS_ModelBlob_GetLayer(blob, l);
+        if (layer->inputs != width) {
+            return ROTS_ERROR;
+        }
+
+        switch (layer->type) {
+            case ROTS_AI_LAYER_DENSE:
+                if (layer->outputs == 0 || layer->outputs > ROTS_AI_MAX_WIDTH ||
+                    layer->stride != ROTS_AI_QUANT_PADDED(layer->inputs) || !(layer->weight_scale > 0.0f) ||
+                    !ROTS_ModelBlob_InRange(layer->weight_offset, (uint32_t)layer->stride * layer->outputs,
+                                            header->total_size, ROTS_MODEL_ALIGN) ||
+                    !ROTS_ModelBlob_InRange(layer->row_sum_offset, layer->outputs * sizeof(int32_t),
+                                            header->total_size, 4)) {
+                    return ROTS_ERROR;
+                }
+                if ((layer->flags & ROTS_AI_LAYER_FLAG_BIAS) &&
+                    !ROTS_ModelBlob_InRange(layer->bias_offset, layer->outputs * sizeof(float),
+                                            header->total_size, 4)) {
+                    return ROTS_ERROR;
+                }
+                break;
+
+            case ROTS_AI_LAYER_RELU:
+            case ROTS_AI_LAYER_SOFTMAX:
+                if (layer->outputs != layer->inputs) {
+                    return ROTS_ERROR;
+                }
+                break;
+
+            default:
+                return ROTS_ERROR;
+        }
+        width = layer->outputs;
+    }
+
+    if (width != header->outputs) {
+        return ROTS_ERROR;
+    }
+
+    // 附加段: 边界与对齐; 已知类型再核对大小
+    for (uint8_t s = 0; s < header->section_slots; s++) {
+        const ROTS_ModelBlobSection_t* section = ROTS_ModelBlob_GetSectionEntry(blob, s);
+        if (section->type == ROTS_MODEL_SECTION_NONE) {
+            continue;
+        }
+        if (!ROTS_ModelBlob_InRange(section->offset, section->size, header->total_size, 4)) {
+            return ROTS_ERROR;
+        }
+        if (section->type == ROTS_MODEL_SECTION_NOVELTY &&
+            section->size != ROTS_MODEL_NOVELTY_SIZE(header->inputs, header->outputs)) {
+            return ROTS_ERROR;
+        }
+        if (section->type == ROTS_MODEL_SECTION_INTENSITY &&
+            section->size != ROTS_MODEL_INTENSITY_SIZE(header->inputs, header->outputs)) {
+            return ROTS_ERROR;
+        }
+    }
+
+    return ROTS_OK;
+}
+
+// 获取容器头
+const ROTS_ModelBlobHeader_t* ROTS_ModelBlob_GetHeader(const uint8_t* blob) {
+    return (const ROTS_ModelBlobHeader_t*)blob;
+}
+
+// 获取层表项
+const ROTS_ModelBlobLayer_t* ROTS_ModelBlob_GetLayer(const uint8_t* blob, uint8_t index) {
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    return (const ROTS_ModelBlobLayer_t*)(blob + header->header_size) + index;
+}
+
+// 获取段表项
+const ROTS_ModelBlobSection_t* ROTS_ModelBlob_GetSectionEntry(const uint8_t* blob, uint8_t index) {
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    const uint8_t* table = blob + header->header_size + (uint32_t)header->layer_count * sizeof(ROTS_ModelBlobLayer_t);
+    return (const ROTS_ModelBlobSection_t*)table + index;
+}
+
+// 查找附加段 (须已通过校验), 没有该类型时返回NULL
+const void* ROTS_ModelBlob_FindSection(const uint8_t* blob, uint32_t type, uint32_t* size) {
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    for (uint8_t s = 0; s < header->section_slots; s++) {
+        const ROTS_ModelBlobSection_t* section = ROTS_ModelBlob_GetSectionEntry(blob, s);
+        if (section->type == type && type != ROTS_MODEL_SECTION_NONE) {
+            if (size) {
+                *size = section->size;
+            }
+            return blob + section->offset;
+        }
+    }
+    return NULL;
+}
+
+// 段是否位于数据段内且按要求对齐
+static bool ROTS_ModelBlob_InRange(uint32_t offset, uint32_t length, uint32_t size, uint32_t align) {
+    return (offset & (align - 1)) == 0 && offset >= sizeof(ROTS_ModelBlobHeader_t) &&
+           offset <= size && length <= size - offset;
+}
@@ -0,0 +1,81 @@
+// ROTS Model Blob Header
+#ifndef ROTS_MODEL_BLOB_H
+#define ROTS_MODEL_BLOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 模型容器格式 (小端, 偏移量均相对blob起始):
+//   [头 32B][层表 32B * layer_count][段表 16B * section_slots][数据段]
+// 数据段中int8权重按 [outputs][stride] 存放并16字节对齐, 行和为int32,
+// 偏置为float, 均4字节对齐. 固件直接在映射的Flash上执行, 不复制到RAM.
+// 段表为可选的附加数据 (随模型一同训练的统计量等), 旧容器section_slots为0;
+// 不认识的段类型被忽略.
+#define ROTS_MODEL_MAGIC          0x4C444D52UL  // "RMDL"
+#define ROTS_MODEL_VERSION        1
+#define ROTS_MODEL_ALIGN          16
+#define ROTS_MODEL_SECTION_SLOTS  4             // 打包工具预留的段表项数
+#define ROTS_MODEL_MAX_SECTIONS   8
+
+// 附加段类型
+#define ROTS_MODEL_SECTION_NONE     0   // 空表项
+#define ROTS_MODEL_SECTION_NOVELTY  1   // 新颖度统计量: float阈值, 均值[outputs][inputs], 逆方差[outputs][inputs]
+#define ROTS_MODEL_SECTION_INTENSITY 2  // 强度回归头: 权重[outputs][inputs], 偏置[outputs]
+#define ROTS_MODEL_NOVELTY_SIZE(inputs, outputs)    (4 + 2 * 4 * (uint32_t)(inputs) * (outputs))
+#define ROTS_MODEL_INTENSITY_SIZE(inputs, outputs)  (4 * ((uint32_t)(inputs) + 1) * (outputs))
+
+// 容器头
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;     // sizeof(ROTS_ModelBlobHeader_t)
+    uint32_t total_size;      // 整个blob字节数
+    uint32_t crc32;           // 头之后全部字节 (层表 + 数据段) 的CRC32
+    uint32_t model_id;        // 模型版本号, 由打包工具写入
+    uint16_t inputs;
+    uint16_t outputs;
+    uint8_t layer_count;
+    uint8_t section_slots;    // 段表项数 (0为无段表)
+    uint8_t reserved[2];
+    float temperature;        // 置信度校准温度, 0为未校准 (不在CRC范围内, 加载时校验取值)
+} ROTS_ModelBlobHeader_t;
+
+// 层表项
+typedef struct {
+    uint8_t type;             // ROTS_AILayerType_t
+    uint8_t flags;            // ROTS_AI_LAYER_FLAG_*
+    uint16_t inputs;
+    uint16_t outputs;
+    uint16_t stride;          // 权重行长度 (inputs补齐到16)
+    float weight_scale;       // 每张量量化参数
+    int32_t weight_zero_point;
+    uint32_t weight_offset;   // int8 [outputs][stride]
+    uint32_t row_sum_offset;  // int32 [outputs]
+    uint32_t bias_offset;     // float [outputs], 无偏置时为0
+    uint32_t reserved;
+} ROTS_ModelBlobLayer_t;
+
+// 段表项 (数据4字节对齐, 在CRC范围内)
+typedef struct {
+    uint32_t type;            // ROTS_MODEL_SECTION_*
+    uint32_t offset;
+    uint32_t size;
+    uint32_t reserved;
+} ROTS_ModelBlobSection_t;
+
+// 函数声明
+uint32_t ROTS_ModelBlob_Crc32(uint32_t crc, const uint8_t* data, uint32_t length);
+ROTS_StatusTypeDef ROTS_ModelBlob_Validate(const uint8_t* blob, uint32_t size);
+const ROTS_ModelBlobHeader_t* ROTS_ModelBlob_GetHeader(const uint8_t* blob);
+const ROTS_ModelBlobLayer_t* ROTS_ModelBlob_GetLayer(const uint8_t* blob, uint8_t index);
+const ROTS_ModelBlobSection_t* ROTS_ModelBlob_GetSectionEntry(const uint8_t* blob, uint8_t index);
+const void* ROTS_ModelBlob_FindSection(const uint8_t* blob, uint32_t type, uint32_t* size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_MODEL_BLOB_H */
@@ -0,0 +1,261 @@
+// ROTS Model Store - 模型分区映射与双槽位更新
+//
+// 两个模型分区整体映射到数据地址空间 (只读, 经Cache访问), AI模型运行时
+// 直接在映射区上执行. 更新时新模型顺序写入非活动槽位, 按扇区随写入
+// 进度擦除, 校验通过后才切换活动槽位并记入NVS; 写入过程中活动槽位
+// 不受影响, 断电或传输中断后仍从原模型启动.
+#include "rots_sender.h"
+#include "rots_model_store.h"
+#include "rots_model_blob.h"
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+#include <Preferences.h>
+#include "rots_debug.h"
+#endif
+
+// 私有变量
+static const uint8_t* slot_blob[ROTS_MODEL_SLOT_COUNT];
+static uint32_t slot_size[ROTS_MODEL_SLOT_COUNT];
+static bool store_initialized = false;
+static ROTS_ModelStoreStatus_t store_status;
+static uint32_t write_erased = 0;   // 已擦除到的偏移
+
+#ifdef ARDUINO
+static const esp_partition_t* slot_partition[ROTS_MODEL_SLOT_COUNT];
+static spi_flash_mmap_handle_t slot_handle[ROTS_MODEL_SLOT_COUNT];
+#else
+// 主机构建: 以缓冲模拟模型分区和NVS
+static uint8_t host_partition[ROTS_MODEL_SLOT_COUNT][ROTS_MODEL_PARTITION_SIZE] __attribute__((aligned(ROTS_MODEL_ALIGN)));
+static uint8_t host_active_slot = 0;
+#endif
+
+// 私有函数声明
+static bool ROTS_ModelStore_MapSlot(uint8_t slot);
+static ROTS_StatusTypeDef ROTS_ModelStore_EraseSector(uint8_t slot, uint32_t offset);
+static ROTS_StatusTypeDef ROTS_ModelStore_WriteSlot(uint8_t slot, uint32_t offset, const uint8_t* data, uint32_t length);
+static uint8_t ROTS_ModelStore_LoadActiveSlot(void);
+static void ROTS_ModelStore_SaveActiveSlot(uint8_t slot);
+static bool ROTS_ModelStore_SlotValid(uint8_t slot);
+
+// 映射模型分区并确定活动槽位
+ROTS_StatusTypeDef ROTS_ModelStore_Init(void) {
+    if (store_initialized) {
+        return ROTS_OK;
+    }
+
+    memset(&store_status, 0, sizeof(store_status));
+    for (uint8_t slot = 0; slot < ROTS_MODEL_SLOT_COUNT; slot++) {
+        if (ROTS_ModelStore_MapSlot(slot)) {
+            store_status.slot_count++;
+        }
+    }
+    if (!slot_blob[0]) {
+        return ROTS_ERROR;
+    }
+
+    // 记录的槽位无有效模型时 (首次烧录到另一槽位, 或更新写坏) 改用另一个
+    uint8_t active = ROTS_ModelStore_LoadActiveSlot();
+    if (active >= ROTS_MODEL_SLOT_COUNT || !slot_blob[active]) {
+        active = 0;
+    }
+    uint8_t other = active ^ 1;
+    if (!ROTS_ModelStore_SlotValid(active) && ROTS_ModelStore_SlotValid(other)) {
+        active = other;
+    }
+
+    store_status.active_slot = active;
+    store_initialized = true;
+    return ROTS_OK;
+}
+
+// 获取活动槽位内容 (未校验, 由调用方用ROTS_ModelBlob_Validate检查)
+ROTS_StatusTypeDef ROTS_ModelStore_GetBlob(const uint8_t** blob, uint32_t* size) {
+    if (!blob || !size) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (!store_initialized) {
+        return ROTS_ERROR;
+    }
+
+    *blob = slot_blob[store_status.active_slot];
+    *size = slot_size[store_status.active_slot];
+    return ROTS_OK;
+}
+
+// 开始向非活动槽位写入 (丢弃未完成的写入)
+ROTS_StatusTypeDef ROTS_ModelStore_BeginWrite(uint32_t size) {
+    if (!store_initialized || store_status.slot_count < ROTS_MODEL_SLOT_COUNT) {
+        return ROTS_ERROR;
+    }
+
+    uint8_t slot = store_status.active_slot ^ 1;
+    if (size < sizeof(ROTS_ModelBlobHeader_t) || size > slot_size[slot]) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    store_status.writing = true;
+    store_status.write_slot = slot;
+    store_status.write_size = size;
+    store_status.write_offset = 0;
+    write_erased = 0;
+    return ROTS_OK;
+}
+
+// 顺序写入下一段数据
+ROTS_StatusTypeDef ROTS_ModelStore_Write(const uint8_t* data, uint32_t length) {
+    if (!store_status.writing || !data) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (length > store_status.write_size - store_status.write_offset) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    // 擦除本段覆盖到的新扇区
+    uint32_t end = store_status.write_offset + length;
+    while (write_erased < end) {
+        ROTS_StatusTypeDef status = ROTS_ModelStore_EraseSector(store_status.write_slot, write_erased);
+        if (status != ROTS_OK) {
+            return status;
+        }
+        write_erased += ROTS_MODEL_SECTOR_SIZE;
+    }
+
+    ROTS_StatusTypeDef status = ROTS_ModelStore_WriteSlot(store_status.write_slot, store_status.write_offset, data, length);
+    if (status != ROTS_OK) {
+        return status;
+    }
+
+    store_status.write_offset = end;
+    return ROTS_OK;
+}
+
+// 写入完成, 返回新模型的映射地址 (调用方校验后再调用Activate)
+ROTS_StatusTypeDef ROTS_ModelStore_FinishWrite(const uint8_t** blob, uint32_t* size) {
+    if (!store_status.writing || !blob || !size) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (store_status.write_offset != store_status.write_size) {
+        return ROTS_ERROR;
+    }
+
+    store_status.writing = false;
+    *blob = slot_blob[store_status.write_slot];
+    *size = store_status.write_size;
+    return ROTS_OK;
+}
+
+// 放弃写入 (非活动槽位内容作废, 活动槽位不变)
+ROTS_StatusTypeDef ROTS_ModelStore_AbortWrite(void) {
+    store_status.writing = false;
+    return ROTS_OK;
+}
+
+// 将最近写入的槽位设为活动槽位
+ROTS_StatusTypeDef ROTS_ModelStore_Activate(void) {
+    if (!store_initialized || store_status.writing || store_status.slot_count < ROTS_MODEL_SLOT_COUNT) {
+        return ROTS_ERROR;
+    }
+
+    store_status.active_slot = store_status.write_slot;
+    store_status.activations++;
+    ROTS_ModelStore_SaveActiveSlot(store_status.active_slot);
+    return ROTS_OK;
+}
+
+// 获取存储状态
+ROTS_StatusTypeDef ROTS_ModelStore_GetStatus(ROTS_ModelStoreStatus_t* status) {
+    if (!status) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(status, &store_status, sizeof(ROTS_ModelStoreStatus_t));
+    return ROTS_OK;
+}
+
+// 槽位中是否有格式正确的模型
+static bool ROTS_ModelStore_SlotValid(uint8_t slot) {
+    return slot_blob[slot] && ROTS_ModelBlob_Validate(slot_blob[slot], slot_size[slot]) == ROTS_OK;
+}
+
+#ifdef ARDUINO
+// 查找并映射一个槽位
+static bool ROTS_ModelStore_MapSlot(uint8_t slot) {
+    const char* label = slot == 0 ? ROTS_MODEL_PARTITION_LABEL_A : ROTS_MODEL_PARTITION_LABEL_B;
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)ROTS_MODEL_PARTITION_SUBTYPE, label);
+    if (!partition) {
+        DEBUG_WARNING("Model partition '%s' not found\r\n", label);
+        return false;
+    }
+
+    const void* mapped = NULL;
+    if (esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &mapped, &slot_handle[slot]) != ESP_OK) {
+        DEBUG_ERROR("Model partition '%s' mmap failed\r\n", label);
+        return false;
+    }
+
+    slot_partition[slot] = partition;
+    slot_blob[slot] = (const uint8_t*)mapped;
+    slot_size[slot] = partition->size;
+    DEBUG_INFO("Model partition '%s' mapped at 0x%08lx (%lu bytes)\r\n", label, partition->address, slot_size[slot]);
+    return true;
+}
+
+// 擦除一个扇区 (写入Flash后映射区经Cache失效自动可见)
+static ROTS_StatusTypeDef ROTS_ModelStore_EraseSector(uint8_t slot, uint32_t offset) {
+    return esp_partition_erase_range(slot_partition[slot], offset, ROTS_MODEL_SECTOR_SIZE) == ESP_OK ? ROTS_OK : ROTS_ERROR;
+}
+
+static ROTS_StatusTypeDef ROTS_ModelStore_WriteSlot(uint8_t slot, uint32_t offset, const uint8_t* data, uint32_t length) {
+    return esp_partition_write(slot_partition[slot], offset, data, length) == ESP_OK ? ROTS_OK : ROTS_ERROR;
+}
+
+// NVS中记录的活动槽位
+static uint8_t ROTS_ModelStore_LoadActiveSlot(void) {
+    Preferences prefs;
+    if (!prefs.begin("rots_model", true)) {
+        return 0;
+    }
+
+    uint8_t slot = prefs.getUChar("slot", 0);
+    prefs.end();
+    return slot;
+}
+
+static void ROTS_ModelStore_SaveActiveSlot(uint8_t slot) {
+    Preferences prefs;
+    if (!prefs.begin("rots_model", false)) {
+        DEBUG_ERROR("Model slot save failed\r\n");
+        return;
+    }
+
+    prefs.putUChar("slot", slot);
+    prefs.end();
+}
+#else
+static bool ROTS_ModelStore_MapSlot(uint8_t slot) {
+    memset(host_partition[slot], 0xFF, ROTS_MODEL_PARTITION_SIZE);
+    slot_blob[slot] = host_partition[slot];
+    slot_size[slot] = ROTS_MODEL_PARTITION_SIZE;
+    return true;
+}
+
+static ROTS_StatusTypeDef ROTS_ModelStore_EraseSector(uint8_t slot, uint32_t offset) {
+    memset(&host_partition[slot][offset], 0xFF, ROTS_MODEL_SECTOR_SIZE);
+    return ROTS_OK;
+}
+
+static ROTS_StatusTypeDef ROTS_ModelStore_WriteSlot(uint8_t slot, uint32_t offset, const uint8_t* data, uint32_t length) {
+    memcpy(&host_partition[slot][offset], data, length);
+    return ROTS_OK;
+}
+
+static uint8_t ROTS_ModelStore_LoadActiveSlot(void) {
+    return host_active_slot;
+}
+
+static void ROTS_ModelStore_SaveActiveSlot(uint8_t slot) {
+    host_active_slot = slot;
+}
+#endif
@@ -0,0 +1,44 @@
+// ROTS Model Store Header
+#ifndef ROTS_MODEL_STORE_H
+#define ROTS_MODEL_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 模型分区: 两个槽位交替使用, 一个运行, 另一个接收更新 (见 partitions.csv)
+#define ROTS_MODEL_SLOT_COUNT         2
+#define ROTS_MODEL_PARTITION_LABEL_A  "model"
+#define ROTS_MODEL_PARTITION_LABEL_B  "model_b"
+#define ROTS_MODEL_PARTITION_SUBTYPE  0x40
+#define ROTS_MODEL_PARTITION_SIZE     0x40000
+#define ROTS_MODEL_SECTOR_SIZE        4096    // 按扇区随写入进度擦除
+
+// 存储状态
+typedef struct {
+    uint8_t slot_count;       // 找到并映射成功的槽位数
+    uint8_t active_slot;
+    bool writing;
+    uint8_t write_slot;
+    uint32_t write_size;
+    uint32_t write_offset;
+    uint32_t activations;     // 启动以来的槽位切换次数
+} ROTS_ModelStoreStatus_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_ModelStore_Init(void);
+ROTS_StatusTypeDef ROTS_ModelStore_GetBlob(const uint8_t** blob, uint32_t* size);
+ROTS_StatusTypeDef ROTS_ModelStore_BeginWrite(uint32_t size);
+ROTS_StatusTypeDef ROTS_ModelStore_Write(const uint8_t* data, uint32_t length);
+ROTS_StatusTypeDef ROTS_ModelStore_FinishWrite(const uint8_t** blob, uint32_t* size);
+ROTS_StatusTypeDef ROTS_ModelStore_AbortWrite(void);
+ROTS_StatusTypeDef ROTS_ModelStore_Activate(void);
+ROTS_StatusTypeDef ROTS_ModelStore_GetStatus(ROTS_ModelStoreStatus_t* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_MODEL_STORE_H */
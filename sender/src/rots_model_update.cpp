@@ -0,0 +1,272 @@
+// ROTS Model Update - 模型分块更新
+//
+// 接收分块帧并顺序写入非活动模型槽位 (rots_model_store), 同时累计
+// 整体CRC32; 结束帧到达后核对CRC并校验模型容器, 通过后交由AI引擎
+// 在两次推理之间切换. 协议处理与传输无关, 主机构建可直接喂帧测试.
+//
+// 帧处理在通信任务中, 切换在推理任务中. 状态READY为交接点: 通信任务写好
+// ready_blob/ready_size后以release发布READY, 推理任务以acquire读到READY后
+// 才取用, 切换完成后再以release发布ACTIVE/FAILED交还. READY期间通信任务
+// 不触碰模型槽位 (开始帧返回ROTS_BUSY).
+#include <atomic>
+
+#include "rots_sender.h"
+#include "rots_model_update.h"
+#include "rots_model_store.h"
+#include "rots_model_blob.h"
+
+static_assert(sizeof(ROTS_ModelFrameHeader_t) == 16, "model update frame header must be 16 bytes");
+
+// 私有变量
+static ROTS_ModelUpdateStatus_t update_status;     // 传输进度与帧计数 (仅通信任务写入)
+static std::atomic<uint8_t> update_state(ROTS_MODEL_UPDATE_IDLE);
+static std::atomic<uint32_t> update_completed(0);
+static std::atomic<uint32_t> update_failed(0);
+static std::atomic<int> update_error(ROTS_OK);
+static uint32_t expected_crc = 0;
+static uint32_t running_crc = 0;
+static uint32_t last_frame_time = 0;
+static const uint8_t* ready_blob = NULL;           // 由update_state的release/acquire保护
+static uint32_t ready_size = 0;
+
+// 私有函数声明
+static ROTS_StatusTypeDef ROTS_ModelUpdate_Begin(const ROTS_ModelFrameHeader_t* header, const uint8_t* data);
+static ROTS_StatusTypeDef ROTS_ModelUpdate_Data(const ROTS_ModelFrameHeader_t* header, const uint8_t* data);
+static ROTS_StatusTypeDef ROTS_ModelUpdate_End(const ROTS_ModelFrameHeader_t* header);
+static void ROTS_ModelUpdate_Fail(ROTS_StatusTypeDef error);
+
+// 初始化
+ROTS_StatusTypeDef ROTS_ModelUpdate_Init(void) {
+    memset(&update_status, 0, sizeof(update_status));
+    update_state.store(ROTS_MODEL_UPDATE_IDLE, std::memory_order_relaxed);
+    update_completed.store(0, std::memory_order_relaxed);
+    update_failed.store(0, std::memory_order_relaxed);
+    update_error.store(ROTS_OK, std::memory_order_relaxed);
+    ready_blob = NULL;
+    ready_size = 0;
+    return ROTS_ModelStore_Init();
+}
+
+// 处理一帧, 并填写应答
+ROTS_StatusTypeDef ROTS_ModelUpdate_HandleFrame(const uint8_t* frame, uint32_t length, uint32_t now_ms, ROTS_ModelUpdateAck_t* ack) {
+    ROTS_StatusTypeDef result = ROTS_INVALID_PARAM;
+    ROTS_ModelFrameHeader_t header;
+
+    if (frame && length >= sizeof(header)) {
+        memcpy(&header, frame, sizeof(header));
+        const uint8_t* data = frame + sizeof(header);
+        if (header.magic == ROTS_MODEL_UPDATE_MAGIC && header.length == length - sizeof(header) &&
+            header.length <= ROTS_MODEL_UPDATE_CHUNK_MAX) {
+            last_frame_time = now_ms;
+            update_status.frames++;
+
+            switch (header.type) {
+                case ROTS_MODEL_FRAME_BEGIN:
+                    result = ROTS_ModelUpdate_Begin(&header, data);
+                    break;
+
+                case ROTS_MODEL_FRAME_DATA:
+                    result = ROTS_ModelUpdate_Data(&header, data);
+                    break;
+
+                case ROTS_MODEL_FRAME_END:
+                    result = ROTS_ModelUpdate_End(&header);
+                    break;
+
+                case ROTS_MODEL_FRAME_ABORT:
+                    if (header.transfer_id == update_status.transfer_id &&
+                        update_state.load(std::memory_order_acquire) == ROTS_MODEL_UPDATE_RECEIVING) {
+                        ROTS_ModelStore_AbortWrite();
+                        update_state.store(ROTS_MODEL_UPDATE_IDLE, std::memory_order_release);
+                    }
+                    result = ROTS_OK;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    if (result != ROTS_OK) {
+        update_status.rejected_frames++;
+    }
+
+    if (ack) {
+        ROTS_ModelUpdate_GetAck(ack);
+        ack->result = result;
+    }
+    return result;
+}
+
+// 传输超时检查
+ROTS_StatusTypeDef ROTS_ModelUpdate_Poll(uint32_t now_ms) {
+    if (update_state.load(std::memory_order_acquire) == ROTS_MODEL_UPDATE_RECEIVING &&
+        now_ms - last_frame_time > ROTS_MODEL_UPDATE_TIMEOUT_MS) {
+        ROTS_ModelUpdate_Fail(ROTS_TIMEOUT);
+        return ROTS_TIMEOUT;
+    }
+    return ROTS_OK;
+}
+
+// 取出待切换的新模型 (由AI引擎在两次推理之间调用)
+ROTS_StatusTypeDef ROTS_ModelUpdate_TakeReady(const uint8_t** blob, uint32_t* size) {
+    if (!blob || !size) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (update_state.load(std::memory_order_acquire) != ROTS_MODEL_UPDATE_READY) {
+        return ROTS_ERROR;
+    }
+
+    *blob = ready_blob;
+    *size = ready_size;
+    return ROTS_OK;
+}
+
+// AI引擎切换结果: 成功则记为活动槽位, 否则保留原模型 (推理任务调用)
+ROTS_StatusTypeDef ROTS_ModelUpdate_Complete(ROTS_StatusTypeDef result) {
+    if (update_state.load(std::memory_order_acquire) != ROTS_MODEL_UPDATE_READY) {
+        return ROTS_ERROR;
+    }
+
+    if (result == ROTS_OK) {
+        result = ROTS_ModelStore_Activate();
+    }
+    if (result != ROTS_OK) {
+        ROTS_ModelUpdate_Fail(result);
+        return result;
+    }
+
+    update_completed.fetch_add(1, std::memory_order_relaxed);
+    update_state.store(ROTS_MODEL_UPDATE_ACTIVE, std::memory_order_release);
+    return ROTS_OK;
+}
+
+// 当前状态对应的应答
+ROTS_StatusTypeDef ROTS_ModelUpdate_GetAck(ROTS_ModelUpdateAck_t* ack) {
+    if (!ack) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    uint8_t state = update_state.load(std::memory_order_acquire);
+    ack->transfer_id = update_status.transfer_id;
+    ack->state = state;
+    ack->result = state == ROTS_MODEL_UPDATE_FAILED ? (ROTS_StatusTypeDef)update_error.load(std::memory_order_relaxed) : ROTS_OK;
+    ack->next_offset = update_status.received;
+    ack->total_size = update_status.total_size;
+    return ROTS_OK;
+}
+
+// 获取统计
+ROTS_StatusTypeDef ROTS_ModelUpdate_GetStatus(ROTS_ModelUpdateStatus_t* status) {
+    if (!status) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(status, &update_status, sizeof(ROTS_ModelUpdateStatus_t));
+    status->state = update_state.load(std::memory_order_acquire);
+    status->completed = update_completed.load(std::memory_order_relaxed);
+    status->failed = update_failed.load(std::memory_order_relaxed);
+    status->last_error = (ROTS_StatusTypeDef)update_error.load(std::memory_order_relaxed);
+    return ROTS_OK;
+}
+
+// 开始帧: 重发的同一开始帧直接应答, 新传输取代未完成的旧传输
+static ROTS_StatusTypeDef ROTS_ModelUpdate_Begin(const ROTS_ModelFrameHeader_t* header, const uint8_t* data) {
+    if (header->length != sizeof(uint32_t)) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    uint32_t crc;
+    memcpy(&crc, data, sizeof(crc));
+    uint8_t state = update_state.load(std::memory_order_acquire);
+    if (state == ROTS_MODEL_UPDATE_RECEIVING && header->transfer_id == update_status.transfer_id &&
+        header->value == update_status.total_size && crc == expected_crc) {
+        return ROTS_OK;
+    }
+
+    // 新模型尚未切换时, 旧模型仍在使用另一槽位, 不能开始写入
+    if (state == ROTS_MODEL_UPDATE_READY) {
+        return ROTS_BUSY;
+    }
+
+    ROTS_ModelStore_AbortWrite();
+    update_status.transfer_id = header->transfer_id;
+    update_status.total_size = header->value;
+    update_status.received = 0;
+    expected_crc = crc;
+    running_crc = 0;
+
+    ROTS_StatusTypeDef status = ROTS_ModelStore_BeginWrite(header->value);
+    if (status != ROTS_OK) {
+        ROTS_ModelUpdate_Fail(status);
+        return status;
+    }
+
+    update_state.store(ROTS_MODEL_UPDATE_RECEIVING, std::memory_order_release);
+    return ROTS_OK;
+}
+
+// 数据帧: 仅接受期望偏移处的块, 已写入的重发块直接应答
+static ROTS_StatusTypeDef ROTS_ModelUpdate_Data(const ROTS_ModelFrameHeader_t* header, const uint8_t* data) {
+    if (update_state.load(std::memory_order_acquire) != ROTS_MODEL_UPDATE_RECEIVING ||
+        header->transfer_id != update_status.transfer_id) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (header->value < update_status.received) {
+        return header->value + header->length <= update_status.received ? ROTS_OK : ROTS_ERROR;
+    }
+    if (header->value != update_status.received || header->length == 0) {
+        return ROTS_ERROR;
+    }
+
+    ROTS_StatusTypeDef status = ROTS_ModelStore_Write(data, header->length);
+    if (status != ROTS_OK) {
+        ROTS_ModelUpdate_Fail(status);
+        return status;
+    }
+
+    running_crc = ROTS_ModelBlob_Crc32(running_crc, data, header->length);
+    update_status.received += header->length;
+    return ROTS_OK;
+}
+
+// 结束帧: 核对整体CRC并校验模型容器
+static ROTS_StatusTypeDef ROTS_ModelUpdate_End(const ROTS_ModelFrameHeader_t* header) {
+    if (header->transfer_id != update_status.transfer_id) {
+        return ROTS_INVALID_PARAM;
+    }
+    uint8_t state = update_state.load(std::memory_order_acquire);
+    if (state == ROTS_MODEL_UPDATE_READY || state == ROTS_MODEL_UPDATE_ACTIVE) {
+        return ROTS_OK;
+    }
+    if (state != ROTS_MODEL_UPDATE_RECEIVING || header->value != update_status.total_size ||
+        update_status.received != update_status.total_size) {
+        return ROTS_ERROR;
+    }
+
+    const uint8_t* blob = NULL;
+    uint32_t size = 0;
+    ROTS_StatusTypeDef status = ROTS_ModelStore_FinishWrite(&blob, &size);
+    if (status == ROTS_OK && (running_crc != expected_crc || ROTS_ModelBlob_Validate(blob, size) != ROTS_OK)) {
+        status = ROTS_ERROR;
+    }
+    if (status != ROTS_OK) {
+        ROTS_ModelUpdate_Fail(status);
+        return status;
+    }
+
+    // 先写好交接内容, 再发布READY
+    ready_blob = blob;
+    ready_size = size;
+    update_state.store(ROTS_MODEL_UPDATE_READY, std::memory_order_release);
+    return ROTS_OK;
+}
+
+// 传输失败, 活动槽位不变
+static void ROTS_ModelUpdate_Fail(ROTS_StatusTypeDef error) {
+    ROTS_ModelStore_AbortWrite();
+    update_error.store(error, std::memory_order_relaxed);
+    update_failed.fetch_add(1, std::memory_order_relaxed);
+    update_state.store(ROTS_MODEL_UPDATE_FAILED, std::memory_order_release);
+}
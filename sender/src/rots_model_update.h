@@ -0,0 +1,85 @@
+// ROTS Model Update Header
+#ifndef ROTS_MODEL_UPDATE_H
+#define ROTS_MODEL_UPDATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 模型分块更新协议 (MQTT主题 ROTS_MQTT_TOPIC_MODEL, 二进制帧, 小端):
+//   [帧头 16B][数据]
+//   BEGIN: value = 模型总字节数, 数据 = 整个模型的CRC32 (4字节)
+//   DATA:  value = 本块在模型中的偏移, 数据 = 模型内容 (须按顺序, 重发的旧块被忽略)
+//   END:   value = 模型总字节数
+//   ABORT: 放弃当前传输
+// 每帧回复一条应答 (ROTS_MQTT_TOPIC_MODEL_ACK), 给出期望的下一偏移,
+// 发送端据此续传. 模型在两次推理之间切换, 新模型被AI引擎接受后才记为活动槽位.
+#define ROTS_MODEL_UPDATE_MAGIC       0x50554D52UL  // "RMUP"
+#define ROTS_MODEL_UPDATE_CHUNK_MAX   1024          // 单帧最大数据字节
+#define ROTS_MODEL_UPDATE_TIMEOUT_MS  30000         // 传输中断超时
+
+// 帧类型
+typedef enum {
+    ROTS_MODEL_FRAME_BEGIN = 0x01,
+    ROTS_MODEL_FRAME_DATA = 0x02,
+    ROTS_MODEL_FRAME_END = 0x03,
+    ROTS_MODEL_FRAME_ABORT = 0x04
+} ROTS_ModelFrameType_t;
+
+// 帧头
+typedef struct {
+    uint32_t magic;
+    uint8_t type;             // ROTS_ModelFrameType_t
+    uint8_t reserved;
+    uint16_t length;          // 帧头之后的数据字节数
+    uint32_t transfer_id;     // 由发送端选择, 同一次传输的各帧相同
+    uint32_t value;
+} ROTS_ModelFrameHeader_t;
+
+// 更新状态
+typedef enum {
+    ROTS_MODEL_UPDATE_IDLE = 0x00,
+    ROTS_MODEL_UPDATE_RECEIVING = 0x01,
+    ROTS_MODEL_UPDATE_READY = 0x02,       // 校验通过, 等待AI引擎切换
+    ROTS_MODEL_UPDATE_ACTIVE = 0x03,      // 新模型已生效
+    ROTS_MODEL_UPDATE_FAILED = 0x04
+} ROTS_ModelUpdateState_t;
+
+// 应答
+typedef struct {
+    uint32_t transfer_id;
+    uint8_t state;            // ROTS_ModelUpdateState_t
+    ROTS_StatusTypeDef result;
+    uint32_t next_offset;
+    uint32_t total_size;
+} ROTS_ModelUpdateAck_t;
+
+// 统计
+typedef struct {
+    uint8_t state;
+    uint32_t transfer_id;
+    uint32_t received;
+    uint32_t total_size;
+    uint32_t frames;
+    uint32_t rejected_frames;
+    uint32_t completed;
+    uint32_t failed;
+    ROTS_StatusTypeDef last_error;
+} ROTS_ModelUpdateStatus_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_ModelUpdate_Init(void);
+ROTS_StatusTypeDef ROTS_ModelUpdate_HandleFrame(const uint8_t* frame, uint32_t length, uint32_t now_ms, ROTS_ModelUpdateAck_t* ack);
+ROTS_StatusTypeDef ROTS_ModelUpdate_Poll(uint32_t now_ms);
+ROTS_StatusTypeDef ROTS_ModelUpdate_TakeReady(const uint8_t** blob, uint32_t* size);
+ROTS_StatusTypeDef ROTS_ModelUpdate_Complete(ROTS_StatusTypeDef result);
+ROTS_StatusTypeDef ROTS_ModelUpdate_GetAck(ROTS_ModelUpdateAck_t* ack);
+ROTS_StatusTypeDef ROTS_ModelUpdate_GetStatus(ROTS_ModelUpdateStatus_t* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_MODEL_UPDATE_H */
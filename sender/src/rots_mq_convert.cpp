@@ -0,0 +1,73 @@
+// ROTS MQ Convert - MQ传感器ADC码值到浓度的换算
+//
+// 公式换算用于构建查找表和低速的外部通道; 板载通道采样时只查表.
+// 不依赖Arduino, 固件与主机工具 (tools/rots_mq_lut_check.cpp) 共用.
+#include "rots_sender.h"
+#include "rots_mq_convert.h"
+
+// 私有函数声明
+static float ROTS_MQConvert_Unclamped(float calibrated_code);
+
+// 按公式计算校准后浓度
+float ROTS_MQConvert_Compute(uint16_t raw_value, float factor) {
+    float concentration = ROTS_MQConvert_Unclamped(raw_value * factor);
+    
+    // 限制浓度范围
+    if (concentration > ROTS_SENSOR_CONCENTRATION_MAX) concentration = ROTS_SENSOR_CONCENTRATION_MAX;
+    if (concentration < ROTS_SENSOR_CONCENTRATION_MIN) concentration = ROTS_SENSOR_CONCENTRATION_MIN;
+    
+    // 输出再乘校准系数 (与原ApplyCalibration一致)
+    return concentration * factor;
+}
+
+// 构建共用查找表的 [start, start + count) 段 (末段含右端点), 并累计量化与插值相对公式的最大相对误差
+void ROTS_MQConvert_BuildTable(uint16_t* table, uint16_t start, uint16_t count, float* max_error) {
+    uint32_t end = (uint32_t)start + count;
+    if (end > ROTS_MQ_LUT_ENTRIES) end = ROTS_MQ_LUT_ENTRIES;
+    
+    for (uint32_t x = start; x < end; x++) {
+        float exact = ROTS_MQConvert_Unclamped((float)x);
+        if (exact > ROTS_MQ_LUT_CEILING) exact = ROTS_MQ_LUT_CEILING;
+        
+        // 选取能容纳尾数的最小移位量, 保证12位有效精度
+        float units = exact / ROTS_MQ_LUT_SCALE;
+        uint32_t shift = 0;
+        uint32_t mantissa = (uint32_t)(units + 0.5f);
+        while (mantissa > ROTS_MQ_LUT_MANTISSA_MASK) {
+            shift++;
+            mantissa = (uint32_t)(units / (float)(1UL << shift) + 0.5f);
+        }
+        table[x] = (uint16_t)((shift << ROTS_MQ_LUT_MANTISSA_BITS) | mantissa);
+        
+        // 只统计限幅范围内的误差, 范围外的误差在查表限幅后不可见
+        if (exact >= ROTS_SENSOR_CONCENTRATION_MIN && exact <= ROTS_SENSOR_CONCENTRATION_MAX) {
+            float error = fabsf(ROTS_MQConvert_Decode(table[x]) - exact) / exact;
+            if (error > *max_error) *max_error = error;
+        }
+        
+        // 与前一项之间的插值误差 (取中点, 分段构建按顺序进行, 前一项已写入)
+        if (x > 0) {
+            float middle = ROTS_MQConvert_Unclamped((float)x - 0.5f);
+            if (middle >= ROTS_SENSOR_CONCENTRATION_MIN && middle <= ROTS_SENSOR_CONCENTRATION_MAX) {
+                float interpolated = 0.5f * (ROTS_MQConvert_Decode(table[x - 1]) + ROTS_MQConvert_Decode(table[x]));
+                float error = fabsf(interpolated - middle) / middle;
+                if (error > *max_error) *max_error = error;
+            }
+        }
+    }
+}
+
+// 校准后码值到未限幅浓度
+static float ROTS_MQConvert_Unclamped(float calibrated_code) {
+    // 转换为电压值 (0-3.3V, 已应用校准)
+    float calibrated_value = (calibrated_code * 3.3f) / 4095.0f;
+    
+    // 转换为电阻值 (假设RL=10kΩ)
+    float resistance = (3.3f - calibrated_value) * 10000.0f / calibrated_value;
+    
+    // 防止除零错误
+    if (resistance < 1.0f) resistance = 1.0f;
+    
+    // 转换为气体浓度 (简化计算)
+    return pow(10, (log10(resistance) - 2.0f) / 0.8f);
+}
@@ -0,0 +1,59 @@
+// ROTS MQ Convert Header
+#ifndef ROTS_MQ_CONVERT_H
+#define ROTS_MQ_CONVERT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 浓度查找表 (12位ADC): 按校准后码值 x = raw * factor 索引, 与校准系数无关, 全部板载通道共用.
+// 表项为16位块浮点定点值: 高4位移位量e, 低12位尾数m, 未限幅浓度 = (m << e) * ROTS_MQ_LUT_SCALE.
+// 查表时在相邻两项之间线性插值, 再限幅并乘校准系数; x >= ROTS_MQ_LUT_SIZE 时电阻已钳到下限, 取浓度下限
+#define ROTS_MQ_LUT_SIZE          4096
+#define ROTS_MQ_LUT_ENTRIES       (ROTS_MQ_LUT_SIZE + 1)   // 末项为插值右端点
+#define ROTS_MQ_LUT_MANTISSA_BITS 12
+#define ROTS_MQ_LUT_MANTISSA_MASK 0x0FFF
+#define ROTS_MQ_LUT_MAX_UNITS     (0x0FFFUL << 15)
+
+// 浓度限幅 (校准系数之前)
+#define ROTS_SENSOR_CONCENTRATION_MIN        0.1f
+#define ROTS_SENSOR_CONCENTRATION_MAX        1000.0f
+
+// 表项上限取限幅上限的2倍, 使上限拐点两侧的插值仍落在准确值附近
+#define ROTS_MQ_LUT_CEILING       (2.0f * ROTS_SENSOR_CONCENTRATION_MAX)
+#define ROTS_MQ_LUT_SCALE         (ROTS_MQ_LUT_CEILING / (float)ROTS_MQ_LUT_MAX_UNITS)
+
+// 函数声明
+float ROTS_MQConvert_Compute(uint16_t raw_value, float factor);
+void ROTS_MQConvert_BuildTable(uint16_t* table, uint16_t start, uint16_t count, float* max_error);
+
+static inline float ROTS_MQConvert_Decode(uint16_t code) {
+    uint32_t units = (uint32_t)(code & ROTS_MQ_LUT_MANTISSA_MASK) << (code >> ROTS_MQ_LUT_MANTISSA_BITS);
+    return (float)units * ROTS_MQ_LUT_SCALE;
+}
+
+// 查表换算 (采样热路径: 两次读表, 一次线性插值, 限幅后乘校准系数)
+static inline float ROTS_MQConvert_Lookup(const uint16_t* table, uint16_t raw_value, float factor) {
+    float x = (float)raw_value * factor;
+    float concentration = ROTS_SENSOR_CONCENTRATION_MIN;
+    
+    if (x < (float)ROTS_MQ_LUT_SIZE) {
+        uint32_t index = (uint32_t)x;
+        float lower = ROTS_MQConvert_Decode(table[index]);
+        float upper = ROTS_MQConvert_Decode(table[index + 1]);
+        concentration = lower + (upper - lower) * (x - (float)index);
+        
+        if (concentration > ROTS_SENSOR_CONCENTRATION_MAX) concentration = ROTS_SENSOR_CONCENTRATION_MAX;
+        if (concentration < ROTS_SENSOR_CONCENTRATION_MIN) concentration = ROTS_SENSOR_CONCENTRATION_MIN;
+    }
+    
+    return concentration * factor;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_MQ_CONVERT_H */
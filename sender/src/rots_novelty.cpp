@@ -0,0 +1,80 @@
+// ROTS Novelty - 分布外读数检测 (对角马氏距离)
+//
+// 特征布局与AI引擎一致: [通道值][环境3项][相邻通道比值][每通道时序特征].
+// 环境量随现场变化而非随气味变化, 不参与打分; 被屏蔽的通道在特征向量中为0,
+// 其相关特征同样跳过, 否则通道故障会被误判为新气味.
+#include "rots_sender.h"
+#include "rots_novelty.h"
+#include "rots_temporal_features.h"
+
+// 选出参与打分的特征下标, 返回个数
+uint16_t ROTS_Novelty_SelectFeatures(uint8_t channel_count, uint32_t channel_mask, uint8_t* used) {
+    uint16_t count = 0;
+    uint16_t ratio_base = channel_count + 3;
+    uint16_t temporal_base = ratio_base + channel_count / 2;
+
+    for (uint8_t ch = 0; ch < channel_count; ch++) {
+        if (channel_mask & (1UL << ch)) {
+            used[count++] = ch;
+        }
+    }
+    for (uint8_t pair = 0; pair < channel_count / 2; pair++) {
+        uint32_t bits = 3UL << (2 * pair);
+        if ((channel_mask & bits) == bits) {
+            used[count++] = (uint8_t)(ratio_base + pair);
+        }
+    }
+    for (uint8_t ch = 0; ch < channel_count; ch++) {
+        if (channel_mask & (1UL << ch)) {
+            for (uint8_t t = 0; t < ROTS_TEMPORAL_FEATURES; t++) {
+                used[count++] = (uint8_t)(temporal_base + ch * ROTS_TEMPORAL_FEATURES + t);
+            }
+        }
+    }
+    return count;
+}
+
+// 到最近类别的平均每维平方z值; means/inv_vars按 [classes][feature_count] 存放
+float ROTS_Novelty_Score(const float* features, const float* means, const float* inv_vars, uint16_t feature_count,
+                         uint8_t classes, const uint8_t* used, uint16_t used_count, uint8_t* nearest) {
+    if (used_count == 0 || classes == 0) {
+        return 0.0f;
+    }
+
+    float best = 0.0f;
+    uint8_t best_class = 0;
+    for (uint8_t c = 0; c < classes; c++) {
+        const float* mean = &means[c * feature_count];
+        const float* inv_var = &inv_vars[c * feature_count];
+
+        // 四路累加, 打断浮点加法的串行依赖
+        float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+        uint16_t i = 0;
+        for (; i + 4 <= used_count; i += 4) {
+            const uint8_t* f = &used[i];
+            float d0 = features[f[0]] - mean[f[0]];
+            float d1 = features[f[1]] - mean[f[1]];
+            float d2 = features[f[2]] - mean[f[2]];
+            float d3 = features[f[3]] - mean[f[3]];
+            acc0 += d0 * d0 * inv_var[f[0]];
+            acc1 += d1 * d1 * inv_var[f[1]];
+            acc2 += d2 * d2 * inv_var[f[2]];
+            acc3 += d3 * d3 * inv_var[f[3]];
+        }
+        for (; i < used_count; i++) {
+            float d = features[used[i]] - mean[used[i]];
+            acc0 += d * d * inv_var[used[i]];
+        }
+
+        float sum = (acc0 + acc1) + (acc2 + acc3);
+        if (c == 0 || sum < best) {
+            best = sum;
+            best_class = c;
+        }
+    }
+
+    if (nearest) {
+        *nearest = best_class;
+    }
+    return best / used_count;
+}
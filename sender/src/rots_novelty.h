@@ -0,0 +1,27 @@
+// ROTS Novelty Header
+#ifndef ROTS_NOVELTY_H
+#define ROTS_NOVELTY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 新颖度 (分布外检测): 每个训练类别保存特征均值和逆方差 (对角协方差之逆, 离线预先算好),
+// 读数到各类的按方差归一化平方距离 (对角马氏距离) 取最小值, 以平均每维平方z值表示.
+// 打分为一次 [类别 × 特征] 的矩阵-向量运算, 固件与打包工具共用.
+#define ROTS_NOVELTY_THRESHOLD       9.0f    // 默认阈值: 平均每维平方z值 (约3σ, 与原型查找一致)
+#define ROTS_NOVELTY_STD_FLOOR_RATIO 0.05f   // 拟合时标准差下限 (相对均值)
+#define ROTS_NOVELTY_STD_FLOOR       0.01f   // 拟合时标准差下限 (绝对值)
+
+// 函数声明
+uint16_t ROTS_Novelty_SelectFeatures(uint8_t channel_count, uint32_t channel_mask, uint8_t* used);
+float ROTS_Novelty_Score(const float* features, const float* means, const float* inv_vars, uint16_t feature_count,
+                         uint8_t classes, const uint8_t* used, uint16_t used_count, uint8_t* nearest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_NOVELTY_H */
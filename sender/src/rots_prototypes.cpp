@@ -0,0 +1,357 @@
+// ROTS Prototypes - 现场学习气味的最近原型分类
+//
+// 由MQTT命令触发, 在数秒内用当前特征向量增量更新一个原型的均值/方差,
+// 之后与模型分类并行使用, 无需重新训练和刷写固件.
+#include "rots_sender.h"
+#include "rots_prototypes.h"
+
+#ifdef ARDUINO
+#include <Preferences.h>
+#include "rots_debug.h"
+#endif
+
+#define ROTS_PROTO_STORE_MAGIC     0x524F5054UL  // "ROPT"
+#define ROTS_PROTO_STORE_VERSION   1
+
+// 原型槽位状态
+typedef enum {
+    ROTS_PROTO_FREE = 0,
+    ROTS_PROTO_LEARNING = 1,
+    ROTS_PROTO_READY = 2
+} ROTS_ProtoState_t;
+
+// 单个原型 (持久化部分)
+typedef struct {
+    char name[ROTS_PROTO_NAME_LENGTH];
+    uint32_t count;                         // 样本数, 0为空槽位
+    float mean[ROTS_PROTO_MAX_FEATURES];
+    float m2[ROTS_PROTO_MAX_FEATURES];      // 与均值差的平方和
+} ROTS_Prototype_t;
+
+// 持久化记录
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t feature_count;
+    ROTS_Prototype_t prototypes[ROTS_PROTO_MAX_CLASSES];
+} ROTS_ProtoRecord_t;
+
+// 私有变量
+static ROTS_Prototype_t prototypes[ROTS_PROTO_MAX_CLASSES];
+static uint8_t proto_state[ROTS_PROTO_MAX_CLASSES];
+static float proto_inv_std[ROTS_PROTO_MAX_CLASSES][ROTS_PROTO_MAX_FEATURES];  // 由均值/方差导出, 不保存
+static float proto_log_std[ROTS_PROTO_MAX_CLASSES];                           // 各维log标准差之和
+static uint8_t proto_features = 0;
+static ROTS_ProtoStats_t proto_stats;
+
+// 学习会话 (同一时间只有一个): 追加到已有原型时保留原值, 放弃时恢复
+static ROTS_Prototype_t session_backup;
+static int8_t session_slot = -1;
+static bool session_extends = false;
+static uint32_t session_samples = 0;
+
+// 持久化缓冲 (约4KB, 不放在任务栈上)
+static ROTS_ProtoRecord_t proto_record;
+
+#ifndef ARDUINO
+// 主机构建: 进程内模拟持久化存储
+static ROTS_ProtoRecord_t host_store;
+#endif
+
+// 私有函数声明
+static void ROTS_Prototypes_Prepare(uint8_t slot);
+static void ROTS_Prototypes_Persist(void);
+static bool ROTS_Prototypes_Load(ROTS_ProtoRecord_t* record);
+static bool ROTS_Prototypes_Save(const ROTS_ProtoRecord_t* record);
+
+// 初始化 (读取已保存的原型, 特征数不一致时忽略)
+ROTS_StatusTypeDef ROTS_Prototypes_Init(uint8_t feature_count) {
+    if (feature_count == 0 || feature_count > ROTS_PROTO_MAX_FEATURES) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memset(prototypes, 0, sizeof(prototypes));
+    memset(proto_state, ROTS_PROTO_FREE, sizeof(proto_state));
+    memset(&proto_stats, 0, sizeof(proto_stats));
+    proto_features = feature_count;
+    proto_stats.feature_count = feature_count;
+    session_slot = -1;
+
+    if (ROTS_Prototypes_Load(&proto_record) &&
+        proto_record.magic == ROTS_PROTO_STORE_MAGIC &&
+        proto_record.version == ROTS_PROTO_STORE_VERSION &&
+        proto_record.feature_count == feature_count) {
+        for (uint8_t slot = 0; slot < ROTS_PROTO_MAX_CLASSES; slot++) {
+            const ROTS_Prototype_t* stored = &proto_record.prototypes[slot];
+            if (stored->count < ROTS_PROTO_MIN_SAMPLES || stored->name[0] == '\0' ||
+                stored->name[ROTS_PROTO_NAME_LENGTH - 1] != '\0') {
+                continue;
+            }
+            prototypes[slot] = *stored;
+            ROTS_Prototypes_Prepare(slot);
+            proto_stats.restored = true;
+        }
+    }
+    return ROTS_OK;
+}
+
+// 开始学习: 同名原型存在时追加样本, 否则占用空槽位
+ROTS_StatusTypeDef ROTS_Prototypes_Begin(const char* name, uint8_t* slot) {
+    if (!name || !slot || name[0] == '\0' || strlen(name) >= ROTS_PROTO_NAME_LENGTH) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (session_slot >= 0) {
+        return ROTS_BUSY;
+    }
+
+    int8_t found = -1;
+    int8_t free_slot = -1;
+    for (uint8_t s = 0; s < ROTS_PROTO_MAX_CLASSES; s++) {
+        if (proto_state[s] == ROTS_PROTO_READY && strcmp(prototypes[s].name, name) == 0) {
+            found = (int8_t)s;
+        } else if (proto_state[s] == ROTS_PROTO_FREE && free_slot < 0) {
+            free_slot = (int8_t)s;
+        }
+    }
+
+    if (found >= 0) {
+        session_backup = prototypes[found];
+        session_extends = true;
+        session_slot = found;
+    } else if (free_slot >= 0) {
+        memset(&prototypes[free_slot], 0, sizeof(ROTS_Prototype_t));
+        strcpy(prototypes[free_slot].name, name);
+        session_extends = false;
+        session_slot = free_slot;
+    } else {
+        return ROTS_MEMORY_ERROR;
+    }
+
+    proto_state[session_slot] = ROTS_PROTO_LEARNING;
+    session_samples = 0;
+    *slot = (uint8_t)session_slot;
+    return ROTS_OK;
+}
+
+// 加入一个样本 (Welford增量均值/方差)
+ROTS_StatusTypeDef ROTS_Prototypes_AddSample(uint8_t slot, const float* features) {
+    if (!features || slot != session_slot) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    ROTS_Prototype_t* proto = &prototypes[slot];
+    proto->count++;
+    float inverse = 1.0f / proto->count;
+    for (uint8_t f = 0; f < proto_features; f++) {
+        float delta = features[f] - proto->mean[f];
+        proto->mean[f] += delta * inverse;
+        proto->m2[f] += delta * (features[f] - proto->mean[f]);
+    }
+    session_samples++;
+    return ROTS_OK;
+}
+
+// 结束学习: 本次样本足够时生效并保存, 否则放弃
+ROTS_StatusTypeDef ROTS_Prototypes_Commit(uint8_t slot) {
+    if (slot != session_slot) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (session_samples < ROTS_PROTO_MIN_SAMPLES) {
+        ROTS_Prototypes_Abort(slot);
+        return ROTS_ERROR;
+    }
+
+    ROTS_Prototypes_Prepare(slot);
+    session_slot = -1;
+    ROTS_Prototypes_Persist();
+    return ROTS_OK;
+}
+
+// 放弃学习 (追加时恢复原值)
+void ROTS_Prototypes_Abort(uint8_t slot) {
+    if (slot != session_slot) {
+        return;
+    }
+
+    if (session_extends) {
+        prototypes[slot] = session_backup;
+        proto_state[slot] = ROTS_PROTO_READY;
+    } else {
+        memset(&prototypes[slot], 0, sizeof(ROTS_Prototype_t));
+        proto_state[slot] = ROTS_PROTO_FREE;
+    }
+    session_slot = -1;
+}
+
+// 删除原型并保存
+ROTS_StatusTypeDef ROTS_Prototypes_Remove(const char* name) {
+    if (!name) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    for (uint8_t s = 0; s < ROTS_PROTO_MAX_CLASSES; s++) {
+        if (proto_state[s] == ROTS_PROTO_READY && strcmp(prototypes[s].name, name) == 0) {
+            memset(&prototypes[s], 0, sizeof(ROTS_Prototype_t));
+            proto_state[s] = ROTS_PROTO_FREE;
+            ROTS_Prototypes_Persist();
+            return ROTS_OK;
+        }
+    }
+    return ROTS_INVALID_PARAM;
+}
+
+// 查找最近原型: 在ROTS_PROTO_MAX_DISTANCE以内返回ROTS_OK, 否则ROTS_BUSY (match仍填写最近者)
+ROTS_StatusTypeDef ROTS_Prototypes_Match(const float* features, ROTS_ProtoMatch_t* match) {
+    if (!features || !match) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+    proto_stats.lookups++;
+
+    // 各原型的对角高斯对数似然 (省略公共常数) 与平均平方z值
+    float log_likelihood[ROTS_PROTO_MAX_CLASSES];
+    float best_likelihood = 0.0f;
+    int8_t best = -1;
+    for (uint8_t s = 0; s < ROTS_PROTO_MAX_CLASSES; s++) {
+        if (proto_state[s] != ROTS_PROTO_READY) {
+            continue;
+        }
+
+        const float* mean = prototypes[s].mean;
+        const float* inv_std = proto_inv_std[s];
+        float sum = 0.0f;
+        for (uint8_t f = 0; f < proto_features; f++) {
+            float z = (features[f] - mean[f]) * inv_std[f];
+            sum += z * z;
+        }
+        log_likelihood[s] = -0.5f * sum - proto_log_std[s];
+        if (best < 0 || log_likelihood[s] > best_likelihood) {
+            best = (int8_t)s;
+            best_likelihood = log_likelihood[s];
+            match->distance = sum / proto_features;
+        }
+    }
+
+    if (best < 0) {
+        proto_stats.lookup_cycles = ROTS_CYCLE_COUNT() - start;
+        return ROTS_BUSY;
+    }
+
+    // 最近原型的相对概率, 再按距离余量衰减
+    float total = 0.0f;
+    for (uint8_t s = 0; s < ROTS_PROTO_MAX_CLASSES; s++) {
+        if (proto_state[s] == ROTS_PROTO_READY) {
+            total += expf(log_likelihood[s] - best_likelihood);
+        }
+    }
+    float margin = 1.0f - match->distance / ROTS_PROTO_MAX_DISTANCE;
+    match->slot = (uint8_t)best;
+    match->confidence = margin > 0.0f ? margin / total : 0.0f;
+
+    proto_stats.lookup_cycles = ROTS_CYCLE_COUNT() - start;
+    if (match->distance >= ROTS_PROTO_MAX_DISTANCE) {
+        return ROTS_BUSY;
+    }
+    proto_stats.matches++;
+    return ROTS_OK;
+}
+
+// 原型名称 (空槽位返回NULL)
+const char* ROTS_Prototypes_GetName(uint8_t slot) {
+    if (slot >= ROTS_PROTO_MAX_CLASSES || proto_state[slot] == ROTS_PROTO_FREE) {
+        return NULL;
+    }
+    return prototypes[slot].name;
+}
+
+// 原型样本数
+uint32_t ROTS_Prototypes_GetSamples(uint8_t slot) {
+    return slot < ROTS_PROTO_MAX_CLASSES ? prototypes[slot].count : 0;
+}
+
+// 获取统计
+ROTS_StatusTypeDef ROTS_Prototypes_GetStats(ROTS_ProtoStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &proto_stats, sizeof(ROTS_ProtoStats_t));
+    stats->used = 0;
+    for (uint8_t s = 0; s < ROTS_PROTO_MAX_CLASSES; s++) {
+        if (proto_state[s] == ROTS_PROTO_READY) stats->used++;
+    }
+    return ROTS_OK;
+}
+
+// 由均值/方差导出查找用的1/σ和log σ之和, 并置为可用
+static void ROTS_Prototypes_Prepare(uint8_t slot) {
+    const ROTS_Prototype_t* proto = &prototypes[slot];
+    float log_std = 0.0f;
+    for (uint8_t f = 0; f < proto_features; f++) {
+        float variance = proto->count > 1 ? proto->m2[f] / (proto->count - 1) : 0.0f;
+        float std = sqrtf(variance > 0.0f ? variance : 0.0f);
+        float floor = fabsf(proto->mean[f]) * ROTS_PROTO_STD_FLOOR_RATIO;
+        if (floor < ROTS_PROTO_STD_FLOOR) floor = ROTS_PROTO_STD_FLOOR;
+        if (std < floor) std = floor;
+        proto_inv_std[slot][f] = 1.0f / std;
+        log_std += logf(std);
+    }
+    proto_log_std[slot] = log_std;
+    proto_state[slot] = ROTS_PROTO_READY;
+}
+
+// 保存全部可用原型
+static void ROTS_Prototypes_Persist(void) {
+    memset(&proto_record, 0, sizeof(proto_record));
+    proto_record.magic = ROTS_PROTO_STORE_MAGIC;
+    proto_record.version = ROTS_PROTO_STORE_VERSION;
+    proto_record.feature_count = proto_features;
+    for (uint8_t s = 0; s < ROTS_PROTO_MAX_CLASSES; s++) {
+        if (proto_state[s] == ROTS_PROTO_READY) {
+            proto_record.prototypes[s] = prototypes[s];
+        }
+    }
+    ROTS_Prototypes_Save(&proto_record);
+}
+
+#ifdef ARDUINO
+// 从NVS读取
+static bool ROTS_Prototypes_Load(ROTS_ProtoRecord_t* record) {
+    Preferences prefs;
+    if (!prefs.begin("rots_proto", true)) {
+        return false;
+    }
+
+    size_t length = prefs.getBytes("record", record, sizeof(ROTS_ProtoRecord_t));
+    prefs.end();
+    return length == sizeof(ROTS_ProtoRecord_t);
+}
+
+// 写入NVS
+static bool ROTS_Prototypes_Save(const ROTS_ProtoRecord_t* record) {
+    Preferences prefs;
+    if (!prefs.begin("rots_proto", false)) {
+        return false;
+    }
+
+    size_t length = prefs.putBytes("record", record, sizeof(ROTS_ProtoRecord_t));
+    prefs.end();
+
+    if (length != sizeof(ROTS_ProtoRecord_t)) {
+        DEBUG_WARNING("Prototype persist failed\r\n");
+        return false;
+    }
+    return true;
+}
+#else
+static bool ROTS_Prototypes_Load(ROTS_ProtoRecord_t* record) {
+    memcpy(record, &host_store, sizeof(ROTS_ProtoRecord_t));
+    return host_store.magic == ROTS_PROTO_STORE_MAGIC;
+}
+
+static bool ROTS_Prototypes_Save(const ROTS_ProtoRecord_t* record) {
+    memcpy(&host_store, record, sizeof(ROTS_ProtoRecord_t));
+    return true;
+}
+#endif
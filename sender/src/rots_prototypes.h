@@ -0,0 +1,55 @@
+// ROTS Prototypes Header
+#ifndef ROTS_PROTOTYPES_H
+#define ROTS_PROTOTYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 最近原型分类: 每个现场学习的气味保存特征均值和方差 (Welford增量更新),
+// 按方差归一化的平方距离 (对角马氏距离) 找最近原型. 查找O(K·F), 表容量固定,
+// 学习完成后写入NVS.
+#define ROTS_PROTO_MAX_CLASSES     ROTS_LEARNED_ODOR_SLOTS
+#define ROTS_PROTO_MAX_FEATURES    64
+#define ROTS_PROTO_NAME_LENGTH     16      // 含结尾'\0'
+#define ROTS_PROTO_MIN_SAMPLES     10      // 学习至少需要的样本数
+#define ROTS_PROTO_MAX_DISTANCE    9.0f    // 平均每维平方z值上限 (约3σ), 超出判为未知
+#define ROTS_PROTO_STD_FLOOR_RATIO 0.05f   // 标准差下限 (相对均值), 防止样本少时方差过小
+#define ROTS_PROTO_STD_FLOOR       0.01f   // 标准差下限 (绝对值)
+
+// 匹配结果
+typedef struct {
+    uint8_t slot;
+    float distance;             // 平均每维平方z值
+    float confidence;           // 原型间的相对概率 × 距离余量
+} ROTS_ProtoMatch_t;
+
+// 统计
+typedef struct {
+    uint8_t feature_count;
+    uint8_t used;               // 已学习的原型数
+    bool restored;              // 启动时从NVS恢复了原型
+    uint32_t lookups;
+    uint32_t matches;
+    uint32_t lookup_cycles;     // 最近一次查找耗时
+} ROTS_ProtoStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_Prototypes_Init(uint8_t feature_count);
+ROTS_StatusTypeDef ROTS_Prototypes_Begin(const char* name, uint8_t* slot);
+ROTS_StatusTypeDef ROTS_Prototypes_AddSample(uint8_t slot, const float* features);
+ROTS_StatusTypeDef ROTS_Prototypes_Commit(uint8_t slot);
+void ROTS_Prototypes_Abort(uint8_t slot);
+ROTS_StatusTypeDef ROTS_Prototypes_Remove(const char* name);
+ROTS_StatusTypeDef ROTS_Prototypes_Match(const float* features, ROTS_ProtoMatch_t* match);
+const char* ROTS_Prototypes_GetName(uint8_t slot);
+uint32_t ROTS_Prototypes_GetSamples(uint8_t slot);
+ROTS_StatusTypeDef ROTS_Prototypes_GetStats(ROTS_ProtoStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_PROTOTYPES_H */
@@ -1,140 +1,236 @@
-// ROTS Sender Main Header File
-#ifndef ROTS_SENDER_H
-#define ROTS_SENDER_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include <Arduino.h>
-#include <WiFi.h>
-#include <PubSubClient.h>
-#include <ArduinoJson.h>
-#include <Wire.h>
-#include <SPI.h>
-
-// 系统状态码
-typedef enum {
-    ROTS_OK = 0x00,
-    ROTS_ERROR = 0x01,
-    ROTS_BUSY = 0x02,
-    ROTS_TIMEOUT = 0x03,
-    ROTS_INVALID_PARAM = 0x04,
-    ROTS_COMM_ERROR = 0x05,
-    ROTS_SENSOR_ERROR = 0x06,
-    ROTS_AI_ERROR = 0x07,
-    ROTS_MEMORY_ERROR = 0x08
-} ROTS_StatusTypeDef;
-
-// 发送端状态
-typedef enum {
-    ROTS_SENDER_IDLE = 0x00,
-    ROTS_SENDER_DETECTING = 0x01,
-    ROTS_SENDER_SENDING = 0x02,
-    ROTS_SENDER_ERROR = 0x03
-} ROTS_SenderState_t;
-
-// 调试级别
-typedef enum {
-    ROTS_DEBUG_ERROR = 0,
-    ROTS_DEBUG_WARNING = 1,
-    ROTS_DEBUG_INFO = 2,
-    ROTS_DEBUG_DEBUG = 3
-} ROTS_DebugLevel_t;
-
-// 气味类型
-typedef enum {
-    ROTS_ODOR_COFFEE = 0x01,
-    ROTS_ODOR_ALCOHOL = 0x02,
-    ROTS_ODOR_LEMON = 0x03,
-    ROTS_ODOR_MINT = 0x04,
-    ROTS_ODOR_LAVENDER = 0x05,
-    ROTS_ODOR_UNKNOWN = 0x00
-} ROTS_OdorType_t;
-
-// 传感器数据结构
-typedef struct {
-    float mq2_value;      // MQ-2 可燃气体
-    float mq3_value;      // MQ-3 酒精
-    float mq4_value;      // MQ-4 甲烷
-    float mq5_value;      // MQ-5 液化气
-    float mq6_value;      // MQ-6 液化气
-    float mq7_value;      // MQ-7 一氧化碳
-    float mq8_value;      // MQ-8 氢气
-    float mq9_value;      // MQ-9 一氧化碳
-    float temperature;    // 温度
-    float humidity;       // 湿度
-    float pressure;       // 气压
-    uint32_t timestamp;   // 时间戳
-} ROTS_SensorData_t;
-
-// AI推理结果
-typedef struct {
-    ROTS_OdorType_t odor_type;
-    char odor_name[16];
-    float confidence;
-    float intensity;
-    uint32_t timestamp;
-} ROTS_OdorResult_t;
-
-// 发送端状态
-typedef struct {
-    ROTS_SenderState_t state;
-    uint32_t last_detection_time;
-    uint32_t detection_count;
-    uint32_t error_count;
-    bool wifi_connected;
-    bool mqtt_connected;
-    float battery_voltage;
-} ROTS_SenderStatus_t;
-
-// 硬件引脚定义
-#define ROTS_ERROR_LED_PIN        2
-#define ROTS_STATUS_LED_PIN       4
-#define ROTS_SENSOR_POWER_PIN     5
-
-// MQ传感器引脚
-#define ROTS_MQ2_PIN              A0
-#define ROTS_MQ3_PIN              A1
-#define ROTS_MQ4_PIN              A2
-#define ROTS_MQ5_PIN              A3
-#define ROTS_MQ6_PIN              A4
-#define ROTS_MQ7_PIN              A5
-#define ROTS_MQ8_PIN              A6
-#define ROTS_MQ9_PIN              A7
-
-// I2C引脚 (DHT22, BMP280)
-#define ROTS_SDA_PIN              21
-#define ROTS_SCL_PIN              22
-
-// 系统配置
-#define ROTS_MAX_SENSORS          8
-#define ROTS_AI_CONFIDENCE_THRESHOLD  0.7f
-#define ROTS_SENSOR_READ_INTERVAL     100    // ms
-#define ROTS_AI_INFERENCE_INTERVAL    500    // ms
-#define ROTS_STATUS_UPDATE_INTERVAL   1000   // ms
-#define ROTS_DEBUG_OUTPUT_INTERVAL    10000  // ms
-
-// WiFi配置
-#define ROTS_WIFI_SSID            "ROTS_Network"
-#define ROTS_WIFI_PASSWORD        "rots_password_2024"
-#define ROTS_WIFI_TIMEOUT_MS      10000
-
-// MQTT配置
-#define ROTS_MQTT_BROKER_HOST     "mqtt.rots-system.com"
-#define ROTS_MQTT_BROKER_PORT     1883
-#define ROTS_MQTT_CLIENT_ID       "ROTS_SENDER_001"
-#define ROTS_MQTT_TOPIC_DETECTION "rots/detection/001"
-#define ROTS_MQTT_TOPIC_STATUS    "rots/status/001"
-#define ROTS_MQTT_TOPIC_ERROR     "rots/error/001"
-
-// 函数声明
-ROTS_StatusTypeDef ROTS_Sender_Init(void);
-void ROTS_Sender_MainLoop(void);
-void ROTS_Sender_ErrorHandler(ROTS_StatusTypeDef error_code);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* ROTS_SENDER_H */
+// ROTS Sender Main Header File
+#ifndef ROTS_SENDER_H
+#define ROTS_SENDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <ArduinoJson.h>
+#include <Wire.h>
+#include <SPI.h>
+
+// CPU周期计数 (用于模块耗时统计)
+#define ROTS_CYCLE_COUNT()        ESP.getCycleCount()
+#else
+// 主机构建 (Linux): 仅编译可移植模块, 用于无板卡调试和性能测量
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// 主机构建下以纳秒代替CPU周期
+static inline uint32_t ROTS_HostCycleCount(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#define ROTS_CYCLE_COUNT()        ROTS_HostCycleCount()
+#endif
+
+// 系统状态码
+typedef enum {
+    ROTS_OK = 0x00,
+    ROTS_ERROR = 0x01,
+    ROTS_BUSY = 0x02,
+    ROTS_TIMEOUT = 0x03,
+    ROTS_INVALID_PARAM = 0x04,
+    ROTS_COMM_ERROR = 0x05,
+    ROTS_SENSOR_ERROR = 0x06,
+    ROTS_AI_ERROR = 0x07,
+    ROTS_MEMORY_ERROR = 0x08
+} ROTS_StatusTypeDef;
+
+// 发送端状态
+typedef enum {
+    ROTS_SENDER_IDLE = 0x00,
+    ROTS_SENDER_DETECTING = 0x01,
+    ROTS_SENDER_SENDING = 0x02,
+    ROTS_SENDER_ERROR = 0x03
+} ROTS_SenderState_t;
+
+// 调试级别
+typedef enum {
+    ROTS_DEBUG_ERROR = 0,
+    ROTS_DEBUG_WARNING = 1,
+    ROTS_DEBUG_INFO = 2,
+    ROTS_DEBUG_DEBUG = 3
+} ROTS_DebugLevel_t;
+
+// 气味类型
+typedef enum {
+    ROTS_ODOR_COFFEE = 0x01,
+    ROTS_ODOR_ALCOHOL = 0x02,
+    ROTS_ODOR_LEMON = 0x03,
+    ROTS_ODOR_MINT = 0x04,
+    ROTS_ODOR_LAVENDER = 0x05,
+    ROTS_ODOR_LEARNED = 0x10,     // 现场学习的气味 (0x10 + 原型槽位)
+    ROTS_ODOR_UNKNOWN = 0x00
+} ROTS_OdorType_t;
+#define ROTS_LEARNED_ODOR_SLOTS   8      // 现场学习气味的最大数量
+
+// 传感器通道配置
+#define ROTS_MAX_CHANNELS         32     // 单个发送端支持的最大通道数
+#ifndef ROTS_ADS1115_BOARD_COUNT
+#define ROTS_ADS1115_BOARD_COUNT  0      // 外部ADS1115板数量 (每板4通道, 地址0x48起)
+#endif
+#define ROTS_CHANNEL_COUNT        (ROTS_MAX_SENSORS + ROTS_ADS1115_BOARD_COUNT * 4)
+
+// 板载MQ通道索引 (外部通道从ROTS_MAX_SENSORS开始按板顺序排列)
+typedef enum {
+    ROTS_CH_MQ2 = 0,      // MQ-2 可燃气体
+    ROTS_CH_MQ3 = 1,      // MQ-3 酒精
+    ROTS_CH_MQ4 = 2,      // MQ-4 甲烷
+    ROTS_CH_MQ5 = 3,      // MQ-5 液化气
+    ROTS_CH_MQ6 = 4,      // MQ-6 液化气
+    ROTS_CH_MQ7 = 5,      // MQ-7 一氧化碳
+    ROTS_CH_MQ8 = 6,      // MQ-8 氢气
+    ROTS_CH_MQ9 = 7       // MQ-9 一氧化碳
+} ROTS_ChannelIndex_t;
+
+// 通道来源
+typedef enum {
+    ROTS_CHANNEL_ONBOARD_ADC = 0x00,
+    ROTS_CHANNEL_ADS1115 = 0x01
+} ROTS_ChannelSource_t;
+
+// 通道描述
+typedef struct {
+    char name[8];                  // 如 "MQ2", "X0.3"
+    ROTS_ChannelSource_t source;
+    uint8_t device;                // 外部ADC板序号
+    uint8_t input;                 // 板载引脚或外部ADC输入号
+} ROTS_ChannelDesc_t;
+
+// 加热循环相位 (MQ-7/MQ-9高低压交替加热, 其余通道连续加热)
+typedef enum {
+    ROTS_HEATER_PHASE_CONTINUOUS = 0x00,
+    ROTS_HEATER_PHASE_HIGH = 0x01,       // 高压清洁相
+    ROTS_HEATER_PHASE_LOW = 0x02,        // 低压测量相
+    ROTS_HEATER_PHASE_LOW_END = 0x03     // 低压相末尾 (有效采样窗口)
+} ROTS_HeaterPhase_t;
+
+// 传感器数据结构
+typedef struct {
+    float channels[ROTS_MAX_CHANNELS];  // 各通道气体浓度, 按ROTS_ChannelIndex_t索引
+                                        // (加热循环通道为最近一次低压相末尾的读数)
+    uint8_t channel_phase[ROTS_MAX_CHANNELS];  // 本帧原始采样所处的加热相位 (ROTS_HeaterPhase_t)
+    uint8_t channel_count;              // 有效通道数
+    float temperature;    // 温度
+    float humidity;       // 湿度
+    float pressure;       // 气压
+    uint32_t timestamp;   // 时间戳
+    uint32_t env_age_ms;  // 环境读数中最陈旧一项的时间 (尚无读数为UINT32_MAX)
+} ROTS_SensorData_t;
+
+// AI推理结果
+typedef struct {
+    ROTS_OdorType_t odor_type;
+    char odor_name[16];
+    float confidence;
+    float intensity;
+    uint32_t timestamp;
+    float novelty;        // 新颖度: 距最近训练类别的平均每维平方z值 (未评估为0)
+    bool novel;           // 新颖度超过阈值: 读数不像任何训练类别, odor_type仅为模型的猜测
+} ROTS_OdorResult_t;
+
+// 发送端状态
+typedef struct {
+    ROTS_SenderState_t state;
+    uint32_t last_detection_time;
+    uint32_t detection_count;
+    uint32_t error_count;
+    bool wifi_connected;
+    bool mqtt_connected;
+    float battery_voltage;
+} ROTS_SenderStatus_t;
+
+// 硬件引脚定义
+#define ROTS_ERROR_LED_PIN        2
+#define ROTS_STATUS_LED_PIN       4
+#define ROTS_SENSOR_POWER_PIN     5
+
+// MQ传感器引脚
+#define ROTS_MQ2_PIN              A0
+#define ROTS_MQ3_PIN              A1
+#define ROTS_MQ4_PIN              A2
+#define ROTS_MQ5_PIN              A3
+#define ROTS_MQ6_PIN              A4
+#define ROTS_MQ7_PIN              A5
+#define ROTS_MQ8_PIN              A6
+#define ROTS_MQ9_PIN              A7
+
+// I2C引脚 (BMP280)
+#define ROTS_SDA_PIN              21
+#define ROTS_SCL_PIN              22
+
+// DHT22单总线数据引脚
+#define ROTS_DHT22_PIN            27
+
+// MQ-7/MQ-9加热控制引脚 (经MOSFET驱动加热丝, PWM调节低压相功率)
+#define ROTS_MQ7_HEATER_PIN       18
+#define ROTS_MQ9_HEATER_PIN       19
+
+// 系统配置
+#define ROTS_MAX_SENSORS          8      // 板载MQ通道数 (ESP32 ADC1)
+#if ROTS_CHANNEL_COUNT > ROTS_MAX_CHANNELS
+#error "ROTS_ADS1115_BOARD_COUNT exceeds ROTS_MAX_CHANNELS"
+#endif
+#define ROTS_AI_CONFIDENCE_THRESHOLD  0.7f
+#define ROTS_SENSOR_READ_INTERVAL     100    // ms (空闲速率, 活动时见ROTS_SENSOR_ACTIVE_RATE_HZ)
+#define ROTS_AI_INFERENCE_INTERVAL    500    // ms
+#define ROTS_STATUS_UPDATE_INTERVAL   1000   // ms
+#define ROTS_DEBUG_OUTPUT_INTERVAL    10000  // ms
+#define ROTS_NOVELTY_REPORT_INTERVAL  2000   // ms, 新颖读数持续时的上报间隔
+
+// 后台ADC采集配置
+#define ROTS_ADC_CAPTURE_ENABLED      1
+#define ROTS_ADC_CAPTURE_SAMPLE_RATE_HZ  1000  // 8路MQ整帧扫描频率
+
+// 任务配置: 采集独占APP核, 推理与通信在PRO核 (与WiFi协议栈同核)
+#define ROTS_ACQ_TASK_CORE        1
+#define ROTS_ACQ_TASK_PRIORITY    5
+#define ROTS_ACQ_TASK_STACK       4096
+#define ROTS_INFER_TASK_CORE      0
+#define ROTS_INFER_TASK_PRIORITY  4
+#define ROTS_INFER_TASK_STACK     8192
+#define ROTS_COMM_TASK_CORE       0
+#define ROTS_COMM_TASK_PRIORITY   2      // 低于推理, 发布/重连阻塞时不影响推理
+#define ROTS_COMM_TASK_STACK      8192
+#define ROTS_FRAME_QUEUE_SIZE     32     // 采集->推理 传感器帧 (2的幂, 最高采样率下约160ms)
+#define ROTS_RESULT_QUEUE_SIZE    8      // 推理->通信 检测结果 (2的幂)
+
+// WiFi配置
+#define ROTS_WIFI_SSID            "ROTS_Network"
+#define ROTS_WIFI_PASSWORD        "rots_password_2024"
+#define ROTS_WIFI_TIMEOUT_MS      10000
+
+// MQTT配置
+#define ROTS_MQTT_BROKER_HOST     "mqtt.rots-system.com"
+#define ROTS_MQTT_BROKER_PORT     1883
+#define ROTS_MQTT_CLIENT_ID       "ROTS_SENDER_001"
+#define ROTS_MQTT_TOPIC_DETECTION "rots/detection/001"
+#define ROTS_MQTT_TOPIC_STATUS    "rots/status/001"
+#define ROTS_MQTT_TOPIC_ERROR     "rots/error/001"
+#define ROTS_MQTT_TOPIC_MODEL     "rots/model/001"      // 模型分块更新 (二进制帧)
+#define ROTS_MQTT_TOPIC_MODEL_ACK "rots/model/001/ack"
+#define ROTS_MQTT_TOPIC_COMMAND   "rots/sender/001/command"  // 发送端设备命令 (JSON, 如学习新气味); rots/command/001 为接收端的气味命令
+#define ROTS_MQTT_TOPIC_COMMAND_ACK "rots/sender/001/command/ack"
+#define ROTS_MQTT_TOPIC_NOVELTY   "rots/novelty/001"    // 分布外读数 (不驱动接收端, 供收集再训练数据)
+#define ROTS_MQTT_BUFFER_SIZE     1280                  // 容纳一帧模型数据
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_Sender_Init(void);
+ROTS_StatusTypeDef ROTS_Sender_StartTasks(void);
+void ROTS_Sender_ErrorHandler(ROTS_StatusTypeDef error_code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SENDER_H */
@@ -0,0 +1,224 @@
+// ROTS Sensor Health - 通道健康评估
+//
+// 每帧对每个通道做O(1)的增量统计: 原始码值与"其余通道均值"的
+// Welford均值/方差/协方差, 以及钳位样本计数. 块按时间划分, 采样率切换时
+// 每块覆盖的时长不变; 每块结束时评估一次:
+//   - 卡死: 块内方差接近0 (ADC噪声消失, 如引脚短路或ADC锁死)
+//   - 钳位: 浓度长期落在0.1/1000限幅上, 且不是多数通道同时钳位 (强气味)
+//   - 失相关: 其余通道有明显共模变化时, 本通道不随之变化
+// 分数下降立即生效, 恢复按块缓慢回升; 低于阈值的通道从推理中屏蔽.
+// 加热循环通道的输出是锁存值, 只参与钳位检测. 参考均值不含加热循环通道和
+// 已屏蔽的通道, 避免一路坏通道拉低其余通道的相关系数; 已屏蔽通道仍与参考比较,
+// 恢复正常后可重新启用.
+#include "rots_sender.h"
+#include "rots_sensor_health.h"
+
+// 单通道增量统计
+typedef struct {
+    uint16_t count;
+    uint16_t rail_count;
+    float mean;
+    float m2;
+    float ref_mean;
+    float ref_m2;
+    float co_m2;
+    float health;
+} ROTS_HealthChannel_t;
+
+// 私有变量
+static ROTS_HealthChannel_t health_channels[ROTS_MAX_CHANNELS];
+static uint8_t health_channel_count = 0;
+static uint32_t health_healthy_mask = 0;
+static uint32_t health_block_start = 0;
+static uint16_t health_block_frames = 0;
+static ROTS_SensorHealthStats_t health_stats;
+
+// 私有函数声明
+static void ROTS_SensorHealth_EvaluateBlock(uint8_t ch, bool cycled);
+
+// 初始化健康评估 (全部通道从满分开始)
+ROTS_StatusTypeDef ROTS_SensorHealth_Init(uint8_t channel_count) {
+    if (channel_count == 0 || channel_count > ROTS_MAX_CHANNELS) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memset(health_channels, 0, sizeof(health_channels));
+    memset(&health_stats, 0, sizeof(ROTS_SensorHealthStats_t));
+    health_channel_count = channel_count;
+    health_stats.channel_count = channel_count;
+    health_block_frames = 0;
+
+    for (uint8_t ch = 0; ch < channel_count; ch++) {
+        health_channels[ch].health = 100.0f;
+        health_stats.health[ch] = 100;
+    }
+    health_healthy_mask = channel_count == 32 ? 0xFFFFFFFFUL : ((1UL << channel_count) - 1);
+    health_stats.healthy_mask = health_healthy_mask;
+    return ROTS_OK;
+}
+
+// 输入一帧原始码值; railed_mask标记浓度落在限幅上的通道, phases可为NULL
+void ROTS_SensorHealth_Update(const uint16_t* raw, const uint8_t* phases, uint32_t railed_mask, uint32_t now_ms) {
+    if (!raw || health_channel_count == 0) {
+        return;
+    }
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+
+    // 块按时间结束, 样本过少时顺延
+    if (health_block_frames == 0) {
+        health_block_start = now_ms;
+    }
+    health_block_frames++;
+    bool block_end = now_ms - health_block_start >= ROTS_HEALTH_BLOCK_MS &&
+                     health_block_frames >= ROTS_HEALTH_BLOCK_MIN_SAMPLES;
+
+    // 参考信号: 未屏蔽的连续加热通道的总和 (参考通道用留一均值)
+    // 块末评估会改写屏蔽掩码, 本帧统一使用帧开始时的掩码
+    uint32_t reference_mask = health_healthy_mask;
+    float sum = 0.0f;
+    uint8_t continuous = 0;
+    uint8_t railed = 0;
+    for (uint8_t ch = 0; ch < health_channel_count; ch++) {
+        if (railed_mask & (1UL << ch)) railed++;
+        if (phases && phases[ch] != ROTS_HEATER_PHASE_CONTINUOUS) continue;
+        if (!(reference_mask & (1UL << ch))) continue;
+        sum += raw[ch];
+        continuous++;
+    }
+
+    // 多数通道同时钳位是强气味而不是故障
+    bool isolated_rail = railed * 2 < health_channel_count;
+
+    for (uint8_t ch = 0; ch < health_channel_count; ch++) {
+        ROTS_HealthChannel_t* state = &health_channels[ch];
+        bool cycled = phases && phases[ch] != ROTS_HEATER_PHASE_CONTINUOUS;
+
+        if (isolated_rail && (railed_mask & (1UL << ch))) {
+            state->rail_count++;
+        }
+
+        // 本通道在参考中时先扣除自身
+        bool in_reference = !cycled && (reference_mask & (1UL << ch));
+        uint8_t others = in_reference ? continuous - 1 : continuous;
+
+        state->count++;
+        if (!cycled && others >= 1) {
+            float x = raw[ch];
+            float r = (in_reference ? sum - x : sum) / (float)others;
+            float dx = x - state->mean;
+            float dr = r - state->ref_mean;
+            state->mean += dx / state->count;
+            state->ref_mean += dr / state->count;
+            state->m2 += dx * (x - state->mean);
+            state->ref_m2 += dr * (r - state->ref_mean);
+            state->co_m2 += dx * (r - state->ref_mean);
+        }
+
+        if (block_end) {
+            ROTS_SensorHealth_EvaluateBlock(ch, cycled || others < 1);
+        }
+    }
+    if (block_end) {
+        health_block_frames = 0;
+    }
+
+    uint32_t cycles = ROTS_CYCLE_COUNT() - start;
+    health_stats.last_cycles = cycles;
+    if (cycles > health_stats.max_cycles) {
+        health_stats.max_cycles = cycles;
+    }
+}
+
+// 获取单通道健康分数
+uint8_t ROTS_SensorHealth_GetChannel(uint8_t channel) {
+    return channel < health_channel_count ? health_stats.health[channel] : 0;
+}
+
+// 获取整体健康分数 (各通道平均)
+uint8_t ROTS_SensorHealth_GetOverall(void) {
+    if (health_channel_count == 0) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t ch = 0; ch < health_channel_count; ch++) {
+        total += health_stats.health[ch];
+    }
+    return (uint8_t)(total / health_channel_count);
+}
+
+// 获取可用于推理的通道掩码
+uint32_t ROTS_SensorHealth_GetHealthyMask(void) {
+    return health_healthy_mask;
+}
+
+// 获取健康统计
+ROTS_StatusTypeDef ROTS_SensorHealth_GetStats(ROTS_SensorHealthStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &health_stats, sizeof(ROTS_SensorHealthStats_t));
+    return ROTS_OK;
+}
+
+// 块末评估并重置统计
+static void ROTS_SensorHealth_EvaluateBlock(uint8_t ch, bool cycled) {
+    ROTS_HealthChannel_t* state = &health_channels[ch];
+    uint8_t flags = 0;
+    float score = 100.0f;
+
+    float rail_fraction = (float)state->rail_count / state->count;
+    if (rail_fraction >= ROTS_HEALTH_RAIL_FRACTION) {
+        flags |= ROTS_HEALTH_FLAG_RAIL;
+        score = 10.0f;
+    } else {
+        score -= rail_fraction * 50.0f;
+    }
+
+    if (!cycled) {
+        float variance = state->m2 / (state->count - 1);
+        float ref_variance = state->ref_m2 / (state->count - 1);
+        health_stats.stddev[ch] = sqrtf(variance);
+
+        // 钳位时码值本来就不变, 由钳位判据处理
+        if (state->rail_count == 0 && variance < ROTS_HEALTH_STUCK_STDDEV * ROTS_HEALTH_STUCK_STDDEV) {
+            flags |= ROTS_HEALTH_FLAG_STUCK;
+            score = 0.0f;
+        }
+
+        if (ref_variance >= ROTS_HEALTH_CORR_MIN_STDDEV * ROTS_HEALTH_CORR_MIN_STDDEV && state->m2 > 0.0f) {
+            float correlation = state->co_m2 / sqrtf(state->m2 * state->ref_m2);
+            health_stats.correlation[ch] = correlation;
+            if (correlation < ROTS_HEALTH_CORR_MIN) {
+                flags |= ROTS_HEALTH_FLAG_UNCORRELATED;
+                score -= 30.0f;
+            }
+        }
+    }
+
+    // 下降立即生效, 回升每块收敛剩余差距的1/4
+    if (score < 0.0f) score = 0.0f;
+    if (score < state->health) {
+        state->health = score;
+    } else {
+        state->health += (score - state->health) * 0.25f;
+    }
+
+    uint8_t health = (uint8_t)(state->health + 0.5f);
+    if (health < ROTS_HEALTH_DEAD_THRESHOLD) {
+        health_healthy_mask &= ~(1UL << ch);
+    } else if (health >= ROTS_HEALTH_ALIVE_THRESHOLD) {
+        health_healthy_mask |= (1UL << ch);
+    }
+
+    health_stats.health[ch] = health;
+    health_stats.flags[ch] = flags;
+    health_stats.healthy_mask = health_healthy_mask;
+    health_stats.blocks_evaluated++;
+
+    float keep_health = state->health;
+    memset(state, 0, sizeof(ROTS_HealthChannel_t));
+    state->health = keep_health;
+}
@@ -0,0 +1,51 @@
+// ROTS Sensor Health Header
+#ifndef ROTS_SENSOR_HEALTH_H
+#define ROTS_SENSOR_HEALTH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 健康评估配置
+#define ROTS_HEALTH_BLOCK_MS           10000   // 每块时长, 块末评估一次 (与采样率无关)
+#define ROTS_HEALTH_BLOCK_MIN_SAMPLES  50      // 块内样本不足时 (任务停顿) 延长该块
+#define ROTS_HEALTH_STUCK_STDDEV       0.5f    // 原始码值标准差低于此值视为卡死 (LSB)
+#define ROTS_HEALTH_RAIL_FRACTION      0.9f    // 块内钳位样本比例超过此值视为失效
+#define ROTS_HEALTH_CORR_MIN_STDDEV    20.0f   // 参考信号有明显变化时才评估相关性 (LSB)
+#define ROTS_HEALTH_CORR_MIN           0.3f    // 与其余通道均值的最低相关系数
+#define ROTS_HEALTH_DEAD_THRESHOLD     40      // 低于此分数从推理中屏蔽
+#define ROTS_HEALTH_ALIVE_THRESHOLD    60      // 恢复到此分数后重新启用
+
+// 通道故障标志
+#define ROTS_HEALTH_FLAG_STUCK         0x01
+#define ROTS_HEALTH_FLAG_RAIL          0x02
+#define ROTS_HEALTH_FLAG_UNCORRELATED  0x04
+
+// 健康统计
+typedef struct {
+    uint8_t channel_count;
+    uint8_t health[ROTS_MAX_CHANNELS];      // 0-100
+    uint8_t flags[ROTS_MAX_CHANNELS];       // 最近一次块评估的故障标志
+    float stddev[ROTS_MAX_CHANNELS];        // 最近一块的原始码值标准差
+    float correlation[ROTS_MAX_CHANNELS];   // 最近一次有效的相关系数
+    uint32_t healthy_mask;
+    uint32_t blocks_evaluated;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+} ROTS_SensorHealthStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_SensorHealth_Init(uint8_t channel_count);
+void ROTS_SensorHealth_Update(const uint16_t* raw, const uint8_t* phases, uint32_t railed_mask, uint32_t now_ms);
+uint8_t ROTS_SensorHealth_GetChannel(uint8_t channel);
+uint8_t ROTS_SensorHealth_GetOverall(void);
+uint32_t ROTS_SensorHealth_GetHealthyMask(void);
+ROTS_StatusTypeDef ROTS_SensorHealth_GetStats(ROTS_SensorHealthStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SENSOR_HEALTH_H */
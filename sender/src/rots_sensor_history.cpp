@@ -0,0 +1,178 @@
+// ROTS Sensor History - 传感器历史数据模块
+//
+// 按通道连续存储 (结构数组), 每个通道使用两倍深度的镜像缓冲:
+// 样本同时写入 i 和 i + depth 两处, 因此任意"最近N个样本"窗口
+// 在内存中都是连续的, 可直接返回指针而无需拷贝.
+#include "rots_sender.h"
+#include "rots_sensor_history.h"
+#include "rots_debug.h"
+
+#include <stdlib.h>
+
+// 私有变量
+static float* history_channels = NULL;    // [slot][2 * depth], 传感器通道在前, 环境量在后
+static uint32_t* history_timestamps = NULL; // [2 * depth]
+static uint16_t history_depth = 0;
+static uint8_t history_sensor_channels = 0;
+static uint8_t history_slots = 0;
+static uint16_t history_head = 0;         // 下一个写入位置 [0, depth)
+static uint16_t history_count = 0;
+
+// 私有函数声明
+static void* ROTS_SensorHistory_Alloc(size_t size);
+static inline float* ROTS_SensorHistory_Channel(int slot);
+static int ROTS_SensorHistory_Slot(uint8_t channel);
+
+// 初始化历史数据存储
+ROTS_StatusTypeDef ROTS_SensorHistory_Init(uint8_t channel_count) {
+    if (channel_count == 0 || channel_count > ROTS_MAX_CHANNELS) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (history_channels != NULL) {
+        if (channel_count != history_sensor_channels) {
+            return ROTS_INVALID_PARAM;
+        }
+        ROTS_SensorHistory_Clear();
+        return ROTS_OK;
+    }
+
+    history_sensor_channels = channel_count;
+    history_slots = (uint8_t)(channel_count + ROTS_HISTORY_ENV_CHANNELS);
+
+#ifdef ARDUINO
+    history_depth = psramFound() ? ROTS_SENSOR_HISTORY_DEPTH : ROTS_SENSOR_HISTORY_DEPTH_INTERNAL;
+#else
+    history_depth = ROTS_SENSOR_HISTORY_DEPTH;
+#endif
+
+    size_t channel_bytes = (size_t)history_slots * 2 * history_depth * sizeof(float);
+    size_t timestamp_bytes = (size_t)2 * history_depth * sizeof(uint32_t);
+
+    history_channels = (float*)ROTS_SensorHistory_Alloc(channel_bytes);
+    history_timestamps = (uint32_t*)ROTS_SensorHistory_Alloc(timestamp_bytes);
+    if (history_channels == NULL || history_timestamps == NULL) {
+        DEBUG_ERROR("Sensor history allocation failed\r\n");
+        free(history_channels);
+        free(history_timestamps);
+        history_channels = NULL;
+        history_timestamps = NULL;
+        history_depth = 0;
+        return ROTS_MEMORY_ERROR;
+    }
+
+    ROTS_SensorHistory_Clear();
+    DEBUG_INFO("Sensor history: %u frames (%u bytes)\r\n",
+               history_depth, (unsigned)(channel_bytes + timestamp_bytes));
+    return ROTS_OK;
+}
+
+// 写入一帧
+void ROTS_SensorHistory_Push(const ROTS_SensorData_t* data) {
+    if (history_channels == NULL || !data) return;
+
+    const float env[ROTS_HISTORY_ENV_CHANNELS] = {
+        data->temperature, data->humidity, data->pressure
+    };
+
+    for (int slot = 0; slot < history_slots; slot++) {
+        float value = slot < history_sensor_channels ? data->channels[slot] : env[slot - history_sensor_channels];
+        float* samples = ROTS_SensorHistory_Channel(slot);
+        samples[history_head] = value;
+        samples[history_head + history_depth] = value;
+    }
+    history_timestamps[history_head] = data->timestamp;
+    history_timestamps[history_head + history_depth] = data->timestamp;
+
+    history_head = (uint16_t)((history_head + 1) % history_depth);
+    if (history_count < history_depth) {
+        history_count++;
+    }
+}
+
+// 清空历史
+void ROTS_SensorHistory_Clear(void) {
+    if (history_channels == NULL) return;
+
+    memset(history_channels, 0, (size_t)history_slots * 2 * history_depth * sizeof(float));
+    memset(history_timestamps, 0, (size_t)2 * history_depth * sizeof(uint32_t));
+    history_head = 0;
+    history_count = 0;
+}
+
+// 获取历史深度
+uint16_t ROTS_SensorHistory_GetDepth(void) {
+    return history_depth;
+}
+
+// 获取已存样本数
+uint16_t ROTS_SensorHistory_GetCount(void) {
+    return history_count;
+}
+
+// 获取通道窗口视图
+ROTS_StatusTypeDef ROTS_SensorHistory_GetWindow(uint8_t channel, uint16_t count, const float** window) {
+    int slot = ROTS_SensorHistory_Slot(channel);
+    if (history_channels == NULL || !window || slot < 0 ||
+        count == 0 || count > history_count) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    *window = ROTS_SensorHistory_Channel(slot) + history_head + history_depth - count;
+    return ROTS_OK;
+}
+
+// 获取时间戳窗口视图
+ROTS_StatusTypeDef ROTS_SensorHistory_GetTimestamps(uint16_t count, const uint32_t** window) {
+    if (history_timestamps == NULL || !window || count == 0 || count > history_count) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    *window = history_timestamps + history_head + history_depth - count;
+    return ROTS_OK;
+}
+
+// 还原单帧
+ROTS_StatusTypeDef ROTS_SensorHistory_GetFrame(uint16_t age, ROTS_SensorData_t* data) {
+    if (history_channels == NULL || !data || age >= history_count) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    uint32_t index = history_head + history_depth - 1 - age;
+    memset(data, 0, sizeof(ROTS_SensorData_t));
+    for (int ch = 0; ch < history_sensor_channels; ch++) {
+        data->channels[ch] = ROTS_SensorHistory_Channel(ch)[index];
+    }
+    data->channel_count = history_sensor_channels;
+    data->temperature = ROTS_SensorHistory_Channel(ROTS_SensorHistory_Slot(ROTS_HISTORY_CH_TEMPERATURE))[index];
+    data->humidity = ROTS_SensorHistory_Channel(ROTS_SensorHistory_Slot(ROTS_HISTORY_CH_HUMIDITY))[index];
+    data->pressure = ROTS_SensorHistory_Channel(ROTS_SensorHistory_Slot(ROTS_HISTORY_CH_PRESSURE))[index];
+    data->timestamp = history_timestamps[index];
+    return ROTS_OK;
+}
+
+// 分配存储 (优先PSRAM)
+static void* ROTS_SensorHistory_Alloc(size_t size) {
+#ifdef ARDUINO
+    if (psramFound()) {
+        void* block = ps_malloc(size);
+        if (block != NULL) return block;
+    }
+#endif
+    return malloc(size);
+}
+
+// 存储槽起始地址
+static inline float* ROTS_SensorHistory_Channel(int slot) {
+    return history_channels + (size_t)slot * 2 * history_depth;
+}
+
+// 通道索引映射到存储槽 (无效通道返回-1)
+static int ROTS_SensorHistory_Slot(uint8_t channel) {
+    if (channel < history_sensor_channels) {
+        return channel;
+    }
+    if (channel >= ROTS_HISTORY_CH_TEMPERATURE && channel < ROTS_HISTORY_CH_END) {
+        return history_sensor_channels + (channel - ROTS_HISTORY_CH_TEMPERATURE);
+    }
+    return -1;
+}
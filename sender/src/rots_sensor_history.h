@@ -0,0 +1,48 @@
+// ROTS Sensor History Header
+#ifndef ROTS_SENSOR_HISTORY_H
+#define ROTS_SENSOR_HISTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 历史深度配置 (帧)
+// 历史按固定间隔记录, 与当前采样率无关: 采样率高于10Hz时由传感器管理器
+// 把同一间隔内的帧平均为一帧, 因此按帧计的窗口对应固定时长
+#define ROTS_SENSOR_HISTORY_PERIOD_MS       100    // 历史帧间隔
+#define ROTS_SENSOR_HISTORY_DEPTH           1024   // 有PSRAM时 (102.4s)
+#define ROTS_SENSOR_HISTORY_DEPTH_INTERNAL  256    // 无PSRAM时退回内部RAM (25.6s)
+
+// 历史通道 (按通道连续存储)
+// 传感器通道直接使用通道索引 (ROTS_ChannelIndex_t), 环境量位于其后
+typedef enum {
+    ROTS_HISTORY_CH_TEMPERATURE = ROTS_MAX_CHANNELS,
+    ROTS_HISTORY_CH_HUMIDITY,
+    ROTS_HISTORY_CH_PRESSURE,
+    ROTS_HISTORY_CH_END
+} ROTS_HistoryChannel_t;
+
+#define ROTS_HISTORY_ENV_CHANNELS  (ROTS_HISTORY_CH_END - ROTS_HISTORY_CH_TEMPERATURE)
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_SensorHistory_Init(uint8_t channel_count);
+void ROTS_SensorHistory_Push(const ROTS_SensorData_t* data);
+void ROTS_SensorHistory_Clear(void);
+uint16_t ROTS_SensorHistory_GetDepth(void);
+uint16_t ROTS_SensorHistory_GetCount(void);
+
+// 零拷贝窗口: 返回某通道最近count个样本的连续视图 (由旧到新)
+// 视图在下一次Push之前有效
+ROTS_StatusTypeDef ROTS_SensorHistory_GetWindow(uint8_t channel, uint16_t count, const float** window);
+ROTS_StatusTypeDef ROTS_SensorHistory_GetTimestamps(uint16_t count, const uint32_t** window);
+
+// 还原第age帧 (0为最新)
+ROTS_StatusTypeDef ROTS_SensorHistory_GetFrame(uint16_t age, ROTS_SensorData_t* data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SENSOR_HISTORY_H */
@@ -1,238 +1,690 @@
-// ROTS Sensor Manager - 传感器管理模块
-#include "rots_sender.h"
-#include "rots_sensor_manager.h"
-#include "rots_debug.h"
-
-// 私有变量
-static ROTS_SensorData_t current_sensor_data;
-static ROTS_SensorData_t sensor_history[10];
-static uint8_t history_index = 0;
-static bool sensor_initialized = false;
-
-// 传感器校准参数
-static float sensor_calibration[ROTS_MAX_SENSORS] = {
-    1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f
-};
-
-// 温度补偿参数
-static float temperature_compensation = 0.02f; // 每度温度补偿系数
-
-// 私有函数声明
-static float ROTS_SensorManager_ReadMQSensor(uint8_t pin, uint8_t sensor_id);
-static void ROTS_SensorManager_ApplyCalibration(ROTS_SensorData_t* data);
-static void ROTS_SensorManager_ApplyTemperatureCompensation(ROTS_SensorData_t* data);
-static void ROTS_SensorManager_UpdateHistory(const ROTS_SensorData_t* data);
-
-// 初始化传感器管理器
-ROTS_StatusTypeDef ROTS_SensorManager_Init(void) {
-    // 配置引脚
-    pinMode(ROTS_SENSOR_POWER_PIN, OUTPUT);
-    digitalWrite(ROTS_SENSOR_POWER_PIN, HIGH);
-    
-    // 初始化I2C
-    Wire.begin(ROTS_SDA_PIN, ROTS_SCL_PIN);
-    
-    // 等待传感器预热
-    DEBUG_INFO("Warming up sensors...\r\n");
-    delay(3000);
-    
-    // 初始化传感器数据
-    memset(&current_sensor_data, 0, sizeof(ROTS_SensorData_t));
-    memset(sensor_history, 0, sizeof(sensor_history));
-    
-    // 执行传感器校准
-    ROTS_StatusTypeDef status = ROTS_SensorManager_CalibrateSensors();
-    if (status != ROTS_OK) {
-        DEBUG_ERROR("Sensor calibration failed\r\n");
-        return status;
-    }
-    
-    sensor_initialized = true;
-    DEBUG_INFO("Sensor manager initialized\r\n");
-    return ROTS_OK;
-}
-
-// 读取所有传感器数据
-ROTS_StatusTypeDef ROTS_SensorManager_ReadSensors(ROTS_SensorData_t* data) {
-    if (!sensor_initialized || !data) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    // 读取MQ传感器
-    data->mq2_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ2_PIN, 0);
-    data->mq3_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ3_PIN, 1);
-    data->mq4_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ4_PIN, 2);
-    data->mq5_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ5_PIN, 3);
-    data->mq6_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ6_PIN, 4);
-    data->mq7_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ7_PIN, 5);
-    data->mq8_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ8_PIN, 6);
-    data->mq9_value = ROTS_SensorManager_ReadMQSensor(ROTS_MQ9_PIN, 7);
-    
-    // 读取环境传感器
-    data->temperature = ROTS_SensorManager_ReadTemperature();
-    data->humidity = ROTS_SensorManager_ReadHumidity();
-    data->pressure = ROTS_SensorManager_ReadPressure();
-    
-    // 设置时间戳
-    data->timestamp = millis();
-    
-    // 应用校准和补偿
-    ROTS_SensorManager_ApplyCalibration(data);
-    ROTS_SensorManager_ApplyTemperatureCompensation(data);
-    
-    // 更新历史数据
-    ROTS_SensorManager_UpdateHistory(data);
-    
-    return ROTS_OK;
-}
-
-// 更新传感器数据
-void ROTS_SensorManager_UpdateData(const ROTS_SensorData_t* data) {
-    if (!data) return;
-    
-    memcpy(&current_sensor_data, data, sizeof(ROTS_SensorData_t));
-}
-
-// 获取当前传感器数据
-ROTS_StatusTypeDef ROTS_SensorManager_GetCurrentData(ROTS_SensorData_t* data) {
-    if (!sensor_initialized || !data) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    memcpy(data, &current_sensor_data, sizeof(ROTS_SensorData_t));
-    return ROTS_OK;
-}
-
-// 获取传感器历史数据
-ROTS_StatusTypeDef ROTS_SensorManager_GetHistoryData(ROTS_SensorData_t* data, uint8_t count) {
-    if (!sensor_initialized || !data || count > 10) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    uint8_t start_index = (history_index - count + 10) % 10;
-    for (uint8_t i = 0; i < count; i++) {
-        memcpy(&data[i], &sensor_history[(start_index + i) % 10], sizeof(ROTS_SensorData_t));
-    }
-    
-    return ROTS_OK;
-}
-
-// 校准传感器
-ROTS_StatusTypeDef ROTS_SensorManager_CalibrateSensors(void) {
-    DEBUG_INFO("Starting sensor calibration...\r\n");
-    
-    // 在清洁空气中校准
-    float calibration_values[ROTS_MAX_SENSORS];
-    const int calibration_samples = 100;
-    
-    for (int sensor = 0; sensor < ROTS_MAX_SENSORS; sensor++) {
-        float sum = 0;
-        for (int i = 0; i < calibration_samples; i++) {
-            sum += analogRead(ROTS_MQ2_PIN + sensor);
-            delay(10);
-        }
-        calibration_values[sensor] = sum / calibration_samples;
-        sensor_calibration[sensor] = 4095.0f / calibration_values[sensor];
-    }
-    
-    DEBUG_INFO("Sensor calibration completed\r\n");
-    return ROTS_OK;
-}
-
-// 读取MQ传感器
-static float ROTS_SensorManager_ReadMQSensor(uint8_t pin, uint8_t sensor_id) {
-    // 读取模拟值
-    int raw_value = analogRead(pin);
-    
-    // 转换为电压值 (0-3.3V)
-    float voltage = (raw_value * 3.3f) / 4095.0f;
-    
-    // 应用校准
-    float calibrated_value = voltage * sensor_calibration[sensor_id];
-    
-    // 转换为电阻值 (假设RL=10kΩ)
-    float resistance = (3.3f - calibrated_value) * 10000.0f / calibrated_value;
-    
-    // 防止除零错误
-    if (resistance < 1.0f) resistance = 1.0f;
-    
-    // 转换为气体浓度 (简化计算)
-    float concentration = pow(10, (log10(resistance) - 2.0f) / 0.8f);
-    
-    // 限制浓度范围
-    if (concentration > 1000.0f) concentration = 1000.0f;
-    if (concentration < 0.1f) concentration = 0.1f;
-    
-    return concentration;
-}
-
-// 读取温度
-float ROTS_SensorManager_ReadTemperature(void) {
-    // 这里应该实现DHT22或BMP280温度读取
-    // 暂时返回模拟值
-    return 25.0f + random(-5, 5);
-}
-
-// 读取湿度
-float ROTS_SensorManager_ReadHumidity(void) {
-    // 这里应该实现DHT22湿度读取
-    // 暂时返回模拟值
-    return 50.0f + random(-10, 10);
-}
-
-// 读取气压
-float ROTS_SensorManager_ReadPressure(void) {
-    // 这里应该实现BMP280气压读取
-    // 暂时返回模拟值
-    return 1013.25f + random(-10, 10);
-}
-
-// 应用校准
-static void ROTS_SensorManager_ApplyCalibration(ROTS_SensorData_t* data) {
-    data->mq2_value *= sensor_calibration[0];
-    data->mq3_value *= sensor_calibration[1];
-    data->mq4_value *= sensor_calibration[2];
-    data->mq5_value *= sensor_calibration[3];
-    data->mq6_value *= sensor_calibration[4];
-    data->mq7_value *= sensor_calibration[5];
-    data->mq8_value *= sensor_calibration[6];
-    data->mq9_value *= sensor_calibration[7];
-}
-
-// 应用温度补偿
-static void ROTS_SensorManager_ApplyTemperatureCompensation(ROTS_SensorData_t* data) {
-    float temp_factor = 1.0f + (data->temperature - 25.0f) * temperature_compensation;
-    
-    data->mq2_value *= temp_factor;
-    data->mq3_value *= temp_factor;
-    data->mq4_value *= temp_factor;
-    data->mq5_value *= temp_factor;
-    data->mq6_value *= temp_factor;
-    data->mq7_value *= temp_factor;
-    data->mq8_value *= temp_factor;
-    data->mq9_value *= temp_factor;
-}
-
-// 更新历史数据
-static void ROTS_SensorManager_UpdateHistory(const ROTS_SensorData_t* data) {
-    memcpy(&sensor_history[history_index], data, sizeof(ROTS_SensorData_t));
-    history_index = (history_index + 1) % 10;
-}
-
-// 获取传感器状态
-ROTS_StatusTypeDef ROTS_SensorManager_GetStatus(ROTS_SensorStatus_t* status) {
-    if (!sensor_initialized || !status) {
-        return ROTS_INVALID_PARAM;
-    }
-    
-    status->initialized = sensor_initialized;
-    status->last_read_time = current_sensor_data.timestamp;
-    status->temperature = current_sensor_data.temperature;
-    status->humidity = current_sensor_data.humidity;
-    status->pressure = current_sensor_data.pressure;
-    
-    // 计算传感器健康状态
-    status->sensor_health = 100; // 简化实现
-    
-    return ROTS_OK;
-}
+// ROTS Sensor Manager - 传感器管理模块
+#include "rots_sender.h"
+#include "rots_sensor_manager.h"
+#include "rots_adc_capture.h"
+#include "rots_ads1115.h"
+#include "rots_sensor_history.h"
+#include "rots_temporal_features.h"
+#include "rots_signal_filter.h"
+#include "rots_baseline_tracker.h"
+#include "rots_env_sensors.h"
+#include "rots_env_compensation.h"
+#include "rots_heater_scheduler.h"
+#include "rots_sensor_health.h"
+#include "rots_seqlock.h"
+#include "rots_debug.h"
+
+static_assert(sizeof(ROTS_SensorData_t) % 4 == 0, "sensor frame must be word-sized for the seqlock");
+
+// 私有变量
+static bool sensor_initialized = false;
+
+// 最新一帧: 推理任务发布, 其他任务读取一致快照
+static std::atomic<uint32_t> current_frame_words[ROTS_SEQLOCK_WORDS(sizeof(ROTS_SensorData_t))];
+static ROTS_Seqlock_t current_frame;
+
+// 通道表: 前ROTS_MAX_SENSORS路为板载MQ, 其后为外部ADS1115输入
+static const uint8_t channel_count = ROTS_CHANNEL_COUNT;
+static ROTS_ChannelDesc_t channel_descs[ROTS_MAX_CHANNELS];
+
+// 预热/校准状态机
+static ROTS_SensorState_t sensor_state = ROTS_SENSOR_STATE_WARMUP;
+static uint32_t state_start_time = 0;
+static uint32_t last_calibration_sample = 0;
+static uint16_t calibration_sample_count = 0;
+static uint32_t calibration_sums[ROTS_MAX_CHANNELS];
+
+// 查找表分段构建 (启动时一次, 与校准系数无关, 基线变化无需重建)
+static uint16_t table_build_index = 0;
+
+// 自适应采样率: 各通道指数加权均值/方差/斜率
+static uint16_t sample_rate_hz = ROTS_SENSOR_IDLE_RATE_HZ;
+static uint32_t rate_switches = 0;
+static bool activity_primed = false;
+static uint32_t activity_last_time = 0;
+static uint32_t activity_quiet_since = 0;
+static float activity_mean[ROTS_MAX_CHANNELS];
+static float activity_var[ROTS_MAX_CHANNELS];
+static float activity_slope[ROTS_MAX_CHANNELS];
+
+// 历史抽取: 按ROTS_SENSOR_HISTORY_PERIOD_MS的时间格把帧平均后写入历史
+static_assert(1000 / ROTS_SENSOR_IDLE_RATE_HZ <= ROTS_SENSOR_HISTORY_PERIOD_MS,
+              "idle sample rate must fill every history period");
+static float history_sums[ROTS_MAX_CHANNELS];
+static uint16_t history_pending = 0;
+static uint32_t history_next_time = 0;
+static bool history_primed = false;
+
+// 传感器校准参数
+static float sensor_calibration[ROTS_MAX_CHANNELS];
+
+// 板载通道共用的浓度查找表 (格式见 rots_mq_convert.h, 约8KB)
+// 外部通道采样率低, 直接按公式换算
+static uint16_t mq_lut[ROTS_MQ_LUT_ENTRIES];
+static float mq_lut_max_error = 0.0f; // 构表时相对公式的最大相对误差
+
+// MQ传感器引脚 (与ROTS_ChannelIndex_t顺序一致)
+static const uint8_t mq_sensor_pins[ROTS_MAX_SENSORS] = {
+    ROTS_MQ2_PIN, ROTS_MQ3_PIN, ROTS_MQ4_PIN, ROTS_MQ5_PIN,
+    ROTS_MQ6_PIN, ROTS_MQ7_PIN, ROTS_MQ8_PIN, ROTS_MQ9_PIN
+};
+
+// 私有函数声明
+static void ROTS_SensorManager_ReadRawFrame(uint16_t* raw, uint8_t* phases);
+static float ROTS_SensorManager_ConvertChannel(uint16_t raw_value, uint8_t channel);
+static void ROTS_SensorManager_StepTableBuild(void);
+static void ROTS_SensorManager_ApplyBaselines(const float* baselines);
+static void ROTS_SensorManager_EnterState(ROTS_SensorState_t state);
+static void ROTS_SensorManager_UpdateActivity(const uint16_t* raw, uint32_t now_ms);
+static void ROTS_SensorManager_SetSampleRate(uint16_t rate_hz);
+static void ROTS_SensorManager_ApplyConditioning(ROTS_SensorData_t* data);
+static void ROTS_SensorManager_UpdateHistory(const ROTS_SensorData_t* data);
+static void ROTS_SensorManager_InitChannels(void);
+static void ROTS_SensorManager_InitHeaters(void);
+
+// 初始化传感器管理器
+ROTS_StatusTypeDef ROTS_SensorManager_Init(void) {
+    // 配置引脚
+    pinMode(ROTS_SENSOR_POWER_PIN, OUTPUT);
+    digitalWrite(ROTS_SENSOR_POWER_PIN, HIGH);
+    
+    // 初始化环境传感器 (I2C与DHT22引脚)
+    ROTS_EnvSensors_Init();
+    
+    // 外部ADC板与I2C环境传感器共用总线
+    ROTS_ADS1115_Init(ROTS_ADS1115_BOARD_COUNT);
+    ROTS_SensorManager_InitChannels();
+    
+    // MQ-7/MQ-9加热循环 (其余传感器由电源引脚连续加热)
+    ROTS_SensorManager_InitHeaters();
+    
+    // 初始化传感器数据
+    ROTS_SensorData_t initial_data;
+    memset(&initial_data, 0, sizeof(ROTS_SensorData_t));
+    initial_data.channel_count = channel_count;
+    ROTS_Seqlock_Init(&current_frame, current_frame_words, sizeof(ROTS_SensorData_t), &initial_data);
+    
+    // 初始化历史数据存储
+    ROTS_StatusTypeDef status = ROTS_SensorHistory_Init(channel_count);
+    if (status != ROTS_OK) {
+        DEBUG_ERROR("Sensor history init failed\r\n");
+        return status;
+    }
+    ROTS_TemporalFeatures_Init(channel_count);
+    
+    // 初始化温湿度补偿 (默认网格) 与滤波级
+    ROTS_EnvComp_Init();
+    ROTS_SignalFilter_Init();
+    
+    // 通道健康评估
+    ROTS_SensorHealth_Init(channel_count);
+    
+    // 读取上次保存的基线
+    ROTS_BaselineTracker_Init(channel_count);
+    
+#if ROTS_ADC_CAPTURE_ENABLED
+    // 启动后台整帧采集, 失败时退回到loop中逐路读取
+    if (ROTS_ADCCapture_Init(ROTS_ADC_CAPTURE_SAMPLE_RATE_HZ) != ROTS_OK ||
+        ROTS_ADCCapture_Start() != ROTS_OK) {
+        DEBUG_WARNING("ADC capture unavailable, using blocking reads\r\n");
+    }
+#endif
+    
+    // 预热与校准由ROTS_SensorManager_Update在主循环中逐步推进
+    DEBUG_INFO("Warming up sensors...\r\n");
+    ROTS_SensorManager_EnterState(ROTS_SENSOR_STATE_WARMUP);
+    
+    sensor_initialized = true;
+    DEBUG_INFO("Sensor manager initialized\r\n");
+    return ROTS_OK;
+}
+
+// 推进预热/校准状态机 (每次主循环调用一次, 不阻塞)
+ROTS_StatusTypeDef ROTS_SensorManager_Update(void) {
+    if (!sensor_initialized) {
+        return ROTS_ERROR;
+    }
+    
+    uint32_t current_time = millis();
+    
+    // 推进环境传感器与外部ADC转换
+    ROTS_EnvSensors_Update(current_time);
+    ROTS_ADS1115_Update(current_time);
+    
+    // 推进MQ-7/MQ-9加热相位
+    ROTS_HeaterScheduler_Update(current_time);
+    
+    // 推进查找表构建 (每次一段)
+    ROTS_SensorManager_StepTableBuild();
+    
+    switch (sensor_state) {
+        case ROTS_SENSOR_STATE_WARMUP:
+            if (current_time - state_start_time >= ROTS_SENSOR_WARMUP_MS) {
+                float baselines[ROTS_MAX_CHANNELS];
+                if (ROTS_BaselineTracker_GetRestored(baselines)) {
+                    // 已有保存的基线, 跳过清洁空气采样
+                    DEBUG_INFO("Using stored sensor baselines\r\n");
+                    ROTS_SensorManager_ApplyBaselines(baselines);
+                    ROTS_BaselineTracker_Seed(baselines, current_time);
+                    ROTS_SensorManager_EnterState(ROTS_SENSOR_STATE_BUILDING_TABLES);
+                } else {
+                    DEBUG_INFO("Starting sensor calibration...\r\n");
+                    ROTS_SensorManager_EnterState(ROTS_SENSOR_STATE_CALIBRATING);
+                }
+            }
+            break;
+            
+        case ROTS_SENSOR_STATE_CALIBRATING: {
+            // 在清洁空气中校准, 每次同时采样全部通道
+            if (current_time - last_calibration_sample < ROTS_SENSOR_CALIBRATION_INTERVAL_MS) {
+                break;
+            }
+            last_calibration_sample = current_time;
+            
+            uint16_t raw[ROTS_MAX_CHANNELS];
+            ROTS_SensorManager_ReadRawFrame(raw, NULL);
+            for (int ch = 0; ch < channel_count; ch++) {
+                calibration_sums[ch] += raw[ch];
+            }
+            
+            if (++calibration_sample_count >= ROTS_SENSOR_CALIBRATION_SAMPLES) {
+                float baselines[ROTS_MAX_CHANNELS];
+                for (int ch = 0; ch < channel_count; ch++) {
+                    baselines[ch] = (float)calibration_sums[ch] / ROTS_SENSOR_CALIBRATION_SAMPLES;
+                }
+                ROTS_SensorManager_ApplyBaselines(baselines);
+                
+                // 以本次校准作为基线跟踪起点, 由通信任务尽快保存
+                ROTS_BaselineTracker_Seed(baselines, current_time);
+                ROTS_BaselineTracker_RequestPersist(current_time);
+                ROTS_SensorManager_EnterState(ROTS_SENSOR_STATE_BUILDING_TABLES);
+            }
+            break;
+        }
+            
+        case ROTS_SENSOR_STATE_BUILDING_TABLES:
+            // 等待查找表构建完成
+            if (table_build_index >= ROTS_MQ_LUT_ENTRIES) {
+                ROTS_SensorManager_EnterState(ROTS_SENSOR_STATE_READY);
+                DEBUG_INFO("Sensor calibration completed (%lu ms)\r\n", millis());
+            }
+            break;
+            
+        case ROTS_SENSOR_STATE_READY:
+        default:
+            break;
+    }
+    
+    return ROTS_OK;
+}
+
+// 传感器是否已完成预热和校准
+bool ROTS_SensorManager_IsReady(void) {
+    return sensor_state == ROTS_SENSOR_STATE_READY;
+}
+
+// 获取预热/校准进度 (0-100%)
+uint8_t ROTS_SensorManager_GetProgress(void) {
+    uint32_t elapsed = millis() - state_start_time;
+    
+    // 预热占50%, 采样占40%, 构建查找表占10%
+    switch (sensor_state) {
+        case ROTS_SENSOR_STATE_WARMUP:
+            if (elapsed > ROTS_SENSOR_WARMUP_MS) elapsed = ROTS_SENSOR_WARMUP_MS;
+            return (uint8_t)(elapsed * 50 / ROTS_SENSOR_WARMUP_MS);
+        case ROTS_SENSOR_STATE_CALIBRATING:
+            return (uint8_t)(50 + calibration_sample_count * 40 / ROTS_SENSOR_CALIBRATION_SAMPLES);
+        case ROTS_SENSOR_STATE_BUILDING_TABLES:
+            return (uint8_t)(90 + table_build_index * 10UL / ROTS_MQ_LUT_ENTRIES);
+        case ROTS_SENSOR_STATE_READY:
+        default:
+            return 100;
+    }
+}
+
+// 切换状态机状态
+static void ROTS_SensorManager_EnterState(ROTS_SensorState_t state) {
+    sensor_state = state;
+    state_start_time = millis();
+    
+    if (state == ROTS_SENSOR_STATE_CALIBRATING) {
+        memset(calibration_sums, 0, sizeof(calibration_sums));
+        calibration_sample_count = 0;
+        last_calibration_sample = 0;
+    } else if (state == ROTS_SENSOR_STATE_READY) {
+        // 校准系数已变化, 丢弃旧的滤波状态
+        ROTS_SignalFilter_Reset();
+        activity_primed = false;
+        ROTS_SensorManager_SetSampleRate(ROTS_SENSOR_IDLE_RATE_HZ);
+    }
+}
+
+// 读取所有传感器数据
+ROTS_StatusTypeDef ROTS_SensorManager_ReadSensors(ROTS_SensorData_t* data) {
+    if (!sensor_initialized || !data) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    // 预热和校准完成前没有有效数据
+    if (sensor_state != ROTS_SENSOR_STATE_READY) {
+        return ROTS_BUSY;
+    }
+    
+    // 读取全部通道 (板载为同一帧原始码值, 外部为最近一次转换)
+    uint16_t raw[ROTS_MAX_CHANNELS];
+    memset(data->channel_phase, ROTS_HEATER_PHASE_CONTINUOUS, sizeof(data->channel_phase));
+    ROTS_SensorManager_ReadRawFrame(raw, data->channel_phase);
+    
+    // 根据信号活动调整采样率
+    ROTS_SensorManager_UpdateActivity(raw, millis());
+    
+    // 安静期跟踪基线漂移, 变化明显的通道更新校准系数
+    uint32_t drifted = ROTS_BaselineTracker_Update(raw, millis());
+    if (drifted != 0) {
+        float baselines[ROTS_MAX_CHANNELS];
+        ROTS_BaselineTracker_GetBaselines(baselines);
+        for (int ch = 0; ch < channel_count; ch++) {
+            if (drifted & (1UL << ch)) {
+                sensor_calibration[ch] = 4095.0f / baselines[ch];
+            }
+        }
+    }
+    
+    memset(data->channels, 0, sizeof(data->channels));
+    uint32_t railed = 0;
+    for (int ch = 0; ch < channel_count; ch++) {
+        float value = ROTS_SensorManager_ConvertChannel(raw[ch], ch);
+        float factor = sensor_calibration[ch];
+        if (value <= ROTS_SENSOR_CONCENTRATION_MIN * factor * (1.0f + ROTS_SENSOR_RAIL_MARGIN) ||
+            value >= ROTS_SENSOR_CONCENTRATION_MAX * factor * (1.0f - ROTS_SENSOR_RAIL_MARGIN)) {
+            railed |= 1UL << ch;
+        }
+        data->channels[ch] = value;
+    }
+    data->channel_count = channel_count;
+    
+    // 通道健康 (原始码值统计 + 限幅判定)
+    ROTS_SensorHealth_Update(raw, data->channel_phase, railed, millis());
+    
+    // 环境传感器只取缓存 (转换由ROTS_SensorManager_Update在后台推进)
+    ROTS_EnvReading_t env;
+    ROTS_EnvSensors_GetReading(&env);
+    data->temperature = env.temperature;
+    data->humidity = env.humidity;
+    data->pressure = env.pressure;
+    
+    // 设置时间戳
+    data->timestamp = millis();
+    data->env_age_ms = ROTS_EnvSensors_GetAge(&env, data->timestamp);
+    
+    // 温湿度补偿与滤波 (校准系数已在换算中应用)
+    ROTS_SensorManager_ApplyConditioning(data);
+    
+    return ROTS_OK;
+}
+
+// 更新传感器数据 (推理任务中逐帧调用, 历史与时序特征只由推理任务访问)
+void ROTS_SensorManager_UpdateData(const ROTS_SensorData_t* data) {
+    if (!data) return;
+    
+    ROTS_Seqlock_Write(&current_frame, data);
+    
+    // 更新历史数据
+    ROTS_SensorManager_UpdateHistory(data);
+}
+
+// 获取当前传感器数据
+ROTS_StatusTypeDef ROTS_SensorManager_GetCurrentData(ROTS_SensorData_t* data) {
+    if (!sensor_initialized || !data) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    return ROTS_Seqlock_Read(&current_frame, data);
+}
+
+// 获取传感器历史数据 (最近count帧, 由旧到新)
+// 按通道扫描时应优先使用ROTS_SensorHistory_GetWindow的零拷贝视图
+ROTS_StatusTypeDef ROTS_SensorManager_GetHistoryData(ROTS_SensorData_t* data, uint16_t count) {
+    if (!sensor_initialized || !data || count > ROTS_SensorHistory_GetCount()) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    for (uint16_t i = 0; i < count; i++) {
+        ROTS_SensorHistory_GetFrame(count - 1 - i, &data[i]);
+    }
+    
+    return ROTS_OK;
+}
+
+// 校准传感器 (重新启动非阻塞校准, 进度通过GetStatus查询)
+ROTS_StatusTypeDef ROTS_SensorManager_CalibrateSensors(void) {
+    if (!sensor_initialized) {
+        return ROTS_ERROR;
+    }
+    
+    DEBUG_INFO("Starting sensor calibration...\r\n");
+    ROTS_SensorManager_EnterState(ROTS_SENSOR_STATE_CALIBRATING);
+    return ROTS_OK;
+}
+
+// 读取一帧原始码值 (全部通道, 12位), phases可为NULL
+// 加热循环通道输出低压相末尾的锁存值, 下游的基线、换算与活动检测都只看到有效读数
+static void ROTS_SensorManager_ReadRawFrame(uint16_t* raw, uint8_t* phases) {
+    // 板载通道优先使用后台采集的最新完整帧
+    ROTS_ADCFrame_t frame;
+    if (ROTS_ADCCapture_IsRunning() && ROTS_ADCCapture_GetLatestFrame(&frame) == ROTS_OK) {
+        memcpy(raw, frame.raw, sizeof(frame.raw));
+    } else {
+        // 后台采集不可用时逐路阻塞读取
+        for (int sensor = 0; sensor < ROTS_MAX_SENSORS; sensor++) {
+            raw[sensor] = (uint16_t)analogRead(mq_sensor_pins[sensor]);
+        }
+    }
+    
+    // 外部通道取ADS1115最近一次转换结果
+    if (channel_count > ROTS_MAX_SENSORS) {
+        ROTS_ADS1115_GetCodes(&raw[ROTS_MAX_SENSORS], channel_count - ROTS_MAX_SENSORS);
+    }
+    
+    ROTS_HeaterScheduler_Process(raw, phases, channel_count, millis());
+}
+
+// 转换通道读数 (板载通道查表, 外部通道按公式)
+static float ROTS_SensorManager_ConvertChannel(uint16_t raw_value, uint8_t channel) {
+    if (channel >= ROTS_MAX_SENSORS) {
+        return ROTS_MQConvert_Compute(raw_value, sensor_calibration[channel]);
+    }
+    
+    return ROTS_MQConvert_Lookup(mq_lut, raw_value, sensor_calibration[channel]);
+}
+
+// 推进一段共用查找表构建, 完成后不再重复
+static void ROTS_SensorManager_StepTableBuild(void) {
+    if (table_build_index >= ROTS_MQ_LUT_ENTRIES) {
+        return;
+    }
+    
+    ROTS_MQConvert_BuildTable(mq_lut, table_build_index, ROTS_MQ_LUT_BUILD_CHUNK, &mq_lut_max_error);
+    table_build_index += ROTS_MQ_LUT_BUILD_CHUNK;
+    if (table_build_index > ROTS_MQ_LUT_ENTRIES) {
+        table_build_index = ROTS_MQ_LUT_ENTRIES;
+    }
+}
+
+// 由清洁空气基线 (ADC码值) 计算校准系数
+static void ROTS_SensorManager_ApplyBaselines(const float* baselines) {
+    for (int ch = 0; ch < channel_count; ch++) {
+        float baseline = baselines[ch];
+        if (baseline < 1.0f) baseline = 1.0f;
+        sensor_calibration[ch] = 4095.0f / baseline;
+    }
+}
+
+// 设置单个通道校准系数 (立即生效)
+ROTS_StatusTypeDef ROTS_SensorManager_SetCalibration(uint8_t channel, float factor) {
+    if (channel >= channel_count || !(factor > 0.0f)) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    sensor_calibration[channel] = factor;
+    return ROTS_OK;
+}
+
+// 获取有效通道数
+uint8_t ROTS_SensorManager_GetChannelCount(void) {
+    return channel_count;
+}
+
+// 获取通道描述
+ROTS_StatusTypeDef ROTS_SensorManager_GetChannelDesc(uint8_t channel, ROTS_ChannelDesc_t* desc) {
+    if (channel >= channel_count || !desc) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    memcpy(desc, &channel_descs[channel], sizeof(ROTS_ChannelDesc_t));
+    return ROTS_OK;
+}
+
+// 获取参与推理的通道掩码 (健康分数低于阈值的通道被清除)
+uint32_t ROTS_SensorManager_GetHealthyMask(void) {
+    return ROTS_SensorHealth_GetHealthyMask();
+}
+
+// 建立通道表并复位校准系数
+static void ROTS_SensorManager_InitChannels(void) {
+    static const char* const onboard_names[ROTS_MAX_SENSORS] = {
+        "MQ2", "MQ3", "MQ4", "MQ5", "MQ6", "MQ7", "MQ8", "MQ9"
+    };
+    
+    memset(channel_descs, 0, sizeof(channel_descs));
+    for (int ch = 0; ch < channel_count; ch++) {
+        ROTS_ChannelDesc_t* desc = &channel_descs[ch];
+        if (ch < ROTS_MAX_SENSORS) {
+            strncpy(desc->name, onboard_names[ch], sizeof(desc->name) - 1);
+            desc->source = ROTS_CHANNEL_ONBOARD_ADC;
+            desc->device = 0;
+            desc->input = mq_sensor_pins[ch];
+        } else {
+            uint8_t index = (uint8_t)(ch - ROTS_MAX_SENSORS);
+            desc->source = ROTS_CHANNEL_ADS1115;
+            desc->device = index / ROTS_ADS1115_INPUTS;
+            desc->input = index % ROTS_ADS1115_INPUTS;
+            snprintf(desc->name, sizeof(desc->name), "X%u.%u", desc->device, desc->input);
+        }
+        sensor_calibration[ch] = 1.0f;
+    }
+}
+
+// 配置MQ-7/MQ-9加热循环
+static void ROTS_SensorManager_InitHeaters(void) {
+    static const ROTS_HeaterConfig_t heater_configs[] = {
+        { ROTS_CH_MQ7, ROTS_MQ7_HEATER_PIN, ROTS_MQ7_HEATER_HIGH_MS, ROTS_MQ7_HEATER_LOW_MS,
+          ROTS_MQ7_HEATER_LOW_MV, ROTS_HEATER_SAMPLE_WINDOW_MS },
+        { ROTS_CH_MQ9, ROTS_MQ9_HEATER_PIN, ROTS_MQ9_HEATER_HIGH_MS, ROTS_MQ9_HEATER_LOW_MS,
+          ROTS_MQ9_HEATER_LOW_MV, ROTS_HEATER_SAMPLE_WINDOW_MS }
+    };
+    
+    ROTS_HeaterScheduler_Init();
+    uint32_t now = millis();
+    for (size_t i = 0; i < sizeof(heater_configs) / sizeof(heater_configs[0]); i++) {
+        if (ROTS_HeaterScheduler_Add(&heater_configs[i], now) != ROTS_OK) {
+            DEBUG_WARNING("Heater %u config rejected\r\n", (unsigned)i);
+        }
+    }
+}
+
+// 通知AI引擎检测结果, 用于基线跟踪的安静期判断
+void ROTS_SensorManager_SetOdorPresent(bool present) {
+    ROTS_BaselineTracker_SetOdorPresent(present, millis());
+}
+
+// 保存待持久化的基线快照 (通信任务调用, NVS写入不占用采集任务)
+void ROTS_SensorManager_SaveBaseline(void) {
+    if (ROTS_BaselineTracker_Persist() == ROTS_ERROR) {
+        DEBUG_WARNING("Baseline snapshot not saved\r\n");
+    }
+}
+
+// 读取温度 (最近一次缓存值)
+float ROTS_SensorManager_ReadTemperature(void) {
+    ROTS_EnvReading_t env;
+    ROTS_EnvSensors_GetReading(&env);
+    return env.temperature;
+}
+
+// 读取湿度 (最近一次缓存值)
+float ROTS_SensorManager_ReadHumidity(void) {
+    ROTS_EnvReading_t env;
+    ROTS_EnvSensors_GetReading(&env);
+    return env.humidity;
+}
+
+// 读取气压 (最近一次缓存值)
+float ROTS_SensorManager_ReadPressure(void) {
+    ROTS_EnvReading_t env;
+    ROTS_EnvSensors_GetReading(&env);
+    return env.pressure;
+}
+
+// 温湿度补偿 (逐通道网格双线性插值) -> 滤波级 (Hampel离群剔除 -> 中值 -> IIR低通)
+static void ROTS_SensorManager_ApplyConditioning(ROTS_SensorData_t* data) {
+    ROTS_EnvComp_Apply(data->channels, data->channel_count, data->temperature, data->humidity);
+    ROTS_SignalFilter_Process(data->channels, data->channel_count);
+}
+
+// 更新活动估计, 任一通道斜率或标准差超过阈值时切到高速采样
+static void ROTS_SensorManager_UpdateActivity(const uint16_t* raw, uint32_t now_ms) {
+    if (!activity_primed) {
+        for (int ch = 0; ch < channel_count; ch++) {
+            activity_mean[ch] = raw[ch];
+            activity_var[ch] = 0.0f;
+            activity_slope[ch] = 0.0f;
+        }
+        activity_primed = true;
+        activity_last_time = now_ms;
+        activity_quiet_since = now_ms;
+        return;
+    }
+    
+    uint32_t dt_ms = now_ms - activity_last_time;
+    if (dt_ms == 0) {
+        return;
+    }
+    activity_last_time = now_ms;
+    
+    // 按实际帧间隔换算系数, 采样率切换后时间常数不变
+    float alpha = (float)dt_ms / (float)(ROTS_SENSOR_ACTIVITY_TAU_MS + dt_ms);
+    float inv_dt = 1000.0f / (float)dt_ms;
+    
+    bool high = sample_rate_hz == ROTS_SENSOR_ACTIVE_RATE_HZ;
+    float ratio = high ? ROTS_SENSOR_ACTIVITY_EXIT_RATIO : 1.0f;
+    float slope_limit = ROTS_SENSOR_ACTIVITY_SLOPE * ratio;
+    float var_limit = ROTS_SENSOR_ACTIVITY_STDDEV * ROTS_SENSOR_ACTIVITY_STDDEV * ratio * ratio;
+    
+    bool active = false;
+    for (int ch = 0; ch < channel_count; ch++) {
+        float x = raw[ch];
+        float previous = activity_mean[ch];
+        float mean = previous + alpha * (x - previous);
+        activity_var[ch] += alpha * ((x - previous) * (x - mean) - activity_var[ch]);
+        activity_slope[ch] += alpha * ((mean - previous) * inv_dt - activity_slope[ch]);
+        activity_mean[ch] = mean;
+        
+        active |= (fabsf(activity_slope[ch]) > slope_limit) | (activity_var[ch] > var_limit);
+    }
+    
+    if (active) {
+        activity_quiet_since = now_ms;
+        if (!high) {
+            ROTS_SensorManager_SetSampleRate(ROTS_SENSOR_ACTIVE_RATE_HZ);
+        }
+    } else if (high && now_ms - activity_quiet_since >= ROTS_SENSOR_ACTIVITY_HOLD_MS) {
+        ROTS_SensorManager_SetSampleRate(ROTS_SENSOR_IDLE_RATE_HZ);
+    }
+}
+
+// 切换采样率, IIR系数按新采样率重算以保持截止频率
+static void ROTS_SensorManager_SetSampleRate(uint16_t rate_hz) {
+    if (rate_hz == sample_rate_hz) {
+        return;
+    }
+    
+    ROTS_FilterConfig_t config;
+    ROTS_SignalFilter_GetConfig(&config);
+    if (config.iir_enabled) {
+        ROTS_SignalFilter_SetIIRCutoff(ROTS_SENSOR_FILTER_CUTOFF_HZ, (float)rate_hz, config.iir_stages);
+    }
+    
+    DEBUG_INFO("Sample rate %u -> %u Hz\r\n", sample_rate_hz, rate_hz);
+    sample_rate_hz = rate_hz;
+    rate_switches++;
+}
+
+// 获取当前采样率
+uint16_t ROTS_SensorManager_GetSampleRate(void) {
+    return sample_rate_hz;
+}
+
+// 获取当前采样间隔 (ms)
+uint32_t ROTS_SensorManager_GetSampleInterval(void) {
+    return 1000 / sample_rate_hz;
+}
+
+// 更新历史数据: 高采样率下同一时间格内的帧取平均, 历史与时序窗口的时长不随采样率变化
+static void ROTS_SensorManager_UpdateHistory(const ROTS_SensorData_t* data) {
+    for (int ch = 0; ch < data->channel_count; ch++) {
+        history_sums[ch] += data->channels[ch];
+    }
+    history_pending++;
+    
+    // 允许提前1/4间隔到达时间格, 10Hz节拍略有抖动时不会漏掉一格
+    int32_t early = (int32_t)(data->timestamp - history_next_time);
+    if (history_primed && early < -(int32_t)(ROTS_SENSOR_HISTORY_PERIOD_MS / 4)) {
+        return;
+    }
+    
+    // 环境量、相位与时间戳取本格最后一帧
+    ROTS_SensorData_t frame;
+    memcpy(&frame, data, sizeof(ROTS_SensorData_t));
+    for (int ch = 0; ch < data->channel_count; ch++) {
+        frame.channels[ch] = history_sums[ch] / history_pending;
+        history_sums[ch] = 0.0f;
+    }
+    history_pending = 0;
+    
+    ROTS_SensorHistory_Push(&frame);
+    ROTS_TemporalFeatures_Update(&frame);
+    
+    // 落后一格以上 (任务停顿) 时从当前帧重新对齐
+    if (!history_primed || early >= (int32_t)ROTS_SENSOR_HISTORY_PERIOD_MS) {
+        history_next_time = data->timestamp + ROTS_SENSOR_HISTORY_PERIOD_MS;
+    } else {
+        history_next_time += ROTS_SENSOR_HISTORY_PERIOD_MS;
+    }
+    history_primed = true;
+}
+
+// 获取传感器状态
+ROTS_StatusTypeDef ROTS_SensorManager_GetStatus(ROTS_SensorStatus_t* status) {
+    if (!sensor_initialized || !status) {
+        return ROTS_INVALID_PARAM;
+    }
+    
+    status->initialized = sensor_initialized;
+    status->channel_count = channel_count;
+    status->state = sensor_state;
+    status->ready = (sensor_state == ROTS_SENSOR_STATE_READY);
+    status->calibration_progress = ROTS_SensorManager_GetProgress();
+    ROTS_SensorData_t latest;
+    if (ROTS_Seqlock_Read(&current_frame, &latest) != ROTS_OK) {
+        memset(&latest, 0, sizeof(ROTS_SensorData_t));
+    }
+    status->last_read_time = latest.timestamp;
+    status->temperature = latest.temperature;
+    status->humidity = latest.humidity;
+    status->pressure = latest.pressure;
+    status->frames_published = ROTS_Seqlock_GetVersion(&current_frame);
+    status->snapshot_retries = ROTS_Seqlock_GetRetries(&current_frame);
+    
+    // 传感器健康状态
+    status->sensor_health = ROTS_SensorHealth_GetOverall();
+    for (int ch = 0; ch < ROTS_MAX_CHANNELS; ch++) {
+        status->channel_health[ch] = ROTS_SensorHealth_GetChannel(ch);
+    }
+    status->healthy_mask = ROTS_SensorHealth_GetHealthyMask();
+    
+    // 基线跟踪
+    ROTS_BaselineStats_t baseline_stats;
+    ROTS_BaselineTracker_GetStats(&baseline_stats);
+    status->baseline_restored = baseline_stats.restored;
+    status->baseline_updates = baseline_stats.updates_applied;
+    
+    // 采样率
+    status->sample_rate_hz = sample_rate_hz;
+    status->rate_switches = rate_switches;
+    
+    // 查找表量化误差
+    status->conversion_max_error = mq_lut_max_error;
+    
+    return ROTS_OK;
+}
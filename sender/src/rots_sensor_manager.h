@@ -1,39 +1,92 @@
-// ROTS Sensor Manager Header
-#ifndef ROTS_SENSOR_MANAGER_H
-#define ROTS_SENSOR_MANAGER_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include "rots_sender.h"
-
-// 传感器状态结构
-typedef struct {
-    bool initialized;
-    uint32_t last_read_time;
-    float temperature;
-    float humidity;
-    float pressure;
-    uint8_t sensor_health; // 0-100%
-} ROTS_SensorStatus_t;
-
-// 函数声明
-ROTS_StatusTypeDef ROTS_SensorManager_Init(void);
-ROTS_StatusTypeDef ROTS_SensorManager_ReadSensors(ROTS_SensorData_t* data);
-void ROTS_SensorManager_UpdateData(const ROTS_SensorData_t* data);
-ROTS_StatusTypeDef ROTS_SensorManager_GetCurrentData(ROTS_SensorData_t* data);
-ROTS_StatusTypeDef ROTS_SensorManager_GetHistoryData(ROTS_SensorData_t* data, uint8_t count);
-ROTS_StatusTypeDef ROTS_SensorManager_CalibrateSensors(void);
-ROTS_StatusTypeDef ROTS_SensorManager_GetStatus(ROTS_SensorStatus_t* status);
-
-// 传感器读取函数
-float ROTS_SensorManager_ReadTemperature(void);
-float ROTS_SensorManager_ReadHumidity(void);
-float ROTS_SensorManager_ReadPressure(void);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* ROTS_SENSOR_MANAGER_H */
+// ROTS Sensor Manager Header
+#ifndef ROTS_SENSOR_MANAGER_H
+#define ROTS_SENSOR_MANAGER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+#include "rots_mq_convert.h"
+
+// 浓度查找表分段构建 (表格式见 rots_mq_convert.h)
+#define ROTS_MQ_LUT_BUILD_CHUNK   512    // 每次Update构建的表项数
+
+#define ROTS_SENSOR_RAIL_MARGIN              0.01f    // 判定钳位的相对余量 (大于查找表误差)
+
+// 预热/校准配置
+#define ROTS_SENSOR_WARMUP_MS                3000
+#define ROTS_SENSOR_CALIBRATION_SAMPLES      100
+#define ROTS_SENSOR_CALIBRATION_INTERVAL_MS  10
+
+// 自适应采样率配置 (活动检测基于原始ADC码值)
+#define ROTS_SENSOR_IDLE_RATE_HZ             10
+#define ROTS_SENSOR_ACTIVE_RATE_HZ           200
+#define ROTS_SENSOR_ACTIVITY_TAU_MS          200      // 均值/方差/斜率估计时间常数
+#define ROTS_SENSOR_ACTIVITY_SLOPE           200.0f   // 进入高速的斜率阈值 (ADC码/s)
+#define ROTS_SENSOR_ACTIVITY_STDDEV          40.0f    // 进入高速的标准差阈值 (ADC码, 高于ESP32 ADC本底噪声)
+#define ROTS_SENSOR_ACTIVITY_EXIT_RATIO      0.5f     // 退出阈值 = 进入阈值 * 比例 (迟滞)
+#define ROTS_SENSOR_ACTIVITY_HOLD_MS         3000     // 持续安静多久后回到空闲速率
+#define ROTS_SENSOR_FILTER_CUTOFF_HZ         2.0f     // IIR截止频率, 随采样率重新计算系数
+
+// 传感器管理器状态
+typedef enum {
+    ROTS_SENSOR_STATE_WARMUP = 0x00,
+    ROTS_SENSOR_STATE_CALIBRATING = 0x01,
+    ROTS_SENSOR_STATE_BUILDING_TABLES = 0x02,
+    ROTS_SENSOR_STATE_READY = 0x03
+} ROTS_SensorState_t;
+
+// 传感器状态结构
+typedef struct {
+    bool initialized;
+    uint8_t channel_count;
+    ROTS_SensorState_t state;
+    bool ready;
+    uint8_t calibration_progress; // 0-100%
+    uint32_t last_read_time;
+    float temperature;
+    float humidity;
+    float pressure;
+    uint8_t sensor_health; // 0-100%
+    uint8_t channel_health[ROTS_MAX_CHANNELS]; // 各通道健康分数 0-100%
+    uint32_t healthy_mask;      // 参与推理的通道
+    float conversion_max_error; // 浓度查找表最大相对误差
+    bool baseline_restored;     // 启动时使用了保存的基线
+    uint32_t baseline_updates;  // 在线基线更新次数
+    uint16_t sample_rate_hz;    // 当前采样率
+    uint32_t rate_switches;     // 采样率切换次数
+    uint32_t frames_published;  // 最新帧快照发布次数
+    uint32_t snapshot_retries;  // 读快照时遇到并发写入的重试次数
+} ROTS_SensorStatus_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_SensorManager_Init(void);
+ROTS_StatusTypeDef ROTS_SensorManager_Update(void);
+bool ROTS_SensorManager_IsReady(void);
+uint8_t ROTS_SensorManager_GetProgress(void);
+ROTS_StatusTypeDef ROTS_SensorManager_ReadSensors(ROTS_SensorData_t* data);
+void ROTS_SensorManager_UpdateData(const ROTS_SensorData_t* data);
+ROTS_StatusTypeDef ROTS_SensorManager_GetCurrentData(ROTS_SensorData_t* data);
+ROTS_StatusTypeDef ROTS_SensorManager_GetHistoryData(ROTS_SensorData_t* data, uint16_t count);
+ROTS_StatusTypeDef ROTS_SensorManager_CalibrateSensors(void);
+ROTS_StatusTypeDef ROTS_SensorManager_SetCalibration(uint8_t channel, float factor);
+uint8_t ROTS_SensorManager_GetChannelCount(void);
+ROTS_StatusTypeDef ROTS_SensorManager_GetChannelDesc(uint8_t channel, ROTS_ChannelDesc_t* desc);
+uint32_t ROTS_SensorManager_GetHealthyMask(void);
+void ROTS_SensorManager_SetOdorPresent(bool present);
+void ROTS_SensorManager_SaveBaseline(void);
+uint16_t ROTS_SensorManager_GetSampleRate(void);
+uint32_t ROTS_SensorManager_GetSampleInterval(void);
+ROTS_StatusTypeDef ROTS_SensorManager_GetStatus(ROTS_SensorStatus_t* status);
+
+// 传感器读取函数
+float ROTS_SensorManager_ReadTemperature(void);
+float ROTS_SensorManager_ReadHumidity(void);
+float ROTS_SensorManager_ReadPressure(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SENSOR_MANAGER_H */
@@ -0,0 +1,76 @@
+// ROTS Seqlock - 最新传感器帧/推理结果的无锁快照
+//
+// 写端可位于任务或中断中, 读端在其他任务或另一个核上.
+// 不依赖FreeRTOS, 主机上可用std::thread验证无撕裂.
+#include "rots_sender.h"
+#include "rots_seqlock.h"
+
+// 初始化 (不可与读写并发调用), initial为NULL时清零
+ROTS_StatusTypeDef ROTS_Seqlock_Init(ROTS_Seqlock_t* lock, std::atomic<uint32_t>* words, uint16_t size, const void* initial) {
+    if (!lock || !words || size == 0 || (size & 3) != 0) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    lock->words = words;
+    lock->size = size;
+    lock->sequence.store(0, std::memory_order_relaxed);
+    lock->read_retries.store(0, std::memory_order_relaxed);
+
+    const uint8_t* src = (const uint8_t*)initial;
+    for (uint16_t i = 0; i < size / 4; i++) {
+        uint32_t word = 0;
+        if (src) {
+            memcpy(&word, src + i * 4, sizeof(word));
+        }
+        words[i].store(word, std::memory_order_relaxed);
+    }
+    return ROTS_OK;
+}
+
+// 发布新值 (仅写端调用)
+void ROTS_Seqlock_Write(ROTS_Seqlock_t* lock, const void* data) {
+    uint32_t sequence = lock->sequence.load(std::memory_order_relaxed);
+    lock->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const uint8_t* src = (const uint8_t*)data;
+    for (uint16_t i = 0; i < lock->size / 4; i++) {
+        uint32_t word;
+        memcpy(&word, src + i * 4, sizeof(word));
+        lock->words[i].store(word, std::memory_order_relaxed);
+    }
+
+    lock->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// 读取一致快照, 持续被写入打断时返回ROTS_BUSY
+ROTS_StatusTypeDef ROTS_Seqlock_Read(ROTS_Seqlock_t* lock, void* data) {
+    uint8_t* dst = (uint8_t*)data;
+
+    for (int attempt = 0; attempt < ROTS_SEQLOCK_READ_RETRY; attempt++) {
+        uint32_t before = lock->sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            for (uint16_t i = 0; i < lock->size / 4; i++) {
+                uint32_t word = lock->words[i].load(std::memory_order_relaxed);
+                memcpy(dst + i * 4, &word, sizeof(word));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (lock->sequence.load(std::memory_order_relaxed) == before) {
+                return ROTS_OK;
+            }
+        }
+        lock->read_retries.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return ROTS_BUSY;
+}
+
+// 已发布次数
+uint32_t ROTS_Seqlock_GetVersion(const ROTS_Seqlock_t* lock) {
+    return lock->sequence.load(std::memory_order_acquire) / 2;
+}
+
+// 读端重试次数
+uint32_t ROTS_Seqlock_GetRetries(const ROTS_Seqlock_t* lock) {
+    return lock->read_retries.load(std::memory_order_relaxed);
+}
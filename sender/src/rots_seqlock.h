@@ -0,0 +1,38 @@
+// ROTS Seqlock Header
+#ifndef ROTS_SEQLOCK_H
+#define ROTS_SEQLOCK_H
+
+#include <atomic>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 最新值发布 (顺序锁): 单写端, 任意多读端.
+// 写端先把序号置为奇数, 写入数据后再置为偶数; 读端拷贝前后序号相同且为偶数
+// 才算得到完整快照, 否则重试. 写端从不等待, 读端不加锁.
+// 数据按32位字逐个原子存取, 结构体大小须为4的倍数.
+#define ROTS_SEQLOCK_WORDS(size)  (((size) + 3) / 4)
+#define ROTS_SEQLOCK_READ_RETRY   8      // 读端重试上限, 超过返回ROTS_BUSY
+
+typedef struct {
+    std::atomic<uint32_t> sequence;      // 偶数: 稳定, 奇数: 写入中
+    std::atomic<uint32_t>* words;        // 调用方提供的存储 (ROTS_SEQLOCK_WORDS(size)个字)
+    uint16_t size;
+    std::atomic<uint32_t> read_retries;  // 读端因并发写入而重试的次数
+} ROTS_Seqlock_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_Seqlock_Init(ROTS_Seqlock_t* lock, std::atomic<uint32_t>* words, uint16_t size, const void* initial);
+void ROTS_Seqlock_Write(ROTS_Seqlock_t* lock, const void* data);
+ROTS_StatusTypeDef ROTS_Seqlock_Read(ROTS_Seqlock_t* lock, void* data);
+uint32_t ROTS_Seqlock_GetVersion(const ROTS_Seqlock_t* lock);
+uint32_t ROTS_Seqlock_GetRetries(const ROTS_Seqlock_t* lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SEQLOCK_H */
@@ -0,0 +1,256 @@
+// ROTS Signal Filter - 多通道流式滤波模块
+//
+// 所有状态按 [窗口/级][通道] 排列, 内层循环连续遍历有效通道,
+// 比较交换采用无分支写法, 便于编译器对通道维度向量化.
+// 中值与MAD通过奇偶换位排序网络求得, 窗口固定, 每样本开销为常数.
+#include "rots_sender.h"
+#include "rots_signal_filter.h"
+
+#define ROTS_FILTER_MAD_SCALE  1.4826f  // MAD到标准差的换算系数
+
+typedef float ROTS_FilterRow_t[ROTS_FILTER_CHANNELS];
+
+// 私有变量
+static ROTS_FilterConfig_t filter_config;
+static ROTS_FilterStats_t filter_stats;
+
+static ROTS_FilterRow_t hampel_ring[ROTS_FILTER_MAX_WINDOW];
+static uint8_t filter_channels = 0;        // 当前帧的有效通道数
+static uint8_t hampel_index = 0;
+static uint8_t hampel_fill = 0;
+
+static ROTS_FilterRow_t median_ring[ROTS_FILTER_MAX_WINDOW];
+static uint8_t median_index = 0;
+static uint8_t median_fill = 0;
+
+static ROTS_FilterRow_t iir_state[ROTS_FILTER_IIR_MAX_STAGES];
+static bool iir_primed = false;
+
+// 默认配置: 10Hz采样, 2级2Hz低通
+static const ROTS_FilterConfig_t default_config = {
+    true, 5, 3.0f,
+    true, 3,
+    true, 2, 0.715f
+};
+
+// 私有函数声明
+static bool ROTS_SignalFilter_ValidWindow(uint8_t window);
+static void ROTS_SignalFilter_SortRows(ROTS_FilterRow_t* rows, uint8_t count);
+static void ROTS_SignalFilter_Hampel(float* values);
+static void ROTS_SignalFilter_Median(float* values);
+static void ROTS_SignalFilter_IIR(float* values);
+
+// 初始化滤波模块
+ROTS_StatusTypeDef ROTS_SignalFilter_Init(void) {
+    memcpy(&filter_config, &default_config, sizeof(ROTS_FilterConfig_t));
+    memset(&filter_stats, 0, sizeof(ROTS_FilterStats_t));
+    ROTS_SignalFilter_Reset();
+    return ROTS_OK;
+}
+
+// 设置滤波配置
+ROTS_StatusTypeDef ROTS_SignalFilter_Configure(const ROTS_FilterConfig_t* config) {
+    if (!config) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (config->hampel_enabled &&
+        (!ROTS_SignalFilter_ValidWindow(config->hampel_window) || !(config->hampel_threshold > 0.0f))) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (config->median_enabled && !ROTS_SignalFilter_ValidWindow(config->median_window)) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (config->iir_enabled &&
+        (config->iir_stages == 0 || config->iir_stages > ROTS_FILTER_IIR_MAX_STAGES ||
+         !(config->iir_alpha > 0.0f) || config->iir_alpha > 1.0f)) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(&filter_config, config, sizeof(ROTS_FilterConfig_t));
+    ROTS_SignalFilter_Reset();
+    return ROTS_OK;
+}
+
+// 获取滤波配置
+ROTS_StatusTypeDef ROTS_SignalFilter_GetConfig(ROTS_FilterConfig_t* config) {
+    if (!config) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(config, &filter_config, sizeof(ROTS_FilterConfig_t));
+    return ROTS_OK;
+}
+
+// 按截止频率设置IIR系数 (保持已有滤波状态, 便于运行中切换采样率)
+ROTS_StatusTypeDef ROTS_SignalFilter_SetIIRCutoff(float cutoff_hz, float sample_rate_hz, uint8_t stages) {
+    if (!(cutoff_hz > 0.0f) || !(sample_rate_hz > 0.0f) ||
+        stages == 0 || stages > ROTS_FILTER_IIR_MAX_STAGES) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    // 一阶低通离散化: alpha = 1 - exp(-2*pi*fc/fs)
+    float alpha = 1.0f - expf(-2.0f * (float)M_PI * cutoff_hz / sample_rate_hz);
+    if (alpha > 1.0f) alpha = 1.0f;
+
+    if (stages > filter_config.iir_stages) {
+        // 新增级从上一级当前输出开始, 避免阶跃
+        for (uint8_t stage = filter_config.iir_stages; stage < stages; stage++) {
+            memcpy(iir_state[stage], iir_state[stage > 0 ? stage - 1 : 0], sizeof(ROTS_FilterRow_t));
+        }
+    }
+
+    filter_config.iir_enabled = true;
+    filter_config.iir_stages = stages;
+    filter_config.iir_alpha = alpha;
+    return ROTS_OK;
+}
+
+// 处理一帧 (原地滤波)
+void ROTS_SignalFilter_Process(float* values, uint8_t channel_count) {
+    if (!values || channel_count == 0 || channel_count > ROTS_FILTER_CHANNELS) {
+        return;
+    }
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+
+    // 通道数变化时历史窗口不再对应, 重新开始
+    if (channel_count != filter_channels) {
+        ROTS_SignalFilter_Reset();
+        filter_channels = channel_count;
+    }
+
+    if (filter_config.hampel_enabled) {
+        ROTS_SignalFilter_Hampel(values);
+    }
+    if (filter_config.median_enabled) {
+        ROTS_SignalFilter_Median(values);
+    }
+    if (filter_config.iir_enabled) {
+        ROTS_SignalFilter_IIR(values);
+    }
+
+    uint32_t cycles = ROTS_CYCLE_COUNT() - start;
+    filter_stats.frames_processed++;
+    filter_stats.last_cycles = cycles;
+    if (cycles > filter_stats.max_cycles) {
+        filter_stats.max_cycles = cycles;
+    }
+}
+
+// 清除滤波状态
+void ROTS_SignalFilter_Reset(void) {
+    memset(hampel_ring, 0, sizeof(hampel_ring));
+    memset(median_ring, 0, sizeof(median_ring));
+    memset(iir_state, 0, sizeof(iir_state));
+    hampel_index = 0;
+    hampel_fill = 0;
+    median_index = 0;
+    median_fill = 0;
+    iir_primed = false;
+}
+
+// 获取滤波统计
+ROTS_StatusTypeDef ROTS_SignalFilter_GetStats(ROTS_FilterStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &filter_stats, sizeof(ROTS_FilterStats_t));
+    return ROTS_OK;
+}
+
+// 窗口长度检查
+static bool ROTS_SignalFilter_ValidWindow(uint8_t window) {
+    return window >= 3 && window <= ROTS_FILTER_MAX_WINDOW && (window & 1) != 0;
+}
+
+// 奇偶换位排序网络, 对每个通道列分别排序
+static void ROTS_SignalFilter_SortRows(ROTS_FilterRow_t* rows, uint8_t count) {
+    for (uint8_t pass = 0; pass < count; pass++) {
+        for (uint8_t i = pass & 1; i + 1 < count; i += 2) {
+            float* a = rows[i];
+            float* b = rows[i + 1];
+            for (int ch = 0; ch < filter_channels; ch++) {
+                float lo = (a[ch] < b[ch]) ? a[ch] : b[ch];
+                float hi = (a[ch] < b[ch]) ? b[ch] : a[ch];
+                a[ch] = lo;
+                b[ch] = hi;
+            }
+        }
+    }
+}
+
+// Hampel离群剔除: |x - 中值| > k * 1.4826 * MAD 时以中值替换
+static void ROTS_SignalFilter_Hampel(float* values) {
+    uint8_t window = filter_config.hampel_window;
+
+    memcpy(hampel_ring[hampel_index], values, sizeof(float) * filter_channels);
+    hampel_index = (uint8_t)((hampel_index + 1) % window);
+    if (hampel_fill < window) {
+        hampel_fill++;
+        return;
+    }
+
+    ROTS_FilterRow_t sorted[ROTS_FILTER_MAX_WINDOW];
+    memcpy(sorted, hampel_ring, sizeof(ROTS_FilterRow_t) * window);
+    ROTS_SignalFilter_SortRows(sorted, window);
+
+    ROTS_FilterRow_t median;
+    memcpy(median, sorted[window / 2], sizeof(ROTS_FilterRow_t));
+
+    for (uint8_t i = 0; i < window; i++) {
+        for (int ch = 0; ch < filter_channels; ch++) {
+            sorted[i][ch] = fabsf(hampel_ring[i][ch] - median[ch]);
+        }
+    }
+    ROTS_SignalFilter_SortRows(sorted, window);
+
+    float limit_scale = filter_config.hampel_threshold * ROTS_FILTER_MAD_SCALE;
+    uint32_t rejected = 0;
+    for (int ch = 0; ch < filter_channels; ch++) {
+        bool outlier = fabsf(values[ch] - median[ch]) > limit_scale * sorted[window / 2][ch];
+        values[ch] = outlier ? median[ch] : values[ch];
+        rejected += outlier ? 1 : 0;
+    }
+    filter_stats.outliers_rejected += rejected;
+}
+
+// 滑动中值
+static void ROTS_SignalFilter_Median(float* values) {
+    uint8_t window = filter_config.median_window;
+
+    memcpy(median_ring[median_index], values, sizeof(float) * filter_channels);
+    median_index = (uint8_t)((median_index + 1) % window);
+    if (median_fill < window) {
+        median_fill++;
+        return;
+    }
+
+    ROTS_FilterRow_t sorted[ROTS_FILTER_MAX_WINDOW];
+    memcpy(sorted, median_ring, sizeof(ROTS_FilterRow_t) * window);
+    ROTS_SignalFilter_SortRows(sorted, window);
+    memcpy(values, sorted[window / 2], sizeof(float) * filter_channels);
+}
+
+// 级联一阶IIR低通
+static void ROTS_SignalFilter_IIR(float* values) {
+    uint8_t stages = filter_config.iir_stages;
+    float alpha = filter_config.iir_alpha;
+
+    // 首帧直接作为初始状态, 避免从0开始的启动瞬态
+    if (!iir_primed) {
+        for (uint8_t stage = 0; stage < ROTS_FILTER_IIR_MAX_STAGES; stage++) {
+            memcpy(iir_state[stage], values, sizeof(float) * filter_channels);
+        }
+        iir_primed = true;
+        return;
+    }
+
+    for (uint8_t stage = 0; stage < stages; stage++) {
+        float* state = iir_state[stage];
+        for (int ch = 0; ch < filter_channels; ch++) {
+            state[ch] += alpha * (values[ch] - state[ch]);
+            values[ch] = state[ch];
+        }
+    }
+}
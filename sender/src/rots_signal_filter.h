@@ -0,0 +1,49 @@
+// ROTS Signal Filter Header
+#ifndef ROTS_SIGNAL_FILTER_H
+#define ROTS_SIGNAL_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 滤波配置
+#define ROTS_FILTER_CHANNELS          ROTS_MAX_CHANNELS
+#define ROTS_FILTER_IIR_MAX_STAGES    4
+#define ROTS_FILTER_MAX_WINDOW        9      // 中值/Hampel窗口上限 (奇数)
+
+// 滤波级配置 (处理顺序: Hampel -> 中值 -> IIR低通)
+typedef struct {
+    bool hampel_enabled;
+    uint8_t hampel_window;      // 奇数, 3-ROTS_FILTER_MAX_WINDOW
+    float hampel_threshold;     // 离群判定阈值 (MAD估计的标准差倍数)
+    bool median_enabled;
+    uint8_t median_window;      // 奇数, 3-ROTS_FILTER_MAX_WINDOW
+    bool iir_enabled;
+    uint8_t iir_stages;         // 级联一阶低通级数, 1-ROTS_FILTER_IIR_MAX_STAGES
+    float iir_alpha;            // y += alpha * (x - y), (0, 1]
+} ROTS_FilterConfig_t;
+
+// 滤波统计
+typedef struct {
+    uint32_t frames_processed;
+    uint32_t outliers_rejected;
+    uint32_t last_cycles;       // 最近一帧耗时 (主机构建为ns)
+    uint32_t max_cycles;
+} ROTS_FilterStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_SignalFilter_Init(void);
+ROTS_StatusTypeDef ROTS_SignalFilter_Configure(const ROTS_FilterConfig_t* config);
+ROTS_StatusTypeDef ROTS_SignalFilter_GetConfig(ROTS_FilterConfig_t* config);
+ROTS_StatusTypeDef ROTS_SignalFilter_SetIIRCutoff(float cutoff_hz, float sample_rate_hz, uint8_t stages);
+void ROTS_SignalFilter_Process(float* values, uint8_t channel_count);
+void ROTS_SignalFilter_Reset(void);
+ROTS_StatusTypeDef ROTS_SignalFilter_GetStats(ROTS_FilterStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SIGNAL_FILTER_H */
@@ -0,0 +1,73 @@
+// ROTS SPSC Queue - 单生产者/单消费者无锁环形队列
+//
+// 采集任务与推理任务, 推理任务与通信任务之间传递帧和结果.
+// 不依赖FreeRTOS, 主机上可用std::thread直接验证.
+#include "rots_sender.h"
+#include "rots_spsc_queue.h"
+
+// 初始化队列 (不可与Push/Pop并发调用)
+ROTS_StatusTypeDef ROTS_SPSCQueue_Init(ROTS_SPSCQueue_t* queue, void* storage, uint16_t item_size, uint16_t capacity) {
+    if (!queue || !storage || item_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    queue->storage = (uint8_t*)storage;
+    queue->item_size = item_size;
+    queue->capacity = capacity;
+    queue->head.store(0, std::memory_order_relaxed);
+    queue->tail.store(0, std::memory_order_relaxed);
+    queue->dropped.store(0, std::memory_order_relaxed);
+    queue->high_water.store(0, std::memory_order_relaxed);
+    return ROTS_OK;
+}
+
+// 写入一个元素 (仅写端调用), 队列满返回ROTS_BUSY
+ROTS_StatusTypeDef ROTS_SPSCQueue_Push(ROTS_SPSCQueue_t* queue, const void* item) {
+    uint32_t head = queue->head.load(std::memory_order_relaxed);
+    uint32_t depth = head - queue->tail.load(std::memory_order_acquire);
+    if (depth >= queue->capacity) {
+        queue->dropped.store(queue->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return ROTS_BUSY;
+    }
+
+    memcpy(queue->storage + (head & (queue->capacity - 1)) * queue->item_size, item, queue->item_size);
+    queue->head.store(head + 1, std::memory_order_release);
+
+    if (depth + 1 > queue->high_water.load(std::memory_order_relaxed)) {
+        queue->high_water.store(depth + 1, std::memory_order_relaxed);
+    }
+    return ROTS_OK;
+}
+
+// 取出一个元素 (仅读端调用), 队列空返回ROTS_BUSY
+ROTS_StatusTypeDef ROTS_SPSCQueue_Pop(ROTS_SPSCQueue_t* queue, void* item) {
+    uint32_t tail = queue->tail.load(std::memory_order_relaxed);
+    if (queue->head.load(std::memory_order_acquire) == tail) {
+        return ROTS_BUSY;
+    }
+
+    memcpy(item, queue->storage + (tail & (queue->capacity - 1)) * queue->item_size, queue->item_size);
+    queue->tail.store(tail + 1, std::memory_order_release);
+    return ROTS_OK;
+}
+
+// 当前深度 (任意任务可调用, 结果为近似值)
+uint16_t ROTS_SPSCQueue_GetDepth(const ROTS_SPSCQueue_t* queue) {
+    uint32_t tail = queue->tail.load(std::memory_order_acquire);
+    return (uint16_t)(queue->head.load(std::memory_order_acquire) - tail);
+}
+
+// 获取统计
+ROTS_StatusTypeDef ROTS_SPSCQueue_GetStats(const ROTS_SPSCQueue_t* queue, ROTS_SPSCQueueStats_t* stats) {
+    if (!queue || !stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    stats->popped = queue->tail.load(std::memory_order_acquire);
+    stats->pushed = queue->head.load(std::memory_order_acquire);
+    stats->capacity = queue->capacity;
+    stats->depth = (uint16_t)(stats->pushed - stats->popped);
+    stats->dropped = queue->dropped.load(std::memory_order_relaxed);
+    stats->high_water = (uint16_t)queue->high_water.load(std::memory_order_relaxed);
+    return ROTS_OK;
+}
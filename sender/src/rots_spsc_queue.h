@@ -0,0 +1,48 @@
+// ROTS SPSC Queue Header
+#ifndef ROTS_SPSC_QUEUE_H
+#define ROTS_SPSC_QUEUE_H
+
+#include <atomic>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 单生产者/单消费者无锁环形队列
+// 写端只修改head, 读端只修改tail, 两端各在一个任务 (可在不同核) 中调用.
+// 元素按值拷贝进出, 存储区由调用方提供, 容量须为2的幂.
+// 队列满时丢弃新元素并计数, 写端不会阻塞.
+typedef struct {
+    uint8_t* storage;
+    uint16_t item_size;
+    uint16_t capacity;
+    std::atomic<uint32_t> head;        // 已写入总数 (写端)
+    std::atomic<uint32_t> tail;        // 已取出总数 (读端)
+    std::atomic<uint32_t> dropped;     // 队列满被丢弃的元素数 (写端)
+    std::atomic<uint32_t> high_water;  // 历史最大深度 (写端)
+} ROTS_SPSCQueue_t;
+
+// 统计
+typedef struct {
+    uint16_t capacity;
+    uint16_t depth;
+    uint32_t pushed;
+    uint32_t popped;
+    uint32_t dropped;
+    uint16_t high_water;
+} ROTS_SPSCQueueStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_SPSCQueue_Init(ROTS_SPSCQueue_t* queue, void* storage, uint16_t item_size, uint16_t capacity);
+ROTS_StatusTypeDef ROTS_SPSCQueue_Push(ROTS_SPSCQueue_t* queue, const void* item);
+ROTS_StatusTypeDef ROTS_SPSCQueue_Pop(ROTS_SPSCQueue_t* queue, void* item);
+uint16_t ROTS_SPSCQueue_GetDepth(const ROTS_SPSCQueue_t* queue);
+ROTS_StatusTypeDef ROTS_SPSCQueue_GetStats(const ROTS_SPSCQueue_t* queue, ROTS_SPSCQueueStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_SPSC_QUEUE_H */
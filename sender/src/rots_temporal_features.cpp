@@ -0,0 +1,254 @@
+// ROTS Temporal Features - 滑动窗口时序特征
+//
+// 每到一帧增量更新各通道的窗口统计, 不重新扫描窗口:
+// - 斜率: 定点整数维护 Σy 与 Σi*y, 滑出一个样本时按公式平移, 结果精确;
+// - 极差: 单调队列维护窗口最大/最小值 (均摊O(1)), 队列只存样本序号,
+//   数值从传感器历史的零拷贝窗口中读取;
+// - EWMA/基线/响应起始: 逐样本递推.
+// 须在ROTS_SensorHistory_Push之后调用, 滑出窗口的样本也取自历史.
+#include "rots_sender.h"
+#include "rots_temporal_features.h"
+#include "rots_sensor_history.h"
+
+#define ROTS_TEMPORAL_MASK   (ROTS_TEMPORAL_WINDOW - 1)
+
+// 窗口极值单调队列 (样本序号的环形缓冲)
+typedef struct {
+    uint8_t seq[ROTS_TEMPORAL_WINDOW];
+    uint8_t head;
+    uint8_t count;
+} ROTS_TemporalDeque_t;
+
+// 单通道状态
+typedef struct {
+    int64_t sum;              // Σq, q = y * ROTS_TEMPORAL_FIXED_SCALE
+    int64_t weighted_sum;     // Σi*q, i = 0为窗口内最旧样本
+    float ewma;
+    float baseline;
+    bool onset;
+    uint32_t onset_time;
+    ROTS_TemporalDeque_t max_queue;
+    ROTS_TemporalDeque_t min_queue;
+    float features[ROTS_TEMPORAL_FEATURES];
+} ROTS_TemporalChannel_t;
+
+static_assert((ROTS_TEMPORAL_WINDOW & ROTS_TEMPORAL_MASK) == 0 && ROTS_TEMPORAL_WINDOW < 256,
+              "temporal window must be a power of two below 256");
+
+// 私有变量
+static ROTS_TemporalChannel_t temporal_channels[ROTS_MAX_CHANNELS];
+static uint8_t temporal_channel_count = 0;
+static uint16_t temporal_fill = 0;
+static uint8_t temporal_seq = 0;     // 最新样本序号
+static ROTS_TemporalStats_t temporal_stats;
+
+// 私有函数声明
+static void ROTS_TemporalFeatures_UpdateChannel(ROTS_TemporalChannel_t* channel, const float* window, uint16_t length,
+                                                bool evict, uint32_t now_ms, float interval_ms);
+static void ROTS_TemporalFeatures_PushDeque(ROTS_TemporalDeque_t* queue, const float* window, uint16_t length,
+                                            float value, bool keep_max);
+static inline float ROTS_TemporalFeatures_Value(const float* window, uint16_t length, uint8_t seq);
+
+// 初始化
+ROTS_StatusTypeDef ROTS_TemporalFeatures_Init(uint8_t channel_count) {
+    if (channel_count == 0 || channel_count > ROTS_MAX_CHANNELS) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    temporal_channel_count = channel_count;
+    memset(&temporal_stats, 0, sizeof(temporal_stats));
+    ROTS_TemporalFeatures_Reset();
+    return ROTS_OK;
+}
+
+// 清空窗口
+void ROTS_TemporalFeatures_Reset(void) {
+    memset(temporal_channels, 0, sizeof(temporal_channels));
+    temporal_fill = 0;
+    temporal_seq = 0;
+}
+
+// 处理最新一帧 (已写入传感器历史)
+void ROTS_TemporalFeatures_Update(const ROTS_SensorData_t* data) {
+    if (temporal_channel_count == 0 || !data) return;
+
+    uint32_t start = ROTS_CYCLE_COUNT();
+
+    // 窗口已满时多取一个样本, 即将滑出的样本位于视图开头
+    bool evict = temporal_fill == ROTS_TEMPORAL_WINDOW;
+    uint16_t length = evict ? ROTS_TEMPORAL_WINDOW + 1 : temporal_fill + 1;
+    if (ROTS_SensorHistory_GetCount() < length) {
+        // 历史被清空, 从头累积
+        ROTS_TemporalFeatures_Reset();
+        evict = false;
+        length = 1;
+    }
+
+    const uint32_t* timestamps = NULL;
+    if (ROTS_SensorHistory_GetTimestamps(length, &timestamps) != ROTS_OK) return;
+
+    uint16_t fill = evict ? ROTS_TEMPORAL_WINDOW : temporal_fill + 1;
+    uint32_t now = timestamps[length - 1];
+    float interval_ms = fill > 1 ? (float)(now - timestamps[length - fill]) / (fill - 1) : 0.0f;
+
+    temporal_seq++;
+    temporal_stats.onset_mask = 0;
+    for (uint8_t ch = 0; ch < temporal_channel_count; ch++) {
+        const float* window = NULL;
+        if (ROTS_SensorHistory_GetWindow(ch, length, &window) != ROTS_OK) continue;
+
+        ROTS_TemporalFeatures_UpdateChannel(&temporal_channels[ch], window, length, evict, now, interval_ms);
+        if (temporal_channels[ch].onset) {
+            temporal_stats.onset_mask |= 1UL << ch;
+        }
+    }
+    temporal_fill = fill;
+
+    temporal_stats.updates++;
+    temporal_stats.window_fill = temporal_fill;
+    temporal_stats.update_cycles = ROTS_CYCLE_COUNT() - start;
+    if (temporal_stats.update_cycles > temporal_stats.max_update_cycles) {
+        temporal_stats.max_update_cycles = temporal_stats.update_cycles;
+    }
+}
+
+// 获取某通道的时序特征 (ROTS_TEMPORAL_FEATURES项)
+ROTS_StatusTypeDef ROTS_TemporalFeatures_Get(uint8_t channel, float* features) {
+    if (channel >= temporal_channel_count || !features) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(features, temporal_channels[channel].features, sizeof(temporal_channels[channel].features));
+    return ROTS_OK;
+}
+
+// 所选通道相对基线的平均偏离: (|EWMA - 基线| + 窗口极差) / (基线 + 下限)
+// 窗口未满或有通道处于响应期时返回ROTS_BUSY, 此时无法判定为洁净空气
+ROTS_StatusTypeDef ROTS_TemporalFeatures_GetDeviation(uint32_t channel_mask, float* deviation) {
+    if (!deviation) {
+        return ROTS_INVALID_PARAM;
+    }
+    if (temporal_fill < ROTS_TEMPORAL_WINDOW || (temporal_stats.onset_mask & channel_mask) != 0) {
+        return ROTS_BUSY;
+    }
+
+    float sum = 0.0f;
+    uint8_t count = 0;
+    for (uint8_t ch = 0; ch < temporal_channel_count; ch++) {
+        if (!(channel_mask & (1UL << ch))) continue;
+
+        const ROTS_TemporalChannel_t* channel = &temporal_channels[ch];
+        float offset = fabsf(channel->ewma - channel->baseline) + channel->features[ROTS_TEMPORAL_RANGE];
+        sum += offset / (fabsf(channel->baseline) + ROTS_TEMPORAL_DEVIATION_FLOOR);
+        count++;
+    }
+    if (count == 0) {
+        return ROTS_ERROR;
+    }
+
+    *deviation = sum / count;
+    return ROTS_OK;
+}
+
+// 获取统计
+ROTS_StatusTypeDef ROTS_TemporalFeatures_GetStats(ROTS_TemporalStats_t* stats) {
+    if (!stats) {
+        return ROTS_INVALID_PARAM;
+    }
+
+    memcpy(stats, &temporal_stats, sizeof(ROTS_TemporalStats_t));
+    return ROTS_OK;
+}
+
+// 单通道增量更新; window为 [滑出样本 (evict时)] + 窗口内样本, 最新在末尾
+static void ROTS_TemporalFeatures_UpdateChannel(ROTS_TemporalChannel_t* channel, const float* window, uint16_t length,
+                                                bool evict, uint32_t now_ms, float interval_ms) {
+    float value = window[length - 1];
+    int64_t q = (int64_t)lroundf(value * ROTS_TEMPORAL_FIXED_SCALE);
+
+    // 滑动和: 滑出最旧样本后其余样本下标各减1
+    if (evict) {
+        int64_t q_old = (int64_t)lroundf(window[0] * ROTS_TEMPORAL_FIXED_SCALE);
+        channel->weighted_sum += (ROTS_TEMPORAL_WINDOW - 1) * q - (channel->sum - q_old);
+        channel->sum += q - q_old;
+    } else {
+        channel->weighted_sum += (int64_t)temporal_fill * q;
+        channel->sum += q;
+    }
+    uint16_t fill = evict ? ROTS_TEMPORAL_WINDOW : temporal_fill + 1;
+
+    // EWMA与慢速基线 (响应期间冻结基线)
+    if (temporal_fill == 0) {
+        channel->ewma = value;
+        channel->baseline = value;
+    } else {
+        channel->ewma += ROTS_TEMPORAL_EWMA_ALPHA * (value - channel->ewma);
+    }
+
+    float excess = value - channel->baseline;
+    if (!channel->onset && excess > ROTS_TEMPORAL_ONSET_DELTA) {
+        channel->onset = true;
+        channel->onset_time = now_ms;
+    } else if (channel->onset && excess < ROTS_TEMPORAL_ONSET_DELTA * ROTS_TEMPORAL_ONSET_RELEASE) {
+        channel->onset = false;
+    }
+    if (!channel->onset) {
+        channel->baseline += ROTS_TEMPORAL_BASELINE_ALPHA * (value - channel->baseline);
+    }
+
+    // 窗口极值
+    ROTS_TemporalFeatures_PushDeque(&channel->max_queue, window, length, value, true);
+    ROTS_TemporalFeatures_PushDeque(&channel->min_queue, window, length, value, false);
+    float max = ROTS_TemporalFeatures_Value(window, length, channel->max_queue.seq[channel->max_queue.head]);
+    float min = ROTS_TemporalFeatures_Value(window, length, channel->min_queue.seq[channel->min_queue.head]);
+
+    // 最小二乘斜率: (nΣiy - ΣiΣy) / (nΣi² - (Σi)²), 按平均采样间隔换算为每秒
+    float slope = 0.0f;
+    if (fill > 1 && interval_ms > 0.0f) {
+        int64_t n = fill;
+        int64_t sum_i = n * (n - 1) / 2;
+        int64_t sum_ii = (n - 1) * n * (2 * n - 1) / 6;
+        float numerator = (float)(n * channel->weighted_sum - sum_i * channel->sum);
+        float denominator = (float)(n * sum_ii - sum_i * sum_i);
+        slope = numerator / denominator / ROTS_TEMPORAL_FIXED_SCALE * (1000.0f / interval_ms);
+    }
+
+    float mean = (float)channel->sum / ROTS_TEMPORAL_FIXED_SCALE / fill;
+    float duration = fill * interval_ms / 1000.0f;
+    float onset_age = 0.0f;
+    if (channel->onset) {
+        onset_age = (now_ms - channel->onset_time) / 1000.0f;
+        if (onset_age > ROTS_TEMPORAL_ONSET_AGE_MAX) onset_age = ROTS_TEMPORAL_ONSET_AGE_MAX;
+    }
+
+    channel->features[ROTS_TEMPORAL_SLOPE] = slope;
+    channel->features[ROTS_TEMPORAL_EWMA] = channel->ewma;
+    channel->features[ROTS_TEMPORAL_RANGE] = max - min;
+    channel->features[ROTS_TEMPORAL_AREA] = (mean - channel->baseline) * duration;
+    channel->features[ROTS_TEMPORAL_ONSET_AGE] = onset_age;
+}
+
+// 单调队列入队: 先移除滑出窗口的队首, 再从队尾移除被新样本支配的元素
+static void ROTS_TemporalFeatures_PushDeque(ROTS_TemporalDeque_t* queue, const float* window, uint16_t length,
+                                            float value, bool keep_max) {
+    uint16_t fill = length > ROTS_TEMPORAL_WINDOW ? ROTS_TEMPORAL_WINDOW : length;
+    while (queue->count > 0 && (uint8_t)(temporal_seq - queue->seq[queue->head]) >= fill) {
+        queue->head = (queue->head + 1) & ROTS_TEMPORAL_MASK;
+        queue->count--;
+    }
+
+    while (queue->count > 0) {
+        uint8_t back = queue->seq[(queue->head + queue->count - 1) & ROTS_TEMPORAL_MASK];
+        float back_value = ROTS_TemporalFeatures_Value(window, length, back);
+        if (keep_max ? back_value > value : back_value < value) break;
+        queue->count--;
+    }
+
+    queue->seq[(queue->head + queue->count) & ROTS_TEMPORAL_MASK] = temporal_seq;
+    queue->count++;
+}
+
+// 按样本序号取值 (序号差即样本年龄)
+static inline float ROTS_TemporalFeatures_Value(const float* window, uint16_t length, uint8_t seq) {
+    return window[length - 1 - (uint8_t)(temporal_seq - seq)];
+}
@@ -0,0 +1,52 @@
+// ROTS Temporal Features Header
+#ifndef ROTS_TEMPORAL_FEATURES_H
+#define ROTS_TEMPORAL_FEATURES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rots_sender.h"
+
+// 滑动窗口配置
+#define ROTS_TEMPORAL_WINDOW          64      // 窗口长度 (历史帧, 2的幂; 6.4s)
+#define ROTS_TEMPORAL_FIXED_SCALE     16.0f   // 滑动和按1/16 ppm定点累加, 长时间运行无累积误差
+#define ROTS_TEMPORAL_EWMA_ALPHA      0.1f    // 快速EWMA
+#define ROTS_TEMPORAL_BASELINE_ALPHA  0.005f  // 慢速基线 (响应期间冻结)
+#define ROTS_TEMPORAL_ONSET_DELTA     20.0f   // 高于基线该值 (ppm) 判为响应起始
+#define ROTS_TEMPORAL_ONSET_RELEASE   0.5f    // 回落到起始阈值的该比例以下时响应结束
+#define ROTS_TEMPORAL_ONSET_AGE_MAX   60.0f   // 起始后时间上限 (s)
+#define ROTS_TEMPORAL_DEVIATION_FLOOR 20.0f   // 相对偏离的分母下限 (ppm), 避免基线接近0时放大噪声
+
+// 每通道时序特征 (在特征向量中按通道连续排列)
+typedef enum {
+    ROTS_TEMPORAL_SLOPE = 0,      // 窗口内最小二乘斜率 (ppm/s)
+    ROTS_TEMPORAL_EWMA,           // 快速EWMA (ppm)
+    ROTS_TEMPORAL_RANGE,          // 窗口内极差 (ppm)
+    ROTS_TEMPORAL_AREA,           // 窗口内高于基线的面积 (ppm*s)
+    ROTS_TEMPORAL_ONSET_AGE,      // 响应起始后的时间 (s), 无响应为0
+    ROTS_TEMPORAL_FEATURES
+} ROTS_TemporalFeature_t;
+
+// 统计
+typedef struct {
+    uint32_t updates;
+    uint16_t window_fill;
+    uint32_t onset_mask;          // 处于响应期的通道
+    uint32_t update_cycles;       // 最近一帧全部通道的更新耗时
+    uint32_t max_update_cycles;
+} ROTS_TemporalStats_t;
+
+// 函数声明
+ROTS_StatusTypeDef ROTS_TemporalFeatures_Init(uint8_t channel_count);
+void ROTS_TemporalFeatures_Reset(void);
+void ROTS_TemporalFeatures_Update(const ROTS_SensorData_t* data);
+ROTS_StatusTypeDef ROTS_TemporalFeatures_Get(uint8_t channel, float* features);
+ROTS_StatusTypeDef ROTS_TemporalFeatures_GetDeviation(uint32_t channel_mask, float* deviation);
+ROTS_StatusTypeDef ROTS_TemporalFeatures_GetStats(ROTS_TemporalStats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROTS_TEMPORAL_FEATURES_H */
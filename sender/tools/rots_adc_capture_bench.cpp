@@ -0,0 +1,118 @@
+// ROTS ADC Capture Bench - 后台采集帧吞吐测量 (主机端)
+//
+// 启动与固件相同的采集模块 (主机后端为独立线程生成合成帧),
+// 主线程按给定间隔轮询 ROTS_ADCCapture_GetLatestFrame, 模拟传感器任务取帧.
+// 报告采集与取帧的帧率、被新帧取代的跳帧数和读取忙次数, 并检查
+// 取到的帧序号递增、时间戳不倒退、码值在12位范围内,
+// 以及 取帧数 + 跳帧数 = 首末帧序号之差 + 1. 任一检查不通过时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -I../src -o rots_adc_capture_bench rots_adc_capture_bench.cpp
+//       ../src/rots_adc_capture.cpp ../src/rots_seqlock.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_adc_capture_bench [--rate HZ] [--ms N] [--poll-us N]
+// --rate 0 为全速生成 (测量后端上限), --poll-us 0 为不间断轮询.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "rots_sender.h"
+#include "rots_adc_capture.h"
+
+#define BENCH_DEFAULT_RATE_HZ  ROTS_ADC_CAPTURE_SAMPLE_RATE_HZ
+#define BENCH_DEFAULT_MS       2000
+#define BENCH_DEFAULT_POLL_US  5000     // 传感器任务的典型取帧间隔 (200Hz)
+
+typedef std::chrono::steady_clock Clock_t;
+
+// 私有函数声明
+static int Bench_Usage(void);
+
+int main(int argc, char** argv) {
+    uint32_t rate_hz = BENCH_DEFAULT_RATE_HZ;
+    uint32_t duration_ms = BENCH_DEFAULT_MS;
+    uint32_t poll_us = BENCH_DEFAULT_POLL_US;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Bench_Usage();
+        } else if (strcmp(argv[i], "--rate") == 0) {
+            rate_hz = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--ms") == 0) {
+            duration_ms = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--poll-us") == 0) {
+            poll_us = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Bench_Usage();
+        }
+    }
+    if (duration_ms == 0) {
+        return Bench_Usage();
+    }
+    if (ROTS_ADCCapture_Init(rate_hz) != ROTS_OK) {
+        fprintf(stderr, "rate must be at most %d Hz (0 = free running)\n", ROTS_ADC_CAPTURE_MAX_RATE_HZ);
+        return 2;
+    }
+
+    uint64_t polls = 0, busy = 0, repeats = 0, errors = 0;
+    uint32_t first_sequence = 0, last_sequence = 0, last_timestamp = 0;
+    ROTS_ADCFrame_t frame;
+
+    Clock_t::time_point start = Clock_t::now();
+    Clock_t::time_point end = start + std::chrono::milliseconds(duration_ms);
+    ROTS_ADCCapture_Start();
+    while (Clock_t::now() < end) {
+        polls++;
+        if (ROTS_ADCCapture_GetLatestFrame(&frame) != ROTS_OK) {
+            busy++;
+        } else if (frame.sequence == last_sequence) {
+            repeats++;
+        } else {
+            bool intact = frame.sequence > last_sequence && frame.timestamp_us >= last_timestamp;
+            for (int ch = 0; intact && ch < ROTS_MAX_SENSORS; ch++) {
+                intact = frame.raw[ch] <= 4095;
+            }
+            if (!intact) {
+                errors++;
+            }
+            if (first_sequence == 0) {
+                first_sequence = frame.sequence;
+            }
+            last_sequence = frame.sequence;
+            last_timestamp = frame.timestamp_us;
+        }
+
+        if (poll_us) {
+            std::this_thread::sleep_for(std::chrono::microseconds(poll_us));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    ROTS_ADCCapture_Stop();
+    double seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    ROTS_ADCCaptureStats_t stats;
+    ROTS_ADCCapture_GetStats(&stats);
+    printf("rate %u Hz%s, poll every %u us, %.2f s\n", rate_hz, rate_hz ? "" : " (free running)", poll_us, seconds);
+    printf("captured %u frames (%.0f frames/s), last scan %u us\n", (unsigned)stats.frames_captured,
+           stats.frames_captured / seconds, (unsigned)stats.last_scan_us);
+    printf("consumed %u frames (%.0f frames/s), skipped %u (%.1f%%), %llu polls: %llu repeated, %llu busy\n",
+           (unsigned)stats.frames_consumed, stats.frames_consumed / seconds, (unsigned)stats.frames_skipped,
+           stats.frames_captured ? stats.frames_skipped * 100.0 / stats.frames_captured : 0.0,
+           (unsigned long long)polls, (unsigned long long)repeats, (unsigned long long)busy);
+    printf("%llu frames out of order or out of range\n", (unsigned long long)errors);
+
+    bool accounted = first_sequence == 0 ||
+                     stats.frames_consumed + stats.frames_skipped == last_sequence - first_sequence + 1;
+    bool ok = errors == 0 && stats.frames_consumed > 0 && accounted && last_sequence <= stats.frames_captured;
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static int Bench_Usage(void) {
+    fprintf(stderr, "usage: rots_adc_capture_bench [--rate HZ] [--ms N] [--poll-us N]\n");
+    return 2;
+}
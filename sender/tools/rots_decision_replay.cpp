@@ -0,0 +1,249 @@
+// ROTS Decision Replay - 判定平滑回放工具 (主机端)
+//
+// 把记录下的逐次推理结果送入与固件相同的判定平滑器, 打印产生的事件,
+// 并统计相比逐次发布节省的消息数, 用于调整窗口和阈值.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_decision_replay rots_decision_replay.cpp
+//       ../src/rots_decision_smoother.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_decision_replay <trace.txt> [--window N] [--enter N] [--exit N]
+//                        [--enter-conf C] [--exit-conf C] [--quiet]
+//   rots_decision_replay check
+//
+// trace.txt 每行一次推理 ('#'起为注释):
+//   <timestamp_ms> <odor_type> <confidence> [intensity]
+// odor_type为0..6 (内置气味, 6为混合类) 或16起 (现场学习的气味, 0x10 + 槽位)
+//
+// check 用内置的合成序列检查: 混合类的出现与消失, 消失事件的载荷
+// (无气味, 强度0, 结束的气味单独给出), 以及气味持续期间修改配置不产生消失事件.
+// 任一检查不通过时返回1.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "rots_sender.h"
+#include "rots_decision_smoother.h"
+
+#define REPLAY_CHECK_PERIOD_MS  500     // 合成序列的推理间隔
+#define REPLAY_MIXED_CLASS      ((ROTS_OdorType_t)ROTS_AI_ODOR_CLASSES)  // 分类器的混合类
+
+// 私有函数声明
+static int Replay_Check(void);
+static int Replay_Feed(ROTS_OdorType_t odor_type, float confidence, int count, uint32_t* now,
+                       ROTS_DecisionEvent_t* last_event);
+static bool Replay_ParseOptions(int argc, char** argv, ROTS_SmootherConfig_t* config, bool* quiet);
+static int Replay_Usage(void);
+
+int main(int argc, char** argv) {
+    static const char* const event_names[] = { "none", "onset", "change", "offset" };
+
+    if (argc == 2 && strcmp(argv[1], "check") == 0) {
+        return Replay_Check();
+    }
+
+    ROTS_SmootherConfig_t config;
+    bool quiet = false;
+    ROTS_DecisionSmoother_Init(NULL);
+    ROTS_DecisionSmoother_GetConfig(&config);
+    if (argc < 2 || !Replay_ParseOptions(argc, argv, &config, &quiet)) {
+        return Replay_Usage();
+    }
+    if (ROTS_DecisionSmoother_Init(&config) != ROTS_OK) {
+        fprintf(stderr, "invalid configuration: need 1 <= exit <= enter <= window <= %d, "
+                        "0 <= exit-conf <= enter-conf <= 1\n", ROTS_SMOOTHER_MAX_WINDOW);
+        return 2;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::string line;
+    int line_no = 0;
+    uint32_t class_flips = 0;
+    ROTS_OdorType_t last_raw = ROTS_ODOR_UNKNOWN;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        unsigned long timestamp;
+        unsigned odor_type;
+        float confidence;
+        if (!(fields >> timestamp)) continue;
+        if (!(fields >> odor_type >> confidence)) {
+            fprintf(stderr, "%s:%d: expected '<timestamp_ms> <odor_type> <confidence> [intensity]'\n",
+                    argv[1], line_no);
+            return 1;
+        }
+
+        ROTS_OdorResult_t result;
+        memset(&result, 0, sizeof(result));
+        result.odor_type = (ROTS_OdorType_t)odor_type;
+        snprintf(result.odor_name, sizeof(result.odor_name), "class%u", odor_type);
+        result.confidence = confidence;
+        result.intensity = confidence * 100.0f;
+        fields >> result.intensity;
+        result.timestamp = (uint32_t)timestamp;
+
+        // 逐次发布时接收端看到的类别变化次数
+        ROTS_OdorType_t raw = confidence > config.enter_confidence ? result.odor_type : ROTS_ODOR_UNKNOWN;
+        if (raw != ROTS_ODOR_UNKNOWN && raw != last_raw) {
+            class_flips++;
+        }
+        if (raw != ROTS_ODOR_UNKNOWN) {
+            last_raw = raw;
+        }
+
+        ROTS_DecisionEvent_t event;
+        ROTS_StatusTypeDef status = ROTS_DecisionSmoother_Update(&result, &event);
+        if (status == ROTS_INVALID_PARAM) {
+            fprintf(stderr, "%s:%d: unknown odor type %u\n", argv[1], line_no, odor_type);
+            return 1;
+        }
+        if (status == ROTS_OK && !quiet) {
+            printf("%10lu  %-6s  %-8s confidence %.2f", timestamp, event_names[event.type],
+                   event.result.odor_name, event.result.confidence);
+            if (event.previous_type != ROTS_ODOR_UNKNOWN) {
+                printf("  (after class%d for %lu ms)", event.previous_type, (unsigned long)event.duration_ms);
+            }
+            if (event.type == ROTS_DECISION_OFFSET) {
+                printf("  ended class%d", event.ended_type);
+            }
+            printf("\n");
+        }
+    }
+
+    ROTS_SmootherStats_t stats;
+    ROTS_DecisionSmoother_GetStats(&stats);
+    uint32_t events = stats.onsets + stats.changes + stats.offsets;
+    printf("window %u, enter %u votes > %.2f, exit < %u votes (> %.2f to stay)\n",
+           config.window, config.enter_votes, config.enter_confidence, config.exit_votes, config.exit_confidence);
+    printf("%lu results, %lu per-result publishes, %lu class flips\n",
+           (unsigned long)stats.updates, (unsigned long)stats.detections, (unsigned long)class_flips);
+    printf("%lu events (%lu onset, %lu change, %lu offset), %.1f%% fewer messages\n",
+           (unsigned long)events, (unsigned long)stats.onsets, (unsigned long)stats.changes,
+           (unsigned long)stats.offsets,
+           stats.detections ? 100.0 * (1.0 - (double)events / stats.detections) : 0.0);
+    return 0;
+}
+
+// 解析选项
+static bool Replay_ParseOptions(int argc, char** argv, ROTS_SmootherConfig_t* config, bool* quiet) {
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--quiet") == 0) {
+            *quiet = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (strcmp(argv[i - 1], "--window") == 0) {
+            config->window = (uint8_t)strtoul(value, NULL, 0);
+        } else if (strcmp(argv[i - 1], "--enter") == 0) {
+            config->enter_votes = (uint8_t)strtoul(value, NULL, 0);
+        } else if (strcmp(argv[i - 1], "--exit") == 0) {
+            config->exit_votes = (uint8_t)strtoul(value, NULL, 0);
+        } else if (strcmp(argv[i - 1], "--enter-conf") == 0) {
+            config->enter_confidence = strtof(value, NULL);
+        } else if (strcmp(argv[i - 1], "--exit-conf") == 0) {
+            config->exit_confidence = strtof(value, NULL);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 合成序列检查
+static int Replay_Check(void) {
+    int failures = 0;
+    uint32_t now = 0;
+    ROTS_DecisionEvent_t event;
+
+    // 混合类: 与内置气味一样出现, 消失时报告无气味并给出结束的气味
+    ROTS_DecisionSmoother_Init(NULL);
+    int onsets = Replay_Feed(REPLAY_MIXED_CLASS, 0.9f, ROTS_SMOOTHER_WINDOW, &now, &event);
+    bool ok = onsets == 1 && event.type == ROTS_DECISION_ONSET && event.result.odor_type == REPLAY_MIXED_CLASS &&
+              ROTS_DecisionSmoother_GetActive() == REPLAY_MIXED_CLASS;
+    printf("mixed class onset: %s\n", ok ? "OK" : "FAIL");
+    failures += !ok;
+
+    int offsets = Replay_Feed(ROTS_ODOR_UNKNOWN, 0.0f, ROTS_SMOOTHER_WINDOW, &now, &event);
+    ok = offsets == 1 && event.type == ROTS_DECISION_OFFSET && event.result.odor_type == ROTS_ODOR_UNKNOWN &&
+         event.result.intensity == 0.0f && event.result.confidence == 0.0f &&
+         event.ended_type == REPLAY_MIXED_CLASS && event.previous_type == REPLAY_MIXED_CLASS &&
+         event.duration_ms > 0 && ROTS_DecisionSmoother_GetActive() == ROTS_ODOR_UNKNOWN;
+    printf("offset payload (unknown, intensity 0, ended class%d): %s\n", REPLAY_MIXED_CLASS, ok ? "OK" : "FAIL");
+    failures += !ok;
+
+    // 气味持续期间修改配置: 不产生事件, 气味保持, 之后仍按新窗口正常消失
+    ROTS_DecisionSmoother_Init(NULL);
+    Replay_Feed(ROTS_ODOR_COFFEE, 0.9f, ROTS_SMOOTHER_WINDOW, &now, &event);
+    ROTS_SmootherConfig_t config;
+    ROTS_DecisionSmoother_GetConfig(&config);
+    config.window = 12;
+    config.enter_votes = 7;
+    config.exit_votes = 4;
+    ok = ROTS_DecisionSmoother_SetConfig(&config) == ROTS_OK;
+    int events = Replay_Feed(ROTS_ODOR_COFFEE, 0.9f, 1, &now, &event);
+    ok = ok && events == 0 && ROTS_DecisionSmoother_GetActive() == ROTS_ODOR_COFFEE;
+    printf("set config while active keeps odor: %s\n", ok ? "OK" : "FAIL");
+    failures += !ok;
+
+    // 新窗口12票中当前气味少于4票才消失: 再送1票后需8次无气味
+    offsets = Replay_Feed(ROTS_ODOR_UNKNOWN, 0.0f, 8, &now, &event);
+    ok = offsets == 0 && ROTS_DecisionSmoother_GetActive() == ROTS_ODOR_COFFEE;
+    offsets = Replay_Feed(ROTS_ODOR_UNKNOWN, 0.0f, 1, &now, &event);
+    ok = ok && offsets == 1 && event.type == ROTS_DECISION_OFFSET && event.ended_type == ROTS_ODOR_COFFEE;
+    printf("offset after set config follows new window: %s\n", ok ? "OK" : "FAIL");
+    failures += !ok;
+
+    // 无气味时修改配置: 保持空窗口, 同样不产生事件
+    ok = ROTS_DecisionSmoother_SetConfig(&config) == ROTS_OK &&
+         Replay_Feed(ROTS_ODOR_UNKNOWN, 0.0f, config.window, &now, &event) == 0;
+    printf("set config while idle: %s\n", ok ? "OK" : "FAIL");
+    failures += !ok;
+
+    printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
+
+// 连续送入count次相同结果, 返回产生的事件数, last_event为最后一个事件
+static int Replay_Feed(ROTS_OdorType_t odor_type, float confidence, int count, uint32_t* now,
+                       ROTS_DecisionEvent_t* last_event) {
+    int events = 0;
+    for (int i = 0; i < count; i++) {
+        ROTS_OdorResult_t result;
+        memset(&result, 0, sizeof(result));
+        result.odor_type = odor_type;
+        snprintf(result.odor_name, sizeof(result.odor_name), "class%d", odor_type);
+        result.confidence = confidence;
+        result.intensity = confidence * 100.0f;
+        *now += REPLAY_CHECK_PERIOD_MS;
+        result.timestamp = *now;
+
+        ROTS_DecisionEvent_t event;
+        if (ROTS_DecisionSmoother_Update(&result, &event) == ROTS_OK) {
+            *last_event = event;
+            events++;
+        }
+    }
+    return events;
+}
+
+static int Replay_Usage(void) {
+    fprintf(stderr, "usage: rots_decision_replay <trace.txt> [--window N] [--enter N] [--exit N]\n"
+                    "                            [--enter-conf C] [--exit-conf C] [--quiet]\n"
+                    "       rots_decision_replay check\n");
+    return 2;
+}
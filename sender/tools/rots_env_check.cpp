@@ -0,0 +1,209 @@
+// ROTS Env Check - 环境传感器驱动模拟总线核对 (主机端)
+//
+// 主机构建的环境传感器驱动使用模拟BMP280寄存器和合成DHT22波形, 走与硬件相同的
+// 状态机与补偿/解码路径. 本工具用模拟时钟每10ms推进一次, 依次检查:
+//   - 正常读数: 数据手册示例原始值换算为约25.08°C/1006.53hPa, DHT22温湿度 (含负温度)
+//   - I2C无应答: 计错误, 判为不在线, 恢复后按探测周期重新探测并继续读数
+//   - BMP280转换卡住: 超时后计错误, 不更新读数
+//   - DHT22无响应/校验错误: 计错误, 温度陈旧后改用BMP280温度
+//   - 超出数据手册范围的读数与BMP280复位值: 计错误, 缓存保持上一次有效读数
+// 任一检查不通过时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_env_check rots_env_check.cpp ../src/rots_env_sensors.cpp
+//
+// 用法:
+//   rots_env_check [-v]
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "rots_sender.h"
+#include "rots_env_sensors.h"
+
+#define CHECK_STEP_MS           10
+#define CHECK_EXAMPLE_ADC_T     519888      // 数据手册示例原始值
+#define CHECK_EXAMPLE_ADC_P     415148
+#define CHECK_EXAMPLE_TEMP      25.08f
+#define CHECK_EXAMPLE_PRESSURE  1006.53f
+#define CHECK_BMP280_RESET      0x80000     // 转换未完成时数据寄存器的复位值
+
+// 私有变量
+static uint32_t check_now = 0;
+static int check_failures = 0;
+static bool check_verbose = false;
+
+// 私有函数声明
+static void Check_Run(uint32_t duration_ms);
+static void Check_Expect(const char* name, bool ok);
+static bool Check_Near(float value, float expected);
+static void Check_Print(const char* label);
+
+int main(int argc, char** argv) {
+    if (argc > 2 || (argc == 2 && strcmp(argv[1], "-v") != 0)) {
+        fprintf(stderr, "usage: rots_env_check [-v]\n");
+        return 2;
+    }
+    check_verbose = argc == 2;
+
+    ROTS_EnvReading_t reading;
+    ROTS_EnvStats_t stats, before;
+
+    // 正常读数
+    ROTS_EnvSensors_Init();
+    Check_Run(3000);
+    ROTS_EnvSensors_GetReading(&reading);
+    ROTS_EnvSensors_GetStats(&stats);
+    Check_Print("normal");
+    Check_Expect("BMP280 probed and read", stats.bmp280_present && stats.bmp280_reads >= 2 && stats.bmp280_errors == 0);
+    Check_Expect("BMP280 example pressure", reading.pressure_valid && Check_Near(reading.pressure, CHECK_EXAMPLE_PRESSURE));
+    Check_Expect("DHT22 temperature/humidity", reading.temperature_valid && reading.humidity_valid &&
+                 Check_Near(reading.temperature, 23.5f) && Check_Near(reading.humidity, 45.0f) &&
+                 stats.dht22_reads >= 1 && stats.dht22_errors == 0);
+    Check_Expect("reading age", ROTS_EnvSensors_GetAge(&reading, check_now) < ROTS_DHT22_INTERVAL_MS);
+
+    ROTS_EnvSensors_MockSetDHT22(-12.3f, 81.5f);
+    Check_Run(ROTS_DHT22_INTERVAL_MS + 100);
+    ROTS_EnvSensors_GetReading(&reading);
+    Check_Expect("DHT22 negative temperature", Check_Near(reading.temperature, -12.3f) && Check_Near(reading.humidity, 81.5f));
+    ROTS_EnvSensors_MockSetDHT22(23.5f, 45.0f);
+
+    // I2C无应答: 读取失败后判为不在线, 恢复后重新探测
+    ROTS_EnvSensors_GetStats(&before);
+    ROTS_EnvSensors_GetReading(&reading);
+    uint32_t pressure_time = reading.pressure_time;
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_I2C_NACK);
+    Check_Run(3000);
+    ROTS_EnvSensors_GetStats(&stats);
+    ROTS_EnvSensors_GetReading(&reading);
+    Check_Print("nack");
+    Check_Expect("NACK counted and sensor dropped", !stats.bmp280_present && stats.bmp280_errors > before.bmp280_errors &&
+                 stats.bmp280_reads == before.bmp280_reads && reading.pressure_time == pressure_time);
+    Check_Expect("NACK does not affect DHT22", stats.dht22_reads > before.dht22_reads &&
+                 stats.dht22_errors == before.dht22_errors);
+
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_NONE);
+    Check_Run(ROTS_BMP280_PROBE_INTERVAL_MS + 2 * ROTS_BMP280_INTERVAL_MS);
+    ROTS_EnvSensors_GetStats(&stats);
+    ROTS_EnvSensors_GetReading(&reading);
+    Check_Expect("re-probed after NACK", stats.bmp280_present && stats.bmp280_reads > before.bmp280_reads &&
+                 check_now - reading.pressure_time <= ROTS_BMP280_INTERVAL_MS + ROTS_BMP280_CONVERSION_MS);
+
+    // 转换卡住: 每个周期超时一次, 不产生读数
+    ROTS_EnvSensors_GetStats(&before);
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_BMP280_BUSY);
+    Check_Run(5 * ROTS_BMP280_INTERVAL_MS);
+    ROTS_EnvSensors_GetStats(&stats);
+    Check_Print("busy");
+    Check_Expect("conversion timeout counted", stats.bmp280_present && stats.bmp280_reads == before.bmp280_reads &&
+                 stats.bmp280_errors >= before.bmp280_errors + 4 && stats.bmp280_errors <= before.bmp280_errors + 5);
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_NONE);
+
+    // DHT22无响应与校验错误: 温度陈旧后改用BMP280温度
+    ROTS_EnvSensors_GetStats(&before);
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_DHT22_SILENT);
+    Check_Run(ROTS_DHT22_INTERVAL_MS);
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_DHT22_CHECKSUM);
+    Check_Run(ROTS_ENV_STALE_MS + ROTS_BMP280_INTERVAL_MS);
+    ROTS_EnvSensors_GetStats(&stats);
+    ROTS_EnvSensors_GetReading(&reading);
+    Check_Print("dht22 errors");
+    Check_Expect("DHT22 errors counted", stats.dht22_reads == before.dht22_reads &&
+                 stats.dht22_errors >= before.dht22_errors + 3);
+    Check_Expect("stale DHT22 falls back to BMP280", Check_Near(reading.temperature, CHECK_EXAMPLE_TEMP) &&
+                 Check_Near(reading.humidity, 45.0f) &&
+                 check_now - reading.humidity_time > ROTS_ENV_STALE_MS);
+    ROTS_EnvSensors_MockSetFault(ROTS_ENV_MOCK_NONE);
+    Check_Run(ROTS_DHT22_INTERVAL_MS + 100);
+    ROTS_EnvSensors_GetReading(&reading);
+    Check_Expect("DHT22 recovers", Check_Near(reading.temperature, 23.5f) &&
+                 ROTS_EnvSensors_GetAge(&reading, check_now) < ROTS_DHT22_INTERVAL_MS);
+
+    // 超出范围的读数: 计错误, 缓存保持上一次有效值
+    static const struct {
+        const char* name;
+        uint32_t adc_T;
+        uint32_t adc_P;
+    } bmp_cases[] = {
+        { "BMP280 reset value", CHECK_BMP280_RESET, CHECK_BMP280_RESET },
+        { "BMP280 pressure above range", CHECK_EXAMPLE_ADC_T, 100000 },
+        { "BMP280 temperature above range", 800000, CHECK_EXAMPLE_ADC_P },
+        { "BMP280 temperature below range", 300000, CHECK_EXAMPLE_ADC_P }
+    };
+    for (size_t i = 0; i < sizeof(bmp_cases) / sizeof(bmp_cases[0]); i++) {
+        ROTS_EnvSensors_GetStats(&before);
+        ROTS_EnvSensors_GetReading(&reading);
+        pressure_time = reading.pressure_time;
+        ROTS_EnvSensors_MockSetBMP280(bmp_cases[i].adc_T, bmp_cases[i].adc_P);
+        Check_Run(2 * ROTS_BMP280_INTERVAL_MS);
+        ROTS_EnvSensors_GetStats(&stats);
+        ROTS_EnvSensors_GetReading(&reading);
+        Check_Expect(bmp_cases[i].name, stats.bmp280_present && stats.bmp280_reads == before.bmp280_reads &&
+                     stats.bmp280_errors >= before.bmp280_errors + 2 && reading.pressure_time == pressure_time &&
+                     Check_Near(reading.pressure, CHECK_EXAMPLE_PRESSURE));
+    }
+    ROTS_EnvSensors_MockSetBMP280(CHECK_EXAMPLE_ADC_T, CHECK_EXAMPLE_ADC_P);
+
+    static const struct {
+        const char* name;
+        float temperature;
+        float humidity;
+    } dht_cases[] = {
+        { "DHT22 humidity above range", 23.5f, 120.0f },
+        { "DHT22 temperature above range", 95.0f, 45.0f },
+        { "DHT22 temperature below range", -45.0f, 45.0f }
+    };
+    for (size_t i = 0; i < sizeof(dht_cases) / sizeof(dht_cases[0]); i++) {
+        ROTS_EnvSensors_GetStats(&before);
+        ROTS_EnvSensors_MockSetDHT22(dht_cases[i].temperature, dht_cases[i].humidity);
+        Check_Run(ROTS_DHT22_INTERVAL_MS);
+        ROTS_EnvSensors_GetStats(&stats);
+        ROTS_EnvSensors_GetReading(&reading);
+        Check_Expect(dht_cases[i].name, stats.dht22_reads == before.dht22_reads &&
+                     stats.dht22_errors == before.dht22_errors + 1 &&
+                     Check_Near(reading.temperature, 23.5f) && Check_Near(reading.humidity, 45.0f));
+
+        // 恢复一次有效读数, 避免连续错误使温度陈旧而改用BMP280温度
+        ROTS_EnvSensors_MockSetDHT22(23.5f, 45.0f);
+        Check_Run(ROTS_DHT22_INTERVAL_MS);
+    }
+    Check_Print("final");
+
+    printf("%s\n", check_failures ? "FAIL" : "OK");
+    return check_failures ? 1 : 0;
+}
+
+// 按模拟时钟推进驱动状态机
+static void Check_Run(uint32_t duration_ms) {
+    for (uint32_t t = 0; t < duration_ms; t += CHECK_STEP_MS) {
+        check_now += CHECK_STEP_MS;
+        ROTS_EnvSensors_Update(check_now);
+    }
+}
+
+static void Check_Expect(const char* name, bool ok) {
+    printf("%-40s %s\n", name, ok ? "OK" : "FAIL");
+    if (!ok) {
+        check_failures++;
+    }
+}
+
+// 读数比较 (DHT22分辨率0.1, BMP280换算到0.01)
+static bool Check_Near(float value, float expected) {
+    return fabsf(value - expected) < 0.051f;
+}
+
+static void Check_Print(const char* label) {
+    if (!check_verbose) {
+        return;
+    }
+
+    ROTS_EnvReading_t reading;
+    ROTS_EnvStats_t stats;
+    ROTS_EnvSensors_GetReading(&reading);
+    ROTS_EnvSensors_GetStats(&stats);
+    printf("  [%s] t=%u ms: %.2f C, %.1f %%RH, %.2f hPa; BMP280 %s %u reads %u errors; DHT22 %u reads %u errors\n",
+           label, check_now, reading.temperature, reading.humidity, reading.pressure,
+           stats.bmp280_present ? "present" : "absent", stats.bmp280_reads, stats.bmp280_errors,
+           stats.dht22_reads, stats.dht22_errors);
+}
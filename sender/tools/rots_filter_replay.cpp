@@ -0,0 +1,325 @@
+// ROTS Filter Replay - 信号滤波回放工具 (主机端)
+//
+// 把记录下的 (或合成的) 通道读数送入与固件相同的滤波级
+// (Hampel -> 中值 -> IIR低通), 在随机位置注入尖峰后再跑一遍,
+// 比较两遍输出: 尖峰漏过滤波的幅度即为抑制效果. 同时报告Hampel剔除数,
+// 合成轨迹的阶跃上升时间, 以及在10/100/1000Hz合成轨迹上每帧耗时的平均值与最大值
+// (主机构建为ns, 同时给出占帧周期的比例), 用于调整窗口、阈值和截止频率.
+// 启用了Hampel或中值级而尖峰漏过超过 --max-leak (百分比, 默认5) 时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_filter_replay rots_filter_replay.cpp ../src/rots_signal_filter.cpp
+//
+// 用法:
+//   rots_filter_replay <trace.txt | synth> [--spikes N] [--spike-size X] [--hampel W] [--threshold T]
+//                      [--median W] [--cutoff HZ] [--stages N] [--max-leak PCT] [--out filtered.txt]
+//
+// trace.txt 每行一帧 ('#'起为注释): <timestamp_ms> <通道0> <通道1> ...
+// synth 为8通道10Hz合成轨迹: 基线50 + 噪声, 第200帧起阶跃到150.
+// 参数为0时关闭对应的滤波级 (--hampel 0, --median 0, --cutoff 0).
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_signal_filter.h"
+
+#define REPLAY_SYNTH_FRAMES     1000
+#define REPLAY_SYNTH_CHANNELS   8
+#define REPLAY_SYNTH_PERIOD_MS  100
+#define REPLAY_SYNTH_STEP_FRAME 200
+#define REPLAY_SYNTH_LOW        50.0f
+#define REPLAY_SYNTH_HIGH       150.0f
+#define REPLAY_MAX_LEAK         5.0f       // 默认允许的尖峰漏过 (%)
+
+static const uint32_t replay_sweep_rates[] = { 10, 100, 1000 };  // 耗时扫描的采样率 (Hz)
+
+// 轨迹: frames x channels, 按帧存放
+typedef struct {
+    std::vector<uint32_t> timestamps;
+    std::vector<float> values;
+    uint8_t channels;
+} Trace_t;
+
+// 私有函数声明
+static bool Replay_LoadTrace(const char* path, Trace_t* trace);
+static void Replay_Synthesize(Trace_t* trace, uint32_t period_ms);
+static void Replay_Filter(const Trace_t& input, std::vector<float>* output, ROTS_FilterStats_t* stats,
+                          double* mean_cycles);
+static bool Replay_RateSweep(float cutoff);
+static float Replay_SampleRate(const Trace_t& trace);
+static int Replay_Usage(void);
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return Replay_Usage();
+    }
+
+    uint32_t spikes = 20;
+    float spike_size = 0.0f;
+    float cutoff = 2.0f;
+    float max_leak = REPLAY_MAX_LEAK;
+    const char* out_path = NULL;
+    ROTS_FilterConfig_t config;
+    ROTS_SignalFilter_Init();
+    ROTS_SignalFilter_GetConfig(&config);
+    for (int i = 2; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Replay_Usage();
+        }
+        const char* value = argv[i + 1];
+        if (strcmp(argv[i], "--spikes") == 0) {
+            spikes = (uint32_t)strtoul(value, NULL, 0);
+        } else if (strcmp(argv[i], "--spike-size") == 0) {
+            spike_size = strtof(value, NULL);
+        } else if (strcmp(argv[i], "--hampel") == 0) {
+            config.hampel_window = (uint8_t)strtoul(value, NULL, 0);
+            config.hampel_enabled = config.hampel_window > 0;
+        } else if (strcmp(argv[i], "--threshold") == 0) {
+            config.hampel_threshold = strtof(value, NULL);
+        } else if (strcmp(argv[i], "--median") == 0) {
+            config.median_window = (uint8_t)strtoul(value, NULL, 0);
+            config.median_enabled = config.median_window > 0;
+        } else if (strcmp(argv[i], "--cutoff") == 0) {
+            cutoff = strtof(value, NULL);
+        } else if (strcmp(argv[i], "--stages") == 0) {
+            config.iir_stages = (uint8_t)strtoul(value, NULL, 0);
+        } else if (strcmp(argv[i], "--max-leak") == 0) {
+            max_leak = strtof(value, NULL);
+        } else if (strcmp(argv[i], "--out") == 0) {
+            out_path = value;
+        } else {
+            return Replay_Usage();
+        }
+    }
+
+    Trace_t clean;
+    bool synth = strcmp(argv[1], "synth") == 0;
+    if (synth) {
+        Replay_Synthesize(&clean, REPLAY_SYNTH_PERIOD_MS);
+    } else if (!Replay_LoadTrace(argv[1], &clean)) {
+        return 1;
+    }
+    size_t frames = clean.timestamps.size();
+    float rate_hz = Replay_SampleRate(clean);
+
+    config.iir_enabled = cutoff > 0.0f;
+    if (ROTS_SignalFilter_Configure(&config) != ROTS_OK ||
+        (config.iir_enabled && ROTS_SignalFilter_SetIIRCutoff(cutoff, rate_hz, config.iir_stages) != ROTS_OK)) {
+        fprintf(stderr, "invalid filter configuration: windows must be odd 3..%d, 1..%d IIR stages\n",
+                ROTS_FILTER_MAX_WINDOW, ROTS_FILTER_IIR_MAX_STAGES);
+        return 2;
+    }
+    ROTS_SignalFilter_GetConfig(&config);
+
+    // 尖峰默认为轨迹幅度范围的2倍
+    if (spike_size <= 0.0f) {
+        std::pair<std::vector<float>::const_iterator, std::vector<float>::const_iterator> range =
+            std::minmax_element(clean.values.begin(), clean.values.end());
+        spike_size = 2.0f * fmaxf(*range.second - *range.first, 1.0f);
+    }
+
+    // 单帧尖峰注入到随机帧/通道 (避开开头未填满窗口的几帧)
+    Trace_t spiked = clean;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> frame_dist(ROTS_FILTER_MAX_WINDOW, frames - 1);
+    std::uniform_int_distribution<int> channel_dist(0, clean.channels - 1);
+    for (uint32_t s = 0; s < spikes && frames > ROTS_FILTER_MAX_WINDOW; s++) {
+        size_t frame = frame_dist(rng);
+        int channel = channel_dist(rng);
+        spiked.values[frame * clean.channels + channel] += (s & 1) ? -spike_size : spike_size;
+    }
+
+    std::vector<float> clean_out, spiked_out;
+    ROTS_FilterStats_t clean_stats, spiked_stats;
+    double spiked_mean = 0.0;
+    Replay_Filter(clean, &clean_out, &clean_stats, NULL);
+    Replay_Filter(spiked, &spiked_out, &spiked_stats, &spiked_mean);
+
+    // 尖峰漏过: 两遍输出之差 (相对尖峰幅度)
+    float leak_max = 0.0f;
+    double leak_sum = 0.0;
+    for (size_t i = 0; i < clean_out.size(); i++) {
+        float leak = fabsf(spiked_out[i] - clean_out[i]) / spike_size;
+        leak_sum += leak;
+        leak_max = fmaxf(leak_max, leak);
+    }
+
+    printf("%zu frames x %u channels at %.1f Hz\n", frames, clean.channels, rate_hz);
+    printf("filter: hampel %s (window %u, %.1f MAD), median %s (window %u), iir %s (%u stages, %.2f Hz, alpha %.3f)\n",
+           config.hampel_enabled ? "on" : "off", config.hampel_window, config.hampel_threshold,
+           config.median_enabled ? "on" : "off", config.median_window,
+           config.iir_enabled ? "on" : "off", config.iir_stages, cutoff, config.iir_alpha);
+    printf("%u spikes of %.1f: hampel rejected %u (clean run %u), leak max %.2f%% / mean %.4f%% of spike size\n",
+           spikes, spike_size, (unsigned)spiked_stats.outliers_rejected, (unsigned)clean_stats.outliers_rejected,
+           leak_max * 100.0f, leak_sum * 100.0 / clean_out.size());
+
+    // 合成轨迹: 阶跃10%-90%上升时间 (通道0)
+    if (synth) {
+        float low = REPLAY_SYNTH_LOW + 0.1f * (REPLAY_SYNTH_HIGH - REPLAY_SYNTH_LOW);
+        float high = REPLAY_SYNTH_LOW + 0.9f * (REPLAY_SYNTH_HIGH - REPLAY_SYNTH_LOW);
+        size_t rise_start = 0, rise_end = 0;
+        for (size_t f = REPLAY_SYNTH_STEP_FRAME; f < frames; f++) {
+            float value = clean_out[f * clean.channels];
+            if (!rise_start && value >= low) rise_start = f;
+            if (!rise_end && value >= high) rise_end = f;
+        }
+        printf("step: 10%% after %zu frames, 90%% after %zu frames (10-90%% rise %.0f ms)\n",
+               rise_start - REPLAY_SYNTH_STEP_FRAME, rise_end - REPLAY_SYNTH_STEP_FRAME,
+               (rise_end - rise_start) * 1000.0f / rate_hz);
+    }
+    printf("cost: %.0f ns per frame mean, %.0f max (host)\n", spiked_mean, (double)spiked_stats.max_cycles);
+
+    if (out_path) {
+        FILE* out = fopen(out_path, "w");
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", out_path);
+            return 1;
+        }
+        fprintf(out, "# timestamp_ms, then per channel: raw (with spikes) filtered\n");
+        for (size_t f = 0; f < frames; f++) {
+            fprintf(out, "%u", (unsigned)clean.timestamps[f]);
+            for (uint8_t ch = 0; ch < clean.channels; ch++) {
+                size_t i = f * clean.channels + ch;
+                fprintf(out, " %.4f %.4f", spiked.values[i], spiked_out[i]);
+            }
+            fprintf(out, "\n");
+        }
+        fclose(out);
+        printf("wrote %s\n", out_path);
+    }
+
+    // 各采样率下的每帧耗时 (同一滤波配置, 截止频率按各采样率重新换算)
+    bool swept = Replay_RateSweep(cutoff);
+
+    // 只有去尖峰级才对漏过负责, 纯IIR只做平滑
+    bool ok = swept && (!(config.hampel_enabled || config.median_enabled) || leak_max * 100.0f <= max_leak);
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 从头跑一遍滤波 (与固件一样逐帧原地处理), mean_cycles可为NULL
+static void Replay_Filter(const Trace_t& input, std::vector<float>* output, ROTS_FilterStats_t* stats,
+                          double* mean_cycles) {
+    ROTS_FilterConfig_t config;
+    ROTS_SignalFilter_GetConfig(&config);
+    ROTS_SignalFilter_Init();
+    ROTS_SignalFilter_Configure(&config);
+
+    double cycle_sum = 0.0;
+    *output = input.values;
+    for (size_t f = 0; f < input.timestamps.size(); f++) {
+        ROTS_SignalFilter_Process(&(*output)[f * input.channels], input.channels);
+        ROTS_SignalFilter_GetStats(stats);
+        cycle_sum += stats->last_cycles;
+    }
+    ROTS_SignalFilter_GetStats(stats);
+    if (mean_cycles) {
+        *mean_cycles = input.timestamps.empty() ? 0.0 : cycle_sum / input.timestamps.size();
+    }
+}
+
+// 在10/100/1000Hz合成轨迹上测每帧耗时的平均值与最大值
+static bool Replay_RateSweep(float cutoff) {
+    ROTS_FilterConfig_t config;
+    ROTS_SignalFilter_GetConfig(&config);
+
+    printf("cost by sample rate (synthetic %u channels, %u frames, host ns per frame):\n",
+           REPLAY_SYNTH_CHANNELS, REPLAY_SYNTH_FRAMES);
+    for (size_t r = 0; r < sizeof(replay_sweep_rates) / sizeof(replay_sweep_rates[0]); r++) {
+        uint32_t rate_hz = replay_sweep_rates[r];
+        if (config.iir_enabled &&
+            ROTS_SignalFilter_SetIIRCutoff(cutoff, (float)rate_hz, config.iir_stages) != ROTS_OK) {
+            fprintf(stderr, "cannot set %.2f Hz cutoff at %u Hz\n", cutoff, rate_hz);
+            return false;
+        }
+
+        Trace_t trace;
+        std::vector<float> output;
+        ROTS_FilterStats_t stats;
+        double mean = 0.0;
+        Replay_Synthesize(&trace, 1000 / rate_hz);
+        Replay_Filter(trace, &output, &stats, &mean);
+        printf("  %4u Hz: mean %6.0f, max %7.0f (%.3f%% / %.3f%% of the %u ms frame period)\n",
+               rate_hz, mean, (double)stats.max_cycles, mean * rate_hz / 1e7,
+               (double)stats.max_cycles * rate_hz / 1e7, 1000 / rate_hz);
+    }
+    return true;
+}
+
+// 由时间戳估计采样率 (合成或单帧轨迹按10Hz)
+static float Replay_SampleRate(const Trace_t& trace) {
+    size_t frames = trace.timestamps.size();
+    if (frames < 2 || trace.timestamps[frames - 1] <= trace.timestamps[0]) {
+        return 1000.0f / REPLAY_SYNTH_PERIOD_MS;
+    }
+    return (frames - 1) * 1000.0f / (trace.timestamps[frames - 1] - trace.timestamps[0]);
+}
+
+// 合成轨迹: 基线 + 高斯噪声, 中途阶跃 (模拟气味出现)
+static void Replay_Synthesize(Trace_t* trace, uint32_t period_ms) {
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    trace->channels = REPLAY_SYNTH_CHANNELS;
+    for (uint32_t f = 0; f < REPLAY_SYNTH_FRAMES; f++) {
+        trace->timestamps.push_back(f * period_ms);
+        float level = f >= REPLAY_SYNTH_STEP_FRAME ? REPLAY_SYNTH_HIGH : REPLAY_SYNTH_LOW;
+        for (uint8_t ch = 0; ch < REPLAY_SYNTH_CHANNELS; ch++) {
+            trace->values.push_back(level + noise(rng));
+        }
+    }
+}
+
+// 读取轨迹文件, 各帧通道数须一致
+static bool Replay_LoadTrace(const char* path, Trace_t* trace) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    trace->channels = 0;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        uint32_t timestamp;
+        if (!(fields >> timestamp)) continue;
+
+        float value;
+        uint8_t count = 0;
+        while (fields >> value && count < ROTS_FILTER_CHANNELS) {
+            trace->values.push_back(value);
+            count++;
+        }
+        if (count == 0 || (trace->channels && count != trace->channels)) {
+            fprintf(stderr, "%s:%d: expected '<timestamp_ms> <1..%d channel values>' with a fixed channel count\n",
+                    path, line_no, ROTS_FILTER_CHANNELS);
+            return false;
+        }
+        trace->channels = count;
+        trace->timestamps.push_back(timestamp);
+    }
+
+    if (trace->timestamps.empty()) {
+        fprintf(stderr, "%s: no frames\n", path);
+        return false;
+    }
+    return true;
+}
+
+static int Replay_Usage(void) {
+    fprintf(stderr, "usage: rots_filter_replay <trace.txt | synth> [--spikes N] [--spike-size X] [--hampel W]\n"
+                    "                          [--threshold T] [--median W] [--cutoff HZ] [--stages N]\n"
+                    "                          [--max-leak PCT] [--out filtered.txt]\n");
+    return 2;
+}
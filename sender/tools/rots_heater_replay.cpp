@@ -0,0 +1,244 @@
+// ROTS Heater Replay - MQ加热循环调度回放 (主机端)
+//
+// 以与固件相同的MQ-7/MQ-9配置驱动加热调度器, 用模拟时钟按固定步长推进若干
+// 60s高压/90s低压周期, 每步送入一帧合成码值 (与相位、周期和时间相关).
+// 通过SetDriver换上记录输出的驱动, 检查:
+//   - 每次占空比切换发生在预期的相位边界 (不晚于一个步长), 高压相255, 低压相为等效电压的占空比
+//   - 相位标签与按时间算出的相位一致
+//   - 每个低压相结束时锁存的码值等于该相最后window_ms内合成码值的平均 (四舍五入)
+//   - 锁存后该通道输出锁存值, 首次锁存前输出实时读数, 没有空窗口
+// 任一检查不通过时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_heater_replay rots_heater_replay.cpp
+//       ../src/rots_heater_scheduler.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_heater_replay [--cycles N] [--step-ms N] [--start-ms N]
+// --start-ms 可设为接近0xFFFFFFFF, 检查millis()回绕.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "rots_sender.h"
+#include "rots_heater_scheduler.h"
+
+#define REPLAY_DEFAULT_CYCLES   4
+#define REPLAY_DEFAULT_STEP_MS  100
+#define REPLAY_DEFAULT_START_MS 1000
+#define REPLAY_HEATERS          2
+#define REPLAY_MAX_SWITCHES     256
+#define REPLAY_HIGH_CODE        3500    // 高压相的合成码值 (清洁时读数偏高, 不应进入锁存值)
+
+// 记录的一次占空比输出
+typedef struct {
+    uint32_t time;
+    uint8_t heater;
+    uint8_t duty;
+} Replay_Switch_t;
+
+// 私有变量
+static const ROTS_HeaterConfig_t replay_configs[REPLAY_HEATERS] = {
+    { ROTS_CH_MQ7, ROTS_MQ7_HEATER_PIN, ROTS_MQ7_HEATER_HIGH_MS, ROTS_MQ7_HEATER_LOW_MS,
+      ROTS_MQ7_HEATER_LOW_MV, ROTS_HEATER_SAMPLE_WINDOW_MS },
+    { ROTS_CH_MQ9, ROTS_MQ9_HEATER_PIN, ROTS_MQ9_HEATER_HIGH_MS, ROTS_MQ9_HEATER_LOW_MS,
+      ROTS_MQ9_HEATER_LOW_MV, ROTS_HEATER_SAMPLE_WINDOW_MS }
+};
+static Replay_Switch_t replay_switches[REPLAY_MAX_SWITCHES];
+static uint32_t replay_switch_count = 0;
+static uint32_t replay_now = 0;
+
+// 私有函数声明
+static void Replay_SetDuty(uint8_t heater, uint8_t pin, uint8_t duty);
+static uint8_t Replay_LowDuty(uint16_t low_mv);
+static uint16_t Replay_Code(uint8_t heater, uint32_t cycle, uint32_t low_elapsed);
+static int Replay_Usage(void);
+
+static const ROTS_HeaterDriver_t replay_driver = {
+    Replay_SetDuty
+};
+
+int main(int argc, char** argv) {
+    uint32_t cycles = REPLAY_DEFAULT_CYCLES;
+    uint32_t step_ms = REPLAY_DEFAULT_STEP_MS;
+    uint32_t start_ms = REPLAY_DEFAULT_START_MS;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Replay_Usage();
+        } else if (strcmp(argv[i], "--cycles") == 0) {
+            cycles = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--step-ms") == 0) {
+            step_ms = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--start-ms") == 0) {
+            start_ms = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Replay_Usage();
+        }
+    }
+    // 每个周期2次切换, 步长须能在有效窗口内取到采样
+    if (cycles == 0 || cycles * 2 * REPLAY_HEATERS + REPLAY_HEATERS > REPLAY_MAX_SWITCHES ||
+        step_ms == 0 || step_ms > ROTS_HEATER_SAMPLE_WINDOW_MS) {
+        return Replay_Usage();
+    }
+
+    ROTS_HeaterScheduler_Init();
+    ROTS_HeaterScheduler_SetDriver(&replay_driver);
+    replay_now = start_ms;
+    for (uint8_t id = 0; id < REPLAY_HEATERS; id++) {
+        if (ROTS_HeaterScheduler_Add(&replay_configs[id], start_ms) != ROTS_OK) {
+            fprintf(stderr, "heater %u rejected\n", id);
+            return 1;
+        }
+    }
+
+    uint32_t period = replay_configs[0].high_ms + replay_configs[0].low_ms;
+    uint32_t duration = cycles * period;
+    uint32_t tag_errors = 0, output_errors = 0, latch_errors = 0, latches = 0;
+
+    // 各加热器当前低压相末尾窗口的期望累计, 以及最近一次期望的锁存值
+    uint32_t expect_sum[REPLAY_HEATERS] = { 0 };
+    uint32_t expect_count[REPLAY_HEATERS] = { 0 };
+    uint32_t expect_cycle[REPLAY_HEATERS] = { 0 };
+    bool expect_latched[REPLAY_HEATERS] = { false };
+    uint16_t expect_code[REPLAY_HEATERS] = { 0 };
+
+    // 推进到第一个不早于最后一个周期末尾的步, 使最后一个低压相完成锁存
+    for (uint32_t t = step_ms; t < duration + step_ms; t += step_ms) {
+        replay_now = start_ms + t;
+
+        // 按模拟时间算出的相位 (各加热器周期相同, 都从start_ms的高压相开始)
+        uint16_t raw[ROTS_MAX_CHANNELS];
+        uint8_t expected_tag[REPLAY_HEATERS];
+        memset(raw, 0, sizeof(raw));
+        for (uint8_t id = 0; id < REPLAY_HEATERS; id++) {
+            const ROTS_HeaterConfig_t* config = &replay_configs[id];
+            uint32_t cycle = t / period;
+            uint32_t offset = t % period;
+
+            // 上一周期的低压相刚结束: 期望锁存其窗口平均
+            if (cycle != expect_cycle[id]) {
+                if (expect_count[id] > 0) {
+                    expect_code[id] = (uint16_t)((expect_sum[id] + expect_count[id] / 2) / expect_count[id]);
+                    expect_latched[id] = true;
+                }
+                expect_sum[id] = 0;
+                expect_count[id] = 0;
+                expect_cycle[id] = cycle;
+            }
+
+            if (offset < config->high_ms) {
+                expected_tag[id] = ROTS_HEATER_PHASE_HIGH;
+                raw[config->channel] = REPLAY_HIGH_CODE;
+            } else {
+                uint32_t low_elapsed = offset - config->high_ms;
+                raw[config->channel] = Replay_Code(id, cycle, low_elapsed);
+                if (low_elapsed + config->window_ms >= config->low_ms) {
+                    expected_tag[id] = ROTS_HEATER_PHASE_LOW_END;
+                    expect_sum[id] += raw[config->channel];
+                    expect_count[id]++;
+                } else {
+                    expected_tag[id] = ROTS_HEATER_PHASE_LOW;
+                }
+            }
+        }
+
+        uint16_t input[ROTS_MAX_CHANNELS];
+        uint8_t phases[ROTS_MAX_CHANNELS];
+        memcpy(input, raw, sizeof(raw));
+        ROTS_HeaterScheduler_Process(raw, phases, ROTS_MAX_CHANNELS, replay_now);
+
+        ROTS_HeaterStats_t stats;
+        ROTS_HeaterScheduler_GetStats(&stats);
+        for (uint8_t id = 0; id < REPLAY_HEATERS; id++) {
+            uint8_t ch = replay_configs[id].channel;
+            if (phases[ch] != expected_tag[id]) {
+                if (tag_errors++ < 5) {
+                    printf("t=%u ms heater %u: phase %u, expected %u\n", t, id, phases[ch], expected_tag[id]);
+                }
+            }
+
+            // 锁存值: 低压相结束后第一帧检查, 之后每帧输出锁存值
+            if (expect_latched[id] && stats.latched_code[id] != expect_code[id]) {
+                if (latch_errors++ < 5) {
+                    printf("t=%u ms heater %u: latched %u, expected window mean %u\n",
+                           t, id, stats.latched_code[id], expect_code[id]);
+                }
+            }
+            uint16_t expected_output = expect_latched[id] ? expect_code[id] : input[ch];
+            if (stats.latched[id] != expect_latched[id] || raw[ch] != expected_output) {
+                if (output_errors++ < 5) {
+                    printf("t=%u ms heater %u: output %u, expected %u\n", t, id, raw[ch], expected_output);
+                }
+            }
+        }
+    }
+
+    // 占空比切换: 添加时高压, 之后交替, 时刻不晚于边界一个步长
+    uint32_t switch_errors = 0;
+    uint32_t next_switch[REPLAY_HEATERS] = { 0 };
+    for (uint32_t i = 0; i < replay_switch_count; i++) {
+        const Replay_Switch_t* sw = &replay_switches[i];
+        const ROTS_HeaterConfig_t* config = &replay_configs[sw->heater];
+        uint32_t n = next_switch[sw->heater]++;
+        uint32_t boundary = (n / 2) * period + (n % 2 ? config->high_ms : 0);
+        uint8_t duty = n % 2 ? Replay_LowDuty(config->low_mv) : 255;
+        uint32_t at = sw->time - start_ms;
+        bool ok = sw->duty == duty && at >= boundary && at < boundary + (n ? step_ms : 1);
+        if (!ok && switch_errors++ < 5) {
+            printf("heater %u switch %u: duty %u at %u ms, expected %u at %u ms\n",
+                   sw->heater, n, sw->duty, at, duty, boundary);
+        }
+    }
+    for (uint8_t id = 0; id < REPLAY_HEATERS; id++) {
+        // 最后一步已越过周期末尾, 完成最后一次回到高压相的切换
+        if (next_switch[id] != cycles * 2 + 1) {
+            printf("heater %u: %u duty switches, expected %u\n", id, next_switch[id], cycles * 2 + 1);
+            switch_errors++;
+        }
+    }
+
+    ROTS_HeaterStats_t stats;
+    ROTS_HeaterScheduler_GetStats(&stats);
+    for (uint8_t id = 0; id < REPLAY_HEATERS; id++) {
+        latches += stats.cycles[id];
+        printf("heater %u (ch %u): low duty %u, %u cycles, latched %u\n", id, replay_configs[id].channel,
+               Replay_LowDuty(replay_configs[id].low_mv), stats.cycles[id], stats.latched_code[id]);
+    }
+    printf("%u cycles of %u ms, step %u ms from %u ms: %u duty switches, %u window samples, %u empty windows\n",
+           cycles, period, step_ms, start_ms, replay_switch_count, stats.window_samples, stats.empty_windows);
+    printf("%u switch errors, %u phase errors, %u latch errors, %u output errors\n",
+           switch_errors, tag_errors, latch_errors, output_errors);
+
+    bool ok = switch_errors == 0 && tag_errors == 0 && latch_errors == 0 && output_errors == 0 &&
+              stats.empty_windows == 0 && latches == cycles * REPLAY_HEATERS;
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 记录占空比输出
+static void Replay_SetDuty(uint8_t heater, uint8_t pin, uint8_t duty) {
+    (void)pin;
+    if (replay_switch_count < REPLAY_MAX_SWITCHES) {
+        replay_switches[replay_switch_count].time = replay_now;
+        replay_switches[replay_switch_count].heater = heater;
+        replay_switches[replay_switch_count].duty = duty;
+        replay_switch_count++;
+    }
+}
+
+// 低压相占空比 (加热功率与电压平方成正比)
+static uint8_t Replay_LowDuty(uint16_t low_mv) {
+    float ratio = (float)low_mv / ROTS_HEATER_SUPPLY_MV;
+    return (uint8_t)(255.0f * ratio * ratio + 0.5f);
+}
+
+// 低压相合成码值: 随周期和相内时间变化, 窗口平均不是常数
+static uint16_t Replay_Code(uint8_t heater, uint32_t cycle, uint32_t low_elapsed) {
+    return (uint16_t)(800 + heater * 200 + cycle * 37 + low_elapsed / 97 + (low_elapsed * 13) % 11);
+}
+
+static int Replay_Usage(void) {
+    fprintf(stderr, "usage: rots_heater_replay [--cycles N] [--step-ms N] [--start-ms N]\n");
+    return 2;
+}
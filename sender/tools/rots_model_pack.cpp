@@ -0,0 +1,938 @@
+// ROTS Model Pack - 模型容器打包工具 (主机端)
+//
+// 将层描述 + 浮点参数量化打包为固件可直接映射执行的模型容器
+// (格式见 src/rots_model_blob.h), 并用与固件相同的运行时核对结果;
+// 也可将容器切分为远程更新帧 (协议见 src/rots_model_update.h),
+// 或在标注样本上拟合置信度校准温度与新颖度统计量.
+// frames 的输出目录不存在时自动创建.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_model_pack rots_model_pack.cpp
+//       ../src/rots_model_blob.cpp ../src/rots_ai_quant.cpp ../src/rots_ai_model.cpp
+//       ../src/rots_novelty.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_model_pack pack <model.txt> <params.txt> <model.bin> [--id N] [--temperature T] [--intensity head.txt]
+//   rots_model_pack verify <model.bin>
+//   rots_model_pack frames <model.bin> <out_dir> [--chunk N] [--transfer N]
+//   rots_model_pack calibrate <model.bin> <samples.txt> [--write] [--logits logits.txt]
+//   rots_model_pack novelty <model.bin> <samples.txt> [--write]
+//
+// model.txt 每行一层 ('#'起为注释):
+//   inputs 15
+//   dense 16 bias
+//   relu
+//   dense 6 bias
+//   softmax
+// params.txt 为空白分隔的浮点数, 顺序与 ROTS_AIModelDesc_t 相同:
+// 每个全连接层先 [outputs][inputs] 权重, 再 (可选) outputs 个偏置.
+// head.txt 为强度回归头, 空白分隔的浮点数: [outputs][inputs] 权重后跟 outputs 个偏置.
+// samples.txt 每行一个标注样本: 类别下标 (0起) 后跟 inputs 个特征值.
+// logits.txt 为calibrate记录的Softmax前输出, 每行: 类别下标 后跟 outputs 个值
+// (供 rots_softmax_bench 回放).
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#include "rots_sender.h"
+#include "rots_ai_model.h"
+#include "rots_ai_quant.h"
+#include "rots_model_blob.h"
+#include "rots_model_update.h"
+#include "rots_ai_engine.h"
+#include "rots_novelty.h"
+
+#define PACK_CHECK_RUNS       64      // 打包后随机输入核对次数
+#define PACK_CHECK_TOLERANCE  0.05f   // 相对最大输出的允许误差
+#define PACK_ECE_BINS         10      // 校准误差的置信度分箱数
+#define PACK_CALIBRATE_STEPS  48      // 温度黄金分割搜索的迭代次数
+#define PACK_NOVELTY_QUANTILE 0.995   // 建议阈值: 训练样本新颖度的该分位数 (不低于默认阈值)
+
+// 16字节对齐的字节缓冲 (与固件映射地址的对齐要求一致)
+typedef struct alignas(ROTS_MODEL_ALIGN) {
+    uint8_t bytes[ROTS_MODEL_ALIGN];
+} AlignedBlock_t;
+typedef std::vector<AlignedBlock_t> AlignedBuffer_t;
+#define PACK_BLOCKS(size)     (((size) + ROTS_MODEL_ALIGN - 1) / ROTS_MODEL_ALIGN)
+
+// 私有函数声明
+static bool Pack_LoadDesc(const char* path, ROTS_AIModelDesc_t* desc);
+static bool Pack_LoadParams(const char* path, std::vector<float>* params);
+static uint32_t Pack_Align(std::vector<uint8_t>* blob, uint32_t align);
+static uint32_t Pack_Append(std::vector<uint8_t>* blob, const void* data, uint32_t size, uint32_t align);
+static bool Pack_Build(const ROTS_AIModelDesc_t* desc, const std::vector<float>& params,
+                       uint32_t model_id, std::vector<uint8_t>* blob);
+static bool Pack_Check(const ROTS_AIModelDesc_t* desc, const std::vector<float>& params,
+                       const uint8_t* blob, uint32_t size);
+static bool Pack_SetSection(std::vector<uint8_t>* blob, uint32_t type, const void* data, uint32_t size);
+static bool Pack_WriteSection(const char* path, uint32_t type, const void* data, uint32_t size);
+static bool Pack_ReadFile(const char* path, AlignedBuffer_t* buffer, uint32_t* size);
+static void Pack_PrintBlob(const uint8_t* blob);
+static bool Pack_WriteFrame(const std::string& dir, uint32_t index, uint8_t type, uint32_t transfer_id,
+                            uint32_t value, const uint8_t* data, uint16_t length);
+static int Pack_Frames(int argc, char** argv);
+static bool Pack_LoadSamples(const char* path, uint16_t inputs, uint16_t outputs,
+                             std::vector<float>* features, std::vector<uint16_t>* labels);
+static void Pack_Score(const std::vector<float>& logits, const std::vector<uint16_t>& labels, uint16_t outputs,
+                       float temperature, double* nll, double* ece, double* accuracy);
+static int Pack_Calibrate(int argc, char** argv);
+static void Pack_FitNovelty(const std::vector<float>& features, const std::vector<uint16_t>& labels, uint16_t inputs,
+                            uint16_t outputs, std::vector<float>* means, std::vector<float>* inv_vars);
+static float Pack_Quantile(std::vector<float> values, double q);
+static int Pack_Novelty(int argc, char** argv);
+static int Pack_Usage(void);
+
+int main(int argc, char** argv) {
+    if (argc >= 5 && strcmp(argv[1], "pack") == 0) {
+        uint32_t model_id = 0;
+        float temperature = 0.0f;
+        const char* head_path = NULL;
+        for (int i = 5; i < argc; i += 2) {
+            if (i + 1 >= argc) {
+                return Pack_Usage();
+            } else if (strcmp(argv[i], "--id") == 0) {
+                model_id = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            } else if (strcmp(argv[i], "--temperature") == 0) {
+                temperature = strtof(argv[i + 1], NULL);
+                if (temperature < ROTS_AI_MIN_TEMPERATURE || temperature > ROTS_AI_MAX_TEMPERATURE) {
+                    fprintf(stderr, "temperature must be %.2f..%.1f\n", ROTS_AI_MIN_TEMPERATURE, ROTS_AI_MAX_TEMPERATURE);
+                    return 2;
+                }
+            } else if (strcmp(argv[i], "--intensity") == 0) {
+                head_path = argv[i + 1];
+            } else {
+                return Pack_Usage();
+            }
+        }
+
+        ROTS_AIModelDesc_t desc;
+        std::vector<float> params;
+        std::vector<uint8_t> blob;
+        if (!Pack_LoadDesc(argv[2], &desc) || !Pack_LoadParams(argv[3], &params) ||
+            !Pack_Build(&desc, params, model_id, &blob)) {
+            return 1;
+        }
+        if (head_path) {
+            std::vector<float> head;
+            uint32_t head_size = ROTS_MODEL_INTENSITY_SIZE(desc.inputs, ROTS_ModelBlob_GetHeader(blob.data())->outputs);
+            if (!Pack_LoadParams(head_path, &head)) {
+                return 1;
+            }
+            if (head.size() * sizeof(float) != head_size) {
+                fprintf(stderr, "%s: intensity head needs %u values, file has %zu\n",
+                        head_path, (unsigned)(head_size / sizeof(float)), head.size());
+                return 1;
+            }
+            if (!Pack_SetSection(&blob, ROTS_MODEL_SECTION_INTENSITY, head.data(), head_size)) {
+                return 1;
+            }
+        }
+        // 温度不在CRC范围内, 直接写入头部
+        memcpy(blob.data() + offsetof(ROTS_ModelBlobHeader_t, temperature), &temperature, sizeof(temperature));
+
+        // 复制到对齐缓冲后按固件流程加载核对
+        AlignedBuffer_t aligned(PACK_BLOCKS(blob.size()));
+        memcpy(aligned.data(), blob.data(), blob.size());
+        if (!Pack_Check(&desc, params, (const uint8_t*)aligned.data(), (uint32_t)blob.size())) {
+            return 1;
+        }
+
+        std::ofstream out(argv[4], std::ios::binary);
+        out.write((const char*)blob.data(), (std::streamsize)blob.size());
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", argv[4]);
+            return 1;
+        }
+
+        Pack_PrintBlob((const uint8_t*)aligned.data());
+        printf("wrote %s (%zu bytes)\n", argv[4], blob.size());
+        return 0;
+    }
+
+    if (argc == 3 && strcmp(argv[1], "verify") == 0) {
+        AlignedBuffer_t buffer;
+        uint32_t size = 0;
+        if (!Pack_ReadFile(argv[2], &buffer, &size)) {
+            return 1;
+        }
+
+        const uint8_t* blob = (const uint8_t*)buffer.data();
+        if (ROTS_ModelBlob_Validate(blob, size) != ROTS_OK) {
+            fprintf(stderr, "%s: invalid model blob\n", argv[2]);
+            return 1;
+        }
+        Pack_PrintBlob(blob);
+        printf("%s: OK\n", argv[2]);
+        return 0;
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "frames") == 0) {
+        return Pack_Frames(argc, argv);
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "calibrate") == 0) {
+        return Pack_Calibrate(argc, argv);
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "novelty") == 0) {
+        return Pack_Novelty(argc, argv);
+    }
+
+    return Pack_Usage();
+}
+
+// 切分为更新帧: frame_0000.bin (BEGIN), 数据帧..., 最后一个为END
+static int Pack_Frames(int argc, char** argv) {
+    uint32_t chunk = ROTS_MODEL_UPDATE_CHUNK_MAX;
+    uint32_t transfer_id = 1;
+    for (int i = 4; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--chunk") == 0) {
+            chunk = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--transfer") == 0) {
+            transfer_id = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Pack_Usage();
+        }
+    }
+    if ((argc - 4) % 2 != 0 || chunk == 0 || chunk > ROTS_MODEL_UPDATE_CHUNK_MAX) {
+        return Pack_Usage();
+    }
+
+    AlignedBuffer_t buffer;
+    uint32_t size = 0;
+    if (!Pack_ReadFile(argv[2], &buffer, &size)) {
+        return 1;
+    }
+
+    const uint8_t* blob = (const uint8_t*)buffer.data();
+    if (ROTS_ModelBlob_Validate(blob, size) != ROTS_OK) {
+        fprintf(stderr, "%s: invalid model blob\n", argv[2]);
+        return 1;
+    }
+
+    // 输出目录不存在时创建 (只建最后一级)
+    std::string dir = argv[3];
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "%s: %s\n", dir.c_str(), strerror(errno));
+        return 1;
+    }
+
+    uint32_t crc = ROTS_ModelBlob_Crc32(0, blob, size);
+    uint32_t index = 0;
+    bool ok = Pack_WriteFrame(dir, index++, ROTS_MODEL_FRAME_BEGIN, transfer_id, size,
+                              (const uint8_t*)&crc, sizeof(crc));
+    for (uint32_t offset = 0; ok && offset < size; offset += chunk) {
+        uint32_t length = size - offset < chunk ? size - offset : chunk;
+        ok = Pack_WriteFrame(dir, index++, ROTS_MODEL_FRAME_DATA, transfer_id, offset, blob + offset, (uint16_t)length);
+    }
+    ok = ok && Pack_WriteFrame(dir, index++, ROTS_MODEL_FRAME_END, transfer_id, size, NULL, 0);
+    if (!ok) {
+        return 1;
+    }
+
+    printf("transfer %u: %u frames (%u-byte chunks), crc 0x%08X\n",
+           (unsigned)transfer_id, (unsigned)index, (unsigned)chunk, (unsigned)crc);
+    return 0;
+}
+
+// 在标注样本上拟合校准温度: 最小化负对数似然, 在log T上做黄金分割搜索
+// (NLL对温度是单峰的). 可选写回容器头, 或记录logits.
+static int Pack_Calibrate(int argc, char** argv) {
+    bool write = false;
+    const char* logits_path = NULL;
+    for (int i = 4; i < argc; i++) {
+        if (strcmp(argv[i], "--write") == 0) {
+            write = true;
+        } else if (strcmp(argv[i], "--logits") == 0 && i + 1 < argc) {
+            logits_path = argv[++i];
+        } else {
+            return Pack_Usage();
+        }
+    }
+
+    AlignedBuffer_t buffer;
+    uint32_t size = 0;
+    if (!Pack_ReadFile(argv[2], &buffer, &size)) {
+        return 1;
+    }
+
+    uint8_t* blob = (uint8_t*)buffer.data();
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    if (ROTS_ModelBlob_Validate(blob, size) != ROTS_OK || ROTS_AIModel_LoadBlob(blob, size) != ROTS_OK) {
+        fprintf(stderr, "%s: invalid model blob\n", argv[2]);
+        return 1;
+    }
+
+    std::vector<float> features;
+    std::vector<uint16_t> labels;
+    if (!Pack_LoadSamples(argv[3], header->inputs, header->outputs, &features, &labels)) {
+        return 1;
+    }
+
+    // 固件同样在int8路径上取Softmax前的输出
+    std::vector<float> logits(labels.size() * header->outputs);
+    for (size_t s = 0; s < labels.size(); s++) {
+        ROTS_AIModel_RunLogits(&features[s * header->inputs], &logits[s * header->outputs], true);
+    }
+
+    if (logits_path) {
+        FILE* out = fopen(logits_path, "w");
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", logits_path);
+            return 1;
+        }
+        fprintf(out, "# label, then %u int8-path logits\n", header->outputs);
+        for (size_t s = 0; s < labels.size(); s++) {
+            fprintf(out, "%u", labels[s]);
+            for (uint16_t o = 0; o < header->outputs; o++) {
+                fprintf(out, " %.6g", logits[s * header->outputs + o]);
+            }
+            fprintf(out, "\n");
+        }
+        fclose(out);
+        printf("wrote %zu logit rows to %s\n", labels.size(), logits_path);
+    }
+
+    float current = header->temperature > 0.0f ? header->temperature : 1.0f;
+    double nll, ece, accuracy;
+    Pack_Score(logits, labels, header->outputs, current, &nll, &ece, &accuracy);
+    printf("%zu samples, accuracy %.3f\n", labels.size(), accuracy);
+    printf("T=%.3f: NLL %.4f, ECE %.4f\n", current, nll, ece);
+
+    const double ratio = 0.6180339887498949;
+    double lo = log(ROTS_AI_MIN_TEMPERATURE);
+    double hi = log(ROTS_AI_MAX_TEMPERATURE);
+    double a = hi - ratio * (hi - lo);
+    double b = lo + ratio * (hi - lo);
+    double nll_a, nll_b, unused;
+    Pack_Score(logits, labels, header->outputs, (float)exp(a), &nll_a, &unused, &unused);
+    Pack_Score(logits, labels, header->outputs, (float)exp(b), &nll_b, &unused, &unused);
+    for (int step = 0; step < PACK_CALIBRATE_STEPS; step++) {
+        if (nll_a < nll_b) {
+            hi = b;
+            b = a;
+            nll_b = nll_a;
+            a = hi - ratio * (hi - lo);
+            Pack_Score(logits, labels, header->outputs, (float)exp(a), &nll_a, &unused, &unused);
+        } else {
+            lo = a;
+            a = b;
+            nll_a = nll_b;
+            b = lo + ratio * (hi - lo);
+            Pack_Score(logits, labels, header->outputs, (float)exp(b), &nll_b, &unused, &unused);
+        }
+    }
+
+    float fitted = (float)exp((lo + hi) / 2);
+    Pack_Score(logits, labels, header->outputs, fitted, &nll, &ece, &accuracy);
+    printf("T=%.3f: NLL %.4f, ECE %.4f (fitted)\n", fitted, nll, ece);
+
+    if (write) {
+        memcpy(blob + offsetof(ROTS_ModelBlobHeader_t, temperature), &fitted, sizeof(fitted));
+        std::ofstream out(argv[2], std::ios::binary);
+        out.write((const char*)blob, (std::streamsize)size);
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", argv[2]);
+            return 1;
+        }
+        printf("wrote temperature to %s\n", argv[2]);
+    }
+    return 0;
+}
+
+// 拟合新颖度统计量, 并估计阈值与对未见类别的检出率 (依次留出一类, 用其余类别的统计量打分)
+static int Pack_Novelty(int argc, char** argv) {
+    bool write = argc == 5 && strcmp(argv[4], "--write") == 0;
+    if (argc != 4 && !write) {
+        return Pack_Usage();
+    }
+
+    AlignedBuffer_t buffer;
+    uint32_t size = 0;
+    if (!Pack_ReadFile(argv[2], &buffer, &size)) {
+        return 1;
+    }
+
+    const uint8_t* blob = (const uint8_t*)buffer.data();
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    if (ROTS_ModelBlob_Validate(blob, size) != ROTS_OK) {
+        fprintf(stderr, "%s: invalid model blob\n", argv[2]);
+        return 1;
+    }
+
+    // 由特征数反推通道数 (特征布局见 rots_ai_engine.h)
+    uint8_t channels = 0;
+    for (uint8_t ch = 1; ch <= ROTS_MAX_CHANNELS; ch++) {
+        if (ROTS_AI_FEATURE_COUNT(ch) == header->inputs) {
+            channels = ch;
+        }
+    }
+    if (channels == 0 || header->outputs != ROTS_AI_ODOR_CLASSES) {
+        fprintf(stderr, "%s: %u inputs / %u outputs do not match the sender feature layout\n",
+                argv[2], header->inputs, header->outputs);
+        return 1;
+    }
+
+    std::vector<float> features;
+    std::vector<uint16_t> labels;
+    if (!Pack_LoadSamples(argv[3], header->inputs, header->outputs, &features, &labels)) {
+        return 1;
+    }
+
+    std::vector<uint8_t> used(header->inputs);
+    uint16_t used_count = ROTS_Novelty_SelectFeatures(channels, 0xFFFFFFFFUL, used.data());
+
+    std::vector<float> means, inv_vars;
+    Pack_FitNovelty(features, labels, header->inputs, header->outputs, &means, &inv_vars);
+    std::vector<float> scores(labels.size());
+    for (size_t s = 0; s < labels.size(); s++) {
+        scores[s] = ROTS_Novelty_Score(&features[s * header->inputs], means.data(), inv_vars.data(), header->inputs,
+                                       (uint8_t)header->outputs, used.data(), used_count, NULL);
+    }
+
+    float threshold = Pack_Quantile(scores, PACK_NOVELTY_QUANTILE);
+    if (threshold < ROTS_NOVELTY_THRESHOLD) {
+        threshold = ROTS_NOVELTY_THRESHOLD;
+    }
+    size_t flagged = 0;
+    for (float score : scores) {
+        flagged += score > threshold ? 1 : 0;
+    }
+    printf("%zu samples, %u channels, %u of %u features scored\n",
+           labels.size(), channels, used_count, header->inputs);
+    printf("training novelty: median %.2f, p99 %.2f, max %.2f\n",
+           Pack_Quantile(scores, 0.5), Pack_Quantile(scores, 0.99), Pack_Quantile(scores, 1.0));
+    printf("threshold %.2f: %.2f%% of training samples flagged\n", threshold, flagged * 100.0 / labels.size());
+
+    // 留出一类: 该类样本在其余类别的统计量下应判为新颖
+    for (uint16_t held = 0; held < header->outputs; held++) {
+        std::vector<float> rest_means, rest_inv_vars;
+        for (uint16_t c = 0; c < header->outputs; c++) {
+            if (c != held) {
+                rest_means.insert(rest_means.end(), &means[c * header->inputs], &means[(c + 1) * header->inputs]);
+                rest_inv_vars.insert(rest_inv_vars.end(), &inv_vars[c * header->inputs],
+                                     &inv_vars[(c + 1) * header->inputs]);
+            }
+        }
+
+        size_t total = 0, detected = 0;
+        for (size_t s = 0; s < labels.size(); s++) {
+            if (labels[s] != held) continue;
+            float score = ROTS_Novelty_Score(&features[s * header->inputs], rest_means.data(), rest_inv_vars.data(),
+                                             header->inputs, (uint8_t)(header->outputs - 1), used.data(), used_count, NULL);
+            total++;
+            detected += score > threshold ? 1 : 0;
+        }
+        if (total > 0) {
+            printf("class %u held out: %zu/%zu flagged novel\n", held, detected, total);
+        }
+    }
+
+    if (write) {
+        // 段数据: 阈值, 均值, 逆方差 (格式见 ROTS_MODEL_SECTION_NOVELTY)
+        std::vector<float> section(1, threshold);
+        section.insert(section.end(), means.begin(), means.end());
+        section.insert(section.end(), inv_vars.begin(), inv_vars.end());
+        if (!Pack_WriteSection(argv[2], ROTS_MODEL_SECTION_NOVELTY, section.data(),
+                               (uint32_t)(section.size() * sizeof(float)))) {
+            return 1;
+        }
+        printf("wrote novelty stats to %s\n", argv[2]);
+    }
+    return 0;
+}
+
+// 每类特征均值与逆方差 (标准差设下限, 避免常量特征的方差为0)
+static void Pack_FitNovelty(const std::vector<float>& features, const std::vector<uint16_t>& labels, uint16_t inputs,
+                            uint16_t outputs, std::vector<float>* means, std::vector<float>* inv_vars) {
+    std::vector<double> sum(outputs * inputs, 0.0), sum_sq(outputs * inputs, 0.0);
+    std::vector<size_t> count(outputs, 0);
+    for (size_t s = 0; s < labels.size(); s++) {
+        count[labels[s]]++;
+        for (uint16_t i = 0; i < inputs; i++) {
+            double value = features[s * inputs + i];
+            sum[labels[s] * inputs + i] += value;
+            sum_sq[labels[s] * inputs + i] += value * value;
+        }
+    }
+
+    means->assign(outputs * inputs, 0.0f);
+    inv_vars->assign(outputs * inputs, 0.0f);
+    for (uint16_t c = 0; c < outputs; c++) {
+        if (count[c] == 0) {
+            fprintf(stderr, "warning: no samples for class %u, it will never match\n", c);
+            continue;
+        }
+        for (uint16_t i = 0; i < inputs; i++) {
+            size_t k = c * inputs + i;
+            double mean = sum[k] / count[c];
+            double var = fmax(sum_sq[k] / count[c] - mean * mean, 0.0);
+            double floor = fmax(ROTS_NOVELTY_STD_FLOOR_RATIO * fabs(mean), ROTS_NOVELTY_STD_FLOOR);
+            (*means)[k] = (float)mean;
+            (*inv_vars)[k] = (float)(1.0 / fmax(var, floor * floor));
+        }
+    }
+}
+
+// 分位数 (最近秩)
+static float Pack_Quantile(std::vector<float> values, double q) {
+    size_t index = (size_t)(q * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// 读取标注样本
+static bool Pack_LoadSamples(const char* path, uint16_t inputs, uint16_t outputs,
+                             std::vector<float>* features, std::vector<uint16_t>* labels) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        unsigned label;
+        if (!(fields >> label)) continue;
+
+        float value;
+        uint16_t count = 0;
+        while (fields >> value) {
+            features->push_back(value);
+            count++;
+        }
+        if (label >= outputs || count != inputs) {
+            fprintf(stderr, "%s:%d: expected '<0..%u> <%u features>'\n", path, line_no, outputs - 1, inputs);
+            return false;
+        }
+        labels->push_back((uint16_t)label);
+    }
+
+    if (labels->empty()) {
+        fprintf(stderr, "%s: no samples\n", path);
+        return false;
+    }
+    return true;
+}
+
+// 给定温度下的负对数似然, 期望校准误差 (按最大概率分箱) 与准确率
+static void Pack_Score(const std::vector<float>& logits, const std::vector<uint16_t>& labels, uint16_t outputs,
+                       float temperature, double* nll, double* ece, double* accuracy) {
+    double bin_confidence[PACK_ECE_BINS] = { 0 };
+    double bin_correct[PACK_ECE_BINS] = { 0 };
+    std::vector<float> probs(outputs);
+    double loss = 0.0;
+    double correct = 0.0;
+
+    for (size_t s = 0; s < labels.size(); s++) {
+        ROTS_AIModel_Softmax(&logits[s * outputs], probs.data(), outputs, temperature);
+
+        uint16_t best = 0;
+        for (uint16_t o = 1; o < outputs; o++) {
+            if (probs[o] > probs[best]) best = o;
+        }
+        int bin = (int)(probs[best] * PACK_ECE_BINS);
+        if (bin >= PACK_ECE_BINS) bin = PACK_ECE_BINS - 1;
+        bin_confidence[bin] += probs[best];
+        bin_correct[bin] += best == labels[s] ? 1.0 : 0.0;
+        correct += best == labels[s] ? 1.0 : 0.0;
+        loss -= log(fmax(probs[labels[s]], 1e-12));
+    }
+
+    double gap = 0.0;
+    for (int bin = 0; bin < PACK_ECE_BINS; bin++) {
+        gap += fabs(bin_confidence[bin] - bin_correct[bin]);
+    }
+    *nll = loss / labels.size();
+    *ece = gap / labels.size();
+    *accuracy = correct / labels.size();
+}
+
+// 写出一帧
+static bool Pack_WriteFrame(const std::string& dir, uint32_t index, uint8_t type, uint32_t transfer_id,
+                            uint32_t value, const uint8_t* data, uint16_t length) {
+    ROTS_ModelFrameHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = ROTS_MODEL_UPDATE_MAGIC;
+    header.type = type;
+    header.length = length;
+    header.transfer_id = transfer_id;
+    header.value = value;
+
+    char name[32];
+    snprintf(name, sizeof(name), "/frame_%04u.bin", (unsigned)index);
+    std::ofstream out(dir + name, std::ios::binary);
+    out.write((const char*)&header, sizeof(header));
+    if (length) {
+        out.write((const char*)data, length);
+    }
+    if (!out) {
+        fprintf(stderr, "cannot write %s%s\n", dir.c_str(), name);
+        return false;
+    }
+    return true;
+}
+
+// 解析层描述文件
+static bool Pack_LoadDesc(const char* path, ROTS_AIModelDesc_t* desc) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    memset(desc, 0, sizeof(ROTS_AIModelDesc_t));
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) continue;
+
+        if (keyword == "inputs") {
+            unsigned inputs = 0;
+            fields >> inputs;
+            if (inputs == 0 || inputs > ROTS_AI_MAX_WIDTH) {
+                fprintf(stderr, "%s:%d: inputs must be 1..%d\n", path, line_no, ROTS_AI_MAX_WIDTH);
+                return false;
+            }
+            desc->inputs = (uint16_t)inputs;
+            continue;
+        }
+
+        if (desc->layer_count >= ROTS_AI_MAX_LAYERS) {
+            fprintf(stderr, "%s:%d: more than %d layers\n", path, line_no, ROTS_AI_MAX_LAYERS);
+            return false;
+        }
+
+        ROTS_AILayerDesc_t* layer = &desc->layers[desc->layer_count];
+        if (keyword == "dense") {
+            unsigned outputs = 0;
+            std::string option;
+            fields >> outputs >> option;
+            if (outputs == 0 || outputs > ROTS_AI_MAX_WIDTH || (!option.empty() && option != "bias")) {
+                fprintf(stderr, "%s:%d: expected 'dense <1..%d> [bias]'\n", path, line_no, ROTS_AI_MAX_WIDTH);
+                return false;
+            }
+            layer->type = ROTS_AI_LAYER_DENSE;
+            layer->outputs = (uint16_t)outputs;
+            layer->flags = option == "bias" ? ROTS_AI_LAYER_FLAG_BIAS : 0;
+        } else if (keyword == "relu") {
+            layer->type = ROTS_AI_LAYER_RELU;
+        } else if (keyword == "softmax") {
+            layer->type = ROTS_AI_LAYER_SOFTMAX;
+        } else {
+            fprintf(stderr, "%s:%d: unknown layer '%s'\n", path, line_no, keyword.c_str());
+            return false;
+        }
+        desc->layer_count++;
+    }
+
+    if (desc->inputs == 0 || desc->layer_count == 0) {
+        fprintf(stderr, "%s: missing 'inputs' or layers\n", path);
+        return false;
+    }
+    return true;
+}
+
+// 读取浮点参数
+static bool Pack_LoadParams(const char* path, std::vector<float>* params) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    float value;
+    while (in >> value) {
+        params->push_back(value);
+    }
+    if (!in.eof()) {
+        fprintf(stderr, "%s: bad number after %zu values\n", path, params->size());
+        return false;
+    }
+    return true;
+}
+
+// 补零到对齐位置, 返回当前偏移
+static uint32_t Pack_Align(std::vector<uint8_t>* blob, uint32_t align) {
+    while (blob->size() % align) {
+        blob->push_back(0);
+    }
+    return (uint32_t)blob->size();
+}
+
+// 对齐后追加数据, 返回数据偏移
+static uint32_t Pack_Append(std::vector<uint8_t>* blob, const void* data, uint32_t size, uint32_t align) {
+    uint32_t offset = Pack_Align(blob, align);
+    blob->insert(blob->end(), (const uint8_t*)data, (const uint8_t*)data + size);
+    return offset;
+}
+
+// 量化并生成容器
+static bool Pack_Build(const ROTS_AIModelDesc_t* desc, const std::vector<float>& params,
+                       uint32_t model_id, std::vector<uint8_t>* blob) {
+    ROTS_ModelBlobHeader_t header;
+    ROTS_ModelBlobLayer_t entries[ROTS_AI_MAX_LAYERS];
+    memset(&header, 0, sizeof(header));
+    memset(entries, 0, sizeof(entries));
+
+    // 层表后预留空段表, 供之后写入统计量等附加段
+    uint32_t table_end = sizeof(header) + desc->layer_count * sizeof(ROTS_ModelBlobLayer_t) +
+                         ROTS_MODEL_SECTION_SLOTS * sizeof(ROTS_ModelBlobSection_t);
+    blob->assign(table_end, 0);
+
+    uint16_t width = desc->inputs;
+    size_t param_offset = 0;
+    for (uint8_t l = 0; l < desc->layer_count; l++) {
+        const ROTS_AILayerDesc_t* layer = &desc->layers[l];
+        ROTS_ModelBlobLayer_t* entry = &entries[l];
+        entry->type = layer->type;
+        entry->flags = layer->flags;
+        entry->inputs = width;
+        entry->outputs = layer->type == ROTS_AI_LAYER_DENSE ? layer->outputs : width;
+
+        if (layer->type == ROTS_AI_LAYER_DENSE) {
+            size_t weight_count = (size_t)entry->inputs * entry->outputs;
+            size_t bias_count = (layer->flags & ROTS_AI_LAYER_FLAG_BIAS) ? entry->outputs : 0;
+            if (param_offset + weight_count + bias_count > params.size()) {
+                fprintf(stderr, "layer %u: not enough parameters (%zu given)\n", l, params.size());
+                return false;
+            }
+
+            ROTS_QuantDense_t quant;
+            std::vector<int8_t> weights((size_t)ROTS_AI_QUANT_PADDED(entry->inputs) * entry->outputs);
+            std::vector<int32_t> row_sums(entry->outputs);
+            ROTS_AIQuant_PrepareDense(&quant, &params[param_offset], entry->outputs, entry->inputs,
+                                      weights.data(), row_sums.data());
+            param_offset += weight_count;
+
+            entry->stride = quant.stride;
+            entry->weight_scale = quant.weight_params.scale;
+            entry->weight_zero_point = quant.weight_params.zero_point;
+            entry->weight_offset = Pack_Append(blob, weights.data(), (uint32_t)weights.size(), ROTS_MODEL_ALIGN);
+            entry->row_sum_offset = Pack_Append(blob, row_sums.data(),
+                                                (uint32_t)(row_sums.size() * sizeof(int32_t)), 4);
+            if (bias_count) {
+                entry->bias_offset = Pack_Append(blob, &params[param_offset],
+                                                 (uint32_t)(bias_count * sizeof(float)), 4);
+                param_offset += bias_count;
+            }
+        }
+        width = entry->outputs;
+    }
+
+    if (param_offset != params.size()) {
+        fprintf(stderr, "parameter count mismatch: model uses %zu, file has %zu\n", param_offset, params.size());
+        return false;
+    }
+
+    Pack_Align(blob, ROTS_MODEL_ALIGN);
+    memcpy(blob->data() + sizeof(header), entries, desc->layer_count * sizeof(ROTS_ModelBlobLayer_t));
+
+    header.magic = ROTS_MODEL_MAGIC;
+    header.version = ROTS_MODEL_VERSION;
+    header.header_size = sizeof(header);
+    header.total_size = (uint32_t)blob->size();
+    header.model_id = model_id;
+    header.inputs = desc->inputs;
+    header.outputs = width;
+    header.layer_count = desc->layer_count;
+    header.section_slots = ROTS_MODEL_SECTION_SLOTS;
+    header.crc32 = ROTS_ModelBlob_Crc32(0, blob->data() + sizeof(header), header.total_size - sizeof(header));
+    memcpy(blob->data(), &header, sizeof(header));
+    return true;
+}
+
+// 浮点参数模型与容器模型在随机输入上的输出对比
+static bool Pack_Check(const ROTS_AIModelDesc_t* desc, const std::vector<float>& params,
+                       const uint8_t* blob, uint32_t size) {
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+    if (ROTS_ModelBlob_Validate(blob, size) != ROTS_OK) {
+        fprintf(stderr, "packed blob failed validation\n");
+        return false;
+    }
+
+    std::mt19937 rng(header->model_id);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> input(header->inputs);
+    std::vector<float> expected(header->outputs);
+    std::vector<float> actual(header->outputs);
+    float max_error = 0.0f;
+
+    for (int run = 0; run < PACK_CHECK_RUNS; run++) {
+        for (float& value : input) {
+            value = dist(rng);
+        }
+
+        if (ROTS_AIModel_Load(desc, params.data(), (uint32_t)params.size()) != ROTS_OK ||
+            ROTS_AIModel_Run(input.data(), expected.data(), false) != ROTS_OK ||
+            ROTS_AIModel_LoadBlob(blob, size) != ROTS_OK ||
+            ROTS_AIModel_Run(input.data(), actual.data(), true) != ROTS_OK) {
+            fprintf(stderr, "model runtime rejected the model\n");
+            return false;
+        }
+
+        float peak = 0.0f;
+        float error = 0.0f;
+        for (uint16_t o = 0; o < header->outputs; o++) {
+            peak = fmaxf(peak, fabsf(expected[o]));
+            error = fmaxf(error, fabsf(actual[o] - expected[o]));
+        }
+        if (peak > 0.0f) error /= peak;
+        max_error = fmaxf(max_error, error);
+    }
+
+    printf("int8 vs float: max relative error %.4f over %d inputs\n", max_error, PACK_CHECK_RUNS);
+    if (max_error > PACK_CHECK_TOLERANCE) {
+        fprintf(stderr, "quantization error above %.2f, model not written\n", PACK_CHECK_TOLERANCE);
+        return false;
+    }
+    return true;
+}
+
+// 写入附加段: 替换同类型段或占用空表项, 数据追加到容器末尾 (被替换的段恰在末尾时先截去), 并重算CRC
+static bool Pack_SetSection(std::vector<uint8_t>* blob, uint32_t type, const void* data, uint32_t size) {
+    ROTS_ModelBlobHeader_t header;
+    memcpy(&header, blob->data(), sizeof(header));
+
+    int slot = -1;
+    ROTS_ModelBlobSection_t entry;
+    uint32_t table = header.header_size + header.layer_count * sizeof(ROTS_ModelBlobLayer_t);
+    for (uint8_t s = 0; s < header.section_slots; s++) {
+        memcpy(&entry, blob->data() + table + s * sizeof(entry), sizeof(entry));
+        if (entry.type == type) {
+            slot = s;
+            break;
+        }
+        if (entry.type == ROTS_MODEL_SECTION_NONE && slot < 0) {
+            slot = s;
+        }
+    }
+    if (slot < 0) {
+        fprintf(stderr, "no free section slot (%u slots), repack the model with this tool\n", header.section_slots);
+        return false;
+    }
+
+    memcpy(&entry, blob->data() + table + slot * sizeof(entry), sizeof(entry));
+    if (entry.type == type && PACK_BLOCKS(entry.offset + entry.size) * ROTS_MODEL_ALIGN == blob->size()) {
+        blob->resize(entry.offset);
+    }
+
+    memset(&entry, 0, sizeof(entry));
+    entry.type = type;
+    entry.size = size;
+    entry.offset = Pack_Append(blob, data, size, ROTS_MODEL_ALIGN);
+    Pack_Align(blob, ROTS_MODEL_ALIGN);
+    memcpy(blob->data() + table + slot * sizeof(entry), &entry, sizeof(entry));
+
+    header.total_size = (uint32_t)blob->size();
+    header.crc32 = ROTS_ModelBlob_Crc32(0, blob->data() + sizeof(header), header.total_size - sizeof(header));
+    memcpy(blob->data(), &header, sizeof(header));
+    return true;
+}
+
+// 读入容器, 写入附加段, 校验后写回
+static bool Pack_WriteSection(const char* path, uint32_t type, const void* data, uint32_t size) {
+    AlignedBuffer_t buffer;
+    uint32_t blob_size = 0;
+    if (!Pack_ReadFile(path, &buffer, &blob_size)) {
+        return false;
+    }
+
+    std::vector<uint8_t> blob((const uint8_t*)buffer.data(), (const uint8_t*)buffer.data() + blob_size);
+    if (!Pack_SetSection(&blob, type, data, size)) {
+        return false;
+    }
+
+    AlignedBuffer_t aligned(PACK_BLOCKS(blob.size()));
+    memcpy(aligned.data(), blob.data(), blob.size());
+    if (ROTS_ModelBlob_Validate((const uint8_t*)aligned.data(), (uint32_t)blob.size()) != ROTS_OK) {
+        fprintf(stderr, "section rejected by blob validation\n");
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write((const char*)blob.data(), (std::streamsize)blob.size());
+    if (!out) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+// 读入整个文件到对齐缓冲
+static bool Pack_ReadFile(const char* path, AlignedBuffer_t* buffer, uint32_t* size) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    *size = (uint32_t)in.tellg();
+    buffer->assign(PACK_BLOCKS(*size), AlignedBlock_t());
+    in.seekg(0);
+    in.read((char*)buffer->data(), *size);
+    return (bool)in;
+}
+
+// 打印容器头, 层表与附加段
+static void Pack_PrintBlob(const uint8_t* blob) {
+    static const char* const type_names[] = { "?", "dense", "relu", "softmax" };
+    const ROTS_ModelBlobHeader_t* header = ROTS_ModelBlob_GetHeader(blob);
+
+    printf("model 0x%08X v%u: %u -> %u, %u layers, %u bytes, crc 0x%08X, temperature %.3f%s\n",
+           (unsigned)header->model_id, header->version, header->inputs, header->outputs,
+           header->layer_count, (unsigned)header->total_size, (unsigned)header->crc32,
+           header->temperature > 0.0f ? header->temperature : 1.0f,
+           header->temperature > 0.0f ? "" : " (uncalibrated)");
+    for (uint8_t l = 0; l < header->layer_count; l++) {
+        const ROTS_ModelBlobLayer_t* layer = ROTS_ModelBlob_GetLayer(blob, l);
+        printf("  [%u] %-7s %3u -> %3u", l, type_names[layer->type <= ROTS_AI_LAYER_SOFTMAX ? layer->type : 0],
+               layer->inputs, layer->outputs);
+        if (layer->type == ROTS_AI_LAYER_DENSE) {
+            printf("  stride %u, scale %.6g, weights @0x%X, row sums @0x%X", layer->stride,
+                   layer->weight_scale, (unsigned)layer->weight_offset, (unsigned)layer->row_sum_offset);
+            if (layer->flags & ROTS_AI_LAYER_FLAG_BIAS) {
+                printf(", bias @0x%X", (unsigned)layer->bias_offset);
+            }
+        }
+        printf("\n");
+    }
+
+    static const char* const section_names[] = { "?", "novelty", "intensity" };
+    for (uint8_t s = 0; s < header->section_slots; s++) {
+        const ROTS_ModelBlobSection_t* section = ROTS_ModelBlob_GetSectionEntry(blob, s);
+        if (section->type != ROTS_MODEL_SECTION_NONE) {
+            printf("  section %-7s %u bytes @0x%X\n",
+                   section_names[section->type <= ROTS_MODEL_SECTION_INTENSITY ? section->type : 0],
+                   (unsigned)section->size, (unsigned)section->offset);
+        }
+    }
+}
+
+static int Pack_Usage(void) {
+    fprintf(stderr, "usage: rots_model_pack pack <model.txt> <params.txt> <model.bin> [--id N] [--temperature T]\n"
+                    "                           [--intensity head.txt]\n"
+                    "       rots_model_pack verify <model.bin>\n"
+                    "       rots_model_pack frames <model.bin> <out_dir> [--chunk N] [--transfer N]\n"
+                    "       rots_model_pack calibrate <model.bin> <samples.txt> [--write] [--logits logits.txt]\n"
+                    "       rots_model_pack novelty <model.bin> <samples.txt> [--write]\n");
+    return 2;
+}
@@ -0,0 +1,128 @@
+// ROTS MQ LUT Check - 浓度查找表精度与速度核对 (主机端)
+//
+// 用与固件相同的代码 (rots_mq_convert) 构建共用查找表, 对每个给定校准系数
+// 在全部4096个ADC码值上比较插值查表结果与pow/log10公式的相对误差,
+// 并分别计时查表和公式换算. 构表记录的误差或任一系数下的
+// 最大相对误差超过 LUT_CHECK_MAX_ERROR 时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_mq_lut_check rots_mq_lut_check.cpp ../src/rots_mq_convert.cpp
+//
+// 用法:
+//   rots_mq_lut_check [--factor F]... [--samples N]
+// 校准系数 = 4095 / 清洁空气基线码值, 默认核对 1.0 1.37 1.5 2.5 2.91 4.0.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_mq_convert.h"
+
+#define LUT_CHECK_MAX_ERROR   0.002f     // 允许的最大相对误差 (含插值, 低于钳位判定余量)
+#define LUT_CHECK_SAMPLES     4000000    // 计时用的码值序列长度
+
+typedef std::chrono::steady_clock Clock_t;
+
+// 私有变量
+static uint16_t check_table[ROTS_MQ_LUT_ENTRIES];
+
+// 私有函数声明
+static bool Check_Factor(float factor, const std::vector<uint16_t>& codes);
+static int Check_Usage(void);
+
+int main(int argc, char** argv) {
+    std::vector<float> factors;
+    uint32_t samples = LUT_CHECK_SAMPLES;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Check_Usage();
+        } else if (strcmp(argv[i], "--factor") == 0) {
+            float factor = strtof(argv[i + 1], NULL);
+            if (!(factor > 0.0f)) {
+                return Check_Usage();
+            }
+            factors.push_back(factor);
+        } else if (strcmp(argv[i], "--samples") == 0) {
+            samples = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Check_Usage();
+        }
+    }
+    if (factors.empty()) {
+        factors = { 1.0f, 1.37f, 1.5f, 2.5f, 2.91f, 4.0f };
+    }
+    if (samples == 0) {
+        return Check_Usage();
+    }
+
+    // 计时用的随机码值序列 (与采样顺序无关, 避免分支预测与缓存占便宜)
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dist(0, ROTS_MQ_LUT_SIZE - 1);
+    std::vector<uint16_t> codes(samples);
+    for (uint16_t& code : codes) {
+        code = (uint16_t)dist(rng);
+    }
+
+    // 共用查找表与校准系数无关, 只构建一次
+    float recorded = 0.0f;
+    ROTS_MQConvert_BuildTable(check_table, 0, ROTS_MQ_LUT_ENTRIES, &recorded);
+    bool ok = recorded <= LUT_CHECK_MAX_ERROR;
+    printf("table: %u entries, %u bytes, recorded max error %.5f%%%s\n", ROTS_MQ_LUT_ENTRIES,
+           (unsigned)sizeof(check_table), recorded * 100.0f, ok ? "" : "  <-- FAIL");
+
+    for (float factor : factors) {
+        ok = Check_Factor(factor, codes) && ok;
+    }
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 核对一个校准系数下的插值查表
+static bool Check_Factor(float factor, const std::vector<uint16_t>& codes) {
+    // 全部码值上的相对误差
+    double error_sum = 0.0;
+    float error_max = 0.0f;
+    uint16_t worst = 0;
+    for (uint32_t raw = 0; raw < ROTS_MQ_LUT_SIZE; raw++) {
+        float exact = ROTS_MQConvert_Compute((uint16_t)raw, factor);
+        float lookup = ROTS_MQConvert_Lookup(check_table, (uint16_t)raw, factor);
+        float error = exact > 0.0f ? fabsf(lookup - exact) / exact : 0.0f;
+        error_sum += error;
+        if (error > error_max) {
+            error_max = error;
+            worst = (uint16_t)raw;
+        }
+    }
+
+    // 计时: 查表与公式各走一遍同一码值序列
+    double checksum = 0.0;
+    Clock_t::time_point start = Clock_t::now();
+    for (uint16_t code : codes) {
+        checksum += ROTS_MQConvert_Lookup(check_table, code, factor);
+    }
+    double lookup_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    start = Clock_t::now();
+    for (uint16_t code : codes) {
+        checksum -= ROTS_MQConvert_Compute(code, factor);
+    }
+    double compute_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    double count = (double)codes.size();
+    bool ok = error_max <= LUT_CHECK_MAX_ERROR;
+    printf("factor %.3f: max error %.5f%% at code %u, mean %.5f%%\n", factor,
+           error_max * 100.0f, worst, error_sum * 100.0 / ROTS_MQ_LUT_SIZE);
+    printf("  lookup %.2f ns, pow/log10 %.2f ns per sample (%.1fx), residual %.3g%s\n",
+           lookup_seconds * 1e9 / count, compute_seconds * 1e9 / count, compute_seconds / lookup_seconds,
+           checksum / count, ok ? "" : "  <-- FAIL");
+    return ok;
+}
+
+static int Check_Usage(void) {
+    fprintf(stderr, "usage: rots_mq_lut_check [--factor F]... [--samples N]\n");
+    return 2;
+}
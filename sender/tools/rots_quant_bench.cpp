@@ -0,0 +1,305 @@
+// ROTS Quant Bench - int8推理与浮点推理对比 (主机端)
+//
+// 用与固件相同的运行时加载浮点模型 (同时生成int8权重), 在记录的特征
+// 轨迹上分别走浮点路径和int8路径 (ROTS_AIQuant_RunDense), 报告两者的
+// 推理速度、判定准确率、判定一致率和Softmax前输出的误差; 另单独计时
+// 第一个全连接层的int8内核与浮点矩阵乘.
+// 主机上的速度比只作参考 (没有PIE向量指令), 固件上的耗时见调试输出的 Inference 行.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_quant_bench rots_quant_bench.cpp
+//       ../src/rots_ai_quant.cpp ../src/rots_ai_model.cpp ../src/rots_model_blob.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_quant_bench <model.txt> <params.txt> <trace.txt> [--runs N]
+//
+// model.txt / params.txt 格式同 rots_model_pack.
+// trace.txt 每行一次推理的特征: 类别下标 (0起) 后跟 inputs 个特征值.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_ai_model.h"
+#include "rots_ai_quant.h"
+
+typedef std::chrono::steady_clock Clock_t;
+
+// 私有函数声明
+static bool Bench_LoadDesc(const char* path, ROTS_AIModelDesc_t* desc);
+static bool Bench_LoadValues(const char* path, std::vector<float>* values);
+static bool Bench_LoadTrace(const char* path, uint16_t inputs, uint16_t outputs,
+                            std::vector<float>* features, std::vector<uint16_t>* labels);
+static double Bench_RunModel(const std::vector<float>& features, uint16_t inputs, uint16_t outputs,
+                             bool use_int8, uint32_t runs, std::vector<float>* logits);
+static void Bench_DenseKernel(const ROTS_AIModelDesc_t* desc, const std::vector<float>& params,
+                              const std::vector<float>& features, uint32_t runs);
+static uint16_t Bench_ArgMax(const float* values, uint16_t count);
+static int Bench_Usage(void);
+
+int main(int argc, char** argv) {
+    uint32_t runs = 20;
+    if (argc == 6 && strcmp(argv[4], "--runs") == 0) {
+        runs = (uint32_t)strtoul(argv[5], NULL, 0);
+    } else if (argc != 4) {
+        return Bench_Usage();
+    }
+    if (runs == 0) {
+        return Bench_Usage();
+    }
+
+    ROTS_AIModelDesc_t desc;
+    std::vector<float> params;
+    if (!Bench_LoadDesc(argv[1], &desc) || !Bench_LoadValues(argv[2], &params)) {
+        return 1;
+    }
+    if (ROTS_AIModel_Load(&desc, params.data(), (uint32_t)params.size()) != ROTS_OK) {
+        fprintf(stderr, "model runtime rejected the model (check widths and parameter count)\n");
+        return 1;
+    }
+
+    ROTS_AIModelInfo_t info;
+    ROTS_AIModel_GetInfo(&info);
+    std::vector<float> features;
+    std::vector<uint16_t> labels;
+    if (!Bench_LoadTrace(argv[3], info.inputs, info.outputs, &features, &labels)) {
+        return 1;
+    }
+
+    std::vector<float> float_logits, int8_logits;
+    double float_seconds = Bench_RunModel(features, info.inputs, info.outputs, false, runs, &float_logits);
+    double int8_seconds = Bench_RunModel(features, info.inputs, info.outputs, true, runs, &int8_logits);
+
+    size_t samples = labels.size();
+    size_t float_correct = 0, int8_correct = 0, agree = 0;
+    double error_sum = 0.0, error_max = 0.0;
+    for (size_t s = 0; s < samples; s++) {
+        const float* f = &float_logits[s * info.outputs];
+        const float* q = &int8_logits[s * info.outputs];
+        uint16_t float_class = Bench_ArgMax(f, info.outputs);
+        uint16_t int8_class = Bench_ArgMax(q, info.outputs);
+        float_correct += float_class == labels[s] ? 1 : 0;
+        int8_correct += int8_class == labels[s] ? 1 : 0;
+        agree += float_class == int8_class ? 1 : 0;
+
+        // 误差相对本样本输出的最大幅值
+        float peak = 0.0f, error = 0.0f;
+        for (uint16_t o = 0; o < info.outputs; o++) {
+            peak = fmaxf(peak, fabsf(f[o]));
+            error = fmaxf(error, fabsf(q[o] - f[o]));
+        }
+        double relative = peak > 0.0f ? error / peak : 0.0;
+        error_sum += relative;
+        if (relative > error_max) error_max = relative;
+    }
+
+    double inferences = (double)samples * runs;
+    printf("model: %u -> %u, %u layers, %u params, %u int8 weight bytes\n", info.inputs, info.outputs,
+           info.layer_count, (unsigned)info.param_count, (unsigned)info.quant_bytes);
+    printf("%zu samples x %u runs\n", samples, runs);
+    printf("float: %10.0f inferences/s, accuracy %.4f\n", inferences / float_seconds,
+           (double)float_correct / samples);
+    printf("int8:  %10.0f inferences/s, accuracy %.4f (%+.4f), speedup %.2fx\n", inferences / int8_seconds,
+           (double)int8_correct / samples, ((double)int8_correct - (double)float_correct) / samples,
+           float_seconds / int8_seconds);
+    printf("int8 vs float: %.4f same decision, logit error mean %.4f / max %.4f (relative to peak)\n",
+           (double)agree / samples, error_sum / samples, error_max);
+
+    Bench_DenseKernel(&desc, params, features, runs);
+    return 0;
+}
+
+// 整个轨迹跑runs遍, 返回耗时 (秒); logits保存最后一遍的Softmax前输出
+static double Bench_RunModel(const std::vector<float>& features, uint16_t inputs, uint16_t outputs,
+                             bool use_int8, uint32_t runs, std::vector<float>* logits) {
+    size_t samples = features.size() / inputs;
+    logits->assign(samples * outputs, 0.0f);
+
+    Clock_t::time_point start = Clock_t::now();
+    for (uint32_t run = 0; run < runs; run++) {
+        for (size_t s = 0; s < samples; s++) {
+            ROTS_AIModel_RunLogits(&features[s * inputs], &(*logits)[s * outputs], use_int8);
+        }
+    }
+    return std::chrono::duration<double>(Clock_t::now() - start).count();
+}
+
+// 第一个全连接层单独计时: int8内核 (含输入量化) 与浮点矩阵乘
+static void Bench_DenseKernel(const ROTS_AIModelDesc_t* desc, const std::vector<float>& params,
+                              const std::vector<float>& features, uint32_t runs) {
+    if (desc->layers[0].type != ROTS_AI_LAYER_DENSE) {
+        return;
+    }
+
+    uint16_t inputs = desc->inputs;
+    uint16_t outputs = desc->layers[0].outputs;
+    uint16_t stride = ROTS_AI_QUANT_PADDED(inputs);
+    size_t samples = features.size() / inputs;
+    const float* weights = params.data();
+
+    ROTS_QuantDense_t layer;
+    std::vector<int32_t> row_sums(outputs);
+    int8_t* quant_weights = (int8_t*)aligned_alloc(ROTS_AI_QUANT_ALIGN, (size_t)stride * outputs);
+    int8_t* scratch = (int8_t*)aligned_alloc(ROTS_AI_QUANT_ALIGN, stride);
+    ROTS_AIQuant_PrepareDense(&layer, weights, outputs, inputs, quant_weights, row_sums.data());
+
+    std::vector<float> output(outputs);
+    double checksum = 0.0;
+    Clock_t::time_point start = Clock_t::now();
+    for (uint32_t run = 0; run < runs; run++) {
+        for (size_t s = 0; s < samples; s++) {
+            const float* input = &features[s * inputs];
+            for (uint16_t o = 0; o < outputs; o++) {
+                float acc = 0.0f;
+                for (uint16_t i = 0; i < inputs; i++) {
+                    acc += weights[o * inputs + i] * input[i];
+                }
+                output[o] = acc;
+            }
+            checksum += output[0];
+        }
+    }
+    double float_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    start = Clock_t::now();
+    for (uint32_t run = 0; run < runs; run++) {
+        for (size_t s = 0; s < samples; s++) {
+            ROTS_AIQuant_RunDense(&layer, &features[s * inputs], scratch, output.data());
+            checksum -= output[0];
+        }
+    }
+    double int8_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    double calls = (double)samples * runs;
+    printf("dense[0] %u x %u: float %.0f ns, int8 %.0f ns per call (%.2fx), checksum %.3g\n", outputs, inputs,
+           float_seconds * 1e9 / calls, int8_seconds * 1e9 / calls, float_seconds / int8_seconds, checksum);
+    free(quant_weights);
+    free(scratch);
+}
+
+// 最大值下标
+static uint16_t Bench_ArgMax(const float* values, uint16_t count) {
+    uint16_t best = 0;
+    for (uint16_t i = 1; i < count; i++) {
+        if (values[i] > values[best]) best = i;
+    }
+    return best;
+}
+
+// 解析层描述文件 (格式同 rots_model_pack)
+static bool Bench_LoadDesc(const char* path, ROTS_AIModelDesc_t* desc) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    memset(desc, 0, sizeof(ROTS_AIModelDesc_t));
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) continue;
+
+        if (keyword == "inputs") {
+            unsigned inputs = 0;
+            fields >> inputs;
+            desc->inputs = (uint16_t)inputs;
+            continue;
+        }
+        if (desc->layer_count >= ROTS_AI_MAX_LAYERS) {
+            fprintf(stderr, "%s:%d: more than %d layers\n", path, line_no, ROTS_AI_MAX_LAYERS);
+            return false;
+        }
+
+        ROTS_AILayerDesc_t* layer = &desc->layers[desc->layer_count++];
+        if (keyword == "dense") {
+            unsigned outputs = 0;
+            std::string option;
+            fields >> outputs >> option;
+            layer->type = ROTS_AI_LAYER_DENSE;
+            layer->outputs = (uint16_t)outputs;
+            layer->flags = option == "bias" ? ROTS_AI_LAYER_FLAG_BIAS : 0;
+        } else if (keyword == "relu") {
+            layer->type = ROTS_AI_LAYER_RELU;
+        } else if (keyword == "softmax") {
+            layer->type = ROTS_AI_LAYER_SOFTMAX;
+        } else {
+            fprintf(stderr, "%s:%d: unknown layer '%s'\n", path, line_no, keyword.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// 读取空白分隔的浮点数
+static bool Bench_LoadValues(const char* path, std::vector<float>* values) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    float value;
+    while (in >> value) {
+        values->push_back(value);
+    }
+    if (!in.eof()) {
+        fprintf(stderr, "%s: bad number after %zu values\n", path, values->size());
+        return false;
+    }
+    return true;
+}
+
+// 读取特征轨迹
+static bool Bench_LoadTrace(const char* path, uint16_t inputs, uint16_t outputs,
+                            std::vector<float>* features, std::vector<uint16_t>* labels) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        unsigned label;
+        if (!(fields >> label)) continue;
+
+        float value;
+        uint16_t count = 0;
+        while (fields >> value) {
+            features->push_back(value);
+            count++;
+        }
+        if (label >= outputs || count != inputs) {
+            fprintf(stderr, "%s:%d: expected '<0..%u> <%u features>'\n", path, line_no, outputs - 1, inputs);
+            return false;
+        }
+        labels->push_back((uint16_t)label);
+    }
+
+    if (labels->empty()) {
+        fprintf(stderr, "%s: no samples\n", path);
+        return false;
+    }
+    return true;
+}
+
+static int Bench_Usage(void) {
+    fprintf(stderr, "usage: rots_quant_bench <model.txt> <params.txt> <trace.txt> [--runs N]\n");
+    return 2;
+}
@@ -0,0 +1,168 @@
+// ROTS Seqlock Stress - 顺序锁并发压力测试 (主机端)
+//
+// 一个写线程不停发布新值, 若干读线程同时读取, 逐个检查读到的快照是否完整
+// (所有字出自同一次写入) 且版本不倒退. 出现撕裂或倒退时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -I../src -o rots_seqlock_stress rots_seqlock_stress.cpp
+//       ../src/rots_seqlock.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_seqlock_stress [--readers N] [--words N] [--ms N]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_seqlock.h"
+
+#define STRESS_MAX_WORDS      256     // 快照最大字数
+#define STRESS_MAX_READERS    16
+
+// 读线程统计
+typedef struct {
+    uint64_t reads;        // 成功读取次数
+    uint64_t busy;         // 返回ROTS_BUSY的次数
+    uint64_t torn;         // 字之间不一致的快照
+    uint64_t regressed;    // 版本比上次读到的旧
+} StressReader_t;
+
+// 私有变量
+static ROTS_Seqlock_t lock;
+static std::atomic<uint32_t> words[STRESS_MAX_WORDS];
+static std::atomic<bool> running(true);
+
+// 私有函数声明
+static uint32_t Stress_Word(uint32_t version, uint32_t index);
+static void Stress_Writer(uint32_t word_count, uint64_t* writes);
+static void Stress_Reader(uint32_t word_count, StressReader_t* stats);
+static int Stress_Usage(void);
+
+int main(int argc, char** argv) {
+    uint32_t readers = 3;
+    uint32_t word_count = 64;
+    uint32_t duration_ms = 2000;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Stress_Usage();
+        } else if (strcmp(argv[i], "--readers") == 0) {
+            readers = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--words") == 0) {
+            word_count = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--ms") == 0) {
+            duration_ms = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Stress_Usage();
+        }
+    }
+    if (readers == 0 || readers > STRESS_MAX_READERS || word_count < 2 || word_count > STRESS_MAX_WORDS) {
+        fprintf(stderr, "need 1..%d readers and 2..%d words\n", STRESS_MAX_READERS, STRESS_MAX_WORDS);
+        return 2;
+    }
+
+    // 初始值即版本0的快照
+    std::vector<uint32_t> initial(word_count);
+    for (uint32_t i = 0; i < word_count; i++) {
+        initial[i] = Stress_Word(0, i);
+    }
+    if (ROTS_Seqlock_Init(&lock, words, (uint16_t)(word_count * 4), initial.data()) != ROTS_OK) {
+        fprintf(stderr, "seqlock init failed\n");
+        return 1;
+    }
+
+    uint64_t writes = 0;
+    std::vector<StressReader_t> stats(readers);
+    std::vector<std::thread> threads;
+    for (uint32_t r = 0; r < readers; r++) {
+        threads.emplace_back(Stress_Reader, word_count, &stats[r]);
+    }
+    std::thread writer(Stress_Writer, word_count, &writes);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+    running.store(false, std::memory_order_relaxed);
+    writer.join();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    StressReader_t total;
+    memset(&total, 0, sizeof(total));
+    for (uint32_t r = 0; r < readers; r++) {
+        printf("reader %u: %llu reads, %llu busy, %llu torn, %llu regressed\n", r,
+               (unsigned long long)stats[r].reads, (unsigned long long)stats[r].busy,
+               (unsigned long long)stats[r].torn, (unsigned long long)stats[r].regressed);
+        total.reads += stats[r].reads;
+        total.busy += stats[r].busy;
+        total.torn += stats[r].torn;
+        total.regressed += stats[r].regressed;
+    }
+    printf("%llu writes of %u bytes in %u ms, %u read retries\n", (unsigned long long)writes,
+           word_count * 4, duration_ms, ROTS_Seqlock_GetRetries(&lock));
+    printf("version %u (expected %u)\n", ROTS_Seqlock_GetVersion(&lock), (uint32_t)writes);
+
+    if (total.torn || total.regressed || ROTS_Seqlock_GetVersion(&lock) != (uint32_t)writes) {
+        printf("FAIL\n");
+        return 1;
+    }
+    if (total.reads == 0) {
+        printf("FAIL: no successful reads\n");
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
+
+// 版本version第index个字的值: 每个字都能反推出版本, 不同版本的字混在一起即可检出
+static uint32_t Stress_Word(uint32_t version, uint32_t index) {
+    return index == 0 ? version : (version * 2654435761UL) ^ (index * 0x9E3779B9UL);
+}
+
+// 写线程: 尽快发布连续版本
+static void Stress_Writer(uint32_t word_count, uint64_t* writes) {
+    std::vector<uint32_t> snapshot(word_count);
+    uint32_t version = 0;
+    while (running.load(std::memory_order_relaxed)) {
+        version++;
+        for (uint32_t i = 0; i < word_count; i++) {
+            snapshot[i] = Stress_Word(version, i);
+        }
+        ROTS_Seqlock_Write(&lock, snapshot.data());
+    }
+    *writes = version;
+}
+
+// 读线程: 每个快照的各字须出自同一版本, 且版本单调不减
+static void Stress_Reader(uint32_t word_count, StressReader_t* stats) {
+    std::vector<uint32_t> snapshot(word_count);
+    uint32_t last_version = 0;
+    memset(stats, 0, sizeof(*stats));
+    while (running.load(std::memory_order_relaxed)) {
+        if (ROTS_Seqlock_Read(&lock, snapshot.data()) != ROTS_OK) {
+            stats->busy++;
+            continue;
+        }
+        stats->reads++;
+
+        uint32_t version = snapshot[0];
+        for (uint32_t i = 1; i < word_count; i++) {
+            if (snapshot[i] != Stress_Word(version, i)) {
+                stats->torn++;
+                break;
+            }
+        }
+        if (version < last_version) {
+            stats->regressed++;
+        }
+        last_version = version;
+    }
+}
+
+static int Stress_Usage(void) {
+    fprintf(stderr, "usage: rots_seqlock_stress [--readers N] [--words N] [--ms N]\n");
+    return 2;
+}
@@ -0,0 +1,362 @@
+// ROTS Softmax Bench - 置信度Softmax与温度校准核对 (主机端)
+//
+// 用与固件相同的 ROTS_AIModel_FastExp / ROTS_AIModel_Softmax:
+// - 在 [-30, 0] 上逐点比较查表exp与双精度exp的相对误差, 并与libm expf计时对比;
+// - 在记录的logits上比较Softmax概率与双精度参考值, 并与expf版本计时对比;
+// - 给出T=1、指定温度和按NLL拟合温度下的准确率、NLL与ECE,
+//   以及查表exp本身给NLL/ECE带来的偏差.
+// exp或概率误差超过允许值, 或拟合温度反而使NLL变差时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_softmax_bench rots_softmax_bench.cpp
+//       ../src/rots_ai_model.cpp ../src/rots_ai_quant.cpp ../src/rots_model_blob.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_softmax_bench [logits.txt] [--temperature T] [--runs N]
+//
+// logits.txt 每行一个样本 ('#'起为注释): 类别下标 (0起) 后跟各类Softmax前输出,
+// 可由 rots_model_pack calibrate ... --logits logits.txt 记录.
+// 不给文件时合成一组过度自信的3类logits (2000个样本).
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_ai_model.h"
+
+#define BENCH_EXP_POINTS       1000000    // exp误差扫描点数
+#define BENCH_EXP_MIN          -30.0f
+#define BENCH_EXP_TOLERANCE    1e-4       // 查表exp允许的相对误差
+#define BENCH_PROB_TOLERANCE   1e-4       // 概率允许的绝对误差
+#define BENCH_ECE_BINS         10         // 与 rots_model_pack calibrate 相同
+#define BENCH_CALIBRATE_STEPS  48
+#define BENCH_SYNTH_SAMPLES    2000
+#define BENCH_SYNTH_CLASSES    3
+
+typedef std::chrono::steady_clock Clock_t;
+
+// 记录的logits
+typedef struct {
+    std::vector<float> logits;
+    std::vector<uint16_t> labels;
+    uint16_t classes;
+} Logits_t;
+
+// 校准指标
+typedef struct {
+    double nll;
+    double ece;
+    double accuracy;
+} Score_t;
+
+// 私有函数声明
+static bool Bench_Load(const char* path, Logits_t* data);
+static void Bench_Synthesize(Logits_t* data);
+static bool Bench_Exp(uint32_t runs);
+static bool Bench_Softmax(const Logits_t& data, float temperature, uint32_t runs);
+static void Bench_Reference(const float* logits, double* probs, uint16_t count, float temperature);
+static Score_t Bench_Score(const Logits_t& data, float temperature, bool reference);
+static float Bench_Fit(const Logits_t& data);
+static int Bench_Usage(void);
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    float temperature = 0.0f;
+    uint32_t runs = 50;
+    int first = 1;
+    if (argc > 1 && argv[1][0] != '-') {
+        path = argv[1];
+        first = 2;
+    }
+    for (int i = first; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Bench_Usage();
+        } else if (strcmp(argv[i], "--temperature") == 0) {
+            temperature = strtof(argv[i + 1], NULL);
+            if (!(temperature >= ROTS_AI_MIN_TEMPERATURE && temperature <= ROTS_AI_MAX_TEMPERATURE)) {
+                return Bench_Usage();
+            }
+        } else if (strcmp(argv[i], "--runs") == 0) {
+            runs = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Bench_Usage();
+        }
+    }
+    if (runs == 0) {
+        return Bench_Usage();
+    }
+
+    Logits_t data;
+    if (path) {
+        if (!Bench_Load(path, &data)) {
+            return 1;
+        }
+    } else {
+        Bench_Synthesize(&data);
+    }
+    printf("%zu samples x %u classes%s\n", data.labels.size(), data.classes, path ? "" : " (synthetic)");
+
+    bool ok = Bench_Exp(runs);
+    ok = Bench_Softmax(data, temperature > 0.0f ? temperature : 1.0f, runs) && ok;
+
+    // 校准: 每行 "查表exp (双精度参考)"
+    std::vector<float> temperatures(1, 1.0f);
+    if (temperature > 0.0f) temperatures.push_back(temperature);
+    float fitted = Bench_Fit(data);
+    temperatures.push_back(fitted);
+
+    Score_t plain = Bench_Score(data, 1.0f, false);
+    for (size_t t = 0; t < temperatures.size(); t++) {
+        Score_t fast = Bench_Score(data, temperatures[t], false);
+        Score_t exact = Bench_Score(data, temperatures[t], true);
+        printf("T=%.3f%s: accuracy %.3f, NLL %.4f (%.4f), ECE %.4f (%.4f)\n", temperatures[t],
+               t + 1 == temperatures.size() ? " fitted" : "", fast.accuracy, fast.nll, exact.nll, fast.ece, exact.ece);
+    }
+    Score_t best = Bench_Score(data, fitted, false);
+    if (best.nll > plain.nll + 1e-9) {
+        printf("fitted temperature increases NLL  <-- FAIL\n");
+        ok = false;
+    }
+
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 查表exp的精度与速度
+static bool Bench_Exp(uint32_t runs) {
+    double error_max = 0.0;
+    float worst = 0.0f;
+    std::vector<float> points(BENCH_EXP_POINTS);
+    for (uint32_t i = 0; i < BENCH_EXP_POINTS; i++) {
+        float x = BENCH_EXP_MIN * i / (BENCH_EXP_POINTS - 1);
+        double exact = exp((double)x);
+        double error = fabs(ROTS_AIModel_FastExp(x) - exact) / exact;
+        if (error > error_max) {
+            error_max = error;
+            worst = x;
+        }
+        points[i] = x;
+    }
+
+    double checksum = 0.0;
+    Clock_t::time_point start = Clock_t::now();
+    for (uint32_t r = 0; r < runs; r++) {
+        for (float x : points) checksum += ROTS_AIModel_FastExp(x);
+    }
+    double fast_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    start = Clock_t::now();
+    for (uint32_t r = 0; r < runs; r++) {
+        for (float x : points) checksum -= expf(x);
+    }
+    double libm_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    double calls = (double)runs * BENCH_EXP_POINTS;
+    bool ok = error_max <= BENCH_EXP_TOLERANCE;
+    printf("exp: max relative error %.3g at x=%.4f, table %.2f ns, expf %.2f ns per call (residual %.3g)%s\n",
+           error_max, worst, fast_seconds * 1e9 / calls, libm_seconds * 1e9 / calls, checksum / calls,
+           ok ? "" : "  <-- FAIL");
+    return ok;
+}
+
+// Softmax概率误差与速度 (与逐项调用expf的同结构实现对比)
+static bool Bench_Softmax(const Logits_t& data, float temperature, uint32_t runs) {
+    size_t samples = data.labels.size();
+    uint16_t classes = data.classes;
+    std::vector<float> probs(classes);
+    std::vector<double> exact(classes);
+    double error_max = 0.0, sum_error_max = 0.0;
+    for (size_t s = 0; s < samples; s++) {
+        const float* logits = &data.logits[s * classes];
+        ROTS_AIModel_Softmax(logits, probs.data(), classes, temperature);
+        Bench_Reference(logits, exact.data(), classes, temperature);
+        double sum = 0.0;
+        for (uint16_t c = 0; c < classes; c++) {
+            error_max = fmax(error_max, fabs(probs[c] - exact[c]));
+            sum += probs[c];
+        }
+        sum_error_max = fmax(sum_error_max, fabs(sum - 1.0));
+    }
+
+    double checksum = 0.0;
+    Clock_t::time_point start = Clock_t::now();
+    for (uint32_t r = 0; r < runs; r++) {
+        for (size_t s = 0; s < samples; s++) {
+            ROTS_AIModel_Softmax(&data.logits[s * classes], probs.data(), classes, temperature);
+            checksum += probs[0];
+        }
+    }
+    double fast_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    start = Clock_t::now();
+    for (uint32_t r = 0; r < runs; r++) {
+        for (size_t s = 0; s < samples; s++) {
+            const float* logits = &data.logits[s * classes];
+            float max = logits[0];
+            for (uint16_t c = 1; c < classes; c++) max = fmaxf(max, logits[c]);
+            float sum = 0.0f;
+            for (uint16_t c = 0; c < classes; c++) {
+                probs[c] = expf((logits[c] - max) / temperature);
+                sum += probs[c];
+            }
+            checksum -= probs[0] / sum;
+        }
+    }
+    double libm_seconds = std::chrono::duration<double>(Clock_t::now() - start).count();
+
+    double calls = (double)runs * samples;
+    bool ok = error_max <= BENCH_PROB_TOLERANCE && sum_error_max <= BENCH_PROB_TOLERANCE;
+    printf("softmax (T=%.3f): max probability error %.3g, max |sum-1| %.3g, table %.1f ns, expf %.1f ns"
+           " per sample (residual %.3g)%s\n", temperature, error_max, sum_error_max, fast_seconds * 1e9 / calls,
+           libm_seconds * 1e9 / calls, checksum / calls, ok ? "" : "  <-- FAIL");
+    return ok;
+}
+
+// 双精度参考Softmax
+static void Bench_Reference(const float* logits, double* probs, uint16_t count, float temperature) {
+    double max = logits[0];
+    for (uint16_t i = 1; i < count; i++) max = fmax(max, logits[i]);
+    double sum = 0.0;
+    for (uint16_t i = 0; i < count; i++) {
+        probs[i] = exp((logits[i] - max) / temperature);
+        sum += probs[i];
+    }
+    for (uint16_t i = 0; i < count; i++) probs[i] /= sum;
+}
+
+// 给定温度下的NLL, ECE (按最大概率分箱) 与准确率; reference为真时用双精度Softmax
+static Score_t Bench_Score(const Logits_t& data, float temperature, bool reference) {
+    double bin_confidence[BENCH_ECE_BINS] = { 0 };
+    double bin_correct[BENCH_ECE_BINS] = { 0 };
+    std::vector<float> fast(data.classes);
+    std::vector<double> probs(data.classes);
+    double loss = 0.0, correct = 0.0;
+
+    for (size_t s = 0; s < data.labels.size(); s++) {
+        const float* logits = &data.logits[s * data.classes];
+        if (reference) {
+            Bench_Reference(logits, probs.data(), data.classes, temperature);
+        } else {
+            ROTS_AIModel_Softmax(logits, fast.data(), data.classes, temperature);
+            for (uint16_t c = 0; c < data.classes; c++) probs[c] = fast[c];
+        }
+
+        uint16_t best = 0;
+        for (uint16_t c = 1; c < data.classes; c++) {
+            if (probs[c] > probs[best]) best = c;
+        }
+        int bin = (int)(probs[best] * BENCH_ECE_BINS);
+        if (bin >= BENCH_ECE_BINS) bin = BENCH_ECE_BINS - 1;
+        double hit = best == data.labels[s] ? 1.0 : 0.0;
+        bin_confidence[bin] += probs[best];
+        bin_correct[bin] += hit;
+        correct += hit;
+        loss -= log(fmax(probs[data.labels[s]], 1e-12));
+    }
+
+    Score_t score;
+    double gap = 0.0;
+    for (int bin = 0; bin < BENCH_ECE_BINS; bin++) {
+        gap += fabs(bin_confidence[bin] - bin_correct[bin]);
+    }
+    score.nll = loss / data.labels.size();
+    score.ece = gap / data.labels.size();
+    score.accuracy = correct / data.labels.size();
+    return score;
+}
+
+// 在log T上黄金分割搜索NLL最小的温度 (与 rots_model_pack calibrate 相同)
+static float Bench_Fit(const Logits_t& data) {
+    const double ratio = 0.6180339887498949;
+    double lo = log(ROTS_AI_MIN_TEMPERATURE);
+    double hi = log(ROTS_AI_MAX_TEMPERATURE);
+    double a = hi - ratio * (hi - lo);
+    double b = lo + ratio * (hi - lo);
+    double nll_a = Bench_Score(data, (float)exp(a), false).nll;
+    double nll_b = Bench_Score(data, (float)exp(b), false).nll;
+    for (int step = 0; step < BENCH_CALIBRATE_STEPS; step++) {
+        if (nll_a < nll_b) {
+            hi = b;
+            b = a;
+            nll_b = nll_a;
+            a = hi - ratio * (hi - lo);
+            nll_a = Bench_Score(data, (float)exp(a), false).nll;
+        } else {
+            lo = a;
+            a = b;
+            nll_a = nll_b;
+            b = lo + ratio * (hi - lo);
+            nll_b = Bench_Score(data, (float)exp(b), false).nll;
+        }
+    }
+    return (float)exp((lo + hi) / 2);
+}
+
+// 合成过度自信的logits: 正确类别得分偏高, 但整体幅度放大了4倍
+static void Bench_Synthesize(Logits_t* data) {
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::uniform_int_distribution<int> label(0, BENCH_SYNTH_CLASSES - 1);
+    data->classes = BENCH_SYNTH_CLASSES;
+    for (uint32_t s = 0; s < BENCH_SYNTH_SAMPLES; s++) {
+        uint16_t y = (uint16_t)label(rng);
+        data->labels.push_back(y);
+        for (uint16_t c = 0; c < BENCH_SYNTH_CLASSES; c++) {
+            data->logits.push_back(4.0f * ((c == y ? 1.0f : 0.0f) + noise(rng)));
+        }
+    }
+}
+
+// 读取记录的logits, 各行类别数须一致
+static bool Bench_Load(const char* path, Logits_t* data) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    data->classes = 0;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        unsigned label;
+        if (!(fields >> label)) continue;
+
+        float value;
+        uint16_t count = 0;
+        while (fields >> value) {
+            data->logits.push_back(value);
+            count++;
+        }
+        if (count < 2 || label >= count || (data->classes && count != data->classes)) {
+            fprintf(stderr, "%s:%d: expected '<label> <logit>...' with a fixed class count and label < classes\n",
+                    path, line_no);
+            return false;
+        }
+        data->classes = count;
+        data->labels.push_back((uint16_t)label);
+    }
+
+    if (data->labels.empty()) {
+        fprintf(stderr, "%s: no samples\n", path);
+        return false;
+    }
+    return true;
+}
+
+static int Bench_Usage(void) {
+    fprintf(stderr, "usage: rots_softmax_bench [logits.txt] [--temperature T] [--runs N]\n"
+                    "       T must be within %.2f..%.1f\n", ROTS_AI_MIN_TEMPERATURE, ROTS_AI_MAX_TEMPERATURE);
+    return 2;
+}
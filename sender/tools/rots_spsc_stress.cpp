@@ -0,0 +1,148 @@
+// ROTS SPSC Stress - 单生产者/单消费者队列并发测试 (主机端)
+//
+// 生产线程与消费线程同时操作同一个队列: 生产端给每个写入成功的元素编连续序号,
+// 消费端检查取出的序号连续且内容完整, 结束后核对统计 (写入 = 取出 + 剩余,
+// 丢弃数 = 写入失败次数). 出现乱序、缺失或内容损坏时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -pthread -I../src -o rots_spsc_stress rots_spsc_stress.cpp
+//       ../src/rots_spsc_queue.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_spsc_stress [--capacity N] [--items N] [--consumer-delay N]
+// --consumer-delay 为消费端每取出N个元素让出一次CPU, 用于制造队列满与丢弃.
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_spsc_queue.h"
+
+#define STRESS_ITEM_WORDS     16      // 元素大小 (字), 与传感器帧同一量级
+#define STRESS_MAX_CAPACITY   1024
+
+// 队列元素: 序号 + 由序号派生的填充字
+typedef struct {
+    uint32_t sequence;
+    uint32_t payload[STRESS_ITEM_WORDS - 1];
+} StressItem_t;
+
+// 私有变量
+static ROTS_SPSCQueue_t queue;
+static StressItem_t storage[STRESS_MAX_CAPACITY];
+static std::atomic<bool> producer_done(false);
+
+// 私有函数声明
+static uint32_t Stress_Payload(uint32_t sequence, uint32_t index);
+static void Stress_Producer(uint32_t items, uint64_t* attempts, uint64_t* rejected);
+static void Stress_Consumer(uint32_t delay, uint64_t* popped, uint64_t* errors);
+static int Stress_Usage(void);
+
+int main(int argc, char** argv) {
+    uint32_t capacity = 8;
+    uint32_t items = 2000000;
+    uint32_t delay = 0;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Stress_Usage();
+        } else if (strcmp(argv[i], "--capacity") == 0) {
+            capacity = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--items") == 0) {
+            items = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--consumer-delay") == 0) {
+            delay = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Stress_Usage();
+        }
+    }
+    if (capacity > STRESS_MAX_CAPACITY ||
+        ROTS_SPSCQueue_Init(&queue, storage, sizeof(StressItem_t), (uint16_t)capacity) != ROTS_OK) {
+        fprintf(stderr, "capacity must be a power of two up to %d\n", STRESS_MAX_CAPACITY);
+        return 2;
+    }
+
+    uint64_t attempts = 0, rejected = 0, popped = 0, errors = 0;
+    std::thread consumer(Stress_Consumer, delay, &popped, &errors);
+    std::thread producer(Stress_Producer, items, &attempts, &rejected);
+    producer.join();
+    producer_done.store(true, std::memory_order_release);
+    consumer.join();
+
+    ROTS_SPSCQueueStats_t stats;
+    ROTS_SPSCQueue_GetStats(&queue, &stats);
+    printf("%u items through capacity %u: %llu push attempts, %llu rejected (queue full)\n", items, capacity,
+           (unsigned long long)attempts, (unsigned long long)rejected);
+    printf("stats: pushed %u, popped %u, depth %u, dropped %u, high water %u\n", (unsigned)stats.pushed,
+           (unsigned)stats.popped, stats.depth, (unsigned)stats.dropped, stats.high_water);
+    printf("consumer: %llu popped, %llu sequence/payload errors\n", (unsigned long long)popped,
+           (unsigned long long)errors);
+
+    bool ok = errors == 0 && popped == items && stats.pushed == items && stats.popped == items &&
+              stats.depth == 0 && stats.dropped == (uint32_t)rejected && stats.high_water <= capacity;
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 序号sequence的第index个填充字
+static uint32_t Stress_Payload(uint32_t sequence, uint32_t index) {
+    return (sequence * 2654435761UL) ^ (index * 0x9E3779B9UL);
+}
+
+// 生产线程: 写入失败 (队列满) 时重试同一元素, 只有写入成功才推进序号
+static void Stress_Producer(uint32_t items, uint64_t* attempts, uint64_t* rejected) {
+    StressItem_t item;
+    for (uint32_t sequence = 0; sequence < items; ) {
+        item.sequence = sequence;
+        for (uint32_t i = 0; i < STRESS_ITEM_WORDS - 1; i++) {
+            item.payload[i] = Stress_Payload(sequence, i);
+        }
+
+        (*attempts)++;
+        if (ROTS_SPSCQueue_Push(&queue, &item) == ROTS_OK) {
+            sequence++;
+        } else {
+            (*rejected)++;
+            std::this_thread::yield();
+        }
+    }
+}
+
+// 消费线程: 序号须连续, 填充字须与序号一致
+static void Stress_Consumer(uint32_t delay, uint64_t* popped, uint64_t* errors) {
+    StressItem_t item;
+    uint32_t expected = 0;
+    while (true) {
+        // 先读结束标志再取元素: 标志已置位而队列仍为空时, 生产端的写入均已可见
+        bool done = producer_done.load(std::memory_order_acquire);
+        if (ROTS_SPSCQueue_Pop(&queue, &item) != ROTS_OK) {
+            if (done) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        bool intact = item.sequence == expected;
+        for (uint32_t i = 0; intact && i < STRESS_ITEM_WORDS - 1; i++) {
+            intact = item.payload[i] == Stress_Payload(item.sequence, i);
+        }
+        if (!intact) {
+            (*errors)++;
+        }
+        expected = item.sequence + 1;
+        (*popped)++;
+
+        if (delay && *popped % delay == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+static int Stress_Usage(void) {
+    fprintf(stderr, "usage: rots_spsc_stress [--capacity N] [--items N] [--consumer-delay N]\n");
+    return 2;
+}
@@ -0,0 +1,326 @@
+// ROTS Temporal Check - 时序特征增量更新核对 (主机端)
+//
+// 把记录下的 (或合成的) 轨迹逐帧写入传感器历史并调用与固件相同的
+// ROTS_TemporalFeatures_Update, 每帧对窗口内样本重新扫描计算斜率、极差和面积,
+// 与增量结果比较. 斜率和面积的允许误差由定点累加的量化步长推出, 极差须完全一致;
+// EWMA/基线/响应起始为逐样本递推, 与同样的递推式比较. 长轨迹可检查累积误差.
+// 任一特征超出允许误差时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_temporal_check rots_temporal_check.cpp
+//       ../src/rots_temporal_features.cpp ../src/rots_sensor_history.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_temporal_check [trace.txt] [--frames N] [--channels N] [--jitter MS]
+//
+// trace.txt 每行一帧 ('#'起为注释): <timestamp_ms> <通道0> <通道1> ...
+// 不给轨迹时合成: 各通道不同基线 + 噪声 + 随机响应脉冲, 帧间隔100ms加随机抖动.
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_sensor_history.h"
+#include "rots_temporal_features.h"
+#include "rots_debug.h"
+
+#define CHECK_SYNTH_FRAMES    200000
+#define CHECK_SYNTH_CHANNELS  8
+#define CHECK_PERIOD_MS       100
+#define CHECK_RELATIVE_TOL    1e-5     // 浮点换算的相对误差余量
+
+typedef std::chrono::steady_clock Clock_t;
+
+// 轨迹: frames x channels, 按帧存放
+typedef struct {
+    std::vector<uint32_t> timestamps;
+    std::vector<float> values;
+    uint8_t channels;
+} Trace_t;
+
+// 逐样本递推的参考状态
+typedef struct {
+    float ewma;
+    float baseline;
+    bool onset;
+    uint32_t onset_time;
+} Reference_t;
+
+// 私有函数声明
+static bool Check_LoadTrace(const char* path, Trace_t* trace);
+static void Check_Synthesize(Trace_t* trace, uint32_t frames, uint8_t channels, uint32_t jitter_ms);
+static void Check_Recurse(Reference_t* ref, float value, uint32_t now_ms, bool first);
+static void Check_Window(const Reference_t* ref, uint8_t channel, uint16_t fill, uint32_t now_ms,
+                         float* expected, float* tolerance);
+static int Check_Usage(void);
+
+int main(int argc, char** argv) {
+    const char* trace_path = NULL;
+    uint32_t frames = CHECK_SYNTH_FRAMES;
+    uint32_t channels = CHECK_SYNTH_CHANNELS;
+    uint32_t jitter_ms = 10;
+    int first = 1;
+    if (argc > 1 && argv[1][0] != '-') {
+        trace_path = argv[1];
+        first = 2;
+    }
+    for (int i = first; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return Check_Usage();
+        } else if (strcmp(argv[i], "--frames") == 0) {
+            frames = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--channels") == 0) {
+            channels = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else if (strcmp(argv[i], "--jitter") == 0) {
+            jitter_ms = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        } else {
+            return Check_Usage();
+        }
+    }
+    if (frames == 0 || channels == 0 || channels > ROTS_MAX_CHANNELS || jitter_ms >= CHECK_PERIOD_MS) {
+        return Check_Usage();
+    }
+
+    Trace_t trace;
+    if (trace_path) {
+        if (!Check_LoadTrace(trace_path, &trace)) {
+            return 1;
+        }
+    } else {
+        Check_Synthesize(&trace, frames, (uint8_t)channels, jitter_ms);
+    }
+    frames = (uint32_t)trace.timestamps.size();
+
+    if (ROTS_SensorHistory_Init(trace.channels) != ROTS_OK ||
+        ROTS_TemporalFeatures_Init(trace.channels) != ROTS_OK) {
+        fprintf(stderr, "cannot initialise history/temporal features for %u channels\n", trace.channels);
+        return 1;
+    }
+
+    static const char* names[ROTS_TEMPORAL_FEATURES] = { "slope", "ewma", "range", "area", "onset_age" };
+    double error_max[ROTS_TEMPORAL_FEATURES] = { 0 };
+    double excess_max[ROTS_TEMPORAL_FEATURES] = { 0 };    // 误差/允许误差, >1为超差
+    uint64_t failures[ROTS_TEMPORAL_FEATURES] = { 0 };
+    uint32_t onset_frames = 0;
+    double brute_seconds = 0.0;
+    uint64_t update_ns = 0;
+
+    std::vector<Reference_t> refs(trace.channels);
+    ROTS_SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    data.channel_count = trace.channels;
+    for (uint32_t f = 0; f < frames; f++) {
+        memcpy(data.channels, &trace.values[(size_t)f * trace.channels], trace.channels * sizeof(float));
+        data.timestamp = trace.timestamps[f];
+        ROTS_SensorHistory_Push(&data);
+        ROTS_TemporalFeatures_Update(&data);
+
+        ROTS_TemporalStats_t stats;
+        ROTS_TemporalFeatures_GetStats(&stats);
+        update_ns += stats.update_cycles;
+        if (stats.onset_mask) onset_frames++;
+
+        Clock_t::time_point start = Clock_t::now();
+        for (uint8_t ch = 0; ch < trace.channels; ch++) {
+            Check_Recurse(&refs[ch], data.channels[ch], data.timestamp, f == 0);
+
+            float expected[ROTS_TEMPORAL_FEATURES], tolerance[ROTS_TEMPORAL_FEATURES];
+            float actual[ROTS_TEMPORAL_FEATURES];
+            Check_Window(&refs[ch], ch, stats.window_fill, data.timestamp, expected, tolerance);
+            ROTS_TemporalFeatures_Get(ch, actual);
+
+            for (int k = 0; k < ROTS_TEMPORAL_FEATURES; k++) {
+                double error = fabs((double)actual[k] - expected[k]);
+                double allowed = tolerance[k] + CHECK_RELATIVE_TOL * fabs(expected[k]);
+                if (error > error_max[k]) error_max[k] = error;
+                if (allowed > 0.0 && error / allowed > excess_max[k]) excess_max[k] = error / allowed;
+                if (error > allowed || std::isnan(actual[k])) {
+                    if (failures[k] == 0) {
+                        fprintf(stderr, "frame %u ch %u %s: incremental %.6g, brute force %.6g\n",
+                                f, ch, names[k], actual[k], expected[k]);
+                    }
+                    failures[k]++;
+                }
+            }
+        }
+        brute_seconds += std::chrono::duration<double>(Clock_t::now() - start).count();
+    }
+
+    printf("%u frames x %u channels, window %d frames, %u frames with an onset\n",
+           frames, trace.channels, ROTS_TEMPORAL_WINDOW, onset_frames);
+    bool ok = true;
+    for (int k = 0; k < ROTS_TEMPORAL_FEATURES; k++) {
+        printf("  %-9s max error %.3g (%.0f%% of tolerance), %llu over tolerance\n", names[k], error_max[k],
+               excess_max[k] * 100.0, (unsigned long long)failures[k]);
+        ok = ok && failures[k] == 0;
+    }
+    printf("update %.0f ns per frame (all channels), brute force %.0f ns\n",
+           (double)update_ns / frames, brute_seconds * 1e9 / frames);
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// 与固件相同的递推: EWMA, 慢速基线 (响应期间冻结), 响应起始
+static void Check_Recurse(Reference_t* ref, float value, uint32_t now_ms, bool first) {
+    if (first) {
+        memset(ref, 0, sizeof(*ref));
+        ref->ewma = value;
+        ref->baseline = value;
+    } else {
+        ref->ewma += ROTS_TEMPORAL_EWMA_ALPHA * (value - ref->ewma);
+    }
+
+    float excess = value - ref->baseline;
+    if (!ref->onset && excess > ROTS_TEMPORAL_ONSET_DELTA) {
+        ref->onset = true;
+        ref->onset_time = now_ms;
+    } else if (ref->onset && excess < ROTS_TEMPORAL_ONSET_DELTA * ROTS_TEMPORAL_ONSET_RELEASE) {
+        ref->onset = false;
+    }
+    if (!ref->onset) {
+        ref->baseline += ROTS_TEMPORAL_BASELINE_ALPHA * (value - ref->baseline);
+    }
+}
+
+// 扫描窗口重新计算全部特征, 同时给出定点量化带来的允许误差
+static void Check_Window(const Reference_t* ref, uint8_t channel, uint16_t fill, uint32_t now_ms,
+                         float* expected, float* tolerance) {
+    const float* window = NULL;
+    const uint32_t* timestamps = NULL;
+    ROTS_SensorHistory_GetWindow(channel, fill, &window);
+    ROTS_SensorHistory_GetTimestamps(fill, &timestamps);
+
+    double interval_ms = fill > 1 ? (double)(timestamps[fill - 1] - timestamps[0]) / (fill - 1) : 0.0;
+    double mean = 0.0;
+    float max = window[0], min = window[0];
+    for (uint16_t i = 0; i < fill; i++) {
+        mean += window[i];
+        max = fmaxf(max, window[i]);
+        min = fminf(min, window[i]);
+    }
+    mean /= fill;
+
+    // 最小二乘斜率; 每个样本的量化误差至多半个定点步长
+    double half_step = 0.5 / ROTS_TEMPORAL_FIXED_SCALE;
+    double slope = 0.0, slope_tol = 0.0;
+    if (fill > 1 && interval_ms > 0.0) {
+        double center = (fill - 1) / 2.0;
+        double sxx = 0.0, sxy = 0.0, sx_abs = 0.0;
+        for (uint16_t i = 0; i < fill; i++) {
+            sxx += (i - center) * (i - center);
+            sxy += (i - center) * (window[i] - mean);
+            sx_abs += fabs(i - center);
+        }
+        slope = sxy / sxx * 1000.0 / interval_ms;
+        slope_tol = sx_abs / sxx * half_step * 1000.0 / interval_ms;
+    }
+
+    double duration = fill * interval_ms / 1000.0;
+    double onset_age = 0.0;
+    if (ref->onset) {
+        onset_age = (now_ms - ref->onset_time) / 1000.0;
+        if (onset_age > ROTS_TEMPORAL_ONSET_AGE_MAX) onset_age = ROTS_TEMPORAL_ONSET_AGE_MAX;
+    }
+
+    expected[ROTS_TEMPORAL_SLOPE] = (float)slope;
+    expected[ROTS_TEMPORAL_EWMA] = ref->ewma;
+    expected[ROTS_TEMPORAL_RANGE] = max - min;
+    expected[ROTS_TEMPORAL_AREA] = (float)((mean - ref->baseline) * duration);
+    expected[ROTS_TEMPORAL_ONSET_AGE] = (float)onset_age;
+
+    tolerance[ROTS_TEMPORAL_SLOPE] = (float)slope_tol;
+    tolerance[ROTS_TEMPORAL_EWMA] = 0.0f;
+    tolerance[ROTS_TEMPORAL_RANGE] = 0.0f;
+    tolerance[ROTS_TEMPORAL_AREA] = (float)(half_step * duration);
+    tolerance[ROTS_TEMPORAL_ONSET_AGE] = 0.0f;
+}
+
+// 合成轨迹: 基线 + 高斯噪声 + 随机出现的响应脉冲 (指数上升/衰减)
+static void Check_Synthesize(Trace_t* trace, uint32_t frames, uint8_t channels, uint32_t jitter_ms) {
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::uniform_int_distribution<int> jitter(-(int)jitter_ms, (int)jitter_ms);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+    std::vector<float> level(channels, 0.0f), target(channels, 0.0f);
+    trace->channels = channels;
+    uint32_t timestamp = 0;
+    for (uint32_t f = 0; f < frames; f++) {
+        timestamp += CHECK_PERIOD_MS + jitter(rng);
+        trace->timestamps.push_back(timestamp);
+        for (uint8_t ch = 0; ch < channels; ch++) {
+            // 平均每分钟出现一次响应, 幅度从几ppm到上千ppm
+            if (target[ch] == 0.0f && chance(rng) < 1.0f / 600.0f) {
+                target[ch] = powf(10.0f, 3.0f * chance(rng));
+            } else if (target[ch] != 0.0f && chance(rng) < 1.0f / 150.0f) {
+                target[ch] = 0.0f;
+            }
+            level[ch] += 0.05f * (target[ch] - level[ch]);
+            trace->values.push_back(50.0f + 20.0f * ch + level[ch] + noise(rng));
+        }
+    }
+}
+
+// 读取轨迹文件, 各帧通道数须一致
+static bool Check_LoadTrace(const char* path, Trace_t* trace) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    trace->channels = 0;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        uint32_t timestamp;
+        if (!(fields >> timestamp)) continue;
+
+        float value;
+        uint8_t count = 0;
+        while (fields >> value && count < ROTS_MAX_CHANNELS) {
+            trace->values.push_back(value);
+            count++;
+        }
+        if (count == 0 || (trace->channels && count != trace->channels)) {
+            fprintf(stderr, "%s:%d: expected '<timestamp_ms> <1..%d channel values>' with a fixed channel count\n",
+                    path, line_no, ROTS_MAX_CHANNELS);
+            return false;
+        }
+        trace->channels = count;
+        trace->timestamps.push_back(timestamp);
+    }
+
+    if (trace->timestamps.empty()) {
+        fprintf(stderr, "%s: no frames\n", path);
+        return false;
+    }
+    return true;
+}
+
+// 传感器历史的调试输出 (主机端不链接rots_debug), 只显示错误
+void ROTS_Debug_Print(ROTS_DebugLevel_t level, const char* format, ...) {
+    if (level != ROTS_DEBUG_ERROR) return;
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+static int Check_Usage(void) {
+    fprintf(stderr, "usage: rots_temporal_check [trace.txt] [--frames N] [--channels N] [--jitter MS]\n"
+                    "       --jitter must be below %d ms\n", CHECK_PERIOD_MS);
+    return 2;
+}
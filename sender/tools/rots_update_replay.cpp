@@ -0,0 +1,281 @@
+// ROTS Update Replay - 远程模型更新回放测试 (主机端)
+//
+// 读入 rots_model_pack frames 生成的帧文件, 经固件同一份协议处理
+// (ROTS_ModelUpdate_HandleFrame) 写入主机模拟的模型分区, 依次回放
+// 顺序、重复、乱序、损坏、超时和切换前再次开始 (BUSY) 几种情形,
+// 核对每种情形的应答、最终状态和活动槽位. 任一情形不符时返回1.
+//
+// 构建:
+//   g++ -std=c++17 -O2 -I../src -o rots_update_replay rots_update_replay.cpp
+//       ../src/rots_model_update.cpp ../src/rots_model_store.cpp ../src/rots_model_blob.cpp
+// (以上为同一条命令)
+//
+// 用法:
+//   rots_model_pack frames model.bin frames --chunk 256
+//   rots_update_replay frames
+// 乱序情形需要至少3个数据帧.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "rots_sender.h"
+#include "rots_model_update.h"
+#include "rots_model_store.h"
+#include "rots_model_blob.h"
+
+#define REPLAY_FRAME_INTERVAL_MS  20      // 相邻帧的模拟到达间隔
+#define REPLAY_MAX_SENDS          4096    // 单次传输的发送上限 (防止续传死循环)
+
+typedef std::vector<uint8_t> Frame_t;
+
+// 私有变量
+static std::vector<Frame_t> frames;          // frame_0000.bin 起依次读入
+static std::vector<uint8_t> model;           // 数据帧拼出的原始模型
+static uint32_t now_ms = 0;
+static int failures = 0;
+
+// 私有函数声明
+static bool Replay_LoadFrames(const std::string& dir);
+static const ROTS_ModelFrameHeader_t* Replay_Header(const Frame_t& frame);
+static ROTS_StatusTypeDef Replay_Send(const Frame_t& frame, ROTS_ModelUpdateAck_t* ack);
+static ROTS_StatusTypeDef Replay_Transfer(const std::vector<size_t>& order, ROTS_ModelUpdateAck_t* ack);
+static bool Replay_FinishSwap(void);
+static void Replay_Check(const char* scenario, const char* what, bool ok);
+static uint8_t Replay_ActiveSlot(void);
+static int Replay_Usage(void);
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        return Replay_Usage();
+    }
+    if (!Replay_LoadFrames(argv[1])) {
+        return 1;
+    }
+    if (ROTS_ModelUpdate_Init() != ROTS_OK) {
+        fprintf(stderr, "host model store init failed\n");
+        return 1;
+    }
+
+    size_t data_frames = frames.size() - 2;
+    printf("%zu frames (%zu data), model %zu bytes, transfer %u\n", frames.size(), data_frames, model.size(),
+           (unsigned)Replay_Header(frames[0])->transfer_id);
+
+    std::vector<size_t> in_order;
+    for (size_t i = 0; i < frames.size(); i++) {
+        in_order.push_back(i);
+    }
+    ROTS_ModelUpdateAck_t ack;
+    ROTS_StatusTypeDef result;
+
+    // 顺序: 全部接受, 结束后READY, 切换后活动槽位改变
+    {
+        const char* name = "in-order";
+        uint8_t slot = Replay_ActiveSlot();
+        result = Replay_Transfer(in_order, &ack);
+        Replay_Check(name, "end frame accepted", result == ROTS_OK && ack.state == ROTS_MODEL_UPDATE_READY);
+        Replay_Check(name, "ack covers whole model", ack.next_offset == model.size());
+        Replay_Check(name, "swap and activate", Replay_FinishSwap());
+        Replay_Check(name, "active slot switched", Replay_ActiveSlot() != slot);
+    }
+
+    // 重复: 开始帧和每个数据帧各发两次, 重发帧应答OK且不推进偏移
+    {
+        const char* name = "duplicate";
+        std::vector<size_t> order;
+        for (size_t i = 0; i < frames.size(); i++) {
+            order.push_back(i);
+            if (i + 1 < frames.size()) order.push_back(i);
+        }
+        result = Replay_Transfer(order, &ack);
+        Replay_Check(name, "end frame accepted", result == ROTS_OK && ack.state == ROTS_MODEL_UPDATE_READY);
+        Replay_Check(name, "swap and activate", Replay_FinishSwap());
+    }
+
+    // 乱序: 先发第2个数据块, 被拒后按应答的偏移续传
+    if (data_frames >= 3) {
+        const char* name = "out-of-order";
+        ROTS_ModelUpdateStatus_t before, after;
+        ROTS_ModelUpdate_GetStatus(&before);
+        Replay_Send(frames[0], &ack);
+        result = Replay_Send(frames[2], &ack);
+        Replay_Check(name, "skipped-ahead chunk rejected", result == ROTS_ERROR);
+        Replay_Check(name, "ack points at first chunk", ack.next_offset == 0 && ack.state == ROTS_MODEL_UPDATE_RECEIVING);
+        result = Replay_Transfer(std::vector<size_t>(in_order.begin() + 1, in_order.end()), &ack);
+        ROTS_ModelUpdate_GetStatus(&after);
+        Replay_Check(name, "resumed transfer completes", result == ROTS_OK && ack.state == ROTS_MODEL_UPDATE_READY);
+        Replay_Check(name, "rejection counted", after.rejected_frames == before.rejected_frames + 1);
+        Replay_Check(name, "swap and activate", Replay_FinishSwap());
+    } else {
+        printf("[out-of-order] skipped: need at least 3 data frames (use a smaller --chunk)\n");
+    }
+
+    // 损坏: 帧头魔数错误的帧直接拒绝; 数据被篡改的传输在结束帧CRC核对失败, 活动槽位不变
+    {
+        const char* name = "corrupt";
+        uint8_t slot = Replay_ActiveSlot();
+        Frame_t bad_magic = frames[0];
+        bad_magic[0] ^= 0xFF;
+        Replay_Check(name, "bad magic rejected", Replay_Send(bad_magic, &ack) == ROTS_INVALID_PARAM);
+
+        Frame_t bad_length = frames[1];
+        bad_length.pop_back();
+        Replay_Send(frames[0], &ack);
+        Replay_Check(name, "truncated frame rejected", Replay_Send(bad_length, &ack) == ROTS_INVALID_PARAM);
+
+        Frame_t bad_data = frames[frames.size() / 2];
+        bad_data.back() ^= 0x01;
+        ROTS_StatusTypeDef last = ROTS_OK;
+        for (size_t i = 0; i < frames.size(); i++) {
+            last = Replay_Send(i == frames.size() / 2 ? bad_data : frames[i], &ack);
+        }
+        Replay_Check(name, "end frame fails CRC", last == ROTS_ERROR && ack.state == ROTS_MODEL_UPDATE_FAILED);
+        const uint8_t* blob = NULL;
+        uint32_t size = 0;
+        Replay_Check(name, "nothing to swap", ROTS_ModelUpdate_TakeReady(&blob, &size) != ROTS_OK);
+        Replay_Check(name, "active slot unchanged", Replay_ActiveSlot() == slot);
+    }
+
+    // 超时: 传到一半停止, 超时后失败, 迟到的数据帧被拒绝
+    {
+        const char* name = "timeout";
+        size_t half = 1 + data_frames / 2;
+        for (size_t i = 0; i < half; i++) {
+            Replay_Send(frames[i], &ack);
+        }
+        Replay_Check(name, "no timeout before deadline",
+                     ROTS_ModelUpdate_Poll(now_ms + ROTS_MODEL_UPDATE_TIMEOUT_MS) == ROTS_OK);
+        now_ms += ROTS_MODEL_UPDATE_TIMEOUT_MS + 1;
+        Replay_Check(name, "poll reports timeout", ROTS_ModelUpdate_Poll(now_ms) == ROTS_TIMEOUT);
+        Replay_Check(name, "late chunk rejected", Replay_Send(frames[half], &ack) == ROTS_INVALID_PARAM &&
+                                                  ack.state == ROTS_MODEL_UPDATE_FAILED && ack.result == ROTS_INVALID_PARAM);
+        result = Replay_Transfer(in_order, &ack);
+        Replay_Check(name, "restarted transfer completes", result == ROTS_OK && ack.state == ROTS_MODEL_UPDATE_READY);
+    }
+
+    // BUSY: 上一个模型尚未切换时, 新传输的开始帧返回ROTS_BUSY; 切换后可重新开始
+    {
+        const char* name = "busy";
+        Replay_Check(name, "begin while ready is busy", Replay_Send(frames[0], &ack) == ROTS_BUSY &&
+                                                        ack.state == ROTS_MODEL_UPDATE_READY);
+        Replay_Check(name, "swap and activate", Replay_FinishSwap());
+        Replay_Check(name, "begin after swap accepted", Replay_Send(frames[0], &ack) == ROTS_OK &&
+                                                        ack.state == ROTS_MODEL_UPDATE_RECEIVING);
+        Frame_t abort = frames[0];
+        ROTS_ModelFrameHeader_t header;
+        memcpy(&header, abort.data(), sizeof(header));
+        header.type = ROTS_MODEL_FRAME_ABORT;
+        header.length = 0;
+        memcpy(abort.data(), &header, sizeof(header));
+        abort.resize(sizeof(header));
+        Replay_Check(name, "abort returns to idle", Replay_Send(abort, &ack) == ROTS_OK &&
+                                                    ack.state == ROTS_MODEL_UPDATE_IDLE);
+    }
+
+    ROTS_ModelUpdateStatus_t status;
+    ROTS_ModelUpdate_GetStatus(&status);
+    printf("%u frames handled, %u rejected, %u completed, %u failed\n", (unsigned)status.frames,
+           (unsigned)status.rejected_frames, (unsigned)status.completed, (unsigned)status.failed);
+    printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
+
+// 读入 frame_NNNN.bin 直到缺号, 并拼出原始模型
+static bool Replay_LoadFrames(const std::string& dir) {
+    for (uint32_t index = 0; ; index++) {
+        char name[32];
+        snprintf(name, sizeof(name), "/frame_%04u.bin", (unsigned)index);
+        std::ifstream in(dir + name, std::ios::binary);
+        if (!in) {
+            break;
+        }
+        frames.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    if (frames.size() < 3) {
+        fprintf(stderr, "%s: need BEGIN, DATA... and END frames\n", dir.c_str());
+        return false;
+    }
+    for (size_t i = 0; i < frames.size(); i++) {
+        uint8_t expected = i == 0 ? ROTS_MODEL_FRAME_BEGIN :
+                           i + 1 == frames.size() ? ROTS_MODEL_FRAME_END : ROTS_MODEL_FRAME_DATA;
+        const ROTS_ModelFrameHeader_t* header = Replay_Header(frames[i]);
+        if (!header || header->type != expected) {
+            fprintf(stderr, "frame %zu: unexpected frame\n", i);
+            return false;
+        }
+        if (expected == ROTS_MODEL_FRAME_DATA) {
+            model.insert(model.end(), frames[i].begin() + sizeof(ROTS_ModelFrameHeader_t), frames[i].end());
+        }
+    }
+    return true;
+}
+
+// 帧头 (长度不足时为NULL)
+static const ROTS_ModelFrameHeader_t* Replay_Header(const Frame_t& frame) {
+    return frame.size() >= sizeof(ROTS_ModelFrameHeader_t) ? (const ROTS_ModelFrameHeader_t*)frame.data() : NULL;
+}
+
+// 发送一帧, 模拟时钟前进
+static ROTS_StatusTypeDef Replay_Send(const Frame_t& frame, ROTS_ModelUpdateAck_t* ack) {
+    now_ms += REPLAY_FRAME_INTERVAL_MS;
+    return ROTS_ModelUpdate_HandleFrame(frame.data(), (uint32_t)frame.size(), now_ms, ack);
+}
+
+// 按给定顺序发送, 像发送端一样在数据帧被拒时从应答的偏移续传; 返回最后一帧的结果
+static ROTS_StatusTypeDef Replay_Transfer(const std::vector<size_t>& order, ROTS_ModelUpdateAck_t* ack) {
+    ROTS_StatusTypeDef result = ROTS_ERROR;
+    size_t sends = 0;
+    for (size_t i = 0; i < order.size() && sends < REPLAY_MAX_SENDS; i++, sends++) {
+        const Frame_t& frame = frames[order[i]];
+        result = Replay_Send(frame, ack);
+        if (result == ROTS_ERROR && Replay_Header(frame)->type == ROTS_MODEL_FRAME_DATA) {
+            for (size_t f = 1; f + 1 < frames.size(); f++) {
+                if (Replay_Header(frames[f])->value == ack->next_offset) {
+                    std::vector<size_t> rest;
+                    for (size_t r = f; r < frames.size(); r++) rest.push_back(r);
+                    return Replay_Transfer(rest, ack);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// 模拟AI引擎切换: 取出新模型, 核对内容后确认
+static bool Replay_FinishSwap(void) {
+    const uint8_t* blob = NULL;
+    uint32_t size = 0;
+    if (ROTS_ModelUpdate_TakeReady(&blob, &size) != ROTS_OK || size != model.size() ||
+        memcmp(blob, model.data(), size) != 0 || ROTS_ModelBlob_Validate(blob, size) != ROTS_OK) {
+        return false;
+    }
+
+    ROTS_ModelUpdateAck_t ack;
+    return ROTS_ModelUpdate_Complete(ROTS_OK) == ROTS_OK && ROTS_ModelUpdate_GetAck(&ack) == ROTS_OK &&
+           ack.state == ROTS_MODEL_UPDATE_ACTIVE;
+}
+
+// 记录一项检查结果
+static void Replay_Check(const char* scenario, const char* what, bool ok) {
+    char tag[32];
+    snprintf(tag, sizeof(tag), "[%s]", scenario);
+    printf("%-16s %-30s %s\n", tag, what, ok ? "ok" : "FAILED");
+    if (!ok) {
+        failures++;
+    }
+}
+
+// 当前活动槽位
+static uint8_t Replay_ActiveSlot(void) {
+    ROTS_ModelStoreStatus_t status;
+    ROTS_ModelStore_GetStatus(&status);
+    return status.active_slot;
+}
+
+static int Replay_Usage(void) {
+    fprintf(stderr, "usage: rots_update_replay <frames_dir>\n");
+    return 2;
+}